@@ -11,6 +11,7 @@
 #include "lib_command.h"
 #include "lib_buffer.h"
 #include "lib_string.h"
+#include "lib_crc16.h"
 
 
 /*----------------------------------------------------------------------------
@@ -26,6 +27,8 @@
 
 /* Private typedef -----------------------------------------------------------*/
 /* Private define ------------------------------------------------------------*/
+#define CRC_BENCH_MAX           256U                        /**< CRC 명령어 최대 시험 길이 */
+#define CRC_BENCH_LOOPS         100U                        /**< CRC 명령어 반복 계산 횟수 */
 /* Private macro -------------------------------------------------------------*/
 /* Private variables ---------------------------------------------------------*/
 /** \defgroup Console_Thread_Private_Variables Console 쓰레드 비공개 변수
@@ -33,7 +36,8 @@
 static u08_t       _cmd_buf[MAX_SIZE_CMD_BUF];            /**< 명령어 버퍼 */
 static u32_t       _cmd_cnt;                              /**< 명령어 버퍼의 입력 카운트 */
 Bool_t g_monitor_flag;                                    /**< Console 모니터링용 플래그 */
-Bool_t g_temper_flag;
+u08_t  g_OpMode;                                          /**< RS-485 통신 동작 모드, MASTER면 통신 수행(Rs485com_Init) */
+u08_t  g_IdCnt;                                           /**< 마스터 : 연결된 PC 보드 수, 슬레이브 : 자기 보드 ID */
 /** \} Console_Thread_Private_Variables */
 
 /* Exported variables --------------------------------------------------------*/
@@ -75,6 +79,18 @@ static void Cmd_CurTemp(char_t str[]);
 static void Cmd_Mon_Con(char_t str[]);
 static void Cmd_PowerIn(char_t str[]);
 static void Cmd_Watchdog(char_t str[]);
+static void Cmd_Latency(char_t str[]);
+static void Cmd_OssdEvt(char_t str[]);
+static void Cmd_OssdVote(char_t str[]);
+static void Cmd_EbAct(char_t str[]);
+static void Cmd_Fault(char_t str[]);
+static void Cmd_Crc(char_t str[]);
+static void Cmd_Link(char_t str[]);
+static void Cmd_Baud(char_t str[]);
+static void Cmd_Diag(char_t str[]);
+static void Cmd_ConTx(char_t str[]);
+static void Cmd_Dlog(char_t str[]);
+static void Cmd_Log(char_t str[]);
 
 /** \} Console_Thread_Private_Functions */
 
@@ -165,6 +181,18 @@ static void Console_Process_Command(void)
     {"MONCON",  &Cmd_Mon_Con},  
     {"PWRIN", &Cmd_PowerIn},
     {"WATCHDOG",&Cmd_Watchdog},		
+    {"LATENCY", &Cmd_Latency},
+    {"OSSDEVT", &Cmd_OssdEvt},
+    {"OSSDVOTE",&Cmd_OssdVote},
+    {"EBACT",   &Cmd_EbAct},
+    {"FAULT",   &Cmd_Fault},
+    {"CRC",     &Cmd_Crc},
+    {"LINK",    &Cmd_Link},
+    {"BAUD",    &Cmd_Baud},
+    {"DIAG",    &Cmd_Diag},
+    {"CONTX",   &Cmd_ConTx},
+    {"DLOG",    &Cmd_Dlog},
+    {"LOG",     &Cmd_Log},
     {"CMDHIS",  &Cmd_History},
   };
   u32_t    nbrOfCmd = (sizeof(cmd_list) / sizeof(cmd_list[0]));
@@ -179,8 +207,10 @@ static void Console_Process_Command(void)
 		input = Cmd_Parse_Input(_cmd_buf, &_cmd_cnt);
 		if (input == COMMAND)
 		{
-    /* 명령어 실행한다. */
+    /* 명령어 실행한다. 응답은 높은 우선순위 출력(BLOCK_HIGH 정책에서 공간을 기다림) */
+			Rs232_Set_Tx_High(serial3, True);
 			Cmd_Parse_Command(_cmd_buf, _cmd_cnt, cmd_list, nbrOfCmd);
+			Rs232_Set_Tx_High(serial3, False);
     /* 버퍼 카운트와 버퍼를 클리어한다. */
 			_cmd_cnt = 0U;
 			Buffer08_Set(&_cmd_buf[0], 0U, MAX_SIZE_CMD_BUF);
@@ -210,6 +240,18 @@ static void Cmd_Help(char_t str[])
   "| MONCON                      | show State Console On                |\n"	
 	"| WATCHDOG                    | turn WATCHDOG on or off              |\n"
 	"| PWRIN                       | show Power Ok CPU Input state        |\n"
+  "| LATENCY [CLR/BIN]           | show/clear/dump Detect Latency[usec] |\n"
+  "| OSSDEVT [CLR/GLITCH usec]   | show OSSD Edge Counter/Glitch Filter |\n"
+  "| OSSDVOTE [N M_ON M_OFF]     | show/set OSSD M-of-N Vote            |\n"
+  "| EBACT                       | show EB Relay Actuation State        |\n"
+  "| FAULT [CLR|RPT sec]         | show/clear Latched Fault, Report Int |\n"
+  "| CRC [len]                   | CRC16 Self Test, Benchmark[cycle]    |\n"
+  "| LINK [CLR|BIN|RETRY n]      | RS485 Link Stat per Node, Retry      |\n"
+  "| BAUD [bps]                  | RS485 Speed / Max Speed to Negotiate |\n"
+  "| DIAG [CLR]                  | DM/PC Board Sensor Health via RS485  |\n"
+  "| CONTX [NEW|OLD|BLOCK|CLR]   | Console TX Overflow Policy, Drops    |\n"
+  "| DLOG [BIN|TEXT|OFF|CLR]     | Deferred Log Output Mode, Stat       |\n"
+  "| LOG [module|ALL level]      | show/set Log Level per Module        |\n"
   ;
   static const char_t *end_line =
   "+-----------------------------+--------------------------------------+\n";
@@ -592,7 +634,7 @@ static void Cmd_CurVlt(char_t str[])
   {		
     for(i = 0; i < kNbrOfSIs ; i ++)
 	  {
-			  cprintf(" Senor[%d] Currnet Volte =  %d[mV]\r\n",(i+1),sdin[i]->Sensor_Voltage);
+			  cprintf(" Senor[%d] Currnet Volte =  %d[mV]\r\n",(i+1),Device_ADC_To_mV(i, sdin[i]->Sensor_Adc));
         cprintf(" Senor[%d] Currnet Low Counter =  %d[mV]\r\n",(i+1),sdin[i]->Sensor_Low_Counter);
     }		
   }
@@ -612,33 +654,36 @@ static void Cmd_CurTemp(char_t str[])
 {  
 
 	 u32_t temper=0;	
+	 i32_t temper_mC=0;                                                /**< 출력용 온도 크기(0.001 ℃) */
 	
 	 temper = TMP117_get_Temperature(hi2c1);
 	 if(temper > MINUS_TEMPER)
 	 {  
 		  g_device_temper=((65535-temper)*0.0078125);
+		  temper_mC = (i32_t)(((65535U - temper) * 125U) / 16U);      /**< 1/128 ℃ -> 0.001 ℃ */
 	    if(g_monitor_flag == True)
       {		
-		     cprintf("\n DEOD Temperature : -%f\n",g_device_temper);	
+		     cprintf("\n DEOD Temperature : -%.3q\n",temper_mC);	
 		  }
-		  cprintf("\n DEOD Temperature : -%f\n",g_device_temper);
+		  cprintf("\n DEOD Temperature : -%.3q\n",temper_mC);
 	 }
 	 else 
 	 {
 		  g_device_temper=((temper)*0.0078125);
+		  temper_mC = (i32_t)((temper * 125U) / 16U);
       if(g_monitor_flag == True)
       {			
-		     cprintf("\n DEOD Temperature : %f\n",g_device_temper);	
+		     cprintf("\n DEOD Temperature : %.3q\n",temper_mC);	
 		  }
-		  cprintf("\n DEOD Temperature : %f\n",g_device_temper);
+		  cprintf("\n DEOD Temperature : %.3q\n",temper_mC);
 	 }
-//   g_temper_flag = True;
 }
 
 
 /** \brief  "MONCON" 명령어에 대해 속도 모니터링을 제어한다.
   * \param  str - 명령어 옵션 문자열
   * \note   "ON"이면 모니터링을 켜고, "OFF"이면 모니터링을 끈다.
+  *         센서 측정값 출력을 위해 DEOD 로그 레벨도 함께 DEBUG/기본값으로 바꾼다.
   * \retval 없음
   */
 static void Cmd_Mon_Con(char_t str[])
@@ -657,11 +702,13 @@ static void Cmd_Mon_Con(char_t str[])
 		{
 			 cprintf("ON\n");
 			 g_monitor_flag = True;
+			 (void)Dlog_Set_Level(kLOG_DEOD, LOG_LVL_DEBUG);
 		}
 		else if (String_Compare_woCase(szONOFF, text[1]) == 0U)
 		{
 			 cprintf("OFF\n");
 			 g_monitor_flag = False;
+			 (void)Dlog_Set_Level(kLOG_DEOD, LOG_LEVEL_DEFAULT);
 		}
 		else
 		{
@@ -716,6 +763,531 @@ static void Cmd_Watchdog(char_t str[])
 	}
 }
 
+/** \brief  "LATENCY" 명령어에 대해 감지 지연시간 통계를 출력한다.
+  * \param  str - 명령어 옵션 문자열
+  * \note   "LATENCY"이면 단계별 count/min/max/p50/p90/p99/last[usec]를 출력하고,
+  *         "LATENCY CLR"이면 히스토그램을 지우며, "LATENCY BIN"이면 binary로 덤프한다.
+  *         기준(t0)은 동작 전류가 처음 나타난 ADC 프레임의 변환 완료 시점이다.
+  * \retval 없음
+  */
+static void Cmd_Latency(char_t str[])
+{
+  char_t    *szOpt, *szNext;
+  LatStat_t  st;
+  u08_t      s;
+
+  szOpt  = String_Extract_Word(str, &szNext, ' ');
+  if (*szOpt == '\0')
+  {
+    cprintf("\n%-10s %8s %8s %8s %8s %8s %8s %8s\n",
+            "STAGE", "COUNT", "MIN", "MAX", "P50", "P90", "P99", "LAST");
+    for (s = 0; s < kNbrOfLatStages; s++)
+    {
+      Latency_Get_Stat((LatStage_t)s, &st);
+      cprintf("%-10s %8d %8d %8d %8d %8d %8d %8d\n", Latency_Stage_Name((LatStage_t)s),
+              st.count, st.min, st.max, st.p50, st.p90, st.p99, st.last);
+    }
+  }
+  else if (String_Compare_woCase(szOpt, "CLR") == 0U)
+  {
+    Latency_Clear();
+    cprintf("Latency Clear\n");
+  }
+  else if (String_Compare_woCase(szOpt, "BIN") == 0U)
+  {
+    Latency_Dump(&cprint);
+  }
+  else
+  {
+    cprintf("Plz, append CLR or BIN\n");
+  }
+}
+
+/** \brief  "OSSDEVT" 명령어에 대해 OSSD edge 통계를 출력한다.
+  * \param  str - 명령어 옵션 문자열
+  * \note   "OSSDEVT"이면 Pin별 EXTI edge/확정/glitch 수와 센서별 OSSD1/OSSD2 skew, 불일치, 한쪽 pulse 횟수를 출력하고,
+  *         "OSSDEVT CLR"이면 통계를 지우며, "OSSDEVT GLITCH 300"이면 최소 pulse 폭을 300usec로 설정한다.
+  * \retval 없음
+  */
+static void Cmd_OssdEvt(char_t str[])
+{
+  char_t        *szOpt, *szNext, *szUsec;
+  OssdPinStat_t  pin;
+  OssdSenStat_t  sen;
+  u08_t          i;
+
+  szOpt  = String_Extract_Word(str, &szNext, ' ');
+  if (*szOpt == '\0')
+  {
+    cprintf("\nGlitch Filter = %d usec, Overflow = %d, Resync = %d\n",
+            Ossd_Edge_Get_Glitch(), Device_Ossd_Edge_Overflow(), Ossd_Edge_Resync_Count());
+    for (i = 0; i < kNbrOfSOs; i++)
+    {
+      Ossd_Edge_Get_Pin_Stat(i, &pin);
+      cprintf("%s OSSD%d : Edge = %d, Accept = %d, Glitch = %d\n",
+              sdin[i / 2U]->name, (i % 2U) + 1U, pin.edges, pin.accepted, pin.glitch);
+    }
+    for (i = 0; i < kNbrOfSIs; i++)
+    {
+      Ossd_Edge_Get_Sen_Stat(i, &sen);
+      cprintf("%s Skew = %d usec(max %d), Discrepancy = %d, Pulse = %d\n",
+              sdin[i]->name, sen.skew_last, sen.skew_max, sen.discrepancy, sen.pulse);
+    }
+  }
+  else if (String_Compare_woCase(szOpt, "CLR") == 0U)
+  {
+    Ossd_Edge_Clear();
+    cprintf("OSSD Edge Clear\n");
+  }
+  else if (String_Compare_woCase(szOpt, "GLITCH") == 0U)
+  {
+    szUsec = String_Extract_Word(szNext, &szNext, ' ');
+    if ((*szUsec == '\0') || (Ossd_Edge_Set_Glitch((u32_t)String_Convert_toInteger(szUsec)) != True))
+    {
+      cprintf("Plz, append GLITCH 0 ~ %d[usec]\n", OSSD_GLITCH_usec_MAX);
+    }
+    else
+    {
+      cprintf("Glitch Filter = %d usec\n", Ossd_Edge_Get_Glitch());
+    }
+  }
+  else
+  {
+    cprintf("Plz, append CLR or GLITCH usec\n");
+  }
+}
+
+/** \brief  "OSSDVOTE" 명령어에 대해 OSSD 확정 투표(M-of-N) 설정을 표시/변경한다.
+  * \param  str - 명령어 옵션 문자열
+  * \note   "OSSDVOTE 8 6 2"이면 최근 8 sample 중 6개 이상 High면 확정, 2개 이하면 해제한다.
+  * \retval 없음
+  */
+static void Cmd_OssdVote(char_t str[])
+{
+  char_t  *szN, *szOn, *szOff, *szNext;
+  u08_t    n, on, off;
+  i32_t    v[3];
+
+  szN = String_Extract_Word(str, &szNext, ' ');
+  if (*szN != '\0')
+  {
+    szOn  = String_Extract_Word(szNext, &szNext, ' ');
+    szOff = String_Extract_Word(szNext, &szNext, ' ');
+    v[0] = String_Convert_toInteger(szN);
+    v[1] = String_Convert_toInteger(szOn);
+    v[2] = String_Convert_toInteger(szOff);
+    if ((*szOn == '\0') || (*szOff == '\0')
+        || (v[0] < 0) || (v[0] > 255) || (v[1] < 0) || (v[1] > 255) || (v[2] < 0) || (v[2] > 255)
+        || (Deod_Set_Ossd_Vote((u08_t)v[0], (u08_t)v[1], (u08_t)v[2]) != True))
+    {
+      cprintf("Plz, append N(1~%d) M_ON(1~N) M_OFF(<M_ON)\n", OSSD_VOTE_WINDOW_MAX);
+      return;
+    }
+  }
+  Deod_Get_Ossd_Vote(&n, &on, &off);
+  cprintf("OSSD Vote : Confirm %d of %d, Release <= %d\n", on, n, off);
+}
+
+/** \brief  "EBACT" 명령어에 대해 EB 릴레이 동작 상태와 이력을 표시한다.
+  * \param  str - 명령어 옵션 문자열
+  * \note   EB 동작 후에도 loop가 계속 돌기 때문에 사후 진단에 사용한다.
+  * \retval 없음
+  */
+static void Cmd_EbAct(char_t str[])
+{
+  EbInfo_t info;
+
+  (void)str;
+  Eb_Act_Get_Info(&info);
+  cprintf("EB State : %s\n", Eb_Act_State_Name(info.state));
+  if (info.state != kEB_IDLE)
+  {
+    cprintf("Cause    : %s (%s)\n", Eb_Act_Cause_Name(info.cause), info.name);
+    cprintf("Tripped  : %d msec ago\n", (HAL_GetTick() - info.trip_tick));
+    cprintf("Feedback : %d usec, Lost %d\n", info.fb_usec, info.fb_loss);
+  }
+}
+
+/** \brief  "FAULT" 명령어에 대해 latch된 고장과 고장별 발생 횟수를 표시한다.
+  * \param  str - 명령어 옵션 문자열
+  * \note   "FAULT CLR"는 발생 횟수와 반응 시간만 지운다(latch는 리셋으로만 해제).
+  * \retval 없음
+  */
+static void Cmd_Fault(char_t str[])
+{
+  char_t         *szOpt, *szNext, *szSec;
+  FaultInfo_t     info;
+  FaultStat_t     stat;
+  FaultRptInfo_t  rpt;
+  u08_t           i;
+
+  szOpt = String_Extract_Word(str, &szNext, ' ');
+  if (*szOpt != '\0')
+  {
+    if (String_Compare_woCase(szOpt, "CLR") == 0U)
+    {
+      Fault_Clear_Stat();
+      cprintf("Fault Counter Cleared\n");
+    }
+    else if (String_Compare_woCase(szOpt, "RPT") == 0U)
+    {
+      szSec = String_Extract_Word(szNext, &szNext, ' ');
+      if (Fault_Report_Set_Interval((u32_t)String_Convert_toInteger(szSec) * 1000U) == False)
+      {
+        cprintf("Plz, append %d ~ %d sec\n", FAULT_RPT_MIN_msec / 1000U, FAULT_RPT_MAX_msec / 1000U);
+        return;
+      }
+      cprintf("Fault Report every %s sec\n", szSec);
+    }
+    else
+    {
+      cprintf("Plz, append CLR or RPT sec\n");
+    }
+    return;
+  }
+  Fault_Get_Info(&info);
+  cprintf("Fault Level : %s, React %d usec (max %d)\n",
+          Fault_Sev_Name(info.level), info.react_last, info.react_max);
+  if (info.first_valid == True)
+  {
+    cprintf("First Fault : %s (%d) at %d msec\n",
+            Fault_Name(info.first), info.first_detail, info.first_tick);
+  }
+  for (i = 0U; i < kNbrOfFaults; i++)
+  {
+    Fault_Get_Stat((FaultCode_t)i, &stat);
+    if ((stat.count != 0U) || (Fault_Is_Latched((FaultCode_t)i) == True))
+    {
+      cprintf("  %s [%s] %s count %d, detail %d\n", Fault_Name((FaultCode_t)i),
+              Fault_Sev_Name(Fault_Severity((FaultCode_t)i)),
+              (Fault_Is_Latched((FaultCode_t)i) == True) ? "LATCH" : "-", stat.count, stat.detail);
+    }
+  }
+  Fault_Report_Get_Info(&rpt);
+  cprintf("Report every %d sec : Repeating %d, Suppressed %d, No Slot %d\n",
+          rpt.interval / 1000U, rpt.active, rpt.suppressed, rpt.overflow);
+}
+
+
+/** \brief  "CRC" 명령어에 대해 CRC16 자기시험과 byte 단위/slice 구현의 계산 시간을 표시한다.
+  * \param  str - 명령어 옵션 문자열
+  * \note   "CRC 64"이면 64 byte를 각 구현으로 CRC_BENCH_LOOPS 번 계산한 평균 DWT cycle을 표시한다.
+  * \retval 없음
+  */
+static void Cmd_Crc(char_t str[])
+{
+  static u08_t  buf[CRC_BENCH_MAX];
+  char_t       *szLen, *szNext;
+  i32_t         len = 64;
+  u32_t         byte_clk, slice_clk, i;
+
+  szLen = String_Extract_Word(str, &szNext, ' ');
+  if (*szLen != '\0')
+  {
+    len = String_Convert_toInteger(szLen);
+    if ((len < 1) || (len > (i32_t)CRC_BENCH_MAX))
+    {
+      cprintf("Plz, append len(1~%d)\n", CRC_BENCH_MAX);
+      return;
+    }
+  }
+  for (i = 0U; i < CRC_BENCH_MAX; i++)
+  {
+    buf[i] = (u08_t)((i * 7U) + 3U);
+  }
+  cprintf("CRC16 Self Test : %s\n", (Crc16_Krs_Self_Test() == True) ? "OK" : "FAIL");
+  Crc16_Krs_Bench(buf, (u32_t)len, CRC_BENCH_LOOPS, &Latency_Now, &byte_clk, &slice_clk);
+  cprintf("len %d : Bytewise %d cycle, Slice-by-%d %d cycle\n", len, byte_clk, CRC16_KRS_SLICE, slice_clk);
+}
+
+/** \brief  "LINK" 명령어에 대해 RS-485 보드(node)별 통신 통계를 표시한다.
+  * \param  str - 명령어 옵션 문자열
+  * \note   "LINK CLR"는 계수를 지우고, "LINK BIN"은 보드별 통계 frame을 HEX로 출력하며,
+  *         "LINK RETRY 2"는 통신 고장으로 판정하기 전 연속 무응답 허용 횟수를 바꾼다.
+  *         ID 0은 어느 보드인지 알 수 없는 오류다.
+  *         마지막 줄은 serial1의 DMA 송신 frame 수와 TC에서 잰 TXE(DE) 해제 지연이다.
+  * \retval 없음
+  */
+static void Cmd_Link(char_t str[])
+{
+  char_t          *szOpt, *szNext, *szVal;
+  Rs485LinkStat_t  stat;
+  u08_t            frame[RS485_LINK_FRAME_SIZE];
+  u32_t            len, i;
+  u08_t            id;
+
+  szOpt = String_Extract_Word(str, &szNext, ' ');
+  if (*szOpt != '\0')
+  {
+    if (String_Compare_woCase(szOpt, "CLR") == 0U)
+    {
+      Rs485_Link_Clear_Stat();
+      cprintf("Link Counter Cleared\n");
+    }
+    else if (String_Compare_woCase(szOpt, "BIN") == 0U)
+    {
+      for (id = 0U; id <= RS485_LINK_NODE_MAX; id++)
+      {
+        len = Rs485_Link_Build_Frame(id, frame, sizeof(frame));
+        for (i = 0U; i < len; i++)
+        {
+          cprintf("%02X", frame[i]);
+        }
+        cprintf("\n");
+      }
+    }
+    else if (String_Compare_woCase(szOpt, "RETRY") == 0U)
+    {
+      szVal = String_Extract_Word(szNext, &szNext, ' ');
+      if ((*szVal == '\0') || (Rs485_Link_Set_Retry((u08_t)String_Convert_toInteger(szVal)) == False))
+      {
+        cprintf("Plz, append RETRY n(0~%d)\n", RS485_LINK_RETRY_MAX);
+        return;
+      }
+      cprintf("Link Retry %d\n", Rs485_Link_Get_Retry());
+    }
+    else
+    {
+      cprintf("Plz, append CLR, BIN or RETRY n\n");
+    }
+    return;
+  }
+  cprintf("Link Retry %d, RTT[usec] min/avg/max\n", Rs485_Link_Get_Retry());
+  for (id = 0U; id <= RS485_LINK_NODE_MAX; id++)
+  {
+    (void)Rs485_Link_Get_Stat(id, &stat);
+    if ((stat.sent == 0U) && (stat.crc_err == 0U) && (stat.id_err == 0U) && (stat.len_err == 0U))
+    {
+      continue;
+    }
+    cprintf("  ID %d : Sent %d, Reply %d, CRC %d, Timeout %d, ID %d, Len %d, RTT %d/%d/%d, RTO %d\n",
+            id, stat.sent, stat.replies, stat.crc_err, stat.timeouts, stat.id_err, stat.len_err,
+            stat.rtt_min, Rs485_Link_Rtt_Avg(id), stat.rtt_max, stat.rto);
+  }
+  cprintf("  DMA %s : Frame %d, Drop %d, DE turnaround[usec] last/max %d/%d\n",
+          (serial1->hdma_tx != NULL) ? "ON" : "OFF", serial1->dma_frames, serial1->dma_drop,
+          serial1->turn_usec, serial1->turn_max_usec);
+}
+
+/** \brief  "BAUD" 명령어에 대해 RS-485 통신 속도와 협상 상태를 표시하거나 최대 속도를 바꾼다.
+  * \param  str - 명령어 옵션 문자열
+  * \note   "BAUD 230400"이면 최대 속도를 230400으로 하고 다시 협상한다.
+  *         RS-485 통신을 쓰지 않는 보드(Dip-Switch 0, g_OpMode != MASTER)에서는 동작하지 않는다.
+  * \retval 없음
+  */
+static void Cmd_Baud(char_t str[])
+{
+  char_t          *szRate, *szNext;
+  Rs485BaudInfo_t  info;
+  Rs485Baud_t      code;
+
+  if (g_OpMode != MASTER)
+  {
+    cprintf("RS485 Link Not Used\n");
+    return;
+  }
+  szRate = String_Extract_Word(str, &szNext, ' ');
+  if (*szRate != '\0')
+  {
+    code = Rs485_Baud_Code((u32_t)String_Convert_toInteger(szRate));
+    if (Rs485_Baud_Set_Max(code) == False)
+    {
+      cprintf("Plz, append 38400, 115200, 230400 or 460800\n");
+      return;
+    }
+    cprintf("RS485 Max %d bps, Negotiate\n", Rs485_Baud_Rate(code));
+    return;
+  }
+  Rs485_Baud_Get_Info(&info);
+  cprintf("RS485 %d bps, Max %d, Allowed %d\n",
+          Rs485_Baud_Rate(info.cur), Rs485_Baud_Rate(info.max), Rs485_Baud_Rate(info.cap));
+  cprintf("Negotiated %d, Fallback %d, Error %d/%d frame%s\n",
+          info.negotiations, info.fallbacks, info.win_err, (info.win_ok + info.win_err),
+          (info.need == True) ? ", Pending" : "");
+}
+
+/** \brief  "DIAG" 명령어에 대해 마스터가 모은 DM/PC 보드별 확장 진단을 표시한다.
+  * \param  str - 명령어 옵션 문자열
+  * \note   "DIAG CLR"는 모은 진단과 계수를 지운다. Age는 마지막 수신 후 지난 시간이다.
+  *         OSSD는 OSSD1/OSSD2/확정 bit(bit0 = 센서 1), FB는 릴레이 Feedback bit(kRYFBI_x)이다.
+  * \retval 없음
+  */
+static void Cmd_Diag(char_t str[])
+{
+  char_t          *szOpt, *szNext;
+  Rs485DiagNode_t  node;
+  i32_t            temper;
+  u08_t            id;
+
+  szOpt = String_Extract_Word(str, &szNext, ' ');
+  if (String_Compare_woCase(szOpt, "CLR") == 0U)
+  {
+    Rs485_Diag_Clear();
+    cprintf("Diag Cleared\n");
+    return;
+  }
+  for (id = 1U; id <= RS485_DIAG_NODE_MAX; id++)
+  {
+    (void)Rs485_Diag_Get_Node(id, &node);
+    if (node.requests == 0U)
+    {
+      continue;
+    }
+    cprintf("  ID %d : Req %d, Rx %d, Timeout %d, Lost %d", id, node.requests, node.frames, node.timeouts, node.seq_lost);
+    if (node.valid == False)
+    {
+      cprintf("\n");
+      continue;
+    }
+    temper = ((i32_t)node.last.temper_raw * 10) / 128;                /**< 0.1 ℃ */
+    cprintf(", Age %d msec, Seq %d, Up %d sec\n", HAL_GetTick() - node.rx_tick, node.last.seq, node.last.uptime_msec / 1000U);
+    cprintf("         Sensor %d/%d/%d/%d mV, OSSD %02X/%02X/%02X, FB %02X, Temp %.1q C, Fault %08X(%s) x%d\n",
+            node.last.sensor_mv[0], node.last.sensor_mv[1], node.last.sensor_mv[2], node.last.sensor_mv[3],
+            node.last.ossd1, node.last.ossd2, node.last.ossd_confirmed, node.last.relay_fb,
+            temper,
+            node.last.fault_latched, Fault_Sev_Name((FaultSev_t)node.last.fault_level), node.last.fault_count);
+  }
+}
+
+/** \brief  "CONTX" 명령어에 대해 콘솔 송신 버퍼 넘침 정책과 버림 계수를 표시하거나 바꾼다.
+  * \param  str - 명령어 옵션 문자열
+  * \note   NEW는 새 메시지를, OLD는 오래된 byte를 버리고, BLOCK은 명령어 응답만 기다린다.
+  *         cprintf() 형식화 시간(clk/call)도 함께 표시한다. "CONTX CLR"는 계수를 지운다.
+  * \retval 없음
+  */
+static void Cmd_ConTx(char_t str[])
+{
+  static const char_t * const policy_name[kRS232_TX_POLICY_MAX] = {"NEW", "OLD", "BLOCK"};
+  char_t        *szOpt, *szNext;
+  CprintfStat_t  fmt;
+  u08_t          policy;
+
+  szOpt = String_Extract_Word(str, &szNext, ' ');
+  if (String_Compare_woCase(szOpt, "CLR") == 0U)
+  {
+    Rs232_Clear_Tx_Stat(serial3);
+    Cprintf_Clear_Stat();
+    cprintf("Console TX Stat Cleared\n");
+    return;
+  }
+  if (*szOpt != '\0')
+  {
+    for (policy = 0U; policy < (u08_t)kRS232_TX_POLICY_MAX; policy++)
+    {
+      if (String_Compare_woCase(szOpt, policy_name[policy]) == 0U)
+      {
+        break;
+      }
+    }
+    if (Rs232_Set_Tx_Policy(serial3, policy) == False)
+    {
+      cprintf("Plz, append NEW, OLD, BLOCK or CLR\n");
+      return;
+    }
+  }
+  cprintf("Console TX %s, Policy %s, Buf Peak %d/%d byte\n",
+          (serial3->hdma_tx != NULL) ? "DMA" : "TXE", policy_name[serial3->tx_policy],
+          serial3->tx_peak, serial3->tx_size);
+  cprintf("Msg %d, Drop New %d msg, Drop Old %d byte, Blocked %d, DMA %d xfer\n",
+          serial3->tx_msgs, serial3->tx_drop_new, serial3->tx_drop_old, serial3->tx_blocked, serial3->dma_xfers);
+  Cprintf_Get_Stat(&fmt);
+  cprintf("Format %d call, %d char, Last %d, Max %d clk/call, Queue Max %d clk (%d clk/usec)\n",
+          fmt.calls, fmt.chars, fmt.fmt_last, fmt.fmt_max, fmt.put_max, LATENCY_CLOCK_PER_usec);
+}
+
+/** \brief  "DLOG" 명령어에 대해 지연 로그 출력 모드와 통계를 표시하거나 모드를 바꾼다.
+  * \param  str - 명령어 옵션 문자열
+  * \note   BIN은 binary frame(PC 도구 tools/dlog_decode.py로 복원), TEXT는 글자 출력,
+  *         OFF는 ring에 모아 둔다. "DLOG CLR"는 통계를 지운다.
+  * \retval 없음
+  */
+static void Cmd_Dlog(char_t str[])
+{
+  static const char_t * const mode_name[kNbrOfDlogModes] = {"BIN", "TEXT", "OFF"};
+  char_t      *szOpt, *szNext;
+  DlogStat_t   st;
+  u08_t        mode;
+
+  szOpt = String_Extract_Word(str, &szNext, ' ');
+  if (String_Compare_woCase(szOpt, "CLR") == 0U)
+  {
+    Dlog_Clear_Stat();
+    cprintf("Dlog Stat Cleared\n");
+    return;
+  }
+  if (*szOpt != '\0')
+  {
+    for (mode = 0U; mode < (u08_t)kNbrOfDlogModes; mode++)
+    {
+      if (String_Compare_woCase(szOpt, mode_name[mode]) == 0U)
+      {
+        break;
+      }
+    }
+    if (Dlog_Set_Mode((DlogMode_t)mode) == False)
+    {
+      cprintf("Plz, append BIN, TEXT, OFF or CLR\n");
+      return;
+    }
+  }
+  Dlog_Get_Stat(&st);
+  cprintf("Dlog %s, Ring %d/%d word (Peak %d)\n", mode_name[st.mode], st.used, DLOG_RING_WORDS, st.peak);
+  cprintf("Record %d, Drop %d, Frame %d, %d byte\n", st.records, st.drops, st.frames, st.bytes);
+}
+
+/** \brief  "LOG" 명령어에 대해 모듈별 로그 레벨을 표시하거나 바꾼다.
+  * \param  str - 명령어 옵션 문자열
+  * \note   "LOG RS485 TRACE"처럼 모듈(DEOD, RS485, SYSMON, STL, CONSOLE 또는 ALL)과
+  *         레벨(OFF, ERROR, WARN, INFO, DEBUG, TRACE)을 준다. 출력은 DLOG 모드를 따른다.
+  *         빌드 레벨보다 자세한 호출은 컴파일에서 빠져 있어 레벨을 올려도 나오지 않는다.
+  * \retval 없음
+  */
+static void Cmd_Log(char_t str[])
+{
+  static const char_t * const mod_name[kNbrOfLogMods] = {"DEOD", "RS485", "SYSMON", "STL", "CONSOLE"};
+  static const char_t * const lvl_name[LOG_LVL_TRACE + 1] = {"OFF", "ERROR", "WARN", "INFO", "DEBUG", "TRACE"};
+  char_t  *szMod, *szLvl, *szNext;
+  Bool_t   found = False;
+  Bool_t   all;
+  u08_t    mod, lvl;
+
+  szMod = String_Extract_Word(str, &szNext, ' ');
+  if (*szMod != '\0')
+  {
+    szLvl = String_Extract_Word(szNext, &szNext, ' ');
+    all   = (String_Compare_woCase(szMod, "ALL") == 0U) ? True : False;
+    for (lvl = 0U; lvl <= (u08_t)LOG_LVL_TRACE; lvl++)
+    {
+      if (String_Compare_woCase(szLvl, lvl_name[lvl]) == 0U)
+      {
+        break;
+      }
+    }
+    if ((*szLvl == '\0') || (lvl > (u08_t)LOG_LVL_TRACE))
+    {
+      cprintf("Plz, append OFF, ERROR, WARN, INFO, DEBUG or TRACE\n");
+      return;
+    }
+    for (mod = 0U; mod < (u08_t)kNbrOfLogMods; mod++)
+    {
+      if ((all == True) || (String_Compare_woCase(szMod, mod_name[mod]) == 0U))
+      {
+        (void)Dlog_Set_Level((LogMod_t)mod, lvl);
+        found = True;
+      }
+    }
+    if (found == False)
+    {
+      cprintf("Plz, append DEOD, RS485, SYSMON, STL, CONSOLE or ALL\n");
+      return;
+    }
+  }
+  cprintf("Log Build Level %s, Output DLOG\n", lvl_name[LOG_LEVEL_BUILD]);
+  for (mod = 0U; mod < (u08_t)kNbrOfLogMods; mod++)
+  {
+    cprintf("  %-8s %s\n", mod_name[mod], lvl_name[g_dlog_level[mod]]);
+  }
+}
 
 /** \} Console_Thread_Private_Functions */
 
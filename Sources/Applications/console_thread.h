@@ -33,7 +33,6 @@
   * \{ */
 #define MAX_SIZE_CMD_BUF 20U          /**< 명령어 버퍼 크기 */
 extern Bool_t g_monitor_flag;
-extern Bool_t g_temper_flag;
 extern void Console_Thread(void);
 extern u08_t g_OpMode;
 extern u08_t g_IdCnt;
@@ -9,6 +9,7 @@
 /* Includes ------------------------------------------------------------------*/
 #include "deod_thread.h"
 #include "device.h"
+#include "rs485com_thread.h"
 
 
 /* Private define ------------------------------------------------------------*/
@@ -30,14 +31,54 @@ u32_t   	g_Low_Voltage_Check_timer=0;
   * \{ */
 
 /* Private typedef -----------------------------------------------------------*/
+/** \brief 센서 채널 테이블(struct-of-arrays)
+  * \note  Deod_Init()에서 한번 구성하며, 채널이 늘어나면 테이블 크기(kNbrOfSIs)만 늘어난다. */
+typedef struct
+{
+  u08_t      num;                                   /* 사용 채널 수(2CH/4CH) */
+  u16_t      act_min[kNbrOfSIs];                    /* 판정 기준값(ADC code), sensor_thr[] 복사 */
+  u16_t      act_max[kNbrOfSIs];
+  u16_t      high[kNbrOfSIs];
+  u16_t      low[kNbrOfSIs];
+  u16_t      low_clear[kNbrOfSIs];
+  u08_t      pair[kNbrOfSIs];                       /* 좌/우 반대편 채널(없으면 DEOD_NO_PAIR) */
+  DEOD_t   * sensor[kNbrOfSIs];
+  Led_t    * led[kNbrOfSIs];                        /* 센서 이상 LED */
+  Led_t    * e_led[kNbrOfSIs];                      /* 감지 LED */
+  Relay_t  * relay[kNbrOfSIs];                      /* 감지 릴레이 */
+}DeodCh_t;
+
+/** \brief OSSD 확정 투표 설정 */
+typedef struct
+{
+  u08_t      window;                                /* N */
+  u08_t      assert_m;                              /* 확정 : votes >= assert_m */
+  u08_t      deassert_m;                            /* 해제 : votes <= deassert_m */
+  u32_t      mask;                                  /* 하위 N bit */
+}OssdVote_t;
+
 /* Private define ------------------------------------------------------------*/
+#define DEOD_NO_PAIR            0xFFU
+
 /* Private constants ---------------------------------------------------------*/
 /* Private variables ---------------------------------------------------------*/
 /** \defgroup Deod_Thread_Private_Variables 시스템 모니터링 쓰레드 비공개 변수
   * \{ */
+static DeodCh_t  deod_ch;                           /* 센서 채널 테이블 */
+static u32_t     deod_start_tick;                   /* Deod_Init() 시각, 첫 ADC 프레임 대기 기준 */
+static OssdVote_t ossd_vote =                       /* OSSD 확정 투표 설정 */
+{
+  OSSD_VOTE_WINDOW, OSSD_VOTE_ASSERT, OSSD_VOTE_DEASSERT, (1UL << OSSD_VOTE_WINDOW) - 1UL
+};
+
 static void Decide_DEOD_State(void);
 void Read_Safety_Sensor_OSSD(void);
 static void Read_Safety_Sensor_Voltage(void);
+static void Sensor_Voltage_State(u08_t ch, u16_t code);
+static void Deod_Awd_Arm(void);
+static void Deod_Adc_Stall(u32_t seq);
+static void Ossd_Vote_Update(DEOD_t * sen, Bool_t both_high);
+static u08_t Deod_Popcount32(u32_t v);
 void Low_Voltage_Check(void);
 /** \} Deod_Thread_Exported_Variables */
 
@@ -49,6 +90,43 @@ void Low_Voltage_Check(void);
 /** \addtogroup Deod_Thread_Private_Functions
   * \{ */
 
+/** \brief  DEOD 쓰레드에서 사용할 센서 채널 테이블을 구성한다.
+  * \note   sensor_ch_num(PB15 2CH/4CH 선택) 만큼의 채널을 사용하며, 4CH 이상이면
+  *         앞쪽 절반(OBR,DER)과 뒤쪽 절반(OBL,DEL)을 좌/우 한쌍으로 묶는다.
+  * \retval 없음
+  */
+void Deod_Init(void)
+{
+  u08_t ch;
+  Led_t   * const led_tbl[kNbrOfSIs]   = { obr_led,   der_led,   obl_led,   del_led   };
+  Led_t   * const e_led_tbl[kNbrOfSIs] = { e_obr_led, e_der_led, e_obl_led, e_del_led };
+  Relay_t * const relay_tbl[kNbrOfSIs] = { obr_out,   der_out,   obl_out,   del_out   };
+
+  deod_ch.num = sensor_ch_num;
+  for(ch = 0; ch < kNbrOfSIs; ch++)
+  {
+    deod_ch.act_min[ch]   = sensor_thr[ch].act_min;
+    deod_ch.act_max[ch]   = sensor_thr[ch].act_max;
+    deod_ch.high[ch]      = sensor_thr[ch].high;
+    deod_ch.low[ch]       = sensor_thr[ch].low;
+    deod_ch.low_clear[ch] = sensor_thr[ch].low_clear;
+    deod_ch.sensor[ch]    = sdin[ch];
+    deod_ch.led[ch]       = led_tbl[ch];
+    deod_ch.e_led[ch]     = e_led_tbl[ch];
+    deod_ch.relay[ch]     = relay_tbl[ch];
+    deod_ch.pair[ch]      = DEOD_NO_PAIR;
+  }
+  if(deod_ch.num >= 4U)
+  {
+    for(ch = 0; ch < (deod_ch.num / 2U); ch++)
+    {
+      deod_ch.pair[ch] = ch + (deod_ch.num / 2U);
+    }
+  }
+  Ossd_Edge_Init();
+  deod_start_tick = HAL_GetTick();
+}
+
 /** \brief  DEOD 쓰레드 본체
   * \param  argument - 쓰레드로 전달된 인자
   * \note
@@ -56,19 +134,70 @@ void Low_Voltage_Check(void);
   */
 void   Deod_Thread(void)
 {
+   AdcAwdEvent_t  awd;
+   Bool_t         awd_wake;
 
 	 /** 열차가 100Km/h로 달릴경우 1 Sec당 27.7M 전진. */
 	 /** 100msec일 경우 이동 거리는 약 2.7M 이동함.  10mse 27cm 이동함. */
-   if(g_DEOD_Check_timer  >= DEOD_SYS_CHECK_TIME)
+   /** Analog Watchdog이 동작 전류 초과를 감지하면 주기를 기다리지 않고 바로 판정한다. */
+   /** OSSD edge는 판정 주기와 관계없이 매 loop 처리해서 ring이 넘치지 않게 한다. */
+   Ossd_Edge_Process();
+   Eb_Act_Process();                                                   /** EB 릴레이 Feedback 확인/유지 */
+   awd_wake = Device_ADC_Awd_Get_Event(&awd);
+   if((g_DEOD_Check_timer  >= DEOD_SYS_CHECK_TIME) || (awd_wake == True))
    {  
 	    g_DEOD_Check_timer = 0;
 //    g_monitor_flag = True;
+      if(awd_wake == True)
+      {
+        LOG2(TRACE, DEOD, "AWD Wakeup (frame %d, %d msec late)\n", awd.seq, (HAL_GetTick() - awd.tick));
+      }
       Read_Safety_Sensor_Voltage();                                    /** 전류체크 */
       Read_Safety_Sensor_OSSD();
 //		  Low_Voltage_Check();
-		  Decide_DEOD_State();                                             /** 센서 동작 여부 최종 판단 */
+      /** EB 동작 후에는 안전 상태를 유지하고 센서 값만 계속 갱신한다(사후 진단용). */
+      if(Eb_Act_Is_Tripped() == False)
+      {
+		    Decide_DEOD_State();                                           /** 센서 동작 여부 최종 판단 */
+        Deod_Awd_Arm();                                                /** 다음 감지를 위해 Analog Watchdog 재설정 */
+      }
 	 }
 }  
+
+/** \brief  ADC 프레임이 오지 않거나 갱신이 멈춘 것을 고장으로 올린다.
+  * \param  seq - 마지막 프레임 순번, 시작 후 프레임이 없으면 0
+  * \note   ADC/DMA/TIM2가 멈추면 센서를 판정할 수 없으므로 HLT를 끈다(fail-safe).
+  *         10msec마다 반복되므로 출력은 Fault_Report()로 묶는다.
+  * \retval 없음
+  */
+static void Deod_Adc_Stall(u32_t seq)
+{
+  if (Fault_Report("F_010", "ADC") == True)
+  {
+    DLOG1("\n\n\nF_010.(ADC Scan Stall, frame %d)\n", seq);          /** Fault Code 출력 */
+  }
+  Fault_Raise(kFLT_ADC_STALL, seq);                                    /** HLT Signal OFF */
+}
+
+/** \brief  모든 채널이 동작 전류 아래이면 Analog Watchdog 인터럽트를 다시 허용한다.
+  * \note   동작 전류 이상인 채널이 남아 있는 동안은 주기 scan으로만 판정한다.
+  *         감지 지연시간 측정 이벤트도 이때 닫아 다음 감지를 측정할 수 있게 한다.
+  * \retval 없음
+  */
+static void Deod_Awd_Arm(void)
+{
+  u08_t ch;
+
+  for(ch = 0; ch < deod_ch.num; ch++)
+  {
+    if(deod_ch.sensor[ch]->Sensor_Adc >= deod_ch.act_min[ch])
+    {
+      return;
+    }
+  }
+  Latency_Cancel();
+  Device_ADC_Awd_Arm();
+}
 /*
 void Low_Voltage_Check(void)
 {
@@ -94,316 +223,272 @@ void Low_Voltage_Check(void)
 /** \brief  센서의 전류값을 읽어서 장애물 및 탈선이 되었는지를 주기적으로 감시한다.
   * \note   센서의 전류값이 160mV  ~ 190mV 이면 정상 범위
   *         센서의 전류값이 2100mV ~ 2950mV 이면 장애물 및 탈선이 감지됨    
+  *         기준값은 Device_Init()에서 ADC code로 변환해 둔 sensor_thr[]와 비교한다.
   * \retval 없음
   */
 
 static void Read_Safety_Sensor_Voltage(void)
 {
-static u16_t adc1_value=0, adc2_value=0, adc3_value=0,adc4_value=0;
- 
-/*****************************************************************************
-  **************************** OBR Sensor  ***********************************
-******************************************************************************/
-//    cprintf("\nSensor Voltage Check Interval Time\n");			       /** 모니터링 주기 테스트 코드 */
-	  HAL_ADC_Start(&hadc1);
- 		while(HAL_ADC_PollForConversion(&hadc1, 5) == HAL_OK)
- 		{
-			adc1_value = (u16_t)HAL_ADC_GetValue(&hadc1);
-			adc1_value = ((3300U * adc1_value) / 4095U);	                 /** 검지시 200~ 499mV   평상시  51 ~ 199mV */
-			sdin[kSI_1]->Sensor_Voltage = adc1_value;
-	 
-      if(adc1_value > cMIN_ACT_CUR) 
-      { 
-        sdin[kSI_1]->Sensor_flag = True;                                      /** 센서 이상 체크 */
-      }
-			else if(adc1_value < cLOW_CUR && sdin[kSI_1]->low_counter_start == 0)    /** Low Voltage */
-			{
-				sdin[kSI_1]->Sensor_Low_Counter++;
-				sdin[kSI_1]->low_counter_start = 1;
-				sdin[kSI_1]->Sensor_flag = True;                                       /** 센서 이상 체크 */
-//				sdin[kSI_1]->Sensor_fail_flag = False;				
-			}
-			else if(adc1_value < cLOW_CUR && sdin[kSI_1]->low_counter_start == 1)
-			{
-					sdin[kSI_1]->Sensor_Low_Counter++;
-			}
-			else if(adc1_value > cLOW_CUR && sdin[kSI_1]->low_counter_start == 1)
-			{
-				   sdin[kSI_1]->Sensor_Low_Counter=0;
-				   sdin[kSI_1]->low_counter_start = 0;
-					 sdin[kSI_1]->Sensor_flag = False;
-			}
-	 	}
-       
-
-/*****************************************************************************
-  **************************** DER Sensor  ***********************************
-******************************************************************************/		
-	  HAL_ADC_Start(&hadc1);
- 		while(HAL_ADC_PollForConversion(&hadc1, 5) ==HAL_OK)
-		{
-			adc2_value = (u16_t)HAL_ADC_GetValue(&hadc1);
-			adc2_value = ((3300U * adc2_value) / 4095U);
-      sdin[kSI_2] ->Sensor_Voltage = adc2_value;
-      if(adc2_value > cMIN_ACT_CUR) 
-      { 
-        sdin[kSI_2]->Sensor_flag = True;
-      }
-			else if(adc2_value < cLOW_CUR && sdin[kSI_2]->low_counter_start == 0)
-			{
-				sdin[kSI_2]->Sensor_Low_Counter++;
-				sdin[kSI_2]->low_counter_start = 1;
-				sdin[kSI_2]->Sensor_flag = True;
-//				sdin[kSI_2]->Sensor_fail_flag = False;
-			}
-			else if(adc2_value < cLOW_CUR && sdin[kSI_2]->low_counter_start == 1)
-			{
-							sdin[kSI_2]->Sensor_Low_Counter++;
-			}
-			else if(adc2_value > cLOW_CUR && sdin[kSI_2]->low_counter_start == 1)
-			{
-				   sdin[kSI_2]->Sensor_Low_Counter=0;
-				   sdin[kSI_2]->low_counter_start = 0;
-					 sdin[kSI_2]->Sensor_flag = False;
-			}
-	  }
-
-/*****************************************************************************
-  **************************** OBL Sensor  ***********************************
-******************************************************************************/		
-	  HAL_ADC_Start(&hadc1);
- 		while(HAL_ADC_PollForConversion(&hadc1, 5) ==HAL_OK)
-		{
-			adc3_value = (u16_t)HAL_ADC_GetValue(&hadc1);
-			adc3_value = ((3300U * adc3_value) / 4095U);
-      sdin[kSI_3] ->Sensor_Voltage = adc3_value;
-      if(adc3_value > cMIN_ACT_CUR) 
-      { 
-        sdin[kSI_3]->Sensor_flag = True;
+static u32_t last_seq = 0;
+AdcFrame_t   frame;
+u08_t        ch;
+
+    /** ADC1은 TIM2 trigger + DMA로 계속 scan 되므로 최근 완료된 프레임만 가져온다. */
+    if(Device_ADC_Get_Frame(&frame) != True)
+    {
+      if((HAL_GetTick() - deod_start_tick) > DEOD_ADC_START_GRACE)
+      {
+        Deod_Adc_Stall(0U);                                            /** 시작 후 프레임이 한번도 없음 */
       }
-			else if(adc3_value < cLOW_CUR && sdin[kSI_3]->low_counter_start == 0)
-			{
-				sdin[kSI_3]->Sensor_Low_Counter++;
-				sdin[kSI_3]->low_counter_start = 1;
-				sdin[kSI_3]->Sensor_flag = True;
-//				sdin[kSI_3]->Sensor_fail_flag = False;				
-				
-			}
-			else if(adc3_value < cLOW_CUR && sdin[kSI_3]->low_counter_start == 1)
-			{
-							sdin[kSI_3]->Sensor_Low_Counter++;
-			}
-			else if(adc3_value > cLOW_CUR && sdin[kSI_3]->low_counter_start == 1)
-			{
-				   sdin[kSI_3]->Sensor_Low_Counter=0;
-				sdin[kSI_3]->low_counter_start = 0;
-								sdin[kSI_3]->Sensor_flag = False;
-			}	
-	  }		
-
-/*****************************************************************************
-  **************************** DEL Sensor  ***********************************
-******************************************************************************/
-	  HAL_ADC_Start(&hadc1);
- 		while(HAL_ADC_PollForConversion(&hadc1, 5) ==HAL_OK)
-		{
-			adc4_value = (u16_t)HAL_ADC_GetValue(&hadc1);
-			adc4_value = ((3300U * adc4_value) / 4095U);
-      sdin[kSI_4]->Sensor_Voltage = adc4_value;
-      if(adc4_value > cMIN_ACT_CUR) 
-      { 
-        sdin[kSI_4]->Sensor_flag = True;
+      return;
+    }
+    if((HAL_GetTick() - frame.tick) > (DEOD_SYS_CHECK_TIME * 3U))
+    {
+      Deod_Adc_Stall(frame.seq);                                       /** 프레임 갱신이 멈춤 */
+      return;
+    }
+    if(frame.seq == last_seq)
+    {
+      return;                                                          /** AWD 판정 직후라 아직 새 프레임 없음 */
+    }
+    last_seq = frame.seq;
+
+    /** 사용 채널(2CH/4CH) 모두 같은 상태머신으로 처리한다. */
+    for(ch = 0; ch < deod_ch.num; ch++)
+    {
+      Sensor_Voltage_State(ch, frame.raw[ch]);
+    }
+
+    /** 동작 전류 채널이 처음 나타난 프레임의 변환 완료 시점을 감지 지연시간 기준(t0)으로 한다. */
+    for(ch = 0; ch < deod_ch.num; ch++)
+    {
+      if((frame.raw[ch] >= deod_ch.act_min[ch]) && (frame.raw[ch] < deod_ch.act_max[ch]))
+      {
+        Latency_Start(frame.cyc);
+        Latency_Mark(kLAT_SAMPLE);
+        break;
       }
-			else if(adc4_value < cLOW_CUR && sdin[kSI_4]->low_counter_start == 0)
-			{
-				sdin[kSI_4]->Sensor_Low_Counter++;
-				sdin[kSI_4]->low_counter_start = 1;
-				sdin[kSI_4]->Sensor_flag = True;
-//				sdin[kSI_4]->Sensor_fail_flag = False;				
-			}
-			else if(adc4_value < cLOW_CUR && sdin[kSI_4]->low_counter_start == 1)
-			{
-							sdin[kSI_4]->Sensor_Low_Counter++;
-			}
-			else if(adc1_value > cLOW_CUR && sdin[kSI_4]->low_counter_start == 1)
-			{
-				sdin[kSI_4]->Sensor_Low_Counter=0;
-				sdin[kSI_4]->low_counter_start = 0;
-				sdin[kSI_4]->Sensor_flag = False;
-			}
-	  }	
-    if(g_monitor_flag == True)
-    {			
-		  cprintf("OBR  = %d\r\n", sdin[kSI_1]->Sensor_Voltage);
-		  cprintf("DER  = %d\r\n", sdin[kSI_2]->Sensor_Voltage);
-		  cprintf("OBL  = %d\r\n", sdin[kSI_3]->Sensor_Voltage);
-		  cprintf("DEL  = %d\r\n", sdin[kSI_4]->Sensor_Voltage);
-		}
+    }
+
+    for(ch = 0; ch < deod_ch.num; ch++)
+    {
+      LOG2(DEBUG, DEOD, "%s  = %d\n", deod_ch.led[ch]->name, Device_ADC_To_mV(ch, deod_ch.sensor[ch]->Sensor_Adc));  /** 10msec마다 반복 : DEBUG */
+    }
+}
+
+/** \brief  센서 1채널의 전류(ADC code) 상태를 갱신한다.
+  * \param  ch   - 센서 채널
+  * \param  code - 이번 프레임의 ADC code
+  * \note   전압 > cMIN_ACT_CUR : 센서 동작(Sensor_flag)
+  *         전압 < cLOW_CUR     : Low Voltage 카운트 시작/증가
+  *         전압 > cLOW_CUR     : Low Voltage 카운트 중이었으면 해제
+  * \retval 없음
+  */
+static void Sensor_Voltage_State(u08_t ch, u16_t code)
+{
+  DEOD_t * sen = deod_ch.sensor[ch];
+
+  sen->Sensor_Adc = code;                                              /** 판정은 ADC code로, mV 변환은 표시할 때만 */
+
+  if(code >= deod_ch.act_min[ch])
+  {
+    sen->Sensor_flag = True;                                           /** 센서 이상 체크 */
+  }
+  else if(code < deod_ch.low[ch])                                      /** Low Voltage */
+  {
+    sen->Sensor_Low_Counter++;
+    if(sen->low_counter_start == 0U)
+    {
+      sen->low_counter_start = 1U;
+      sen->Sensor_flag = True;                                         /** 센서 이상 체크 */
+    }
+  }
+  else if((code >= deod_ch.low_clear[ch]) && (sen->low_counter_start == 1U))
+  {
+    sen->Sensor_Low_Counter = 0U;
+    sen->low_counter_start = 0U;
+    sen->Sensor_flag = False;
+  }
 }
 
 void Read_Safety_Sensor_OSSD(void)
 {
-	u08_t sensor_num=0;
+	u08_t   ch;
+	DEOD_t * sen;
+	InSnap_t snap;
+	u08_t   edge1, edge2;
 /*------------------------------------------------------------*/
 // 센서 OSSD1(탈선) 설정값 일기 
+// OSSD Port를 한번만 읽어 모든 채널의 OSSD1/OSSD2를 같은 시점 값으로 판정한다.
+// 판정 주기 사이에 EXTI로 확정된 High pulse도 함께 반영한다.
 /*------------------------------------------------------------*/	
-//bool_t final_state = False;
-//uint32_t tick_start = HAL_GetTick();
-  
-	for(sensor_num = 0; sensor_num < kNbrOfSIs; sensor_num++)
+	Device_Input_Snapshot(&snap);
+	Ossd_Edge_Take(&edge1, &edge2);
+	for(ch = 0; ch < deod_ch.num; ch++)
 	{
-		if(sdin[sensor_num]->Sensor_flag == True) 
+		sen = deod_ch.sensor[ch];
+		if(sen->Sensor_flag == True) 
 		{	
-      if(sensor_num == 0U)
-			{
-//        while((HAL_GetTick() - tick_start) < 3)
-//        {
-				  sdin[sensor_num]->Sensor_OSSD1 = (Bool_t)(HAL_GPIO_ReadPin(GPIOC, GPIO_PIN_0));
-				  sdin[sensor_num]->Sensor_OSSD2 = (Bool_t)(HAL_GPIO_ReadPin(GPIOC, GPIO_PIN_1));
-//        }
-			}
-			else if(sensor_num == 1U)
-			{
-				sdin[sensor_num]->Sensor_OSSD1 = (Bool_t)(HAL_GPIO_ReadPin(GPIOC, GPIO_PIN_2));
-				sdin[sensor_num]->Sensor_OSSD2 = (Bool_t)(HAL_GPIO_ReadPin(GPIOC, GPIO_PIN_3));
-			}
-			else if(sensor_num == 2U)
-			{
-				sdin[sensor_num]->Sensor_OSSD1 = (Bool_t)(HAL_GPIO_ReadPin(GPIOC, GPIO_PIN_4));
-				sdin[sensor_num]->Sensor_OSSD2 = (Bool_t)(HAL_GPIO_ReadPin(GPIOC, GPIO_PIN_5));
-			}
-			else if(sensor_num == 3U)
-			{
-    		sdin[sensor_num]->Sensor_OSSD1 = (Bool_t)(HAL_GPIO_ReadPin(GPIOC, GPIO_PIN_6));
-				sdin[sensor_num]->Sensor_OSSD2 = (Bool_t)(HAL_GPIO_ReadPin(GPIOC, GPIO_PIN_7));
-			}
-      
-			if((sdin[sensor_num]->Sensor_OSSD1 == True) && (sdin[sensor_num]->Sensor_OSSD2 == True	)) 
-			{ 
-				sdin[sensor_num]->Sensor_Counter++; 
-			}
-			else 
-			{ 
-				sdin[sensor_num]->Sensor_Counter = False; 
-			}
+			sen->Sensor_OSSD1 = IN_SNAP_BIT(snap.ossd1 | edge1, ch);
+			sen->Sensor_OSSD2 = IN_SNAP_BIT(snap.ossd2 | edge2, ch);
+			Ossd_Vote_Update(sen, ((sen->Sensor_OSSD1 == True) && (sen->Sensor_OSSD2 == True)) ? True : False);
 		}
-
-	  if(g_monitor_flag == True)
-		{	
-			cprintf("SENSOR%d state = %s\n",(sensor_num+1),(sdin[sensor_num] ->Sensor_OSSD1  == True) ? "ON" : "OFF" );
-			cprintf("SENSOR%d state = %s\n",(sensor_num+1),(sdin[sensor_num] ->Sensor_OSSD2== True) ? "ON" : "OFF" );
-			cprintf("SENSOR%d Counter = %d\n",(sensor_num+1),sdin[sensor_num] ->Sensor_Counter);
+		else
+		{
+			Ossd_Vote_Update(sen, False);                                   /** 동작 전류가 없으면 이력을 비워감 */
 		}
+
+		LOG2(TRACE, DEOD, "SENSOR%d state = %s\n",(ch+1),(sen->Sensor_OSSD1 == True) ? "ON" : "OFF" );   /** 채널마다 10msec 반복 : TRACE */
+		LOG2(TRACE, DEOD, "SENSOR%d state = %s\n",(ch+1),(sen->Sensor_OSSD2 == True) ? "ON" : "OFF" );
+		LOG4(TRACE, DEOD, "SENSOR%d Votes = %d/%d %s\n",(ch+1),sen->Ossd_Votes,ossd_vote.window,(sen->Ossd_Confirmed == True) ? "CONFIRM" : "");
 	}
 }
 
+/** \brief  센서 1채널의 OSSD 이력에 이번 sample을 넣고 M-of-N 투표로 확정 상태를 갱신한다.
+  * \param  sen       - 센서 구조체 포인터
+  * \param  both_high - 이번 판정 주기의 OSSD1 & OSSD2
+  * \note   최근 window개 sample 중 High 수가 assert_m 이상이면 확정, 확정 후에는
+  *         deassert_m 이하로 떨어져야 해제한다. 잡음으로 한두 sample이 빠져도 처음부터 다시 세지 않는다.
+  * \retval 없음
+  */
+static void Ossd_Vote_Update(DEOD_t * sen, Bool_t both_high)
+{
+  sen->Ossd_History = (sen->Ossd_History << 1) | ((both_high == True) ? 1UL : 0UL);
+  sen->Ossd_Votes   = Deod_Popcount32(sen->Ossd_History & ossd_vote.mask);
+
+  if(sen->Ossd_Confirmed == False)
+  {
+    if(sen->Ossd_Votes >= ossd_vote.assert_m)
+    {
+      sen->Ossd_Confirmed = True;
+      Latency_Mark(kLAT_OSSD);                                         /** OSSD 확정 시점 */
+    }
+  }
+  else if(sen->Ossd_Votes <= ossd_vote.deassert_m)
+  {
+    sen->Ossd_Confirmed = False;
+  }
+}
+
+/** \brief  32bit 값에서 1인 bit 수를 센다.
+  * \note   Cortex-M4에는 popcount 명령이 없으므로 분기 없는 bit 연산으로 처리한다.
+  * \retval 1인 bit 수(0 ~ 32)
+  */
+static u08_t Deod_Popcount32(u32_t v)
+{
+  v = v - ((v >> 1) & 0x55555555UL);
+  v = (v & 0x33333333UL) + ((v >> 2) & 0x33333333UL);
+  v = (v + (v >> 4)) & 0x0F0F0F0FUL;
+  return (u08_t)((v * 0x01010101UL) >> 24);
+}
+
+/** \brief  OSSD 확정 투표 설정을 변경한다.
+  * \param  window     - N(1 ~ OSSD_VOTE_WINDOW_MAX)
+  * \param  assert_m   - N개 중 확정에 필요한 High 수(1 ~ N)
+  * \param  deassert_m - 확정 해제 기준 High 수(assert_m 미만)
+  * \note   이미 쌓인 이력은 유지하며 다음 sample부터 새 설정으로 판정한다.
+  * \retval 설정 범위가 맞으면 True
+  */
+Bool_t Deod_Set_Ossd_Vote(u08_t window, u08_t assert_m, u08_t deassert_m)
+{
+  if((window == 0U) || (window > OSSD_VOTE_WINDOW_MAX) || (assert_m == 0U)
+     || (assert_m > window) || (deassert_m >= assert_m))
+  {
+    return False;
+  }
+  ossd_vote.window     = window;
+  ossd_vote.assert_m   = assert_m;
+  ossd_vote.deassert_m = deassert_m;
+  ossd_vote.mask       = (window >= 32U) ? 0xFFFFFFFFUL : ((1UL << window) - 1UL);
+  return True;
+}
+
+/** \brief  현재 OSSD 확정 투표 설정을 읽는다.
+  * \retval 없음
+  */
+void Deod_Get_Ossd_Vote(u08_t * window, u08_t * assert_m, u08_t * deassert_m)
+{
+  *window     = ossd_vote.window;
+  *assert_m   = ossd_vote.assert_m;
+  *deassert_m = ossd_vote.deassert_m;
+}
 
 static void Decide_DEOD_State(void)
 {
 	u08_t i;
-	Bool_t eb1_state;
-	Bool_t eb2_state;	
-	
-  Led_t     * led[kNbrOfSIs];                                        // 센서의 수량 만큼 배열 확보
-  Led_t     * e_led[kNbrOfSIs];                                        // 센서의 수량 만큼 배열 확보
-  Relay_t   * relay[kNbrOfSIs];                                      // 센서의 수량 만큼 배열 확보
-
-  led[kSI_1] = obr_led;
-  led[kSI_2] = der_led;
-  led[kSI_3] = obl_led;
-  led[kSI_4] = del_led;
+	DEOD_t    * const * sen    = deod_ch.sensor;                        // 채널 테이블 사용
+	Led_t     * const * led    = deod_ch.led;
+	Led_t     * const * e_led  = deod_ch.e_led;
+	Relay_t   * const * relay  = deod_ch.relay;
   
-  e_led[kSI_1] = e_obr_led;
-  e_led[kSI_2] = e_der_led;
-  e_led[kSI_3] = e_obl_led;
-  e_led[kSI_4] = e_del_led;
-  
-  relay[kSI_1] = obr_out ;
-  relay[kSI_2] = der_out ;
-  relay[kSI_3] = obl_out ;
-  relay[kSI_4] = del_out ;
-  
-  for(i = 0; i < kNbrOfSIs ; i ++)
+  for(i = 0; i < deod_ch.num ; i ++)
 	{
-	  if((sdin[i]->Sensor_Voltage < cMAX_ACT_CUR)  && (sdin[i]->Sensor_Voltage > cMIN_ACT_CUR ))  //장애물 감지 상태(2950 ~ 2100)
+	  if((sen[i]->Sensor_Adc < deod_ch.act_max[i])  && (sen[i]->Sensor_Adc >= deod_ch.act_min[i] ))  //장애물 감지 상태(2950 ~ 2100)
 		{
-		  if(((sdin[i]->Sensor_OSSD1== True) && (sdin[i]->Sensor_OSSD2== True) && (sdin[i]->Sensor_Counter > cMAX_COUNT)
-				&& (sdin[i]->Sensor_fail_flag == False)))
+		  if((sen[i]->Ossd_Confirmed == True) && (sen[i]->Sensor_fail_flag == False))    /** OSSD M-of-N 확정 */
 			{
-				cprintf("\n\n\nF_003.(Obstacle/Derailment Activ = %s)\n",led[i]->name);        /** Fault Code 출력	*/
+				Latency_Mark(kLAT_DECISION);
+				if (Fault_Report("F_003 ACT", led[i]->name) == True)                           /** 반복은 묶어서 보고 */
+				{
+					DLOG1("\n\n\nF_003.(Obstacle/Derailment Activ = %s)\n", led[i]->name);      /** Fault Code 출력	*/
+				}
 			  Led_On(e_led[i]);	                                                               /** 감지된 해당 LED ON */						
-        Led_On(e_eb_led);
-				Relay_On(eb1_out);
-				Relay_On(eb2_out);
         Relay_On(relay[i]);
 //        Relay_Off(hlt_out);
 //        Led_Off(hlt_led);        
-//    		cprintf("\nEB1/EB2 Signal Output Command\n");			                            /** 퍼포먼스 테스트 코드 */	
-				HAL_Delay(10);
-//			  eb1_state = (u08_t)(HAL_GPIO_ReadPin(GPIOD, GPIO_PIN_8));
-			  eb1_state = DI_Get_State(din[kRYFBI_EB1]);        
-//			  eb2_state = (u08_t)(HAL_GPIO_ReadPin(GPIOD, GPIO_PIN_9));	
-			  eb2_state = DI_Get_State(din[kRYFBI_EB2]); 				
-//				cprintf("\n\eb1_state = %d\n",eb1_state);       	
-//				Relay_On(eb2_out);
-//				HAL_Delay(10);				
-//			  eb2_state = (u08_t)(HAL_GPIO_ReadPin(GPIOD, GPIO_PIN_9));	
-//				cprintf("\n\eb2_state = %d\n",eb2_state); 				
-//				Relay_On(relay[i+5U]);                                       /** 감지된 해당 릴레이 Signal ON */
-				if((eb1_state != True) || (eb2_state != True))
-				{
-					 Relay_Off(hlt_out);                                        /** HLT Signal OFF */
-           Led_Off(hlt_led);					
-					 Watchdog_Lock(wdog);
-					 cprintf("Relay abnormal action then Health Relay On\n\n");
-				}
-				Led_On(run_led);	
-    	  while(1)
-        {}; 
+				(void)Eb_Act_Trip(kEB_CAUSE_DETECT, led[i]->name);                               /** EB1/EB2 ON, Feedback 확인은 Eb_Act_Process() */
+				g_State_Code  = DERAILMENT_FAIL;                                                 /** 슬레이브 응답 : 탈선 센서 번호(1 ~ 4) */
+				g_Detail_Code = (u08_t)(i + 1U);
+				return;
 		   }
     }	
-    else if(sdin[i]->Sensor_Voltage < cLOW_CUR && sdin[i]->Sensor_flag == True && sdin[i]->Sensor_Low_Counter > 1000U )      /** 500mvolt 이하 전압 감지 */
+    else if(sen[i]->Sensor_Adc < deod_ch.low[i] && sen[i]->Sensor_flag == True && sen[i]->Sensor_Low_Counter > 1000U )      /** 500mvolt 이하 전압 감지 */
     { 		 
-			   cprintf("\n\n\nF_002.(Low Voltage or Disconnect Sernsor = %s)\n",led[i]->name);   /** Fault Code 출력	*/
-//			   cprintf("\n\nLow Voltage  = %d\n",sdin[i]->Sensor_Voltage);                     /** Fault Code 출력	*/
-//         if(sdin[i]->Sensor_Low_Counter  % 200 == 0)
+			   if (Fault_Report("F_002 LOW", led[i]->name) == True)                             /** 10msec마다 반복 : 묶어서 보고 */
+			   {
+			     DLOG1("\n\n\nF_002.(Low Voltage or Disconnect Sernsor = %s)\n", led[i]->name); /** Fault Code 출력	*/
+			   }
+			   LOG2(DEBUG, DEOD, "Low Voltage %s = %d mV\n", led[i]->name, Device_ADC_To_mV(i, sen[i]->Sensor_Adc)); /** 10msec마다 반복 : DEBUG */
+//         if(sen[i]->Sensor_Low_Counter  % 200 == 0)
  //        {g
              Led_On(led[i]);			
 //             Led_Toggle(led[i]);
-			       Relay_Off(hlt_out);	                                           /** HLT Signal OFF */
-			       Led_Off(hlt_led);	                                             /** HLT Signal OFF */
-             sdin[i]->Sensor_fail_flag = True;  
+			       Fault_Raise(kFLT_SENSOR_VOLT, i);                                /** HLT Signal OFF */
+             sen[i]->Sensor_fail_flag = True;  
 //         }           
      				 
     }
-		else if(sdin[i]->Sensor_Voltage > (cMAX_ACT_CUR+1) && sdin[i]->Sensor_flag == True)     /** 2023년 12월 12일 추가   (2700mvolt 이상 검출시) */
+		else if(sen[i]->Sensor_Adc >= deod_ch.high[i] && sen[i]->Sensor_flag == True)     /** 2023년 12월 12일 추가   (2700mvolt 이상 검출시) */
     {    
-			 cprintf("\n\n\nF_002.(Obstacle/Derailment Sensor High voltage = %s)\n",led[i]->name);      /** Fault Code 출력	*/	
+			 if (Fault_Report("F_002 HIGH", led[i]->name) == True)                                     /** 반복은 묶어서 보고 */
+			 {
+			   DLOG1("\n\n\nF_002.(Obstacle/Derailment Sensor High voltage = %s)\n", led[i]->name);  /** Fault Code 출력	*/
+			 }
        Led_On(led[i]);      
-		   Relay_Off(hlt_out);	                                                                      /** HLT Signal OFF */
-			 Led_Off(hlt_led);
-       sdin[i]->Sensor_fail_flag = True;                                                          /** Fault 상황발생	*/	
+		   Fault_Raise(kFLT_SENSOR_VOLT, i);                                                         /** HLT Signal OFF */
+       sen[i]->Sensor_fail_flag = True;                                                          /** Fault 상황발생	*/	
     }
   }
  
 
 	
 	
-  for(i = 0; i < 3 ; i += 2)                                              // OBR,DER,OBL,DEL   
+  for(i = 0; i < deod_ch.num ; i ++)                                      // OBR,DER,OBL,DEL   
   {
-     if((sdin[i]->Sensor_fail_flag == True)  && (sdin[i+2]->Sensor_fail_flag == True)) // Left,Right 동시에 불량발생
+     if(deod_ch.pair[i] == DEOD_NO_PAIR)
+     {
+        continue;
+     }
+     if((sen[i]->Sensor_fail_flag == True)  && (sen[deod_ch.pair[i]]->Sensor_fail_flag == True)) // Left,Right 동시에 불량발생
      {  
-        cprintf("\n\n\nF_003 Sensor Abnormality Both= %s,%s\r\n",led[i]->name,led[i+2]->name);
+        if (Fault_Report("F_003 BOTH", led[i]->name) == True)
+        {
+          DLOG2("\n\n\nF_003 Sensor Abnormality Both= %s,%s\r\n", led[i]->name, led[deod_ch.pair[i]]->name);
+        }
         Led_On(led[i]);
-        Led_On(led[i+2]);        
-			  Relay_Off(hlt_out);	
-        Led_Off(hlt_led);
-        Led_On(run_led);
-			  Relay_On(eb1_out);
-			  Relay_On(eb2_out);			 
-//		    Watchdog_Lock(wdog);  	 
-			  while(1)
-        {};  
+        Led_On(led[deod_ch.pair[i]]);        
+			  Fault_Raise(kFLT_SENSOR_BOTH, i);                                   /** HLT OFF, EB1/EB2 ON 후 안전 상태 유지 */
+        return;
      }
    }  
 }
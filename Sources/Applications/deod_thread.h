@@ -45,8 +45,18 @@
 #define  Watchdog_Fail          0x08
 #define  Sensor_Fail            0x09
 #define DEOD_SYS_CHECK_TIME     10U                         
+#define DEOD_ADC_START_GRACE    100U                     /* Deod_Init() 후 첫 ADC 프레임을 기다리는 시간(msec) */
 
+/* OSSD 확정 투표(M-of-N) 기본값, 콘솔 "OSSDVOTE"로 변경 가능 */
+#define OSSD_VOTE_WINDOW        8U                       /* N : 최근 N개 판정 주기 sample */
+#define OSSD_VOTE_ASSERT        (cMAX_COUNT + 1U)        /* N개 중 이 값 이상 High면 확정 */
+#define OSSD_VOTE_DEASSERT      2U                       /* 확정 후 이 값 이하로 떨어지면 해제 */
+#define OSSD_VOTE_WINDOW_MAX    32U
+
+extern void Deod_Init(void);
 extern void Deod_Thread(void);
+extern Bool_t Deod_Set_Ossd_Vote(u08_t window, u08_t assert_m, u08_t deassert_m);
+extern void Deod_Get_Ossd_Vote(u08_t * window, u08_t * assert_m, u08_t * deassert_m);
 extern u32_t g_DEOD_Check_timer;
 extern u32_t g_Low_Voltage_Check_timer;
  
@@ -12,6 +12,7 @@
 /** \addtogroup Applications
   * \{ */
 ADC_HandleTypeDef    hadc1;
+DMA_HandleTypeDef    hdma_adc1;
 I2C_HandleTypeDef    hi2c1;
 /** \defgroup Device 하드웨어 장치
   * \brief 시스템의 하드웨어 장치를 구성하고 디바이스 객체를 제공합니다.
@@ -21,10 +22,39 @@ I2C_HandleTypeDef    hi2c1;
 /* Private define ------------------------------------------------------------*/
 /* Private macro -------------------------------------------------------------*/
 /* Private variables ---------------------------------------------------------*/
+static u16_t           adc_dma_buf[ADC_SCAN_FRAMES][kNbrOfSIs];  /* ADC1 DMA circular 버퍼(double buffer) */
+static volatile u32_t  adc_frame_seq  = 0;                       /* 완료된 프레임 순번 */
+static volatile u32_t  adc_frame_tick = 0;                       /* 최근 프레임 완료 시점(msec) */
+static volatile u08_t  adc_frame_idx  = 0;                       /* 최근 완료된 프레임 위치 */
+static volatile u32_t  adc_frame_cyc  = 0;                       /* 최근 프레임 완료 시점(Latency clock) */
+static volatile u32_t  adc_frame_usec = 0;                       /* 최근 프레임 완료 시점(USEC_TIM) */
+static volatile Bool_t adc_awd_pending = False;                  /* Analog Watchdog 감지 후 미처리 */
+static AdcAwdEvent_t   adc_awd_event;                            /* 최근 Analog Watchdog 감지 이벤트 */
+static u16_t           in_ossd1_mask[kNbrOfSIs];                 /* 센서별 OSSD1 Pin mask */
+static u16_t           in_ossd2_mask[kNbrOfSIs];                 /* 센서별 OSSD2 Pin mask */
+static u16_t           in_fb_mask[kNbrOfRYFBIs];                 /* Feedback별 Pin mask */
+static u16_t           in_fb_invert = 0;                         /* off가 Low인 Feedback Pin(반전해서 판정) */
+static OssdEdge_t      ossd_edge_ring[OSSD_EDGE_RING_SIZE];      /* OSSD edge ring(EXTI ISR -> Deod_Thread) */
+static volatile u32_t  ossd_edge_head = 0;                       /* ISR만 증가 */
+static volatile u32_t  ossd_edge_tail = 0;                       /* Deod_Thread만 증가 */
+static volatile u32_t  ossd_edge_cnt[kNbrOfSOs];                 /* Pin별 EXTI edge 수 */
+static volatile u32_t  ossd_edge_overflow = 0;                   /* ring이 가득 차서 버린 edge 수 */
+static volatile UsecAlarm_t usec_alarm_cb = NULL;                /* USEC_TIM 비교 시각에 부를 callback */
+
+/* 센서 채널별 ADC 보정값 */
+static const AdcCal_t  adc_cal[kNbrOfSIs] =
+{
+  { SI1_ADC_CAL_GAIN, SI1_ADC_CAL_OFFSET },
+  { SI2_ADC_CAL_GAIN, SI2_ADC_CAL_OFFSET },
+  { SI3_ADC_CAL_GAIN, SI3_ADC_CAL_OFFSET },
+  { SI4_ADC_CAL_GAIN, SI4_ADC_CAL_OFFSET },
+};
+
 /* Exported variables --------------------------------------------------------*/
 /** \addtogroup Device_Exported_Variables
   * \{ */  
 Rs232_t  * serial3;               /* RS-232 serial 디바이스 객체 */
+Rs485_t  * serial1;               /* RS-485 serial 디바이스 객체 */
 
 Led_t  * run_led;                 /* RUN LED 디바이스 객체 */
 Led_t  * der_led;                /* DMPC LED 디바이스 객체 */
@@ -37,8 +67,9 @@ Led_t  * hlt_led;                 /* HLT LED 디바이스 객체 */
 Led_t  * obr_led;                 /* HCR LED 디바이스 객체 */
 Led_t  * e_eb_led;             /* COM_ERR LED 디바이스 객체 */
 Led_t  * obl_led;                  /* EB LED 디바이스 객체 */
-Led_t  * comtx_led;               /* COMTX LED 디바이스 객체 */
-Led_t  * comrx_led;               /* COMRX LED 디바이스 객체 */
+Led_t  * comtx_led = NULL;        /* COMTX LED 디바이스 객체(kLED_COMTX 없음) */
+Led_t  * comrx_led = NULL;        /* COMRX LED 디바이스 객체(kLED_COMRX 없음) */
+Led_t  * com_err_led = NULL;      /* COM_ERR LED 디바이스 객체(통신 오류는 kFLT_COM_TIMEOUT로 표시) */
 
 Relay_t  * eb1_out;               /* EB1 Relay Output 디바이스 객체 */
 Relay_t  * eb2_out;               /* EB2 Relay Output 디바이스 객체 */
@@ -61,10 +92,12 @@ DI_t     * fpin_1;                /* Digital Output Isolator State Input 디바
 DI_t     * fpin_2;                /* Digital Output Isolator State Input 디바이스 객체 */
 DI_t     * pwrin;                 /* POWER INPUT State 디바이스 객체 */
 DI_t     * pc_ch_num;             /* PC Board Sensor 채널 수(2CH/4CH) 선택 스위치 입력 디바이스 객체 */
+u08_t      sensor_ch_num = kNbrOfSIs; /* 사용 센서 채널 수(2CH/4CH) */
 DI_t     * hcr_input;             /* HCR(선두부/후두부) 선택 스위치 입력 디바이스 객체 */
 DI_t     * wdt_ok;                /* CU or PC Board 선택 스위치 입력 디바이스 객체 */
 DipSW_t  * cfg;                   /* PC BOARD 연결 갯수 선택 스위치 입력 디바이스 객체 */
 Watchdog_t *wdog;                 /* WATCHDOG SIGNAL 입력 디바이스 객체 */
+SensorThr_t sensor_thr[kNbrOfSIs]; /* 센서 채널별 판정 기준값(ADC code) */
 
 /** \} Device_Exported_Variables */
 
@@ -74,15 +107,27 @@ Watchdog_t *wdog;                 /* WATCHDOG SIGNAL 입력 디바이스 객체
 
 static void Device_Init_LED(void);
 static void Device_Init_Console(void);
+static void Device_Init_Rs485(void);
+static void Device_Init_Board_Role(void);
 static void Device_Init_Watchdog(void);
 static void Device_Init_Relay_Output(void);
 static void Device_Init_Relay_Feed_Back_Input(void);
 static void Device_Init_Sensor_Input(void);
 static void Device_Init_Sensor_Test_Out(void);
 static void Device_Init_DOIS(void);
+static void Device_Init_Sensor_Channel(void);
 static void Device_Init_I2C(void);
 static void Pwr_OK_CPU_Init(void);	
 static void Device_Init_ADC(void);
+static void Device_Init_ADC_Trigger(void);
+static void Device_ADC_Frame_Complete(u08_t idx);
+static void Device_Init_Sensor_Threshold(void);
+static void Device_Init_ADC_Watchdog(void);
+static u16_t Device_ADC_Code_At_Least(u08_t ch, u16_t mv);
+static void Device_Init_Input_Snapshot(void);
+static void Device_Init_Usec_Timer(void);
+static void Device_Init_Ossd_Edge(void);
+static IRQn_Type Device_Exti_IRQn(u16_t pin);
 
 /** \} Device_Private_Functions */
 
@@ -101,6 +146,10 @@ void Device_Init(void)
   Device_Init_LED();
   /* RS232 디바이스 초기화 */
   Device_Init_Console();
+  /* RS485 디바이스 초기화 */
+  Device_Init_Rs485();
+  /* HCR 입력, PC BOARD 연결 갯수 Dip-Switch 초기화 */
+  Device_Init_Board_Role();
   
   /*Relay Output Port 디바이스 초기화 */
 	//Relay 제어 출력 Port에 대한 초기화
@@ -117,11 +166,21 @@ void Device_Init(void)
   /* Sensor INPUT 디바이스 초기화 */
 	// GG712 SIL2 센서에 대한 디바이스 초기화 
   Device_Init_Sensor_Input();
+
+  /* OSSD/Feedback 입력을 Port 단위로 읽기 위한 Pin mask 구성 */
+  Device_Init_Input_Snapshot();
+
+  /* OSSD edge 시각 측정용 usec timer 및 EXTI 허용 */
+  Device_Init_Usec_Timer();
+  Device_Init_Ossd_Edge();
   
   /* Digital Output Isolator State 디바이스 초기화 */
 	// Si83404AAA Device 초기화
   Device_Init_DOIS();
 
+  /* Sensor 채널 수(2CH/4CH) 선택 스위치 디바이스 초기화 */
+  Device_Init_Sensor_Channel();
+
   /* Watchdog 디바이스 초기화 */	
   Device_Init_Watchdog();
 	
@@ -131,10 +190,339 @@ void Device_Init(void)
 	//TMP117 CHIP에 대한 디바이스 초기화
 	//I2C통신방식 사용
   Device_Init_I2C();
+/* 감지 지연시간 측정용 DWT cycle counter 시작(ADC 프레임 완료 시점 기록에 사용) */
+  Latency_Init();
 /* ADC Chanel 디바이스 초기화 */
 //ADC Port에 대한 디바이스 초기화
 //GG712 센서의 전류를 감시하여 동작여부를 체크
   Device_Init_ADC();	
+/* 센서 판정 기준값을 채널별 보정값을 반영한 ADC code로 미리 계산 */
+  Device_Init_Sensor_Threshold();
+/* 장애물/탈선 동작 전류를 넘는 순간 바로 알 수 있도록 Analog Watchdog 설정 */
+  Device_Init_ADC_Watchdog();
+}
+
+/** \brief  가장 최근에 완료된 ADC scan 프레임을 복사한다.
+  * \param  frame - 복사할 AdcFrame_t 구조체 포인터
+  * \note   DMA가 다른 쪽 버퍼를 채우는 동안 완료된 쪽을 읽으므로 대기하지 않는다.
+  *         복사 도중 프레임이 갱신되면 다시 읽는다.
+  * \retval True  - 프레임 있음
+  * \retval False - 아직 완료된 프레임이 없음
+  */
+Bool_t Device_ADC_Get_Frame(AdcFrame_t * frame)
+{
+  u32_t seq;
+  u08_t i;
+
+  do
+  {
+    seq = adc_frame_seq;
+    if (seq == 0U)
+    {
+      return False;
+    }
+    for (i = 0; i < kNbrOfSIs; i++)
+    {
+      frame->raw[i] = adc_dma_buf[adc_frame_idx][i];
+    }
+    frame->tick = adc_frame_tick;
+    frame->cyc  = adc_frame_cyc;
+    frame->usec = adc_frame_usec;
+  } while (seq != adc_frame_seq);
+
+  frame->seq  = seq;
+  return True;
+}
+
+/** \brief  OSSD Port와 Feedback Port의 IDR을 한번씩 읽어 입력 상태를 만든다.
+  * \param  snap - 결과를 받을 InSnap_t 구조체 포인터
+  * \note   핀마다 HAL_GPIO_ReadPin()을 부르지 않으므로 OSSD1/OSSD2 사이 읽기 시차가 없고,
+  *         한 주기의 판정은 모두 같은 시점의 입력을 사용한다.
+  * \retval 없음
+  */
+void Device_Input_Snapshot(InSnap_t * snap)
+{
+  u16_t ossd;
+  u16_t fb;
+  u08_t i;
+
+  ossd = (u16_t)IN_SNAP_OSSD_Port->IDR;
+  fb   = (u16_t)IN_SNAP_FB_Port->IDR;
+  snap->ossd_idr = ossd;
+  snap->fb_idr   = fb;
+  snap->ossd1 = 0U;
+  snap->ossd2 = 0U;
+  snap->fb    = 0U;
+
+  for (i = 0; i < kNbrOfSIs; i++)
+  {
+    if ((ossd & in_ossd1_mask[i]) != 0U)
+    {
+      snap->ossd1 |= (u08_t)(1U << i);
+    }
+    if ((ossd & in_ossd2_mask[i]) != 0U)
+    {
+      snap->ossd2 |= (u08_t)(1U << i);
+    }
+  }
+
+  fb ^= in_fb_invert;
+  for (i = 0; i < kNbrOfRYFBIs; i++)
+  {
+    if ((fb & in_fb_mask[i]) != 0U)
+    {
+      snap->fb |= (u08_t)(1U << i);
+    }
+  }
+}
+
+/** \brief  usec timer의 현재 값을 읽는다.
+  * \note   32bit 1MHz free-running이므로 약 71분마다 순환하며, 시간차는 뺄셈으로 구한다.
+  * \retval 현재 시각(usec)
+  */
+u32_t Device_Usec_Now(void)
+{
+  return USEC_TIM->CNT;
+}
+
+/** \brief  at(usec) 시각에 USEC_TIM 인터럽트 안에서 cb를 한번 부르도록 예약한다.
+  * \param  at - 부를 시각(Device_Usec_Now() 기준)
+  * \param  cb - 부를 함수
+  * \note   CC1 비교는 CNT == CCR1일 때만 일어나므로 예약하는 사이에 시각이 지났으면 인터럽트를 바로 pending 한다.
+  *         이전 예약은 취소된다. 인터럽트와 thread 양쪽에서 호출할 수 있다.
+  * \retval 없음
+  */
+void Device_Usec_Alarm_Start(u32_t at, UsecAlarm_t cb)
+{
+  USEC_TIM->DIER &= ~TIM_DIER_CC1IE;
+  usec_alarm_cb  = cb;
+  USEC_TIM->CCR1 = at;
+  USEC_TIM->SR   = ~TIM_SR_CC1IF;
+  USEC_TIM->DIER |= TIM_DIER_CC1IE;
+  if ((i32_t)(USEC_TIM->CNT - at) >= 0)
+  {
+    HAL_NVIC_SetPendingIRQ(USEC_TIM_IRQn);
+  }
+}
+
+/** \brief  예약한 alarm을 취소한다.
+  * \retval 없음
+  */
+void Device_Usec_Alarm_Stop(void)
+{
+  USEC_TIM->DIER &= ~TIM_DIER_CC1IE;
+  usec_alarm_cb  = NULL;
+}
+
+/** \brief  USEC_TIM 인터럽트 처리 : 예약 시각이 되었으면 alarm을 끄고 callback을 부른다.
+  * \retval 없음
+  */
+void Device_Usec_Alarm_Isr(void)
+{
+  UsecAlarm_t cb = usec_alarm_cb;
+
+  if ((USEC_TIM->DIER & TIM_DIER_CC1IE) == 0U)
+  {
+    return;
+  }
+  if (((USEC_TIM->SR & TIM_SR_CC1IF) == 0U) && ((i32_t)(USEC_TIM->CNT - USEC_TIM->CCR1) < 0))
+  {
+    return;
+  }
+  USEC_TIM->DIER &= ~TIM_DIER_CC1IE;
+  USEC_TIM->SR   = ~TIM_SR_CC1IF;
+  usec_alarm_cb  = NULL;
+  if (cb != NULL)
+  {
+    cb();
+  }
+}
+
+/** \brief  EXTI ISR이 넣어둔 OSSD edge를 하나 꺼낸다.
+  * \param  edge - 꺼낸 edge를 받을 OssdEdge_t 구조체 포인터
+  * \note   ISR(생산자)은 head만, Deod_Thread(소비자)는 tail만 바꾸므로 인터럽트를 막지 않는다.
+  * \retval 꺼낸 edge가 있으면 True
+  */
+Bool_t Device_Ossd_Edge_Get(OssdEdge_t * edge)
+{
+  u32_t tail = ossd_edge_tail;
+
+  if (tail == ossd_edge_head)
+  {
+    return False;
+  }
+  *edge = ossd_edge_ring[tail];
+  ossd_edge_tail = (tail + 1U) & (OSSD_EDGE_RING_SIZE - 1U);
+  return True;
+}
+
+/** \brief  pin(kSO_x)의 EXTI edge 수를 반환한다.
+  * \retval edge 수
+  */
+u32_t Device_Ossd_Edge_Count(u08_t pin)
+{
+  return (pin < kNbrOfSOs) ? ossd_edge_cnt[pin] : 0U;
+}
+
+/** \brief  ring이 가득 차서 버린 edge 수를 반환한다.
+  * \note   값이 바뀌면 소비자는 edge 순서를 믿을 수 없으므로 snapshot으로 다시 맞춘다.
+  * \retval 버린 edge 수
+  */
+u32_t Device_Ossd_Edge_Overflow(void)
+{
+  return ossd_edge_overflow;
+}
+
+/** \brief  Pin별 EXTI edge 수를 지운다.
+  * \retval 없음
+  */
+void Device_Ossd_Edge_Clear_Count(void)
+{
+  u08_t i;
+
+  for (i = 0; i < kNbrOfSOs; i++)
+  {
+    ossd_edge_cnt[i] = 0U;
+  }
+}
+
+/** \brief  OSSD 입력의 EXTI callback
+  * \param  GPIO_Pin - edge가 발생한 Pin
+  * \note   edge 직후의 Pin 값과 usec 시각을 ring에 넣는다. ISR 진입 전에 다시 바뀐
+  *         짧은 pulse는 같은 level이 연속으로 들어오므로 소비자가 glitch로 판단한다.
+  * \retval 없음
+  */
+void HAL_GPIO_EXTI_Callback(u16_t GPIO_Pin)
+{
+  u32_t usec = USEC_TIM->CNT;
+  u16_t idr  = (u16_t)IN_SNAP_OSSD_Port->IDR;
+  u32_t head, next;
+  u08_t pin  = kNbrOfSOs;
+  u08_t i;
+
+  for (i = 0; i < kNbrOfSIs; i++)
+  {
+    if (GPIO_Pin == in_ossd1_mask[i])
+    {
+      pin = (u08_t)(i * 2U);
+      break;
+    }
+    if (GPIO_Pin == in_ossd2_mask[i])
+    {
+      pin = (u08_t)((i * 2U) + 1U);
+      break;
+    }
+  }
+  if (pin >= kNbrOfSOs)
+  {
+    return;
+  }
+  ossd_edge_cnt[pin]++;
+
+  head = ossd_edge_head;
+  next = (head + 1U) & (OSSD_EDGE_RING_SIZE - 1U);
+  if (next == ossd_edge_tail)
+  {
+    ossd_edge_overflow++;
+    return;
+  }
+  ossd_edge_ring[head].usec  = usec;
+  ossd_edge_ring[head].pin   = pin;
+  ossd_edge_ring[head].level = ((idr & GPIO_Pin) != 0U) ? 1U : 0U;
+  ossd_edge_head = next;
+}
+
+/** \brief  센서 ADC code를 채널 보정값을 반영한 전압(mV)으로 변환한다.
+  * \param  ch   - 센서 채널(kSI_1 ~ )
+  * \param  code - ADC code
+  * \note   콘솔 표시 및 통신 전송용이며 판정에는 사용하지 않는다.
+  * \retval 전압(mV)
+  */
+u16_t Device_ADC_To_mV(u08_t ch, u16_t code)
+{
+  i32_t cal;
+
+  cal = (i32_t)(((u32_t)code * adc_cal[ch].gain) / ADC_CAL_GAIN_ONE) + adc_cal[ch].offset;
+  if (cal < 0)
+  {
+    cal = 0;
+  }
+  return (u16_t)(((u32_t)cal * ADC_REF_mV) / ADC_MAX_CODE);
+}
+
+/** \brief  처리할 Analog Watchdog 감지 이벤트를 가져온다.
+  * \param  event - 감지 이벤트를 복사할 구조체 포인터
+  * \note   감지 당시 변환 중이던 프레임이 DMA로 완료된 뒤에만 True를 돌려주므로
+  *         호출한 쪽에서 곧바로 Device_ADC_Get_Frame()으로 해당 프레임을 읽을 수 있다.
+  * \retval True  - 새 감지 이벤트 있음(가져온 뒤 pending 해제)
+  * \retval False - 없음
+  */
+Bool_t Device_ADC_Awd_Get_Event(AdcAwdEvent_t * event)
+{
+  if ((adc_awd_pending != True) || (adc_frame_seq <= adc_awd_event.seq))
+  {
+    return False;
+  }
+  *event = adc_awd_event;
+  adc_awd_pending = False;
+  return True;
+}
+
+/** \brief  Analog Watchdog 인터럽트를 다시 허용한다.
+  * \note   감지 후에는 같은 상태에서 인터럽트가 변환마다 반복되지 않도록 막아두므로
+  *         모든 채널이 동작 전류 아래로 내려온 것을 확인한 쪽에서 호출한다.
+  * \retval 없음
+  */
+void Device_ADC_Awd_Arm(void)
+{
+  if ((adc_awd_pending == True) || ((hadc1.Instance->CR1 & ADC_CR1_AWDIE) != 0U))
+  {
+    return;
+  }
+  __HAL_ADC_CLEAR_FLAG(&hadc1, ADC_FLAG_AWD);
+  __HAL_ADC_ENABLE_IT(&hadc1, ADC_IT_AWD);
+}
+
+/** \brief  ADC Analog Watchdog(동작 전류 초과) callback
+  * \param  hadc - ADC handle pointer
+  * \note   감지 시점을 기록하고 인터럽트를 막은 뒤 DEOD 쓰레드가 다음 loop에서
+  *         주기(DEOD_SYS_CHECK_TIME)를 기다리지 않고 바로 판정하도록 한다.
+  * \retval 없음
+  */
+void HAL_ADC_LevelOutOfWindowCallback(ADC_HandleTypeDef* hadc)
+{
+  if (hadc->Instance == ADC1)
+  {
+    __HAL_ADC_DISABLE_IT(hadc, ADC_IT_AWD);
+    adc_awd_event.seq  = adc_frame_seq;
+    adc_awd_event.tick = HAL_GetTick();
+    adc_awd_event.usec = Device_Usec_Now();
+    adc_awd_pending    = True;
+  }
+}
+
+/** \brief  ADC DMA 버퍼의 앞쪽 절반(프레임 0) 전송 완료 callback
+  * \param  hadc - ADC handle pointer
+  * \retval 없음
+  */
+void HAL_ADC_ConvHalfCpltCallback(ADC_HandleTypeDef* hadc)
+{
+  if (hadc->Instance == ADC1)
+  {
+    Device_ADC_Frame_Complete(0U);
+  }
+}
+
+/** \brief  ADC DMA 버퍼의 뒤쪽 절반(프레임 1) 전송 완료 callback
+  * \param  hadc - ADC handle pointer
+  * \retval 없음
+  */
+void HAL_ADC_ConvCpltCallback(ADC_HandleTypeDef* hadc)
+{
+  if (hadc->Instance == ADC1)
+  {
+    Device_ADC_Frame_Complete(1U);
+  }
 }
 
 /** \} Device_Exported_Functions */
@@ -289,6 +677,7 @@ static void Device_Init_Console(void)
   static u08_t _serial_buf_tx[SERIAL_BUF_TX_SIZE];
   static u08_t _serial_buf_rx[SERIAL_BUF_RX_SIZE];
   static u08_t _serial_buf_printf[SERIAL_BUF_PRINTF_SIZE];
+  static DMA_HandleTypeDef _hserial_dma_tx;
 
 
   _serial.port_tx            = SERIAL_TX_Port;
@@ -310,12 +699,28 @@ static void Device_Init_Console(void)
   _serial.tx_count_in        = 0U;
   _serial.tx_count_out       = 0U;
   _serial.tx_ing             = False;
+  _serial.tx_policy          = (u08_t)SERIAL_TX_Policy;
+  _serial.tx_high            = False;
+  Rs232_Clear_Tx_Stat(&_serial);
+
+  if (SERIAL_DMA_Use == True)
+  {
+    _hserial_dma_tx.Instance     = SERIAL_DMA_TX_Stream;
+    _hserial_dma_tx.Init.Channel = SERIAL_DMA_TX_Channel;
+    _serial.hdma_tx              = &_hserial_dma_tx;
+  }
+  else
+  {
+    _serial.hdma_tx              = NULL;
+  }
+  _serial.dma_chunk          = SERIAL_DMA_Chunk;
 
   _serial.rx_buf             = _serial_buf_rx;
   _serial.rx_size            = SERIAL_BUF_RX_SIZE;
   _serial.rx_count           = 0U;
   _serial.rx_tick            = 0U;
   _serial.rx_complete        = False;
+  _serial.rx_idle            = SERIAL_RX_Idle_Use;
 
   _serial.printf_buf         = _serial_buf_printf;
   _serial.printf_size        = SERIAL_BUF_PRINTF_SIZE;
@@ -338,6 +743,145 @@ static void Device_Init_Console(void)
   Rs232_Init(serial3);
 }
 
+/** \brief  RS485(DM/PC 보드간 통신 Port)디바이스를 초기화한다.
+  * \note   디바이스 구조체에 디바이스 정의 대입하여 디바이스  전역변수를
+            설정해두며 초기화를 수행한다. 수신 허용은 Rs485com_Init()에서 한다.
+  * \retval 없음
+  */
+static void Device_Init_Rs485(void)
+{
+  static Rs485_t _serial;
+  static UART_HandleTypeDef _hserial;
+  static u08_t _serial_buf_tx[Rs485Ch1_BUF_TX_SIZE];
+  static u08_t _serial_buf_rx[Rs485Ch1_BUF_RX_SIZE];
+  static u08_t _serial_buf_printf[Rs485Ch1_BUF_PRINTF_SIZE];
+  static u08_t _serial_buf_dma[Rs485Ch1_DMA_BUF_SIZE];
+  static DMA_HandleTypeDef _hserial_dma_tx;
+
+  _serial.name               = Rs485Ch1_NAME;
+
+  _serial.port_tx            = Rs485Ch1_TX_Port;
+  _serial.init_tx.Pin        = Rs485Ch1_TX_Pin;
+  _serial.init_tx.Mode       = GPIO_MODE_AF_PP;
+  _serial.init_tx.Pull       = GPIO_PULLUP;
+  _serial.init_tx.Speed      = GPIO_SPEED_FREQ_VERY_HIGH;
+  _serial.init_tx.Alternate  = Rs485Ch1_TX_Alternate;
+
+  _serial.port_rx            = Rs485Ch1_RX_Port;
+  _serial.init_rx.Pin        = Rs485Ch1_RX_Pin;
+  _serial.init_rx.Mode       = GPIO_MODE_AF_PP;
+  _serial.init_rx.Pull       = GPIO_PULLUP;
+  _serial.init_rx.Speed      = GPIO_SPEED_FREQ_VERY_HIGH;
+  _serial.init_rx.Alternate  = Rs485Ch1_RX_Alternate;
+
+  _serial.port_txe           = Rs485Ch1_TXE_Port;
+  _serial.init_txe.Pin       = Rs485Ch1_TXE_Pin;
+  _serial.init_txe.Mode      = GPIO_MODE_OUTPUT_PP;
+  _serial.init_txe.Pull      = GPIO_NOPULL;
+  _serial.init_txe.Speed     = GPIO_SPEED_FREQ_VERY_HIGH;
+  _serial.on_txe             = Rs485Ch1_TXE_ON;
+  _serial.off_txe            = Rs485Ch1_TXE_OFF;
+
+  _serial.tx_buf             = _serial_buf_tx;
+  _serial.tx_size            = Rs485Ch1_BUF_TX_SIZE;
+  _serial.tx_count_in        = 0U;
+  _serial.tx_count_out       = 0U;
+  _serial.tx_ing             = False;
+
+  if (Rs485Ch1_DMA_Use == True)
+  {
+    _hserial_dma_tx.Instance     = Rs485Ch1_DMA_TX_Stream;
+    _hserial_dma_tx.Init.Channel = Rs485Ch1_DMA_TX_Channel;
+    _serial.hdma_tx              = &_hserial_dma_tx;
+  }
+  else
+  {
+    _serial.hdma_tx              = NULL;
+  }
+  _serial.dma_buf            = _serial_buf_dma;
+  _serial.dma_size           = Rs485Ch1_DMA_BUF_SIZE;
+  _serial.dma_busy           = False;
+
+  _serial.rx_buf             = _serial_buf_rx;
+  _serial.rx_size            = Rs485Ch1_BUF_RX_SIZE;
+  _serial.rx_count           = 0U;
+  _serial.rx_tick            = 0U;
+  _serial.rx_complete        = False;
+  _serial.rx_idle            = Rs485Ch1_RX_Idle_Use;
+  _serial.rx_hook            = NULL;
+
+  _serial.printf_buf         = _serial_buf_printf;
+  _serial.printf_size        = Rs485Ch1_BUF_PRINTF_SIZE;
+
+  _serial.usingIRQ           = Rs485Ch1_IRQ_Use;
+  _serial.irqn               = Rs485Ch1_IRQn;
+  _serial.irq_priority       = Rs485Ch1_IRQ_Priority;
+
+  _hserial.Instance          = Rs485Ch1_UART;
+  _hserial.Init.BaudRate     = Rs485Ch1_BaudRate;
+  _hserial.Init.WordLength   = Rs485Ch1_WordLength;
+  _hserial.Init.StopBits     = Rs485Ch1_StopBit;
+  _hserial.Init.Parity       = Rs485Ch1_Parity;
+  _hserial.Init.Mode         = Rs485Ch1_Mode;
+  _hserial.Init.HwFlowCtl    = Rs485Ch1_HwFlowCtl;
+  _hserial.Init.OverSampling = Rs485Ch1_OverSampling;
+  _serial.handle             = &_hserial;
+
+  serial1                      = &_serial;
+  Rs485_Init(serial1);
+}
+
+/** \brief  보드 역할 선택 입력(HCR 입력, PC BOARD 연결 갯수 Dip-Switch)을 초기화한다.
+  * \note   HCR 입력이 ON이면 마스터(DM) 보드, Dip-Switch 값은 마스터에서는 연결된 PC 보드 수,
+  *         슬레이브에서는 자기 보드 ID이다. 값은 Rs485com_Init()에서 읽는다.
+  * \retval 없음
+  */
+static void Device_Init_Board_Role(void)
+{
+  static DI_t     _hcr_input;
+  static DipSW_t  _cfg;
+
+  _hcr_input.name       = HCR_INPUT_NAME;
+  _hcr_input.max_filter = FILTER_msec_DipSW;
+  _hcr_input.filtering  = FILTER_msec_DipSW;
+  _hcr_input.port       = HCR_INPUT_Port;
+  _hcr_input.init.Pin   = HCR_INPUT_Pin;
+  _hcr_input.init.Mode  = GPIO_MODE_INPUT;
+  _hcr_input.init.Pull  = GPIO_PULLUP;
+  _hcr_input.init.Speed = GPIO_SPEED_HIGH;
+  _hcr_input.on         = HCR_INPUT_ON;
+  _hcr_input.off        = HCR_INPUT_OFF;
+  _hcr_input.curr_state = False;
+  hcr_input             = &_hcr_input;
+  DI_Init(hcr_input);
+
+  _cfg.name             = CFG_DIPSW_NAME;
+  _cfg.bits             = CFG_DIPSW_BITS;
+  _cfg.init[0].Mode     = GPIO_MODE_INPUT;
+  _cfg.init[0].Pull     = GPIO_PULLUP;
+  _cfg.init[0].Speed    = GPIO_SPEED_HIGH;
+  _cfg.init[1]          = _cfg.init[0];
+  _cfg.init[2]          = _cfg.init[0];
+  _cfg.port[0]          = CFG_SW1_GPIO_Port;
+  _cfg.init[0].Pin      = CFG_SW1_Pin;
+  _cfg.on[0]            = CFG_DIPSW_BIT0_ON;
+  _cfg.off[0]           = CFG_DIPSW_BIT0_OFF;
+  _cfg.port[1]          = CFG_SW2_GPIO_Port;
+  _cfg.init[1].Pin      = CFG_SW2_Pin;
+  _cfg.on[1]            = CFG_DIPSW_BIT1_ON;
+  _cfg.off[1]           = CFG_DIPSW_BIT1_OFF;
+  _cfg.port[2]          = CFG_SW3_GPIO_Port;
+  _cfg.init[2].Pin      = CFG_SW3_Pin;
+  _cfg.on[2]            = CFG_DIPSW_BIT2_ON;
+  _cfg.off[2]           = CFG_DIPSW_BIT2_OFF;
+  _cfg.max_filter       = FILTER_msec_DipSW;
+  _cfg.filtering        = FILTER_msec_DipSW;
+  cfg                   = &_cfg;
+  DipSW_Init(cfg);
+  _cfg.value            = DipSW_Get_value(cfg, False);
+  _cfg.prev_v           = _cfg.value;
+}
+
 
 /** \brief  Watch-Dog Timer 디바이스를 초기화한다.
   * \note   각 Watch-dog의 정의를 Watchdog_t 타입의 구조체에 대입하여 디바이스 전역변수를
@@ -680,7 +1224,7 @@ static void Device_Init_Sensor_Input(void)
 	_sdin[kSI_1].name           = SI1_OSSD_NAME;	
   _sdin[kSI_1].port1          = SI1_OSSD1_Port;
   _sdin[kSI_1].init1.Pin      = SI1_OSSD1_Pin;
-  _sdin[kSI_1].init1.Mode     = GPIO_MODE_INPUT;
+  _sdin[kSI_1].init1.Mode     = GPIO_MODE_IT_RISING_FALLING;  /* OSSD edge capture(EXTI) */
   _sdin[kSI_1].init1.Pull     = GPIO_PULLUP;
   _sdin[kSI_1].init1.Speed    = GPIO_SPEED_HIGH;
   Periph_Control_GPIO_CLK(_sdin->port1, True);
@@ -688,7 +1232,7 @@ static void Device_Init_Sensor_Input(void)
 /*************************************************************************/	
   _sdin[kSI_1].port2          = SI1_OSSD2_Port;
   _sdin[kSI_1].init2.Pin      = SI1_OSSD2_Pin;
-  _sdin[kSI_1].init2.Mode     = GPIO_MODE_INPUT;
+  _sdin[kSI_1].init2.Mode     = GPIO_MODE_IT_RISING_FALLING;  /* OSSD edge capture(EXTI) */
   _sdin[kSI_1].init2.Pull     = GPIO_PULLUP;
   _sdin[kSI_1].init2.Speed    = GPIO_SPEED_HIGH;
   Periph_Control_GPIO_CLK(_sdin->port2, True);
@@ -696,8 +1240,10 @@ static void Device_Init_Sensor_Input(void)
 /**************************************************************************/	
   _sdin[kSI_1].Sensor_flag    = False;
   _sdin[kSI_1].Sensor_fail_flag = False;
-  _sdin[kSI_1].Sensor_Counter = 0;
-  _sdin[kSI_1].Sensor_Voltage = 0;
+  _sdin[kSI_1].Ossd_History   = 0;
+  _sdin[kSI_1].Ossd_Votes     = 0;
+  _sdin[kSI_1].Ossd_Confirmed = False;
+  _sdin[kSI_1].Sensor_Adc     = 0;
   _sdin[kSI_1].Sensor_OSSD1   = False;
   _sdin[kSI_1].Sensor_OSSD2   = False;	
   sdin[kSI_1]                 = &_sdin[kSI_1];
@@ -706,24 +1252,26 @@ static void Device_Init_Sensor_Input(void)
 	_sdin[kSI_2].name           = SI2_OSSD_NAME;		
   _sdin[kSI_2].port1          = SI2_OSSD1_Port;
   _sdin[kSI_2].init1.Pin      = SI2_OSSD1_Pin;
-  _sdin[kSI_2].init1.Mode     = GPIO_MODE_INPUT;
+  _sdin[kSI_2].init1.Mode     = GPIO_MODE_IT_RISING_FALLING;  /* OSSD edge capture(EXTI) */
   _sdin[kSI_2].init1.Pull     = GPIO_PULLUP;
   _sdin[kSI_2].init1.Speed    = GPIO_SPEED_HIGH;
-  Periph_Control_GPIO_CLK(_sdin->port1, True);
-  HAL_GPIO_Init(_sdin->port1, &_sdin->init1);
+  Periph_Control_GPIO_CLK(_sdin[kSI_2].port1, True);
+  HAL_GPIO_Init(_sdin[kSI_2].port1, &_sdin[kSI_2].init1);
 /**************************************************************************/	
   _sdin[kSI_2].port2          = SI2_OSSD2_Port;
   _sdin[kSI_2].init2.Pin      = SI2_OSSD2_Pin;
-  _sdin[kSI_2].init2.Mode     = GPIO_MODE_INPUT;
+  _sdin[kSI_2].init2.Mode     = GPIO_MODE_IT_RISING_FALLING;  /* OSSD edge capture(EXTI) */
   _sdin[kSI_2].init2.Pull     = GPIO_PULLUP;
   _sdin[kSI_2].init2.Speed    = GPIO_SPEED_HIGH;
-  Periph_Control_GPIO_CLK(_sdin->port2, True);
-  HAL_GPIO_Init(_sdin->port2, &_sdin->init2);	
+  Periph_Control_GPIO_CLK(_sdin[kSI_2].port2, True);
+  HAL_GPIO_Init(_sdin[kSI_2].port2, &_sdin[kSI_2].init2);	
 /**************************************************************************/	
   _sdin[kSI_2].Sensor_flag    = False;
   _sdin[kSI_2].Sensor_fail_flag = False;  
-  _sdin[kSI_2].Sensor_Counter = 0;
-  _sdin[kSI_2].Sensor_Voltage = 0;
+  _sdin[kSI_2].Ossd_History   = 0;
+  _sdin[kSI_2].Ossd_Votes     = 0;
+  _sdin[kSI_2].Ossd_Confirmed = False;
+  _sdin[kSI_2].Sensor_Adc     = 0;
   _sdin[kSI_2].Sensor_OSSD1   = False;
   _sdin[kSI_2].Sensor_OSSD2   = False;
   sdin[kSI_2]                 = &_sdin[kSI_2];
@@ -732,24 +1280,26 @@ static void Device_Init_Sensor_Input(void)
 	_sdin[kSI_3].name           = SI3_OSSD_NAME;		
   _sdin[kSI_3].port1          = SI3_OSSD1_Port;
   _sdin[kSI_3].init1.Pin      = SI3_OSSD1_Pin;
-  _sdin[kSI_3].init1.Mode     = GPIO_MODE_INPUT;
+  _sdin[kSI_3].init1.Mode     = GPIO_MODE_IT_RISING_FALLING;  /* OSSD edge capture(EXTI) */
   _sdin[kSI_3].init1.Pull     = GPIO_PULLUP;
   _sdin[kSI_3].init1.Speed    = GPIO_SPEED_HIGH;
-  Periph_Control_GPIO_CLK(_sdin->port1, True);
-  HAL_GPIO_Init(_sdin->port1, &_sdin->init1);
+  Periph_Control_GPIO_CLK(_sdin[kSI_3].port1, True);
+  HAL_GPIO_Init(_sdin[kSI_3].port1, &_sdin[kSI_3].init1);
 /**************************************************************************/	
   _sdin[kSI_3].port2          = SI3_OSSD2_Port;
   _sdin[kSI_3].init2.Pin      = SI3_OSSD2_Pin;
-  _sdin[kSI_3].init2.Mode     = GPIO_MODE_INPUT;
+  _sdin[kSI_3].init2.Mode     = GPIO_MODE_IT_RISING_FALLING;  /* OSSD edge capture(EXTI) */
   _sdin[kSI_3].init2.Pull     = GPIO_PULLUP;
   _sdin[kSI_3].init2.Speed    = GPIO_SPEED_HIGH;
-  Periph_Control_GPIO_CLK(_sdin->port2, True);
-  HAL_GPIO_Init(_sdin->port2, &_sdin->init2);	
+  Periph_Control_GPIO_CLK(_sdin[kSI_3].port2, True);
+  HAL_GPIO_Init(_sdin[kSI_3].port2, &_sdin[kSI_3].init2);	
 /**************************************************************************/	
   _sdin[kSI_3].Sensor_flag    = False;
   _sdin[kSI_3].Sensor_fail_flag = False;  
-  _sdin[kSI_3].Sensor_Counter = 0;
-  _sdin[kSI_3].Sensor_Voltage = 0;
+  _sdin[kSI_3].Ossd_History   = 0;
+  _sdin[kSI_3].Ossd_Votes     = 0;
+  _sdin[kSI_3].Ossd_Confirmed = False;
+  _sdin[kSI_3].Sensor_Adc     = 0;
   _sdin[kSI_3].Sensor_OSSD1   = False;
   _sdin[kSI_3].Sensor_OSSD2   = False;
   sdin[kSI_3]                 = &_sdin[kSI_3];
@@ -758,29 +1308,65 @@ static void Device_Init_Sensor_Input(void)
 	_sdin[kSI_4].name           = SI4_OSSD_NAME;		
   _sdin[kSI_4].port1          = SI4_OSSD1_Port;
   _sdin[kSI_4].init1.Pin      = SI4_OSSD1_Pin;
-  _sdin[kSI_4].init1.Mode     = GPIO_MODE_INPUT;
+  _sdin[kSI_4].init1.Mode     = GPIO_MODE_IT_RISING_FALLING;  /* OSSD edge capture(EXTI) */
   _sdin[kSI_4].init1.Pull     = GPIO_PULLUP;
   _sdin[kSI_4].init1.Speed    = GPIO_SPEED_HIGH;
-  Periph_Control_GPIO_CLK(_sdin->port1, True);
-  HAL_GPIO_Init(_sdin->port1, &_sdin->init1);
+  Periph_Control_GPIO_CLK(_sdin[kSI_4].port1, True);
+  HAL_GPIO_Init(_sdin[kSI_4].port1, &_sdin[kSI_4].init1);
 /**************************************************************************/	
   _sdin[kSI_4].port2          = SI4_OSSD2_Port;
   _sdin[kSI_4].init2.Pin      = SI4_OSSD2_Pin;
-  _sdin[kSI_4].init2.Mode     = GPIO_MODE_INPUT;
+  _sdin[kSI_4].init2.Mode     = GPIO_MODE_IT_RISING_FALLING;  /* OSSD edge capture(EXTI) */
   _sdin[kSI_4].init2.Pull     = GPIO_PULLUP;
   _sdin[kSI_4].init2.Speed    = GPIO_SPEED_HIGH;
-  Periph_Control_GPIO_CLK(_sdin->port2, True);
-  HAL_GPIO_Init(_sdin->port2, &_sdin->init2);	
+  Periph_Control_GPIO_CLK(_sdin[kSI_4].port2, True);
+  HAL_GPIO_Init(_sdin[kSI_4].port2, &_sdin[kSI_4].init2);	
 /**************************************************************************/	
   _sdin[kSI_4].Sensor_flag    = False;
   _sdin[kSI_4].Sensor_fail_flag = False;  
-  _sdin[kSI_4].Sensor_Counter = 0;
-  _sdin[kSI_4].Sensor_Voltage = 0;
+  _sdin[kSI_4].Ossd_History   = 0;
+  _sdin[kSI_4].Ossd_Votes     = 0;
+  _sdin[kSI_4].Ossd_Confirmed = False;
+  _sdin[kSI_4].Sensor_Adc     = 0;
   _sdin[kSI_4].Sensor_OSSD1   = False;
   _sdin[kSI_4].Sensor_OSSD2   = False;
   sdin[kSI_4]                 = &_sdin[kSI_4];
 }
 
+/** \brief  Device_Input_Snapshot()에서 사용할 OSSD/Feedback Pin mask를 구성한다.
+  * \note   sdin[], din[]의 Pin 정의에서 mask를 만들며, IN_SNAP_OSSD_Port/IN_SNAP_FB_Port가 아닌
+  *         Port에 연결된 입력이 있으면 snapshot으로 읽을 수 없으므로 경고를 출력한다.
+  * \retval 없음
+  */
+static void Device_Init_Input_Snapshot(void)
+{
+  u08_t i;
+
+  for (i = 0; i < kNbrOfSIs; i++)
+  {
+    in_ossd1_mask[i] = (u16_t)sdin[i]->init1.Pin;
+    in_ossd2_mask[i] = (u16_t)sdin[i]->init2.Pin;
+    if ((sdin[i]->port1 != IN_SNAP_OSSD_Port) || (sdin[i]->port2 != IN_SNAP_OSSD_Port))
+    {
+      cprintf("Input Snapshot : %s OSSD Port Mismatch\n", sdin[i]->name);
+    }
+  }
+
+  in_fb_invert = 0U;
+  for (i = 0; i < kNbrOfRYFBIs; i++)
+  {
+    in_fb_mask[i] = (u16_t)din[i]->init.Pin;
+    if (din[i]->off == GPIO_PIN_RESET)
+    {
+      in_fb_invert |= in_fb_mask[i];                                   /* DI_Get_State()는 Pin == off 일 때 True */
+    }
+    if (din[i]->port != IN_SNAP_FB_Port)
+    {
+      cprintf("Input Snapshot : %s Feedback Port Mismatch\n", din[i]->name);
+    }
+  }
+}
+
 
 /** \brief  Digital Output Isolator State 디바이스를 초기화한다.
   * \note   각 DOIS의 정의를 DI_t 타입의 구조체에 대입하여 디바이스 전역변수를
@@ -836,6 +1422,37 @@ static void Device_Init_DOIS(void)
   DI_Init(wdt_ok);
 }
 
+/** \brief  Sensor 채널 수 선택 스위치(PB15) 디바이스를 초기화한다.
+  * \note   부팅 시 한번 읽어서 sensor_ch_num을 결정한다.
+  *         스위치 ON(Low)이면 2CH, OFF(High)이면 4CH로 동작한다.
+  * \retval 없음
+  */
+static void Device_Init_Sensor_Channel(void)
+{
+  static DI_t   _pc_ch_num;
+
+  _pc_ch_num.name       = SEN_CH_INPUT_NAME;
+  _pc_ch_num.max_filter = FILTER_msec_DipSW;
+  _pc_ch_num.filtering  = FILTER_msec_DipSW;
+  _pc_ch_num.port       = SEN_CH_INPUT_Port;
+  _pc_ch_num.init.Pin   = SEN_CH_INPUT_Pin;
+  _pc_ch_num.init.Mode  = GPIO_MODE_INPUT;
+  _pc_ch_num.init.Pull  = GPIO_PULLUP;
+  _pc_ch_num.init.Speed = GPIO_SPEED_HIGH;
+  _pc_ch_num.on         = SEN_CH_INPUT_ON;
+  _pc_ch_num.off        = SEN_CH_INPUT_OFF;
+  _pc_ch_num.curr_state = False;
+  pc_ch_num             = &_pc_ch_num;
+  DI_Init(pc_ch_num);
+
+  /* DI_Get_State()는 Pin이 OFF 값일 때 True */
+  sensor_ch_num = (DI_Get_State(pc_ch_num) == True) ? SEN_CH_NUM_4CH : SEN_CH_NUM_2CH;
+  if (sensor_ch_num > kNbrOfSIs)
+  {
+    sensor_ch_num = kNbrOfSIs;
+  }
+}
+
 /** \brief  TMP117 디바이스를 초기화한다.
   * \note   각 TMP117의 정의를 TMP117_t 타입의 구조체에 대입하여 디바이스 전역변수를
             설정해두며 초기화를 수행한다.
@@ -888,7 +1505,11 @@ void HAL_I2C_MspInit(I2C_HandleTypeDef* hi2c1)
 
 }
 
-// 
+/** \brief  ADC 디바이스를 초기화한다.
+  * \note   ADC1 CH0~CH3(OBR,DER,OBL,DEL)을 TIM2 TRGO 마다 한번씩 scan 하고
+  *         DMA circular 모드로 adc_dma_buf[]에 번갈아 저장한다.
+  * \retval 없음
+  */
 static void Device_Init_ADC(void)
 {
 	 ADC_ChannelConfTypeDef sConfig;
@@ -898,16 +1519,16 @@ static void Device_Init_ADC(void)
    hadc1.Instance                   = ADC1;
    hadc1.Init.ClockPrescaler        = ADC_CLOCK_SYNC_PCLK_DIV2;
    hadc1.Init.Resolution            = ADC_RESOLUTION_12B;
-   hadc1.Init.ScanConvMode          = ENABLE;                      //DISABLE;   Sequencer disabled (ADC conversion on only 1 channel: channel set on rank 1) */
-   hadc1.Init.ContinuousConvMode    = DISABLE;                     //ENABLE;    Continuous mode disabled to have only 1 conversion at each conversion trig */
-   hadc1.Init.DiscontinuousConvMode = ENABLE;                      //DISABLE;   Parameter discarded because sequencer is disabled */
-   hadc1.Init.NbrOfDiscConversion   = 1;
-   hadc1.Init.ExternalTrigConvEdge  = ADC_EXTERNALTRIGCONVEDGE_NONE;        /* Conversion start trigged at each external event */
-   hadc1.Init.ExternalTrigConv      = ADC_SOFTWARE_START;
+   hadc1.Init.ScanConvMode          = ENABLE;                      /* CH0 ~ CH3 순서대로 scan */
+   hadc1.Init.ContinuousConvMode    = DISABLE;                     /* trigger 1회에 scan 1회 */
+   hadc1.Init.DiscontinuousConvMode = DISABLE;
+   hadc1.Init.NbrOfDiscConversion   = 0;
+   hadc1.Init.ExternalTrigConvEdge  = ADC_EXTERNALTRIGCONVEDGE_RISING;      /* TIM2 TRGO 상승 에지에서 scan 시작 */
+   hadc1.Init.ExternalTrigConv      = ADC_EXTERNALTRIGCONV_T2_TRGO;
    hadc1.Init.DataAlign             = ADC_DATAALIGN_RIGHT;
-   hadc1.Init.NbrOfConversion       = 4;
-   hadc1.Init.DMAContinuousRequests = DISABLE;
-   hadc1.Init.EOCSelection          = ADC_EOC_SINGLE_CONV;
+   hadc1.Init.NbrOfConversion       = kNbrOfSIs;
+   hadc1.Init.DMAContinuousRequests = ENABLE;                      /* DMA circular 전송 유지 */
+   hadc1.Init.EOCSelection          = ADC_EOC_SEQ_CONV;
 
 	if (HAL_ADC_Init(&hadc1) != HAL_OK)
   {
@@ -950,6 +1571,204 @@ static void Device_Init_ADC(void)
 	{
  //    Channel Configuration Error  
 	}  	
+
+  /*##-3- Start ADC scan with circular DMA ###################################*/
+	if (HAL_ADC_Start_DMA(&hadc1, (uint32_t *)&adc_dma_buf[0][0], ADC_SCAN_FRAMES * kNbrOfSIs) != HAL_OK)
+	{
+ //    ADC DMA Start Error  
+	}
+	Device_Init_ADC_Trigger();
+}
+
+/** \brief  ADC scan trigger용 TIM2를 초기화한다.
+  * \note   TIM2를 1MHz로 count 하여 ADC_SCAN_PERIOD_usec 마다 Update 이벤트를
+  *         TRGO로 출력한다. APB1 분주비가 1이 아니므로 Timer 클럭은 PCLK1 x 2 이다.
+  * \retval 없음
+  */
+static void Device_Init_ADC_Trigger(void)
+{
+  __HAL_RCC_TIM2_CLK_ENABLE();
+
+  ADC_SCAN_TIM->CR1 = 0U;
+  ADC_SCAN_TIM->PSC = ((HAL_RCC_GetPCLK1Freq() * 2U) / 1000000U) - 1U;
+  ADC_SCAN_TIM->ARR = ADC_SCAN_PERIOD_usec - 1U;
+  ADC_SCAN_TIM->CR2 = TIM_CR2_MMS_1;                                   /* MMS = 010 : Update -> TRGO */
+  ADC_SCAN_TIM->EGR = TIM_EGR_UG;                                      /* PSC/ARR 즉시 반영 */
+  ADC_SCAN_TIM->CR1 = TIM_CR1_CEN;
+}
+
+/** \brief  OSSD edge 시각용 usec timer(TIM5, 32bit)를 시작한다.
+  * \note   ADC trigger용 TIM2와 같이 APB1 timer clock을 1MHz로 분주하고 ARR 최대로 free-running 한다.
+  *         CC1 비교 인터럽트는 Device_Usec_Alarm_Start()가 켠다.
+  * \retval 없음
+  */
+static void Device_Init_Usec_Timer(void)
+{
+  __HAL_RCC_TIM5_CLK_ENABLE();
+
+  USEC_TIM->CR1 = 0U;
+  USEC_TIM->PSC = ((HAL_RCC_GetPCLK1Freq() * 2U) / 1000000U) - 1U;
+  USEC_TIM->ARR = 0xFFFFFFFFU;
+  USEC_TIM->EGR = TIM_EGR_UG;
+  USEC_TIM->SR  = 0U;
+  USEC_TIM->CR1 = TIM_CR1_CEN;
+
+  HAL_NVIC_SetPriority(USEC_TIM_IRQn, USEC_ALARM_IRQ_PRIORITY, 0);
+  HAL_NVIC_EnableIRQ(USEC_TIM_IRQn);
+}
+
+/** \brief  OSSD 입력의 EXTI 인터럽트를 허용한다.
+  * \note   Pin은 Device_Init_Sensor_Input()에서 양쪽 edge EXTI로 설정되어 있으므로
+  *         초기화 중 쌓인 pending을 지우고 Pin별 EXTI IRQ를 같은 우선순위로 켠다.
+  * \retval 없음
+  */
+static void Device_Init_Ossd_Edge(void)
+{
+  u08_t i;
+  u16_t pins = 0U;
+
+  for (i = 0; i < kNbrOfSIs; i++)
+  {
+    pins |= in_ossd1_mask[i] | in_ossd2_mask[i];
+  }
+  ossd_edge_head = 0U;
+  ossd_edge_tail = 0U;
+  ossd_edge_overflow = 0U;
+  Device_Ossd_Edge_Clear_Count();
+  __HAL_GPIO_EXTI_CLEAR_IT(pins);
+
+  for (i = 0; i < 16U; i++)
+  {
+    if ((pins & (1U << i)) != 0U)
+    {
+      HAL_NVIC_SetPriority(Device_Exti_IRQn((u16_t)(1U << i)), OSSD_EDGE_IRQ_PRIORITY, 0);
+      HAL_NVIC_EnableIRQ(Device_Exti_IRQn((u16_t)(1U << i)));
+    }
+  }
+}
+
+/** \brief  GPIO Pin에 해당하는 EXTI IRQ 번호를 구한다.
+  * \param  pin - GPIO_PIN_x
+  * \retval EXTI IRQ 번호
+  */
+static IRQn_Type Device_Exti_IRQn(u16_t pin)
+{
+  IRQn_Type irq;
+
+  switch (pin)
+  {
+    case GPIO_PIN_0: irq = EXTI0_IRQn; break;
+    case GPIO_PIN_1: irq = EXTI1_IRQn; break;
+    case GPIO_PIN_2: irq = EXTI2_IRQn; break;
+    case GPIO_PIN_3: irq = EXTI3_IRQn; break;
+    case GPIO_PIN_4: irq = EXTI4_IRQn; break;
+    case GPIO_PIN_5:
+    case GPIO_PIN_6:
+    case GPIO_PIN_7:
+    case GPIO_PIN_8:
+    case GPIO_PIN_9: irq = EXTI9_5_IRQn; break;
+    default:         irq = EXTI15_10_IRQn; break;
+  }
+  return irq;
+}
+
+/** \brief  센서 판정 기준값(mV)을 채널별 ADC code로 변환하여 sensor_thr[]에 저장한다.
+  * \note   Device_ADC_To_mV()와 같은 계산식을 역으로 풀어 경계 code를 구하므로
+  *         mV로 변환한 뒤 비교하던 결과와 정확히 일치한다.
+  * \retval 없음
+  */
+static void Device_Init_Sensor_Threshold(void)
+{
+  u08_t ch;
+
+  for (ch = 0; ch < kNbrOfSIs; ch++)
+  {
+    sensor_thr[ch].act_min   = Device_ADC_Code_At_Least(ch, cMIN_ACT_CUR + 1U);
+    sensor_thr[ch].act_max   = Device_ADC_Code_At_Least(ch, cMAX_ACT_CUR);
+    sensor_thr[ch].high      = Device_ADC_Code_At_Least(ch, cMAX_ACT_CUR + 2U);
+    sensor_thr[ch].low       = Device_ADC_Code_At_Least(ch, cLOW_CUR);
+    sensor_thr[ch].low_clear = Device_ADC_Code_At_Least(ch, cLOW_CUR + 1U);
+    sensor_thr[ch].max       = Device_ADC_Code_At_Least(ch, cMAX_CUR + 1U);
+  }
+}
+
+/** \brief  ADC1 Analog Watchdog을 설정한다.
+  * \note   모든 regular 채널에 대해 상한을 채널 중 가장 낮은 act_min 바로 아래로 두어
+  *         어느 채널이든 cMIN_ACT_CUR를 넘으면 ADC 인터럽트가 발생하도록 한다.
+  *         (F4의 Analog Watchdog은 하나의 기준값만 가지므로 채널별 보정 중 가장
+  *         민감한 값을 사용하고, 채널별 정확한 판정은 주기 scan에서 다시 한다.)
+  * \retval 없음
+  */
+static void Device_Init_ADC_Watchdog(void)
+{
+  ADC_AnalogWDGConfTypeDef awd;
+  u16_t high;
+  u08_t ch;
+
+  high = ADC_MAX_CODE + 1U;
+  for (ch = 0; ch < sensor_ch_num; ch++)
+  {
+    if (sensor_thr[ch].act_min < high)
+    {
+      high = sensor_thr[ch].act_min;
+    }
+  }
+  if ((high == 0U) || (high > ADC_MAX_CODE))
+  {
+    return;                                                            /* 설정할 수 있는 기준값 없음 */
+  }
+
+  awd.WatchdogMode  = ADC_ANALOGWATCHDOG_ALL_REG;
+  awd.HighThreshold = (u32_t)high - 1U;                                /* code > HTR 이면 감지 */
+  awd.LowThreshold  = 0U;
+  awd.Channel       = ADC_CHANNEL_0;
+  awd.ITMode        = ENABLE;
+  if (HAL_ADC_AnalogWDGConfig(&hadc1, &awd) != HAL_OK)
+  {
+ //    Analog Watchdog Configuration Error
+  }
+
+  HAL_NVIC_SetPriority(ADC_AWD_IRQn, ADC_AWD_IRQ_PRIORITY, 0);
+  HAL_NVIC_EnableIRQ(ADC_AWD_IRQn);
+}
+
+/** \brief  보정된 전압이 mv 이상이 되는 최소 ADC code를 구한다.
+  * \param  ch - 센서 채널
+  * \param  mv - 기준 전압(mV)
+  * \note   (code * gain) / ADC_CAL_GAIN_ONE >= (ADC_mV_TO_CODE(mv) - offset) 를
+  *         만족하는 최소 code. 해당 code가 없으면 ADC_MAX_CODE + 1 을 돌려준다.
+  * \retval ADC code
+  */
+static u16_t Device_ADC_Code_At_Least(u08_t ch, u16_t mv)
+{
+  i32_t need;
+  u32_t code;
+
+  need = (i32_t)ADC_mV_TO_CODE(mv) - adc_cal[ch].offset;
+  if (need <= 0)
+  {
+    return 0U;
+  }
+  code = (((u32_t)need * ADC_CAL_GAIN_ONE) + (adc_cal[ch].gain - 1U)) / adc_cal[ch].gain;
+  if (code > ADC_MAX_CODE)
+  {
+    code = ADC_MAX_CODE + 1U;
+  }
+  return (u16_t)code;
+}
+
+/** \brief  DMA 전송이 끝난 프레임을 최신 프레임으로 공개한다.
+  * \param  idx - 완료된 프레임 위치(0 또는 1)
+  * \note   DMA 인터럽트에서 호출된다.
+  * \retval 없음
+  */
+static void Device_ADC_Frame_Complete(u08_t idx)
+{
+  adc_frame_idx  = idx;
+  adc_frame_tick = HAL_GetTick();
+  adc_frame_cyc  = Latency_Now();
+  adc_frame_usec = Device_Usec_Now();
+  adc_frame_seq++;
 }
 
 /**
@@ -980,6 +1799,27 @@ void HAL_ADC_MspInit(ADC_HandleTypeDef* hadc1)
     GPIO_InitStruct.Pull = GPIO_NOPULL;
     HAL_GPIO_Init(GPIOA, &GPIO_InitStruct);
 
+    /* ADC1 DMA Init : DMA2 Stream0 Channel0, circular */
+    __HAL_RCC_DMA2_CLK_ENABLE();
+    hdma_adc1.Instance                 = ADC_SCAN_DMA_Stream;
+    hdma_adc1.Init.Channel             = ADC_SCAN_DMA_Channel;
+    hdma_adc1.Init.Direction           = DMA_PERIPH_TO_MEMORY;
+    hdma_adc1.Init.PeriphInc           = DMA_PINC_DISABLE;
+    hdma_adc1.Init.MemInc              = DMA_MINC_ENABLE;
+    hdma_adc1.Init.PeriphDataAlignment = DMA_PDATAALIGN_HALFWORD;
+    hdma_adc1.Init.MemDataAlignment    = DMA_MDATAALIGN_HALFWORD;
+    hdma_adc1.Init.Mode                = DMA_CIRCULAR;
+    hdma_adc1.Init.Priority            = DMA_PRIORITY_HIGH;
+    hdma_adc1.Init.FIFOMode            = DMA_FIFOMODE_DISABLE;
+    if (HAL_DMA_Init(&hdma_adc1) != HAL_OK)
+    {
+ //    DMA initialization Error
+    }
+    __HAL_LINKDMA(hadc1, DMA_Handle, hdma_adc1);
+
+    HAL_NVIC_SetPriority(ADC_SCAN_DMA_IRQn, ADC_SCAN_DMA_IRQ_PRIORITY, 0);
+    HAL_NVIC_EnableIRQ(ADC_SCAN_DMA_IRQn);
+
 	}
 
 }
@@ -15,6 +15,7 @@
 #include "led.h"
 #include "dip_switch.h"
 #include "rs232.h"
+#include "rs485.h"
 #include "relay.h"
 #include "digital_output.h"
 #include "digital_input.h"
@@ -29,6 +30,14 @@
 #include "stl_user_api.h"
 #include "stm32f4xx_ll_system.h"
 #include "tpm117.h"
+#include "latency_probe.h"
+#include "ossd_edge.h"
+#include "eb_act.h"
+#include "fault_mgr.h"
+#include "rs485_link.h"
+#include "rs485_baud.h"
+#include "rs485_diag.h"
+#include "dlog.h"
 
 
 typedef struct
@@ -39,10 +48,12 @@ GPIO_InitTypeDef    init1;
 GPIO_TypeDef       *port2;                                     
 GPIO_InitTypeDef    init2;
 Bool_t  Sensor_flag; 	
-u08_t   Sensor_Counter;
+u32_t   Ossd_History;                                        /* OSSD1&OSSD2 sample 이력(bit0 = 최근) */
+u08_t   Ossd_Votes;                                          /* 투표 window 안의 High sample 수 */
+Bool_t  Ossd_Confirmed;                                      /* M-of-N 투표로 확정된 OSSD 동작 */
 u32_t   Sensor_Low_Counter; 
 u08_t   low_counter_start;	
-u16_t	  Sensor_Voltage;
+u16_t	  Sensor_Adc;                                          /* 센서 전류 ADC code(0 ~ 4095), mV 변환은 표시할 때만 */
 Bool_t  Sensor_OSSD1;
 Bool_t  Sensor_OSSD2;
 Bool_t  Sensor_fail_flag;
@@ -55,6 +66,16 @@ Bool_t  Sensor_fail_flag;
   * \{ */
 
 /* Exported types ------------------------------------------------------------*/
+/** \brief cprintf() 시간 통계(LATENCY_CLOCK, 보통 CPU cycle) */
+typedef struct
+{
+u32_t   calls;                                         /**< cprintf() 호출 수 */
+u32_t   chars;                                         /**< 만든 글자 수 */
+u32_t   fmt_last;                                      /**< 마지막 호출의 형식화 시간(송신 버퍼 복사 제외) */
+u32_t   fmt_max;                                       /**< 형식화 최대 시간 */
+u32_t   put_max;                                       /**< 송신 버퍼에 넣은 최대 시간(한 호출 합) */
+}CprintfStat_t;
+
 /* Exported constants --------------------------------------------------------*/
 /** \defgroup Board_Device_Exported_Constants Board 디바이스 공개 상수
   * \{ */
@@ -80,11 +101,17 @@ Bool_t  Sensor_fail_flag;
 
 #define SERIAL_BUF_TX_SIZE      (2048U)                         /**< 송신 버퍼 크기 */
 #define SERIAL_BUF_RX_SIZE      (2048U)                         /**< 수신 버퍼 크기 */
-#define SERIAL_BUF_PRINTF_SIZE  (512U)                          /**< Printf용 버퍼 크기 */
+#define SERIAL_BUF_PRINTF_SIZE  (512U)                          /**< Printf용 버퍼 크기(한 줄 단위, 넘으면 나눠 보냄) */
 
 #define SERIAL_IRQ_Use          (True)                          /**< 인터럽트 사용 유무 */
 #define SERIAL_IRQn             (USART3_IRQn)                   /**< 인터럽트 식별 번호 */
 #define SERIAL_IRQ_Priority     (4U)                            /**< 인터럽트 우선 순위 */
+#define SERIAL_RX_Idle_Use      (True)                          /**< IDLE line으로 수신 완료 판정(False면 5msec 수신 타이머) */
+#define SERIAL_DMA_Use          (True)                          /**< 송신에 DMA 사용 유무(False면 TXE 인터럽트 송신) */
+#define SERIAL_DMA_TX_Stream    (DMA1_Stream3)                  /**< USART3_TX DMA Stream */
+#define SERIAL_DMA_TX_Channel   (DMA_CHANNEL_4)                 /**< USART3_TX DMA Channel */
+#define SERIAL_DMA_Chunk        (256U)                          /**< DMA 1회 전송 최대 byte 수 */
+#define SERIAL_TX_Policy        (kRS232_TX_BLOCK_HIGH)          /**< 송신 버퍼 넘침 정책(Rs232TxPolicy_t) */
 
 #define SERIAL_UART             (USART3)                        /**< USART */
 #define SERIAL_BaudRate         (115200U)                       /**< Baud-Rate */
@@ -124,9 +151,11 @@ Bool_t  Sensor_fail_flag;
 #define Rs485Ch1_IRQ_Use         (True)                 /**< 인터럽트 사용 유무 */
 #define Rs485Ch1_IRQn            (USART1_IRQn)          /**< 인터럽트 식별 번호 */
 #define Rs485Ch1_IRQ_Priority    (7)                    /**< 인터럽트 우선 순위 */
+#define Rs485Ch1_RX_Idle_Use     (True)                 /**< IDLE line으로 수신 완료 판정 */
 
 #define Rs485Ch1_UART            (USART1)               /**< USART */
-#define Rs485Ch1_BaudRate        (38400)                /**< Baud-Rate */
+#define Rs485Ch1_BaudRate        (38400)                /**< Baud-Rate, 전원 투입 시 공통 속도(rs485_baud 기본 속도) */
+#define Rs485Ch1_BaudRate_Max    (460800)               /**< 협상으로 올릴 최대 속도(115200, 230400, 460800) */
 #define Rs485Ch1_WordLength      (UART_WORDLENGTH_8B)   /**< Word Length */
 #define Rs485Ch1_StopBit         (UART_STOPBITS_1)      /**< Stop Bit */
 #define Rs485Ch1_Parity          (UART_PARITY_NONE)     /**< Parity Bit */
@@ -135,6 +164,11 @@ Bool_t  Sensor_fail_flag;
 #define Rs485Ch1_OverSampling    (UART_OVERSAMPLING_16) /**< Over Sampling */
 
 #define Rs485Ch1_IRQHandler      USART1_IRQHandler
+
+#define Rs485Ch1_DMA_Use         (True)                 /**< frame 송신에 DMA 사용 유무 */
+#define Rs485Ch1_DMA_TX_Stream   (DMA2_Stream7)         /**< USART1_TX DMA Stream */
+#define Rs485Ch1_DMA_TX_Channel  (DMA_CHANNEL_4)        /**< USART1_TX DMA Channel */
+#define Rs485Ch1_DMA_BUF_SIZE    (64)                   /**< DMA 송신 frame 버퍼 크기 */
 /** \} Rs485Ch1_Port_정의 */
 /** \} RS485_디바이스_정의 */
 
@@ -692,6 +726,92 @@ enum
 #define HCR_INPUT_OFF           (GPIO_PIN_SET)         /**< OFF 했을 때 Pin의 값 */
 /** \} HCR INPUT */
 
+/** \defgroup ADC_Scan_디바이스_정의 센서 전류 ADC scan 정의
+ * \brief TIM2 TRGO로 ADC1 CH0~CH3을 scan하고 DMA2 Stream0으로 circular 전송한다.
+ * \{ */
+#define ADC_SCAN_PERIOD_usec       1000U                  /**< TIM2 trigger 주기(usec) */
+#define ADC_SCAN_FRAMES            2U                     /**< DMA double buffer 프레임 수 */
+#define ADC_SCAN_DMA_Stream        (DMA2_Stream0)         /**< ADC1 DMA Stream */
+#define ADC_SCAN_DMA_Channel       (DMA_CHANNEL_0)        /**< ADC1 DMA Channel */
+#define ADC_SCAN_DMA_IRQn          (DMA2_Stream0_IRQn)    /**< ADC1 DMA IRQ */
+#define ADC_SCAN_DMA_IRQ_PRIORITY  (5)                    /**< ADC1 DMA IRQ 우선순위 */
+#define ADC_SCAN_DMA_IRQHandler    DMA2_Stream0_IRQHandler
+#define ADC_SCAN_TIM               (TIM2)                 /**< ADC1 trigger Timer */
+#define ADC_AWD_IRQn               (ADC_IRQn)             /**< ADC1 Analog Watchdog IRQ */
+#define ADC_AWD_IRQ_PRIORITY       (3)                    /**< Analog Watchdog IRQ 우선순위(DMA보다 높게) */
+/** \brief ADC1 scan 1회(센서 4채널)의 샘플 프레임 */
+typedef struct
+{
+u16_t   raw[kNbrOfSIs];                                /**< 채널별 ADC 변환값(0 ~ 4095) */
+u32_t   seq;                                           /**< 프레임 순번(갱신될 때마다 증가) */
+u32_t   tick;                                          /**< 변환 완료 시점의 SysTick(msec) */
+u32_t   usec;                                          /**< 변환 완료 시점의 Device_Usec_Now()(TIM5, usec) */
+u32_t   cyc;                                           /**< 변환 완료 시점의 Latency_Now() 값 */
+}AdcFrame_t;
+
+/** \brief ADC1 Analog Watchdog 감지 이벤트 */
+typedef struct
+{
+u32_t   seq;                                           /**< 감지 당시 변환 중이던 프레임 순번 */
+u32_t   tick;                                          /**< 감지 시점의 SysTick(msec) */
+u32_t   usec;                                          /**< 감지 시점의 Device_Usec_Now()(TIM5, usec) */
+}AdcAwdEvent_t;
+
+/** \brief 센서 채널별 ADC 보정값
+  * \note  보정 code = (ADC code * gain) / ADC_CAL_GAIN_ONE + offset */
+typedef struct
+{
+u16_t   gain;                                          /**< 기울기(ADC_CAL_GAIN_ONE = 1.0) */
+i16_t   offset;                                        /**< 옵셋(ADC code) */
+}AdcCal_t;
+
+/** \brief 센서 채널별 판정 기준값(ADC code)
+  * \note  각 값은 보정된 전압이 기준 전압 이상이 되는 최소 ADC code 이다.
+  *        "전압 > X" 는 code >= 기준값, "전압 < X" 는 code < 기준값 으로 비교한다. */
+typedef struct
+{
+u16_t   act_min;                                       /**< 전압 > cMIN_ACT_CUR      */
+u16_t   act_max;                                       /**< 전압 < cMAX_ACT_CUR      */
+u16_t   high;                                          /**< 전압 > cMAX_ACT_CUR + 1  */
+u16_t   low;                                           /**< 전압 < cLOW_CUR          */
+u16_t   low_clear;                                     /**< 전압 > cLOW_CUR          */
+u16_t   max;                                           /**< 전압 > cMAX_CUR          */
+}SensorThr_t;
+
+#define ADC_REF_mV                 3300U                  /**< ADC 기준전압(mV) */
+#define ADC_MAX_CODE               4095U                  /**< 12bit ADC 최대 code */
+#define ADC_CAL_GAIN_ONE           4096U                  /**< 보정 기울기 1.0 */
+/** \brief 보정 전 전압이 mv 이상이 되는 최소 ADC code (컴파일 시 계산용) */
+#define ADC_mV_TO_CODE(mv)         (((u32_t)(mv) * ADC_MAX_CODE + (ADC_REF_mV - 1U)) / ADC_REF_mV)
+
+#define SI1_ADC_CAL_GAIN           ADC_CAL_GAIN_ONE       /**< OBR 보정 기울기 */
+#define SI1_ADC_CAL_OFFSET         (0)                    /**< OBR 보정 옵셋(code) */
+#define SI2_ADC_CAL_GAIN           ADC_CAL_GAIN_ONE       /**< DER 보정 기울기 */
+#define SI2_ADC_CAL_OFFSET         (0)                    /**< DER 보정 옵셋(code) */
+#define SI3_ADC_CAL_GAIN           ADC_CAL_GAIN_ONE       /**< OBL 보정 기울기 */
+#define SI3_ADC_CAL_OFFSET         (0)                    /**< OBL 보정 옵셋(code) */
+#define SI4_ADC_CAL_GAIN           ADC_CAL_GAIN_ONE       /**< DEL 보정 기울기 */
+#define SI4_ADC_CAL_OFFSET         (0)                    /**< DEL 보정 옵셋(code) */
+/** \} ADC_Scan_디바이스_정의 */
+
+/** \defgroup Input_Snapshot_디바이스_정의 입력 Port snapshot 정의
+ * \brief OSSD 입력(GPIOC 0~7)과 릴레이 Feedback 입력(GPIOD 8~15)을 Port IDR 1회 읽기로 가져온다.
+ * \{ */
+#define IN_SNAP_OSSD_Port          (GPIOC)                /**< 센서 OSSD1/OSSD2 입력 Port */
+#define IN_SNAP_FB_Port            (GPIOD)                /**< 릴레이 Feedback 입력 Port */
+#define IN_SNAP_BIT(bits, n)       (((((u32_t)(bits)) >> (n)) & 1U) != 0U ? True : False)
+
+/** \brief 한 시점에 읽은 OSSD/Feedback 입력 상태 */
+typedef struct
+{
+u16_t   ossd_idr;                                      /**< OSSD Port IDR 원본 */
+u16_t   fb_idr;                                        /**< Feedback Port IDR 원본 */
+u08_t   ossd1;                                         /**< bit ch : 센서 ch의 OSSD1 High */
+u08_t   ossd2;                                         /**< bit ch : 센서 ch의 OSSD2 High */
+u08_t   fb;                                            /**< bit kRYFBI_x : DI_Get_State()가 True인 Feedback */
+}InSnap_t;
+/** \} Input_Snapshot_디바이스_정의 */
+
 /** \defgroup Sensor Chanel 구분 Input_디바이스_정의  
  * \brief 입력 1번 pin map과 속성
  * \{ */
@@ -700,6 +820,8 @@ enum
 #define SEN_CH_INPUT_Pin           (GPIO_PIN_15)           /**< GPIO Pin */
 #define SEN_CH_INPUT_ON            (GPIO_PIN_RESET)       /**< ON 했을 때 Pin의 값 */
 #define SEN_CH_INPUT_OFF           (GPIO_PIN_SET)         /**< OFF 했을 때 Pin의 값 */
+#define SEN_CH_NUM_2CH             (2U)                   /**< 스위치 ON : 2CH(OBR,DER) 사용 */
+#define SEN_CH_NUM_4CH             (4U)                   /**< 스위치 OFF : 4CH(OBR,DER,OBL,DEL) 사용 */
 /** \} SEN_CH INPUT */
 enum
 {
@@ -714,6 +836,34 @@ enum
   kNbrOfSOs
 };
 
+/** \defgroup OSSD_Edge_디바이스_정의 OSSD EXTI edge capture 정의
+ * \brief OSSD 8개 입력의 양쪽 edge를 EXTI로 받아 usec 시각과 함께 ring buffer에 넣는다.
+ *        edge 번호는 kSO_x(센서 ch의 OSSD1 = ch*2, OSSD2 = ch*2+1)를 사용한다.
+ * \{ */
+#define OSSD_EDGE_RING_SIZE        64U                    /**< edge ring buffer 크기(2의 거듭제곱) */
+#define OSSD_EDGE_IRQ_PRIORITY     (4)                    /**< EXTI IRQ 우선순위(모두 같게 해서 중첩 방지) */
+#define USEC_TIM                   (TIM5)                 /**< 32bit 1MHz free-running usec timer */
+
+/** \brief OSSD edge 이벤트 */
+typedef struct
+{
+u32_t   usec;                                          /**< edge 시각(USEC_TIM, usec) */
+u08_t   pin;                                           /**< kSO_x */
+u08_t   level;                                         /**< edge 직후 Pin 값(1 = High) */
+}OssdEdge_t;
+/** \} OSSD_Edge_디바이스_정의 */
+
+/** \defgroup Usec_Alarm_디바이스_정의 USEC_TIM 비교 alarm 정의
+ * \brief USEC_TIM(TIM5)의 CC1 비교 인터럽트로 정한 시각에 callback을 한번 부른다(TDMA slot 응답 송신용).
+ * \{ */
+#define USEC_TIM_IRQn              (TIM5_IRQn)            /**< USEC_TIM 인터럽트 번호 */
+#define USEC_TIM_IRQHandler        TIM5_IRQHandler
+#define USEC_ALARM_IRQ_PRIORITY    (Rs485Ch1_IRQ_Priority) /**< RS485 수신 인터럽트와 같게 해서 송신 경로끼리 중첩 방지 */
+
+/** \brief 비교 시각에 USEC_TIM 인터럽트 안에서 불리는 callback */
+typedef void (*UsecAlarm_t)(void);
+/** \} Usec_Alarm_디바이스_정의 */
+
 /** \defgroup DipSW_디바이스_정의 Dip-Switch 디바이스 정의
  * \{ ************************************************************************/
 
@@ -762,6 +912,7 @@ enum DipSWDevice {
 /** \defgroup Board_Device_Exported_Variables Board 디바이스 공개 변수
   * \{ */
 extern Rs232_t * serial3;            /**< RS-232 serial3 디바이스 객체 */
+extern Rs485_t * serial1;            /**< RS-485 serial1(DM/PC 보드간 통신) 디바이스 객체 */
 
 extern Led_t  * run_led;                 /* RUN LED 디바이스 객체 */
 extern Led_t  * der_led;                /* DMPC LED 디바이스 객체 */
@@ -774,6 +925,9 @@ extern Led_t  * hlt_led;                 /* HLT LED 디바이스 객체 */
 extern Led_t  * obr_led;                 /* HCR LED 디바이스 객체 */
 extern Led_t  * e_eb_led;             /* COM_ERR LED 디바이스 객체 */
 extern Led_t  * obl_led;                  /* EB LED 디바이스 객체 */
+extern Led_t  * comtx_led;               /* COMTX LED 디바이스 객체, 이 보드에는 없음(NULL) */
+extern Led_t  * comrx_led;               /* COMRX LED 디바이스 객체, 이 보드에는 없음(NULL) */
+extern Led_t  * com_err_led;             /* COM_ERR LED 디바이스 객체, 이 보드에는 없음(NULL) */
 
 extern Watchdog_t * wdog;
 extern Relay_t      * eb1_out;           /* Relay Output 디바이스 객체 */
@@ -798,10 +952,13 @@ extern DI_t       * fpin_2;
 extern DI_t	      * pwrin; 
 extern DI_t       * wdt_ok;
 extern DI_t       * hcr_input;
-//extern DI_t       *pc_ch_num;
+extern DI_t       * pc_ch_num;
+extern u08_t        sensor_ch_num;        /**< 사용 센서 채널 수(2CH/4CH) */
 extern DipSW_t    * cfg; 
 extern I2C_HandleTypeDef    hi2c1;
 extern ADC_HandleTypeDef    hadc1;
+extern DMA_HandleTypeDef    hdma_adc1;
+extern SensorThr_t          sensor_thr[kNbrOfSIs];   /**< 채널별 판정 기준값(ADC code) */
 //extern DEOD_t * sensort[kNbrOfMO];
 /** \} Board_Device_Exported_Constants */
 
@@ -811,6 +968,19 @@ extern ADC_HandleTypeDef    hadc1;
 /** \defgroup Device_Exported_Functions 디바이스 공개 함수
   * \{ */
 void Device_Init(void);
+Bool_t Device_ADC_Get_Frame(AdcFrame_t * frame);
+u16_t  Device_ADC_To_mV(u08_t ch, u16_t code);
+Bool_t Device_ADC_Awd_Get_Event(AdcAwdEvent_t * event);
+void   Device_ADC_Awd_Arm(void);
+void   Device_Input_Snapshot(InSnap_t * snap);
+u32_t  Device_Usec_Now(void);
+void   Device_Usec_Alarm_Start(u32_t at, UsecAlarm_t cb);
+void   Device_Usec_Alarm_Stop(void);
+void   Device_Usec_Alarm_Isr(void);
+Bool_t Device_Ossd_Edge_Get(OssdEdge_t * edge);
+u32_t  Device_Ossd_Edge_Count(u08_t pin);
+u32_t  Device_Ossd_Edge_Overflow(void);
+void   Device_Ossd_Edge_Clear_Count(void);
 //extern PulseCount_t  * pulsecnt;            /**< 타코미터 입력 디바이스 객체 */
 void Periph_Control_GPIO_CLK(GPIO_TypeDef * port, Bool_t ctrl);
 void Periph_Control_UART_CLK(USART_TypeDef * uart, Bool_t ctrl);
@@ -818,6 +988,8 @@ void Periph_Control_TIM_CLK(TIM_TypeDef * tim, Bool_t ctrl);
 #ifdef RTE_DEVICE_HAL_UART
 void cprintf(const char_t format[], ...);
 void cprint(u08_t buf[], u32_t size);
+void Cprintf_Get_Stat(CprintfStat_t * stat);
+void Cprintf_Clear_Stat(void);
 #endif /* RTE_DEVICE_HAL_UART */
 
 #if (defined(RTE_DEVICE_HAL_NAND) || defined(RTE_DEVICE_HAL_NOR) || defined(RTE_DEVICE_HAL_SDRAM) || defined(RTE_DEVICE_HAL_SRAM))
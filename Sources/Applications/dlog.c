@@ -0,0 +1,344 @@
+/** ****************************************************************************
+  * \file    dlog.c
+  * \author  Jang Ho Jong
+  * \version V0.0.2
+  * \date    2026.10.17
+  * \brief   Deferred Binary Log Body
+  * ***************************************************************************/
+
+/* Includes ------------------------------------------------------------------*/
+#include "dlog.h"
+#include "device.h"
+#include "lib_crc16.h"
+
+/** \addtogroup Applications
+  * \{ */
+
+/** \defgroup Dlog 지연 binary 로그
+  * \brief 호출 위치에서는 형식 문자열 주소와 인자만 저장하고 출력은 main loop에서 합니다.
+  * \{ */
+
+/* Private typedef -----------------------------------------------------------*/
+/* Private define ------------------------------------------------------------*/
+#define DLOG_RING_MASK          (DLOG_RING_WORDS - 1U)
+#define DLOG_ADDR_MASK          0x0FFFFFFFUL           /* Flash(0x0800_0000 ~) 주소는 bit 27..0 */
+#define DLOG_ARGC_SHIFT         28U
+#define DLOG_FRAME_SIZE         (DLOG_FRAME_HEAD + (DLOG_FRAME_WORDS * 4U) + 2U)
+
+/* Private macro -------------------------------------------------------------*/
+/* Private variables ---------------------------------------------------------*/
+/** \defgroup Dlog_Private_Variables 지연 로그 비공개 변수
+  * \{ */
+static u32_t           _ring[DLOG_RING_WORDS];                 /**< record ring */
+static volatile u32_t  _head;                                  /**< 생산자(Dlog_Write) : 인터럽트 금지 구간에서만 바꿈 */
+static volatile u32_t  _tail;                                  /**< 소비자(Dlog_Thread)만 바꿈 */
+static DlogMode_t      _mode;
+static DlogStat_t      _stat;
+static u08_t           _frame[DLOG_FRAME_SIZE];                /**< 송신 frame 조립 버퍼 */
+static const char_t    _anchor[] = DLOG_ANCHOR;
+/** \} Dlog_Private_Variables */
+
+/* Exported variables --------------------------------------------------------*/
+u08_t g_dlog_level[kNbrOfLogMods];
+
+/* Private function prototypes -----------------------------------------------*/
+/** \defgroup Dlog_Private_Functions 지연 로그 비공개 함수
+  * \{ */
+static u32_t Dlog_Used(void);
+static u32_t Dlog_Put32(u08_t buf[], u32_t i, u32_t v);
+static void  Dlog_Send_Frame(void);
+static void  Dlog_Print_Text(void);
+/** \} Dlog_Private_Functions */
+
+/* Exported functions --------------------------------------------------------*/
+/** \addtogroup Dlog_Exported_Functions
+  * \{ */
+
+/** \brief  ring과 통계를 비우고 출력 모드와 모듈별 로그 레벨을 기본값으로 한다.
+  * \retval 없음
+  */
+void Dlog_Init(void)
+{
+  u08_t  i;
+
+  _head = 0U;
+  _tail = 0U;
+  _mode = DLOG_MODE_DEFAULT;
+  for (i = 0U; i < (u08_t)kNbrOfLogMods; i++)
+  {
+    g_dlog_level[i] = LOG_LEVEL_DEFAULT;
+  }
+  Dlog_Clear_Stat();
+}
+
+/** \brief  record 하나를 ring에 넣는다. DLOG0() ~ DLOG4() 매크로로 호출한다.
+  * \param  fmt  - 형식 문자열(Flash 상수), 주소가 ID가 된다
+  * \param  argc - 인자 수(0 ~ DLOG_ARG_MAX)
+  * \param  a0 ~ a3 - 인자
+  * \note   인터럽트에서도 부를 수 있다. 문자열을 만들지 않고 word (2 + argc)개만 저장하며,
+  *         ring이 차면 기다리지 않고 버린 뒤 센다.
+  * \retval 없음
+  */
+void Dlog_Write(const char_t fmt[], u32_t argc, u32_t a0, u32_t a1, u32_t a2, u32_t a3)
+{
+  u32_t  primask, head, used;
+
+  if (argc > DLOG_ARG_MAX)
+  {
+    argc = DLOG_ARG_MAX;
+  }
+  primask = __get_PRIMASK();
+  __disable_irq();
+  head = _head;
+  used = (head - _tail) & DLOG_RING_MASK;
+  if ((DLOG_RING_MASK - used) < (argc + 2U))
+  {
+    _stat.drops++;
+    __set_PRIMASK(primask);
+    return;
+  }
+  _ring[head] = ((u32_t)fmt & DLOG_ADDR_MASK) | (argc << DLOG_ARGC_SHIFT);
+  head = (head + 1U) & DLOG_RING_MASK;
+  _ring[head] = Device_Usec_Now();
+  head = (head + 1U) & DLOG_RING_MASK;
+  if (argc > 0U)
+  {
+    _ring[head] = a0;
+    head = (head + 1U) & DLOG_RING_MASK;
+  }
+  if (argc > 1U)
+  {
+    _ring[head] = a1;
+    head = (head + 1U) & DLOG_RING_MASK;
+  }
+  if (argc > 2U)
+  {
+    _ring[head] = a2;
+    head = (head + 1U) & DLOG_RING_MASK;
+  }
+  if (argc > 3U)
+  {
+    _ring[head] = a3;
+    head = (head + 1U) & DLOG_RING_MASK;
+  }
+  _head = head;
+  _stat.records++;
+  used += argc + 2U;
+  if (used > _stat.peak)
+  {
+    _stat.peak = used;
+  }
+  __set_PRIMASK(primask);
+}
+
+/** \brief  ring에 쌓인 record를 출력 모드에 따라 내보낸다.
+  * \note   main loop에서 가장 낮은 우선순위로 호출한다. 콘솔 송신 버퍼에 자리가 있을 때만
+  *         내보내므로 콘솔 출력을 밀어내지 않고, 못 보낸 record는 다음 호출에서 보낸다.
+  * \retval 없음
+  */
+void Dlog_Thread(void)
+{
+  if (_tail == _head)
+  {
+    return;
+  }
+  if (_mode == kDLOG_BIN)
+  {
+    Dlog_Send_Frame();
+  }
+  else if (_mode == kDLOG_TEXT)
+  {
+    Dlog_Print_Text();
+  }
+  else
+  {
+    /* OFF : ring에 모아 둠 */
+  }
+}
+
+/** \brief  출력 모드를 바꾼다.
+  * \param  mode - 출력 모드
+  * \retval 범위를 벗어난 값이면 False
+  */
+Bool_t Dlog_Set_Mode(DlogMode_t mode)
+{
+  if (mode >= kNbrOfDlogModes)
+  {
+    return False;
+  }
+  _mode = mode;
+  return True;
+}
+
+/** \brief  통계를 복사한다.
+  * \param  stat - 채울 구조체
+  * \retval 없음
+  */
+void Dlog_Get_Stat(DlogStat_t * stat)
+{
+  *stat      = _stat;
+  stat->used = Dlog_Used();
+  stat->mode = _mode;
+}
+
+/** \brief  통계를 지우고 최대 사용량을 현재 사용량으로 되돌린다.
+  * \note   버린 record 누계(drops)는 frame에 실려 가므로 PC 도구는 값이 줄면 지운 것으로 본다.
+  * \retval 없음
+  */
+void Dlog_Clear_Stat(void)
+{
+  u32_t  primask;
+
+  primask = __get_PRIMASK();
+  __disable_irq();
+  _stat.records = 0U;
+  _stat.drops   = 0U;
+  _stat.frames  = 0U;
+  _stat.bytes   = 0U;
+  _stat.peak    = Dlog_Used();
+  __set_PRIMASK(primask);
+}
+
+/** \brief  모듈의 실행 레벨을 바꾼다.
+  * \param  mod   - 로그 모듈
+  * \param  level - LOG_LVL_OFF ~ LOG_LVL_TRACE, LOG_LEVEL_BUILD보다 자세한 호출은 이미 빠져 있다
+  * \retval 범위를 벗어난 값이면 False
+  */
+Bool_t Dlog_Set_Level(LogMod_t mod, u08_t level)
+{
+  if ((mod >= kNbrOfLogMods) || (level > (u08_t)LOG_LVL_TRACE))
+  {
+    return False;
+  }
+  g_dlog_level[mod] = level;
+  return True;
+}
+
+/** \} Dlog_Exported_Functions */
+
+/* Private functions ---------------------------------------------------------*/
+/** \addtogroup Dlog_Private_Functions
+  * \{ */
+
+/** \brief  ring 사용량을 구한다.
+  * \retval 사용 중인 word 수
+  */
+static u32_t Dlog_Used(void)
+{
+  return (_head - _tail) & DLOG_RING_MASK;
+}
+
+/** \brief  buf[i]부터 v를 little endian으로 넣는다.
+  * \retval 다음 위치
+  */
+static u32_t Dlog_Put32(u08_t buf[], u32_t i, u32_t v)
+{
+  buf[i]      = (u08_t)(v & 0xFFU);
+  buf[i + 1U] = (u08_t)((v >> 8) & 0xFFU);
+  buf[i + 2U] = (u08_t)((v >> 16) & 0xFFU);
+  buf[i + 3U] = (u08_t)((v >> 24) & 0xFFU);
+  return i + 4U;
+}
+
+/** \brief  콘솔 송신 버퍼 여유만큼 record를 frame 하나로 묶어 보낸다.
+  * \note   record는 통째로만 담는다. 송신 버퍼에 넣지 못하면 tail을 옮기지 않아 다음에 다시 보낸다.
+  * \retval 없음
+  */
+static void Dlog_Send_Frame(void)
+{
+  u32_t  room, limit, tail, words, w, n, i;
+  u16_t  crc;
+
+  room = Rs232_Get_Tx_Free(serial3);
+  if (room < (DLOG_FRAME_HEAD + 2U + 8U))
+  {
+    return;
+  }
+  limit = (room - DLOG_FRAME_HEAD - 2U) / 4U;
+  if (limit > DLOG_FRAME_WORDS)
+  {
+    limit = DLOG_FRAME_WORDS;
+  }
+
+  tail  = _tail;
+  words = 0U;
+  n     = DLOG_FRAME_HEAD;
+  while (tail != _head)
+  {
+    w = (_ring[tail] >> DLOG_ARGC_SHIFT) + 2U;
+    if ((words + w) > limit)
+    {
+      break;
+    }
+    for (i = 0U; i < w; i++)
+    {
+      n    = Dlog_Put32(_frame, n, _ring[tail]);
+      tail = (tail + 1U) & DLOG_RING_MASK;
+    }
+    words += w;
+  }
+  if (words == 0U)
+  {
+    return;
+  }
+
+  _frame[0] = (u08_t)'D';
+  _frame[1] = (u08_t)'L';
+  _frame[2] = (u08_t)DLOG_FRAME_VER;
+  _frame[3] = (u08_t)words;
+  (void)Dlog_Put32(_frame, 4U, (u32_t)_anchor);
+  (void)Dlog_Put32(_frame, 8U, _stat.drops);
+  crc = Crc16_Krs(_frame, n);
+  _frame[n]      = (u08_t)(crc & 0xFFU);
+  _frame[n + 1U] = (u08_t)(crc >> 8);
+  n += 2U;
+
+  if (Rs232_Write(serial3, _frame, n, False) == 0U)
+  {
+    return;
+  }
+  _tail = tail;
+  _stat.frames++;
+  _stat.bytes += n;
+}
+
+/** \brief  record를 DLOG_TEXT_RECORDS개까지 cprintf()로 출력한다.
+  * \note   형식 문자열에 없는 인자는 0으로 넘기며 printf는 남는 인자를 무시한다.
+  * \retval 없음
+  */
+static void Dlog_Print_Text(void)
+{
+  u32_t  a[DLOG_ARG_MAX];
+  u32_t  tail, hdr, argc, i, r;
+
+  tail = _tail;
+  for (r = 0U; (r < DLOG_TEXT_RECORDS) && (tail != _head); r++)
+  {
+    if (Rs232_Get_Tx_Free(serial3) < serial3->printf_size)
+    {
+      break;
+    }
+    hdr  = _ring[tail];
+    argc = hdr >> DLOG_ARGC_SHIFT;
+    tail = (tail + 2U) & DLOG_RING_MASK;                   /* 시각은 글자 출력에 쓰지 않음 */
+    for (i = 0U; i < DLOG_ARG_MAX; i++)
+    {
+      a[i] = 0U;
+      if (i < argc)
+      {
+        a[i] = _ring[tail];
+        tail = (tail + 1U) & DLOG_RING_MASK;
+      }
+    }
+    _tail = tail;
+    cprintf((const char_t *)(hdr & DLOG_ADDR_MASK), a[0], a[1], a[2], a[3]);
+  }
+}
+
+/** \} Dlog_Private_Functions */
+
+/** \} Dlog */
+
+/** \} Applications */
+
+/*************** (C) COPYRIGHT SHALOM ENGINEERING CO., LTD. ****END OF FILE****/
@@ -0,0 +1,188 @@
+/** ****************************************************************************
+  * \file    dlog.h
+  * \author  Jang Ho Jong
+  * \version V0.0.2
+  * \date    2026.10.17
+  * \brief   Deferred Binary Log Header
+  * ***************************************************************************/
+/*
+  - 지연(Deferred) binary 로그 모듈
+
+  - 개념:
+    호출 위치에서는 형식 문자열을 만들지 않고 형식 문자열 주소, 시각, 인자(u32 최대 4개)만
+    RAM ring에 넣는다(PRIMASK 구간 안에서 word 몇 개 저장). 문자열 생성과 UART 송신은
+    main loop의 Dlog_Thread()가 나중에 한다.
+
+  - 형식 문자열 ID:
+    형식 문자열(Flash 상수)의 주소를 ID로 쓴다. 별도 ID 표가 없으므로 빌드 결과(.axf)가 곧
+    형식 문자열 표이며, PC 도구(tools/dlog_decode.py)가 .axf에서 주소로 문자열을 찾아 복원한다.
+    인자는 %d %u %x %X %c %q %s(상수 문자열 주소)만 쓴다. %f(double)는 쓸 수 없다.
+
+  - 출력 모드(콘솔 "DLOG BIN/TEXT/OFF"):
+    BIN  : record를 frame으로 묶어 콘솔 UART로 보낸다(기본). PC 도구로 받는다.
+    TEXT : Dlog_Thread()가 cprintf()로 글자로 출력한다. 터미널로 직접 볼 때 쓰며 UART 사용량이 크게 는다.
+           디버그 빌드는 DLOG_MODE_DEFAULT=kDLOG_TEXT로 정의해 기본을 TEXT로 할 수 있다.
+    OFF  : 보내지 않고 ring에 모아 둔다. ring이 차면 새 record를 버리고 센다.
+
+  - record(u32 word, ring 안) :
+    word0 = 형식 문자열 주소(bit 27..0) | 인자 수(bit 31..28), word1 = Device_Usec_Now(), 인자...
+
+  - frame(little endian) :
+    'D' | 'L' | ver | word 수 | anchor 주소(4) | 버린 record 누계(4) | record word... | CRC16(2)
+    anchor는 DLOG_ANCHOR 문자열 주소로, PC 도구가 .axf의 같은 주소에 같은 문자열이 있는지 보고
+    다른 빌드의 .axf를 쓰는 실수를 잡는다. CRC16은 Crc16_Krs()이며 앞의 모든 byte에 대해 계산한다.
+    콘솔 글자 사이에 섞여 나가므로 PC 도구는 'D','L'과 CRC가 맞는 frame만 골라낸다.
+
+  - 모니터링:
+    콘솔 "DLOG" 명령어로 record/버림/frame/송신 byte 수와 ring 최대 사용량을 표시한다.
+
+  - 레벨/모듈(LOG0() ~ LOG4()) :
+    LOG1(DEBUG, RS485, "fmt %d\n", v) 처럼 레벨(ERROR, WARN, INFO, DEBUG, TRACE)과
+    모듈(DEOD, RS485, SYSMON, STL, CONSOLE)을 붙여 DLOGx()로 기록한다.
+    LOG_LEVEL_BUILD보다 자세한 레벨의 호출은 전처리기에서 통째로 빠지므로 형식 문자열도 분기도 남지 않는다.
+    남은 호출은 모듈별 실행 레벨(g_dlog_level[], 콘솔 "LOG")보다 자세하면 기록하지 않는다(load 1개와 비교 1개).
+
+  - Dlog 접두어를 사용한다.
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef __DLOG_H
+#define __DLOG_H
+
+/* Includes ------------------------------------------------------------------*/
+#include "main.h"
+
+/** \addtogroup Applications
+  * \{ */
+
+/** \addtogroup Dlog
+  * \{ */
+
+/* Exported constants --------------------------------------------------------*/
+/** \defgroup Dlog_Exported_Constants 지연 로그 공개 상수
+  * \{ */
+#define DLOG_RING_WORDS         512U                   /**< record ring 크기(word, 2의 거듭제곱) */
+#define DLOG_ARG_MAX            4U                     /**< record 당 최대 인자 수 */
+#define DLOG_FRAME_WORDS        64U                    /**< frame 하나에 담는 최대 record word 수 */
+#define DLOG_FRAME_VER          0x01U
+#define DLOG_FRAME_HEAD         12U                    /**< 'D','L',ver,word 수,anchor,drops */
+#define DLOG_TEXT_RECORDS       4U                     /**< TEXT 모드에서 Dlog_Thread() 한번에 출력하는 record 수 */
+#define DLOG_ANCHOR             "DLOG ANCHOR V1"
+#ifndef DLOG_MODE_DEFAULT
+#define DLOG_MODE_DEFAULT       kDLOG_BIN              /**< 전원 투입 시 출력 모드(디버그 빌드 : kDLOG_TEXT) */
+#endif
+
+/* 로그 레벨 : 숫자가 클수록 자세함(#if에서 쓰므로 enum이 아닌 숫자) */
+#define LOG_LVL_OFF             0
+#define LOG_LVL_ERROR           1
+#define LOG_LVL_WARN            2
+#define LOG_LVL_INFO            3
+#define LOG_LVL_DEBUG           4
+#define LOG_LVL_TRACE           5
+#ifndef LOG_LEVEL_BUILD
+#define LOG_LEVEL_BUILD         LOG_LVL_DEBUG          /**< 이보다 자세한 LOGx() 호출은 컴파일에서 빠진다(양산 : LOG_LVL_INFO) */
+#endif
+#define LOG_LEVEL_DEFAULT       LOG_LVL_INFO           /**< 모듈별 실행 레벨 초기값 */
+/** \} Dlog_Exported_Constants */
+
+/* Exported types ------------------------------------------------------------*/
+/** \brief 출력 모드 */
+typedef enum
+{
+  kDLOG_BIN = 0,                                       /**< binary frame 송신 */
+  kDLOG_TEXT,                                          /**< cprintf() 글자 출력 */
+  kDLOG_OFF,                                           /**< ring에 모아 둠 */
+  kNbrOfDlogModes
+}DlogMode_t;
+
+/** \brief 로그 모듈 */
+typedef enum
+{
+  kLOG_DEOD = 0,
+  kLOG_RS485,
+  kLOG_SYSMON,
+  kLOG_STL,
+  kLOG_CONSOLE,
+  kNbrOfLogMods
+}LogMod_t;
+
+/** \brief 지연 로그 통계 */
+typedef struct
+{
+u32_t   records;                                       /**< ring에 넣은 record 수 */
+u32_t   drops;                                         /**< ring이 차서 버린 record 수 */
+u32_t   frames;                                        /**< 보낸 frame 수 */
+u32_t   bytes;                                         /**< 보낸 frame byte 수 */
+u32_t   peak;                                          /**< ring 최대 사용량(word) */
+u32_t   used;                                          /**< ring 현재 사용량(word) */
+DlogMode_t mode;
+}DlogStat_t;
+
+/* Exported macro ------------------------------------------------------------*/
+/** \defgroup Dlog_Exported_Macro 지연 로그 호출 매크로
+  * \brief  fmt는 문자열 상수여야 하며 인자는 u32로 바뀌어 저장된다.
+  * \{ */
+#define DLOG0(fmt)                  Dlog_Write((fmt), 0U, 0U, 0U, 0U, 0U)
+#define DLOG1(fmt, a)               Dlog_Write((fmt), 1U, (u32_t)(a), 0U, 0U, 0U)
+#define DLOG2(fmt, a, b)            Dlog_Write((fmt), 2U, (u32_t)(a), (u32_t)(b), 0U, 0U)
+#define DLOG3(fmt, a, b, c)         Dlog_Write((fmt), 3U, (u32_t)(a), (u32_t)(b), (u32_t)(c), 0U)
+#define DLOG4(fmt, a, b, c, d)      Dlog_Write((fmt), 4U, (u32_t)(a), (u32_t)(b), (u32_t)(c), (u32_t)(d))
+
+/* LOG_IF_<레벨>(x) : LOG_LEVEL_BUILD 이하 레벨만 x를 남긴다 */
+#if (LOG_LEVEL_BUILD >= LOG_LVL_ERROR)
+#define LOG_IF_ERROR(x)             x
+#else
+#define LOG_IF_ERROR(x)
+#endif
+#if (LOG_LEVEL_BUILD >= LOG_LVL_WARN)
+#define LOG_IF_WARN(x)              x
+#else
+#define LOG_IF_WARN(x)
+#endif
+#if (LOG_LEVEL_BUILD >= LOG_LVL_INFO)
+#define LOG_IF_INFO(x)              x
+#else
+#define LOG_IF_INFO(x)
+#endif
+#if (LOG_LEVEL_BUILD >= LOG_LVL_DEBUG)
+#define LOG_IF_DEBUG(x)             x
+#else
+#define LOG_IF_DEBUG(x)
+#endif
+#if (LOG_LEVEL_BUILD >= LOG_LVL_TRACE)
+#define LOG_IF_TRACE(x)             x
+#else
+#define LOG_IF_TRACE(x)
+#endif
+
+/* lvl : ERROR/WARN/INFO/DEBUG/TRACE, mod : DEOD/RS485/SYSMON/STL/CONSOLE */
+#define LOG_ON(lvl, mod)            (g_dlog_level[kLOG_##mod] >= LOG_LVL_##lvl)
+#define LOG0(lvl, mod, fmt)                 LOG_IF_##lvl(do { if (LOG_ON(lvl, mod)) { DLOG0(fmt); } } while (0))
+#define LOG1(lvl, mod, fmt, a)              LOG_IF_##lvl(do { if (LOG_ON(lvl, mod)) { DLOG1(fmt, a); } } while (0))
+#define LOG2(lvl, mod, fmt, a, b)           LOG_IF_##lvl(do { if (LOG_ON(lvl, mod)) { DLOG2(fmt, a, b); } } while (0))
+#define LOG3(lvl, mod, fmt, a, b, c)        LOG_IF_##lvl(do { if (LOG_ON(lvl, mod)) { DLOG3(fmt, a, b, c); } } while (0))
+#define LOG4(lvl, mod, fmt, a, b, c, d)     LOG_IF_##lvl(do { if (LOG_ON(lvl, mod)) { DLOG4(fmt, a, b, c, d); } } while (0))
+/** \} Dlog_Exported_Macro */
+
+/* Exported variables --------------------------------------------------------*/
+extern u08_t g_dlog_level[kNbrOfLogMods];              /**< 모듈별 실행 레벨(LOG_LVL_x) */
+
+/* Exported functions --------------------------------------------------------*/
+/** \defgroup Dlog_Exported_Functions 지연 로그 공개 함수
+  * \{ */
+extern void   Dlog_Init(void);
+extern void   Dlog_Write(const char_t fmt[], u32_t argc, u32_t a0, u32_t a1, u32_t a2, u32_t a3);
+extern void   Dlog_Thread(void);
+extern Bool_t Dlog_Set_Mode(DlogMode_t mode);
+extern void   Dlog_Get_Stat(DlogStat_t * stat);
+extern void   Dlog_Clear_Stat(void);
+extern Bool_t Dlog_Set_Level(LogMod_t mod, u08_t level);
+/** \} Dlog_Exported_Functions */
+
+/** \} Dlog */
+
+/** \} Applications */
+
+#endif /* __DLOG_H */
+
+/*************** (C) COPYRIGHT SHALOM ENGINEERING CO., LTD. ****END OF FILE****/
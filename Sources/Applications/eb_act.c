@@ -0,0 +1,224 @@
+/** ****************************************************************************
+  * \file    eb_act.c
+  * \author  Jang Ho Jong
+  * \version V0.0.1
+  * \date    2026.10.17
+  * \brief   EB Relay Actuation Body
+  * ***************************************************************************/
+
+/* Includes ------------------------------------------------------------------*/
+#include "eb_act.h"
+#include "device.h"
+
+/** \addtogroup Applications
+  * \{ */
+
+/** \defgroup Eb_Act EB 릴레이 동작
+  * \brief EB1/EB2 명령, Feedback 대기, 확인, latch를 loop를 막지 않고 수행합니다.
+  * \{ */
+
+/* Private typedef -----------------------------------------------------------*/
+/* Private define ------------------------------------------------------------*/
+/* Private macro -------------------------------------------------------------*/
+/* Private variables ---------------------------------------------------------*/
+/** \defgroup Eb_Act_Private_Variables EB 동작 비공개 변수
+  * \{ */
+static EbInfo_t  eb_info;
+static u32_t     eb_cmd_usec;                          /* EB1/EB2 ON 명령 시각 */
+static Bool_t    eb_fb_lost;                           /* LATCHED 중 Feedback 소실 진행 중 */
+static u32_t     eb_fb_lost_usec;                      /* Feedback 소실 시작 시각 */
+
+static const char_t * const eb_state_name[kNbrOfEbStates] =
+{
+  "IDLE", "WAIT_FB", "LATCHED", "FAILED"
+};
+static const char_t * const eb_cause_name[kNbrOfEbCauses] =
+{
+  "NONE", "DETECT", "FAULT", "DEPC"
+};
+/** \} Eb_Act_Private_Variables */
+
+/* Private function prototypes -----------------------------------------------*/
+/** \defgroup Eb_Act_Private_Functions EB 동작 비공개 함수
+  * \{ */
+static Bool_t Eb_Act_Feedback(void);
+static void   Eb_Act_Fail(void);
+/** \} Eb_Act_Private_Functions */
+
+/* Exported functions --------------------------------------------------------*/
+/** \addtogroup Eb_Act_Exported_Functions
+  * \{ */
+
+/** \brief  EB 동작 상태를 IDLE로 초기화한다.
+  * \note   main()에서 자기진단 전에 한번 호출한다(자기진단 고장도 EB를 요청할 수 있음).
+  * \retval 없음
+  */
+void Eb_Act_Init(void)
+{
+  eb_info.state     = kEB_IDLE;
+  eb_info.cause     = kEB_CAUSE_NONE;
+  eb_info.name      = "";
+  eb_info.trip_tick = 0U;
+  eb_info.fb_usec   = 0U;
+  eb_info.fb_loss   = 0U;
+  eb_fb_lost        = False;
+}
+
+/** \brief  EB1/EB2 ON 명령을 내리고 Feedback 대기 상태로 들어간다.
+  * \param  cause - 동작 원인
+  * \param  name  - 감지 위치(센서 이름), 콘솔 표시용
+  * \note   이미 동작 중이면 첫 원인을 유지하고 False를 돌려준다.
+  *         Feedback 확인은 Eb_Act_Process()에서 이어서 한다.
+  * \retval True - 이번 호출로 EB 동작 시작
+  */
+Bool_t Eb_Act_Trip(EbCause_t cause, const char_t * name)
+{
+  if (eb_info.state != kEB_IDLE)
+  {
+    return False;
+  }
+  Led_On(e_eb_led);
+  Relay_On(eb1_out);
+  Relay_On(eb2_out);
+  eb_cmd_usec       = Device_Usec_Now();
+  eb_info.trip_tick = HAL_GetTick();
+  eb_info.cause     = cause;
+  eb_info.name      = name;
+  eb_info.state     = kEB_WAIT_FB;
+  Latency_Mark(kLAT_RELAY_CMD);
+  return True;
+}
+
+/** \brief  EB 동작 상태 머신을 한 단계 진행한다.
+  * \note   main loop(Deod_Thread)에서 매번 호출한다. 대기하지 않는다.
+  * \retval 없음
+  */
+void Eb_Act_Process(void)
+{
+  LatStat_t lat;
+  Bool_t    fb;
+  u32_t     now;
+
+  if (eb_info.state == kEB_IDLE)
+  {
+    return;
+  }
+  /* 안전 상태에서는 EB1/EB2 ON을 계속 유지한다. */
+  Relay_On(eb1_out);
+  Relay_On(eb2_out);
+
+  fb  = Eb_Act_Feedback();
+  now = Device_Usec_Now();
+  switch (eb_info.state)
+  {
+  case kEB_WAIT_FB :
+    if (fb == True)
+    {
+      eb_info.fb_usec = now - eb_cmd_usec;
+      eb_info.state   = kEB_LATCHED;
+      Latency_Mark(kLAT_RELAY_FB);
+      Latency_Get_Stat(kLAT_RELAY_FB, &lat);
+      DLOG1("Detect Latency = %d usec\n", lat.last);                /** 감지 ~ EB 릴레이 Feedback */
+    }
+    else if ((now - eb_cmd_usec) >= EB_FB_TIMEOUT_usec)
+    {
+      Eb_Act_Fail();
+    }
+    break;
+
+  case kEB_LATCHED :
+    if (fb == True)
+    {
+      eb_fb_lost = False;
+    }
+    else if (eb_fb_lost == False)
+    {
+      eb_fb_lost      = True;
+      eb_fb_lost_usec = now;
+      eb_info.fb_loss++;
+    }
+    else if ((now - eb_fb_lost_usec) >= EB_FB_LOSS_usec)
+    {
+      Eb_Act_Fail();
+    }
+    break;
+
+  default :
+    break;
+  }
+}
+
+/** \brief  현재 EB 동작 상태를 읽는다.
+  * \retval EB 동작 상태
+  */
+EbState_t Eb_Act_State(void)
+{
+  return eb_info.state;
+}
+
+/** \brief  EB 동작이 시작되었는지(IDLE이 아닌지) 확인한다.
+  * \retval True - WAIT_FB, LATCHED, FAILED
+  */
+Bool_t Eb_Act_Is_Tripped(void)
+{
+  return (eb_info.state != kEB_IDLE) ? True : False;
+}
+
+/** \brief  EB 동작 이력을 복사한다.
+  * \param  info - 복사할 구조체 포인터
+  * \retval 없음
+  */
+void Eb_Act_Get_Info(EbInfo_t * info)
+{
+  *info = eb_info;
+}
+
+/** \brief  EB 동작 상태 이름을 돌려준다.
+  * \retval 상태 이름 문자열
+  */
+const char_t * Eb_Act_State_Name(EbState_t state)
+{
+  return (state < kNbrOfEbStates) ? eb_state_name[state] : "?";
+}
+
+/** \brief  EB 동작 원인 이름을 돌려준다.
+  * \retval 원인 이름 문자열
+  */
+const char_t * Eb_Act_Cause_Name(EbCause_t cause)
+{
+  return (cause < kNbrOfEbCauses) ? eb_cause_name[cause] : "?";
+}
+/** \} Eb_Act_Exported_Functions */
+
+/* Private functions ---------------------------------------------------------*/
+/** \addtogroup Eb_Act_Private_Functions
+  * \{ */
+
+/** \brief  EB1/EB2 Feedback을 같은 시점에 읽는다.
+  * \retval True - EB1/EB2 Feedback 모두 ON
+  */
+static Bool_t Eb_Act_Feedback(void)
+{
+  InSnap_t snap;
+
+  Device_Input_Snapshot(&snap);
+  return ((IN_SNAP_BIT(snap.fb, kRYFBI_EB1) == True) && (IN_SNAP_BIT(snap.fb, kRYFBI_EB2) == True)) ? True : False;
+}
+
+/** \brief  EB 릴레이 Feedback 이상 : 고장을 등록하고 FAILED로 latch 한다.
+  * \note   HLT OFF, Watchdog Lock은 Fault_Process()가 적용한다.
+  * \retval 없음
+  */
+static void Eb_Act_Fail(void)
+{
+  Fault_Raise(kFLT_EB_FB, (u32_t)eb_info.state);
+  eb_info.state = kEB_FAILED;
+  DLOG0("Relay abnormal action then Health Relay On\n\n");
+}
+/** \} Eb_Act_Private_Functions */
+
+/** \} Eb_Act */
+
+/** \} Applications */
+
+/*************** (C) COPYRIGHT SHALOM ENGINEERING CO., LTD. ****END OF FILE****/
@@ -0,0 +1,104 @@
+/** ****************************************************************************
+  * \file    eb_act.h
+  * \author  Jang Ho Jong
+  * \version V0.0.1
+  * \date    2026.10.17
+  * \brief   EB Relay Actuation Header
+  * ***************************************************************************/
+/*
+  - EB1/EB2 릴레이 동작 상태 머신
+
+  - 개념:
+    감지(장애물/탈선) 또는 EB 심각도 고장(Fault_Process)이 발생하면 EB 릴레이를 켜고
+    Feedback을 기다린 뒤 안전 상태로 latch 한다.
+    기존의 HAL_Delay() 대기와 while(1) 정지를 대신하므로 latch 이후에도
+    Sysmon(Watchdog, 온도, 전원), Console, RS-485 보고가 계속 동작한다.
+
+  - 동작:
+    IDLE    : 대기. Eb_Act_Trip() 으로 EB1/EB2 ON 명령 후 WAIT_FB로 간다.
+    WAIT_FB : 매 loop Feedback snapshot을 확인한다. EB1/EB2 Feedback이 모두 ON이면 LATCHED,
+              EB_FB_TIMEOUT_usec 안에 확인되지 않으면 FAILED.
+    LATCHED : EB1/EB2 ON을 계속 유지한다. Feedback이 EB_FB_LOSS_usec 이상 사라지면 FAILED.
+    FAILED  : kFLT_EB_FB 고장 등록(HLT OFF, Watchdog Lock). EB1/EB2 ON 명령은 계속 유지한다.
+    LATCHED/FAILED는 전원 재투입(리셋) 전까지 해제되지 않는다.
+
+  - 모니터링:
+    콘솔 "EBACT" 명령어로 상태, 원인, Feedback 확인 시간을 표시한다.
+
+  - Eb_Act 접두어를 사용한다.
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef __EB_ACT_H
+#define __EB_ACT_H
+
+/* Includes ------------------------------------------------------------------*/
+#include "main.h"
+
+/** \addtogroup Applications
+  * \{ */
+
+/** \addtogroup Eb_Act
+  * \{ */
+
+/* Exported types ------------------------------------------------------------*/
+/** \brief EB 동작 상태 */
+typedef enum
+{
+  kEB_IDLE = 0,
+  kEB_WAIT_FB,
+  kEB_LATCHED,
+  kEB_FAILED,
+  kNbrOfEbStates
+}EbState_t;
+
+/** \brief EB 동작 원인 */
+typedef enum
+{
+  kEB_CAUSE_NONE = 0,
+  kEB_CAUSE_DETECT,                                    /**< 장애물/탈선 감지 */
+  kEB_CAUSE_FAULT,                                     /**< 고장 관리(Fault_Process) 요청 */
+  kEB_CAUSE_DEPC,                                      /**< RS-485로 받은 DEPC 탈선 */
+  kNbrOfEbCauses
+}EbCause_t;
+
+/** \brief EB 동작 이력(사후 진단용) */
+typedef struct
+{
+EbState_t     state;
+EbCause_t     cause;
+const char_t *name;                                    /**< 감지 위치(센서 이름) */
+u32_t         trip_tick;                               /**< Trip 시각(HAL tick, msec) */
+u32_t         fb_usec;                                 /**< 명령 ~ Feedback 확인 시간(usec) */
+u32_t         fb_loss;                                 /**< LATCHED 중 Feedback이 사라진 횟수 */
+}EbInfo_t;
+
+/* Exported constants --------------------------------------------------------*/
+/** \defgroup Eb_Act_Exported_Constants EB 동작 공개 상수
+  * \{ */
+#define EB_FB_TIMEOUT_usec         10000U              /**< 명령 후 Feedback 확인 제한 시간 */
+#define EB_FB_LOSS_usec            50000U              /**< LATCHED 중 Feedback 소실 허용 시간 */
+/** \} Eb_Act_Exported_Constants */
+
+/* Exported macro ------------------------------------------------------------*/
+/* Exported variables --------------------------------------------------------*/
+/* Exported functions --------------------------------------------------------*/
+/** \defgroup Eb_Act_Exported_Functions EB 동작 공개 함수
+  * \{ */
+extern void           Eb_Act_Init(void);
+extern Bool_t         Eb_Act_Trip(EbCause_t cause, const char_t * name);
+extern void           Eb_Act_Process(void);
+extern EbState_t      Eb_Act_State(void);
+extern Bool_t         Eb_Act_Is_Tripped(void);
+extern void           Eb_Act_Get_Info(EbInfo_t * info);
+extern const char_t * Eb_Act_State_Name(EbState_t state);
+extern const char_t * Eb_Act_Cause_Name(EbCause_t cause);
+/** \} Eb_Act_Exported_Functions */
+
+/** \} Eb_Act */
+
+/** \} Applications */
+
+#endif /* __EB_ACT_H */
+
+/*************** (C) COPYRIGHT SHALOM ENGINEERING CO., LTD. ****END OF FILE****/
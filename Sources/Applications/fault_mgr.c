@@ -0,0 +1,410 @@
+/** ****************************************************************************
+  * \file    fault_mgr.c
+  * \author  Jang Ho Jong
+  * \version V0.0.1
+  * \date    2026.10.17
+  * \brief   Fault Manager Body
+  * ***************************************************************************/
+
+/* Includes ------------------------------------------------------------------*/
+#include "fault_mgr.h"
+#include "device.h"
+
+/** \addtogroup Applications
+  * \{ */
+
+/** \defgroup Fault_Mgr 고장 관리
+  * \brief 고장 코드를 latch 하고 심각도에 따른 출력을 main loop 한 곳에서 결정합니다.
+  * \{ */
+
+/* Private typedef -----------------------------------------------------------*/
+/** \brief 고장 코드 테이블 항목 */
+typedef struct
+{
+const char_t * name;
+FaultSev_t     sev;
+}FaultDef_t;
+
+/** \brief 반복 고장 보고 슬롯 */
+typedef struct
+{
+const char_t * tag;                                    /**< NULL이면 빈 슬롯 */
+const char_t * name;
+u32_t          hits;                                   /**< 이번 보고 간격의 반복 수 */
+u32_t          total;                                  /**< 처음 발생부터의 횟수 */
+u32_t          last_tick;                              /**< 마지막 발생 시각(HAL tick) */
+}FaultRpt_t;
+
+/* Private define ------------------------------------------------------------*/
+#define FLT_ACT_HLT             0x01U                  /* HLT Relay/LED OFF */
+#define FLT_ACT_EB              0x02U                  /* EB1/EB2 ON 안전 상태 */
+#define FLT_ACT_LOCK            0x04U                  /* Watchdog strobe 정지 */
+
+/* Private macro -------------------------------------------------------------*/
+/* Private variables ---------------------------------------------------------*/
+/** \defgroup Fault_Mgr_Private_Variables 고장 관리 비공개 변수
+  * \{ */
+/** 고장 코드별 이름, 심각도(FaultCode_t 순서) */
+static const FaultDef_t flt_def[kNbrOfFaults] =
+{
+  { "STL",         kFLT_SEV_LOCK },
+  { "SENSOR_VOLT", kFLT_SEV_HLT  },
+  { "ADC_STALL",   kFLT_SEV_HLT  },
+  { "SENSOR_BOTH", kFLT_SEV_EB   },
+  { "EB_FB",       kFLT_SEV_LOCK },
+  { "TEMP_MAJ",    kFLT_SEV_INFO },
+  { "TEMP_MIN",    kFLT_SEV_INFO },
+  { "POWER",       kFLT_SEV_HLT  },
+  { "ISOL",        kFLT_SEV_HLT  },
+  { "WATCHDOG",    kFLT_SEV_LOCK },
+  { "SELF_SENSOR", kFLT_SEV_HLT  },
+  { "SELF_OSSD",   kFLT_SEV_HLT  },
+  { "SELF_RELAY",  kFLT_SEV_HLT  },
+  { "COM_TIMEOUT", kFLT_SEV_HLT  },
+  { "DEPC_FAIL",   kFLT_SEV_LOCK },
+  { "DEPC_WARN",   kFLT_SEV_INFO },
+};
+/** 심각도별 출력 동작 */
+static const u08_t flt_act[kNbrOfFltSevs] =
+{
+  0U, FLT_ACT_HLT, (FLT_ACT_HLT | FLT_ACT_EB), (FLT_ACT_HLT | FLT_ACT_LOCK)
+};
+static const char_t * const flt_sev_name[kNbrOfFltSevs] =
+{
+  "INFO", "HLT", "EB", "LOCK"
+};
+
+static FaultInfo_t  flt_info;
+static FaultStat_t  flt_stat[kNbrOfFaults];
+static u32_t        flt_pending;                       /* Fault_Process()에 아직 반영 안된 고장 bit */
+static u32_t        flt_pend_usec;                     /* 가장 오래된 미반영 등록 시각 */
+static FaultRpt_t   flt_rpt[FAULT_RPT_SLOTS];
+static FaultRptInfo_t flt_rpt_info;
+static u32_t        flt_rpt_tick;                      /* 마지막 보고 시각 */
+/** \} Fault_Mgr_Private_Variables */
+
+/* Private function prototypes -----------------------------------------------*/
+/* Exported functions --------------------------------------------------------*/
+/** \addtogroup Fault_Mgr_Exported_Functions
+  * \{ */
+
+/** \brief  고장 latch와 기록을 모두 지운다.
+  * \note   main()에서 자기진단 전에 한번 호출한다.
+  * \retval 없음
+  */
+void Fault_Init(void)
+{
+  u08_t i;
+
+  flt_info.latched     = 0U;
+  flt_info.level       = kFLT_SEV_INFO;
+  flt_info.first_valid = False;
+  flt_info.react_last  = 0U;
+  flt_info.react_max   = 0U;
+  flt_pending          = 0U;
+  for (i = 0U; i < kNbrOfFaults; i++)
+  {
+    flt_stat[i].count      = 0U;
+    flt_stat[i].first_tick = 0U;
+    flt_stat[i].detail     = 0U;
+  }
+  for (i = 0U; i < FAULT_RPT_SLOTS; i++)
+  {
+    flt_rpt[i].tag = NULL;
+  }
+  flt_rpt_info.interval   = FAULT_RPT_msec;
+  flt_rpt_info.active     = 0U;
+  flt_rpt_info.suppressed = 0U;
+  flt_rpt_info.overflow   = 0U;
+  flt_rpt_tick            = HAL_GetTick();
+}
+
+/** \brief  고장을 등록(latch)한다.
+  * \param  code   - 고장 코드
+  * \param  detail - 상세 코드(채널 번호 등), 콘솔 표시용
+  * \note   처음 latch될 때 심각도가 HLT 이상이면 바로 HLT를 끈다(어느 쓰레드에서 불러도 같은 반응 시간).
+  *         EB, Watchdog Lock은 다음 Fault_Process()에서 반영된다.
+  * \retval 없음
+  */
+void Fault_Raise(FaultCode_t code, u32_t detail)
+{
+  u32_t bit;
+
+  if (code >= kNbrOfFaults)
+  {
+    return;
+  }
+  bit = (1UL << code);
+  if (flt_stat[code].count == 0U)
+  {
+    flt_stat[code].first_tick = HAL_GetTick();
+  }
+  flt_stat[code].count++;
+  flt_stat[code].detail = detail;
+
+  if ((flt_info.latched & bit) == 0U)
+  {
+    if (flt_pending == 0U)
+    {
+      flt_pend_usec = Device_Usec_Now();
+    }
+    flt_pending      |= bit;
+    flt_info.latched |= bit;
+    if ((flt_act[flt_def[code].sev] & FLT_ACT_HLT) != 0U)
+    {
+      Relay_Off(hlt_out);                                             /** HLT Signal OFF : Fault_Process()를 기다리지 않음 */
+      Led_Off(hlt_led);
+    }
+    if (flt_info.first_valid == False)
+    {
+      flt_info.first_valid  = True;
+      flt_info.first        = code;
+      flt_info.first_detail = detail;
+      flt_info.first_tick   = flt_stat[code].first_tick;
+    }
+  }
+}
+
+/** \brief  latch된 고장의 심각도를 모아 출력(HLT, EB, Watchdog)을 한번에 결정한다.
+  * \note   main loop 시작마다 한번, 그리고 main loop 전 자기진단 끝에서 호출한다.
+  *         latch된 출력은 매번 다시 적용하므로 다른 곳에서 HLT를 켜도 다음 loop에 다시 꺼진다.
+  * \retval 없음
+  */
+void Fault_Process(void)
+{
+  u08_t       act;
+  u08_t       i;
+  FaultSev_t  level;
+  u32_t       now;
+
+  if (flt_info.latched == 0U)
+  {
+    return;
+  }
+  act   = 0U;
+  level = kFLT_SEV_INFO;
+  for (i = 0U; i < kNbrOfFaults; i++)
+  {
+    if ((flt_info.latched & (1UL << i)) != 0U)
+    {
+      act |= flt_act[flt_def[i].sev];
+      if (flt_def[i].sev > level)
+      {
+        level = flt_def[i].sev;
+      }
+    }
+  }
+  if ((act & FLT_ACT_HLT) != 0U)
+  {
+    Relay_Off(hlt_out);                                               /** HLT Signal OFF */
+    Led_Off(hlt_led);
+  }
+  if ((act & FLT_ACT_EB) != 0U)
+  {
+    (void)Eb_Act_Trip(kEB_CAUSE_FAULT, Fault_Name(flt_info.first));
+  }
+  if ((act & FLT_ACT_LOCK) != 0U)
+  {
+    Watchdog_Lock(wdog);
+  }
+  flt_info.level = level;
+
+  if (flt_pending != 0U)
+  {
+    now = Device_Usec_Now();
+    flt_info.react_last = now - flt_pend_usec;
+    if (flt_info.react_last > flt_info.react_max)
+    {
+      flt_info.react_max = flt_info.react_last;
+    }
+    flt_pending = 0U;
+  }
+}
+
+/** \brief  고장이 latch 되었는지 확인한다.
+  * \retval True - latch 됨
+  */
+Bool_t Fault_Is_Latched(FaultCode_t code)
+{
+  if (code >= kNbrOfFaults)
+  {
+    return False;
+  }
+  return ((flt_info.latched & (1UL << code)) != 0U) ? True : False;
+}
+
+/** \brief  고장 관리 상태를 복사한다.
+  * \retval 없음
+  */
+void Fault_Get_Info(FaultInfo_t * info)
+{
+  *info = flt_info;
+}
+
+/** \brief  고장별 기록을 복사한다.
+  * \retval 없음
+  */
+void Fault_Get_Stat(FaultCode_t code, FaultStat_t * stat)
+{
+  if (code < kNbrOfFaults)
+  {
+    *stat = flt_stat[code];
+  }
+}
+
+/** \brief  고장 코드의 심각도를 돌려준다.
+  * \retval 심각도
+  */
+FaultSev_t Fault_Severity(FaultCode_t code)
+{
+  return (code < kNbrOfFaults) ? flt_def[code].sev : kFLT_SEV_INFO;
+}
+
+/** \brief  고장 코드 이름을 돌려준다.
+  * \retval 이름 문자열
+  */
+const char_t * Fault_Name(FaultCode_t code)
+{
+  return (code < kNbrOfFaults) ? flt_def[code].name : "?";
+}
+
+/** \brief  심각도 이름을 돌려준다.
+  * \retval 이름 문자열
+  */
+const char_t * Fault_Sev_Name(FaultSev_t sev)
+{
+  return (sev < kNbrOfFltSevs) ? flt_sev_name[sev] : "?";
+}
+
+/** \brief  고장별 발생 횟수와 반응 시간 기록을 지운다.
+  * \note   latch와 최초 고장은 지우지 않는다(리셋으로만 해제).
+  * \retval 없음
+  */
+void Fault_Clear_Stat(void)
+{
+  u08_t i;
+
+  for (i = 0U; i < kNbrOfFaults; i++)
+  {
+    flt_stat[i].count = 0U;
+  }
+  flt_info.react_last = 0U;
+  flt_info.react_max  = 0U;
+}
+
+/** \brief  반복되는 고장 메시지의 발생을 알리고 지금 출력할지 돌려준다.
+  * \param  tag  - 메시지 구분(예: "F_002 LOW"), 상수 문자열
+  * \param  name - 채널/보드 이름(예: LED 이름), 상수 문자열
+  * \note   처음 발생(또는 cleared 후 다시 발생)이면 True를 돌려주고 호출 위치가 전체 메시지를 출력한다.
+  *         반복이면 세기만 하고 False를 돌려주며, 묶음 출력은 Fault_Report_Process()가 한다.
+  *         슬롯이 모자라면 출력하지 않고 overflow를 센다.
+  * \retval True - 지금 메시지를 출력
+  */
+Bool_t Fault_Report(const char_t tag[], const char_t name[])
+{
+  FaultRpt_t * free_slot = NULL;
+  u08_t        i;
+
+  for (i = 0U; i < FAULT_RPT_SLOTS; i++)
+  {
+    if ((flt_rpt[i].tag == tag) && (flt_rpt[i].name == name))
+    {
+      flt_rpt[i].hits++;
+      flt_rpt[i].total++;
+      flt_rpt[i].last_tick = HAL_GetTick();
+      return False;
+    }
+    if ((flt_rpt[i].tag == NULL) && (free_slot == NULL))
+    {
+      free_slot = &flt_rpt[i];
+    }
+  }
+  if (free_slot == NULL)
+  {
+    flt_rpt_info.overflow++;
+    return False;
+  }
+  free_slot->tag       = tag;
+  free_slot->name      = name;
+  free_slot->hits      = 0U;
+  free_slot->total     = 1U;
+  free_slot->last_tick = HAL_GetTick();
+  flt_rpt_info.active++;
+  return True;
+}
+
+/** \brief  보고 간격마다 반복 고장을 묶어 출력하고 멈춘 고장을 cleared로 출력한다.
+  * \note   main loop에서 Fault_Process() 다음에 호출한다. 출력은 간격당 슬롯마다 한 줄이다.
+  * \retval 없음
+  */
+void Fault_Report_Process(void)
+{
+  FaultRpt_t * r;
+  u32_t        now = HAL_GetTick();
+  u32_t        idle;
+  u08_t        i;
+
+  if ((now - flt_rpt_tick) < flt_rpt_info.interval)
+  {
+    return;
+  }
+  flt_rpt_tick = now;
+  idle = flt_rpt_info.interval * FAULT_RPT_IDLE;
+  if (idle < FAULT_RPT_IDLE_msec)
+  {
+    idle = FAULT_RPT_IDLE_msec;
+  }
+  for (i = 0U; i < FAULT_RPT_SLOTS; i++)
+  {
+    r = &flt_rpt[i];
+    if (r->tag == NULL)
+    {
+      continue;
+    }
+    if (r->hits != 0U)
+    {
+      DLOG4("%s %s x%d in last %d sec\n", r->tag, r->name, r->hits, flt_rpt_info.interval / 1000U);
+      flt_rpt_info.suppressed += r->hits;
+      r->hits = 0U;
+    }
+    else if ((now - r->last_tick) >= idle)
+    {
+      DLOG3("%s %s cleared, x%d total\n", r->tag, r->name, r->total);
+      r->tag = NULL;
+      flt_rpt_info.active--;
+    }
+    else
+    {
+      /* 간격 안에 처음 발생만 있었음 */
+    }
+  }
+}
+
+/** \brief  반복 고장 보고 간격을 바꾼다.
+  * \param  msec - FAULT_RPT_MIN_msec ~ FAULT_RPT_MAX_msec
+  * \retval 범위를 벗어나면 False
+  */
+Bool_t Fault_Report_Set_Interval(u32_t msec)
+{
+  if ((msec < FAULT_RPT_MIN_msec) || (msec > FAULT_RPT_MAX_msec))
+  {
+    return False;
+  }
+  flt_rpt_info.interval = msec;
+  return True;
+}
+
+/** \brief  반복 고장 보고 상태를 복사한다.
+  * \retval 없음
+  */
+void Fault_Report_Get_Info(FaultRptInfo_t * info)
+{
+  *info = flt_rpt_info;
+}
+/** \} Fault_Mgr_Exported_Functions */
+
+/** \} Fault_Mgr */
+
+/** \} Applications */
+
+/*************** (C) COPYRIGHT SHALOM ENGINEERING CO., LTD. ****END OF FILE****/
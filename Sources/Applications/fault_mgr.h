@@ -0,0 +1,154 @@
+/** ****************************************************************************
+  * \file    fault_mgr.h
+  * \author  Jang Ho Jong
+  * \version V0.0.1
+  * \date    2026.10.17
+  * \brief   Fault Manager Header
+  * ***************************************************************************/
+/*
+  - 고장(Fault) 관리 모듈
+
+  - 개념:
+    각 모듈은 고장을 발견하면 Fault_Raise()로 고장 코드를 등록한다.
+    심각도가 HLT 이상인 고장은 Fault_Raise() 안에서 바로 HLT Relay/LED를 끈다.
+    따라서 고장 발생 ~ HLT OFF 시간은 어느 모듈(쓰레드)에서 발생하든 Fault_Raise() 호출 시간
+    (GPIO 쓰기 2번, 수 usec)으로 같으며 main loop 위치나 다른 쓰레드의 대기 시간과 관계없다.
+    EB, Watchdog Lock은 main loop에서 한번 호출되는 Fault_Process()가 latch된 모든 고장의
+    심각도를 모아 결정하므로 main loop 한 바퀴 이내(Sysmon_Thread 점검 대기 포함 최악 약 100msec)에
+    반영된다. 이때 HLT OFF도 다시 적용한다.
+
+  - 심각도:
+    INFO : 기록만 한다.
+    HLT  : HLT Relay/LED OFF.
+    EB   : HLT OFF + EB1/EB2 ON 안전 상태(Eb_Act).
+    LOCK : HLT OFF + Watchdog strobe 정지.
+    고장은 리셋 전까지 latch 되며 해제되지 않는다.
+
+  - 보고:
+    매 주기 반복되는 고장 메시지는 Fault_Report(tag, name)가 True일 때만(처음 발생) 출력한다.
+    이후 반복은 세기만 하고, Fault_Report_Process()가 보고 간격마다 "F_002 LOW OBR x347 in last 5 sec"
+    처럼 묶어서 한 줄로, FAULT_RPT_IDLE 간격(최소 FAULT_RPT_IDLE_msec) 동안 반복이 없으면
+    "cleared"로 한번 출력한다. 최소값은 가장 느린 점검(온도, TEMPERATOR_CHECK_TIME 60sec)의
+    2배보다 길게 두어 주기 점검 고장이 매번 처음 발생으로 다시 출력되지 않게 한다.
+    tag, name은 상수 문자열(DLOG 인자)이어야 하며 (tag, name) 주소 쌍이 보고 단위가 된다.
+    호출 위치의 비용은 슬롯 검색(FAULT_RPT_SLOTS)으로 고장 지속 시간과 관계없이 일정하다.
+
+  - 모니터링:
+    콘솔 "FAULT" 명령어로 최초 고장, 고장별 발생 횟수, 반응 시간(등록 ~ 출력 반영)을 표시한다.
+    "FAULT RPT sec"로 보고 간격을 바꾼다.
+
+  - Fault 접두어를 사용한다.
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef __FAULT_MGR_H
+#define __FAULT_MGR_H
+
+/* Includes ------------------------------------------------------------------*/
+#include "main.h"
+
+/** \addtogroup Applications
+  * \{ */
+
+/** \addtogroup Fault_Mgr
+  * \{ */
+
+/* Exported types ------------------------------------------------------------*/
+/** \brief 고장 심각도(값이 클수록 우선) */
+typedef enum
+{
+  kFLT_SEV_INFO = 0,
+  kFLT_SEV_HLT,
+  kFLT_SEV_EB,
+  kFLT_SEV_LOCK,
+  kNbrOfFltSevs
+}FaultSev_t;
+
+/** \brief 고장 코드 */
+typedef enum
+{
+  kFLT_STL = 0,                                        /**< F_001 CPU 자기진단 */
+  kFLT_SENSOR_VOLT,                                    /**< F_002 센서 전압 Low/High */
+  kFLT_ADC_STALL,                                      /**< F_010 ADC scan 정지(프레임 없음/갱신 멈춤) */
+  kFLT_SENSOR_BOTH,                                    /**< F_003 좌/우 센서 동시 불량 */
+  kFLT_EB_FB,                                          /**< EB 릴레이 Feedback 이상 */
+  kFLT_TEMP_MAJ,                                       /**< F_004 온도 Major */
+  kFLT_TEMP_MIN,                                       /**< F_005 온도 Minor */
+  kFLT_POWER,                                          /**< F_006 입력 전원 */
+  kFLT_ISOL,                                           /**< F_007 Output Isolator FLT */
+  kFLT_WATCHDOG,                                       /**< F_008 WDT_OK */
+  kFLT_SELF_SENSOR,                                    /**< 자기진단 센서 전압 */
+  kFLT_SELF_OSSD,                                      /**< 자기진단 OSSD Logic */
+  kFLT_SELF_RELAY,                                     /**< 자기진단 Relay Feedback */
+  kFLT_COM_TIMEOUT,                                    /**< RS-485 수신 없음 */
+  kFLT_DEPC_FAIL,                                      /**< DEPC Board 고장 통보 */
+  kFLT_DEPC_WARN,                                      /**< DEPC Board 경고 통보 */
+  kNbrOfFaults
+}FaultCode_t;
+
+/** \brief 고장별 기록 */
+typedef struct
+{
+u32_t   count;                                         /**< 등록 횟수 */
+u32_t   first_tick;                                    /**< 최초 등록 시각(HAL tick) */
+u32_t   detail;                                        /**< 마지막 상세 코드(채널 등) */
+}FaultStat_t;
+
+/** \brief 고장 관리 상태 */
+typedef struct
+{
+u32_t        latched;                                  /**< latch된 고장 bit(1 << FaultCode_t) */
+FaultSev_t   level;                                    /**< 현재 적용 중인 최고 심각도 */
+Bool_t       first_valid;
+FaultCode_t  first;                                    /**< 최초 고장 */
+u32_t        first_detail;
+u32_t        first_tick;
+u32_t        react_last;                               /**< 등록 ~ Fault_Process() 출력(EB, Lock) 반영 시간(usec) */
+u32_t        react_max;
+}FaultInfo_t;
+
+/** \brief 반복 고장 보고 상태 */
+typedef struct
+{
+u32_t   interval;                                      /**< 보고 간격(msec) */
+u32_t   active;                                        /**< 반복 중인 보고 수 */
+u32_t   suppressed;                                    /**< 묶어서 출력하지 않은 반복 누계 */
+u32_t   overflow;                                      /**< 슬롯이 없어 버린 보고 수 */
+}FaultRptInfo_t;
+
+/* Exported constants --------------------------------------------------------*/
+#define FAULT_RPT_SLOTS         16U                    /**< 동시에 추적하는 반복 고장 보고 수 */
+#define FAULT_RPT_msec          5000U                  /**< 기본 보고 간격 */
+#define FAULT_RPT_MIN_msec      1000U
+#define FAULT_RPT_MAX_msec      60000U
+#define FAULT_RPT_IDLE          3U                     /**< 이 간격 수 동안 반복이 없으면 cleared */
+#define FAULT_RPT_IDLE_msec     130000U                /**< cleared 판정 최소 시간 */
+
+/* Exported macro ------------------------------------------------------------*/
+/* Exported variables --------------------------------------------------------*/
+/* Exported functions --------------------------------------------------------*/
+/** \defgroup Fault_Mgr_Exported_Functions 고장 관리 공개 함수
+  * \{ */
+extern void           Fault_Init(void);
+extern void           Fault_Raise(FaultCode_t code, u32_t detail);
+extern void           Fault_Process(void);
+extern Bool_t         Fault_Is_Latched(FaultCode_t code);
+extern void           Fault_Get_Info(FaultInfo_t * info);
+extern void           Fault_Get_Stat(FaultCode_t code, FaultStat_t * stat);
+extern FaultSev_t     Fault_Severity(FaultCode_t code);
+extern const char_t * Fault_Name(FaultCode_t code);
+extern const char_t * Fault_Sev_Name(FaultSev_t sev);
+extern void           Fault_Clear_Stat(void);
+extern Bool_t         Fault_Report(const char_t tag[], const char_t name[]);
+extern void           Fault_Report_Process(void);
+extern Bool_t         Fault_Report_Set_Interval(u32_t msec);
+extern void           Fault_Report_Get_Info(FaultRptInfo_t * info);
+/** \} Fault_Mgr_Exported_Functions */
+
+/** \} Fault_Mgr */
+
+/** \} Applications */
+
+#endif /* __FAULT_MGR_H */
+
+/*************** (C) COPYRIGHT SHALOM ENGINEERING CO., LTD. ****END OF FILE****/
@@ -0,0 +1,356 @@
+/** ****************************************************************************
+  * \file    latency_probe.c
+  * \author  Jang Ho Jong
+  * \version V0.0.1
+  * \date    2026.10.17
+  * \brief   Detection Latency Probe Body
+  * ***************************************************************************/
+
+/* Includes ------------------------------------------------------------------*/
+#include "latency_probe.h"
+#include "lib_crc16.h"
+
+/** \addtogroup Applications
+  * \{ */
+
+/** \defgroup Latency_Probe 감지 지연시간 측정
+  * \brief 센서 감지부터 EB 릴레이 Feedback까지 단계별 지연시간을 측정합니다.
+  * \{ */
+
+/* Private typedef -----------------------------------------------------------*/
+/** \brief 단계별 히스토그램 */
+typedef struct
+{
+u32_t   count;
+u32_t   min;
+u32_t   max;
+u32_t   last;
+u32_t   bin[LAT_HIST_BINS];                            /**< bin 0~3: 0~3usec, 이후 옥타브당 4 bin */
+}LatHist_t;
+
+/** \brief 측정 이벤트 상태 */
+typedef enum
+{
+  kLAT_IDLE = 0,                                       /**< 이벤트 대기 */
+  kLAT_OPEN,                                           /**< t0 이후 단계 측정 중 */
+  kLAT_DONE                                            /**< 마지막 단계까지 측정 완료, Cancel 대기 */
+}LatState_t;
+
+/* Private define ------------------------------------------------------------*/
+#define LAT_DUMP_CHUNK          16U                    /* 덤프시 한번에 보내는 bin 수 */
+
+/* Private macro -------------------------------------------------------------*/
+/* Private variables ---------------------------------------------------------*/
+/** \defgroup Latency_Probe_Private_Variables 감지 지연시간 측정 비공개 변수
+  * \{ */
+static LatHist_t   lat_hist[kNbrOfLatStages];          /* 단계별 히스토그램 */
+static LatState_t  lat_state = kLAT_IDLE;
+static u32_t       lat_t0;                             /* 이벤트 기준 시점(clock) */
+static u08_t       lat_marked;                         /* 이번 이벤트에서 기록된 단계(bit) */
+
+static const char_t * const lat_stage_name[kNbrOfLatStages] =
+{
+  "SAMPLE", "OSSD", "DECISION", "RELAY_CMD", "RELAY_FB"
+};
+/** \} Latency_Probe_Private_Variables */
+
+/* Private function prototypes -----------------------------------------------*/
+/** \defgroup Latency_Probe_Private_Functions 감지 지연시간 측정 비공개 함수
+  * \{ */
+static u32_t Latency_Bin(u32_t usec);
+static u32_t Latency_Bin_Upper(u32_t bin);
+static u32_t Latency_Percentile(const LatHist_t * h, u32_t percent);
+static u32_t Latency_Put32(u08_t buf[], u32_t value);
+/** \} Latency_Probe_Private_Functions */
+
+/* Exported functions --------------------------------------------------------*/
+/** \addtogroup Latency_Probe_Exported_Functions
+  * \{ */
+
+/** \brief  DWT cycle counter를 동작시키고 히스토그램을 초기화한다.
+  * \note   디버거가 연결되지 않아도 TRCENA를 켜야 CYCCNT가 증가한다.
+  * \retval 없음
+  */
+void Latency_Init(void)
+{
+#ifndef LATENCY_HOST_CLOCK
+  CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+  DWT->CYCCNT = 0U;
+  DWT->CTRL  |= DWT_CTRL_CYCCNTENA_Msk;
+#endif
+  Latency_Clear();
+}
+
+/** \brief  현재 clock 값을 읽는다.
+  * \note   ISR에서 t0를 남길 때도 사용한다. 32bit 순환(168MHz에서 약 25sec)은
+  *         뺄셈으로 처리되므로 그보다 짧은 구간만 측정한다.
+  * \retval clock 값
+  */
+u32_t Latency_Now(void)
+{
+  return LATENCY_CLOCK();
+}
+
+/** \brief  측정 이벤트를 시작한다.
+  * \param  t0 - 기준 시점(Latency_Now() 값)
+  * \note   대기 상태일 때만 시작하며, 측정 중이거나 완료 후 Cancel 전이면 무시한다.
+  * \retval 없음
+  */
+void Latency_Start(u32_t t0)
+{
+  if (lat_state == kLAT_IDLE)
+  {
+    lat_t0     = t0;
+    lat_marked = 0U;
+    lat_state  = kLAT_OPEN;
+  }
+}
+
+/** \brief  현재 이벤트에서 stage까지의 지연시간을 기록한다.
+  * \param  stage - 측정 단계
+  * \note   이벤트당 단계별로 한번만 기록하며, kLAT_RELAY_FB를 기록하면 이벤트를 닫는다.
+  * \retval 없음
+  */
+void Latency_Mark(LatStage_t stage)
+{
+  LatHist_t * h;
+  u32_t       usec;
+
+  if ((lat_state != kLAT_OPEN) || (stage >= kNbrOfLatStages)
+      || ((lat_marked & (1U << stage)) != 0U))
+  {
+    return;
+  }
+  usec = (Latency_Now() - lat_t0) / LATENCY_CLOCK_PER_usec;
+  lat_marked |= (u08_t)(1U << stage);
+
+  h = &lat_hist[stage];
+  if ((h->count == 0U) || (usec < h->min))
+  {
+    h->min = usec;
+  }
+  if (usec > h->max)
+  {
+    h->max = usec;
+  }
+  h->last = usec;
+  h->count++;
+  h->bin[Latency_Bin(usec)]++;
+
+  if (stage == kLAT_RELAY_FB)
+  {
+    lat_state = kLAT_DONE;
+  }
+}
+
+/** \brief  측정 이벤트를 종료하고 다음 이벤트를 받을 수 있게 한다.
+  * \note   모든 채널이 동작 전류 아래로 내려갔을 때 호출한다.
+  * \retval 없음
+  */
+void Latency_Cancel(void)
+{
+  lat_state = kLAT_IDLE;
+}
+
+/** \brief  히스토그램을 모두 지운다.
+  * \retval 없음
+  */
+void Latency_Clear(void)
+{
+  u32_t s, b;
+
+  for (s = 0U; s < kNbrOfLatStages; s++)
+  {
+    lat_hist[s].count = 0U;
+    lat_hist[s].min   = 0U;
+    lat_hist[s].max   = 0U;
+    lat_hist[s].last  = 0U;
+    for (b = 0U; b < LAT_HIST_BINS; b++)
+    {
+      lat_hist[s].bin[b] = 0U;
+    }
+  }
+  lat_state = kLAT_IDLE;
+}
+
+/** \brief  단계별 통계를 구한다.
+  * \param  stage - 측정 단계
+  * \param  stat  - 결과를 받을 LatStat_t 구조체 포인터
+  * \note   백분위는 bin 상한값이며 실제 max를 넘지 않게 제한한다.
+  * \retval 측정값이 있으면 True
+  */
+Bool_t Latency_Get_Stat(LatStage_t stage, LatStat_t * stat)
+{
+  const LatHist_t * h;
+
+  if (stage >= kNbrOfLatStages)
+  {
+    return False;
+  }
+  h = &lat_hist[stage];
+  stat->count = h->count;
+  stat->min   = h->min;
+  stat->max   = h->max;
+  stat->last  = h->last;
+  stat->p50   = Latency_Percentile(h, 50U);
+  stat->p90   = Latency_Percentile(h, 90U);
+  stat->p99   = Latency_Percentile(h, 99U);
+  return (h->count != 0U) ? True : False;
+}
+
+/** \brief  측정 단계 이름을 반환한다.
+  * \param  stage - 측정 단계
+  * \retval 단계 이름 문자열
+  */
+const char_t * Latency_Stage_Name(LatStage_t stage)
+{
+  return (stage < kNbrOfLatStages) ? lat_stage_name[stage] : "?";
+}
+
+/** \brief  전체 히스토그램을 binary로 out에 출력한다.
+  * \param  out - 출력 함수(콘솔은 cprint)
+  * \note   'L','A','T', 버전, 단계 수, bin 수
+  *         + 단계마다 count, min, max, last, bin[LAT_HIST_BINS] (u32 little endian, usec)
+  *         + 앞의 모든 byte에 대한 Crc16_Krs(little endian, dlog/진단 frame과 같음)
+  * \retval 없음
+  */
+void Latency_Dump(void (*out)(u08_t buf[], u32_t size))
+{
+  u08_t  buf[LAT_DUMP_CHUNK * 4U];
+  u32_t  n, i, s, b;
+  u16_t  crc = CRC16_KRS_INIT;
+
+  buf[0] = (u08_t)'L';
+  buf[1] = (u08_t)'A';
+  buf[2] = (u08_t)'T';
+  buf[3] = (u08_t)LAT_DUMP_VERSION;
+  buf[4] = (u08_t)kNbrOfLatStages;
+  buf[5] = (u08_t)LAT_HIST_BINS;
+  n = 6U;
+  crc = Crc16_Krs_Update(crc, buf, n);
+  out(buf, n);
+
+  for (s = 0U; s < kNbrOfLatStages; s++)
+  {
+    n  = Latency_Put32(&buf[0],  lat_hist[s].count);
+    n += Latency_Put32(&buf[4],  lat_hist[s].min);
+    n += Latency_Put32(&buf[8],  lat_hist[s].max);
+    n += Latency_Put32(&buf[12], lat_hist[s].last);
+    crc = Crc16_Krs_Update(crc, buf, n);
+    out(buf, n);
+
+    for (b = 0U; b < LAT_HIST_BINS; b += LAT_DUMP_CHUNK)
+    {
+      n = 0U;
+      for (i = b; (i < (b + LAT_DUMP_CHUNK)) && (i < LAT_HIST_BINS); i++)
+      {
+        n += Latency_Put32(&buf[n], lat_hist[s].bin[i]);
+      }
+      crc = Crc16_Krs_Update(crc, buf, n);
+      out(buf, n);
+    }
+  }
+
+  buf[0] = (u08_t)(crc & 0xFFU);
+  buf[1] = (u08_t)(crc >> 8);
+  out(buf, 2U);
+}
+
+/** \} Latency_Probe_Exported_Functions */
+
+/* Private functions ---------------------------------------------------------*/
+/** \addtogroup Latency_Probe_Private_Functions
+  * \{ */
+
+/** \brief  지연시간(usec)이 들어갈 bin 번호를 구한다.
+  * \param  usec - 지연시간
+  * \note   0~3usec은 1usec 단위, 그 이상은 2^k 옥타브를 4등분하므로 오차가 25% 이내이다.
+  *         예) 4~7 -> bin 4~7, 8~15 -> bin 8~11, 16~31 -> bin 12~15
+  * \retval bin 번호
+  */
+static u32_t Latency_Bin(u32_t usec)
+{
+  u32_t oct = 2U;
+  u32_t bin;
+
+  if (usec < 4U)
+  {
+    return usec;
+  }
+  while ((usec >> (oct + 1U)) != 0U)
+  {
+    oct++;
+  }
+  bin = ((oct - 1U) * 4U) + ((usec >> (oct - 2U)) & 3U);
+  return (bin < LAT_HIST_BINS) ? bin : (LAT_HIST_BINS - 1U);
+}
+
+/** \brief  bin에 들어가는 가장 큰 지연시간(usec)을 구한다.
+  * \param  bin - bin 번호
+  * \retval bin 상한(usec)
+  */
+static u32_t Latency_Bin_Upper(u32_t bin)
+{
+  u32_t oct;
+
+  if (bin < 4U)
+  {
+    return bin;
+  }
+  oct = (bin / 4U) + 1U;
+  return ((5U + (bin % 4U)) << (oct - 2U)) - 1U;
+}
+
+/** \brief  히스토그램에서 percent 백분위 값을 구한다.
+  * \param  h       - 단계 히스토그램
+  * \param  percent - 백분위(1~100)
+  * \retval 백분위 값(usec), 측정값이 없으면 0
+  */
+static u32_t Latency_Percentile(const LatHist_t * h, u32_t percent)
+{
+  u32_t target, acc = 0U, b, v;
+
+  if (h->count == 0U)
+  {
+    return 0U;
+  }
+  target = ((h->count * percent) + 99U) / 100U;
+  for (b = 0U; b < LAT_HIST_BINS; b++)
+  {
+    acc += h->bin[b];
+    if (acc >= target)
+    {
+      break;
+    }
+  }
+  v = Latency_Bin_Upper(b);
+  if (v > h->max)
+  {
+    v = h->max;
+  }
+  if (v < h->min)
+  {
+    v = h->min;
+  }
+  return v;
+}
+
+/** \brief  value를 little endian 4byte로 buf에 쓴다.
+  * \retval 쓴 byte 수
+  */
+static u32_t Latency_Put32(u08_t buf[], u32_t value)
+{
+  buf[0] = (u08_t)(value);
+  buf[1] = (u08_t)(value >> 8);
+  buf[2] = (u08_t)(value >> 16);
+  buf[3] = (u08_t)(value >> 24);
+  return 4U;
+}
+
+/** \} Latency_Probe_Private_Functions */
+
+/** \} Latency_Probe */
+
+/** \} Applications */
+
+/*************** (C) COPYRIGHT SHALOM ENGINEERING CO., LTD. ****END OF FILE****/
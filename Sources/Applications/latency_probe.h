@@ -0,0 +1,106 @@
+/** ****************************************************************************
+  * \file    latency_probe.h
+  * \author  Jang Ho Jong
+  * \version V0.0.1
+  * \date    2026.10.17
+  * \brief   Detection Latency Probe Header
+  * ***************************************************************************/
+/*
+  - 감지 지연시간 측정 모듈
+
+  - 개념:
+    센서 전류가 동작 기준을 넘은 ADC 프레임의 변환 완료 시점을 기준(t0)으로
+    감지 경로의 각 단계까지 걸린 시간을 Cortex-M4 DWT cycle counter로 측정한다.
+
+  - 동작:
+    Latency_Start(t0)로 이벤트를 열고 단계마다 Latency_Mark()를 호출한다.
+    단계별로 이벤트당 한번만 기록되며, 마지막 단계(릴레이 Feedback)에서 이벤트가 닫힌다.
+    모든 채널이 동작 기준 아래로 내려가면 Latency_Cancel()로 다음 이벤트를 받을 수 있게 한다.
+
+  - 시계:
+    LATENCY_HOST_CLOCK을 정의하면 DWT 대신 Latency_Host_Clock()(1 tick = 1usec)을 사용한다.
+    PC에서 판정 로직을 돌릴 때 fake clock을 넣기 위한 것이다.
+
+  - 모니터링:
+    콘솔 "LATENCY" 명령어로 단계별 count/min/max/p50/p90/p99(usec)를 표시하며,
+    "LATENCY BIN"으로 히스토그램 전체를 binary로 덤프한다.
+
+  - Latency 접두어를 사용한다.
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef __LATENCY_PROBE_H
+#define __LATENCY_PROBE_H
+
+/* Includes ------------------------------------------------------------------*/
+#include "main.h"
+
+/** \addtogroup Applications
+  * \{ */
+
+/** \addtogroup Latency_Probe
+  * \{ */
+
+/* Exported types ------------------------------------------------------------*/
+/** \brief 감지 경로 측정 단계 */
+typedef enum
+{
+  kLAT_SAMPLE = 0,                                     /**< 동작 전류 프레임을 쓰레드가 읽음 */
+  kLAT_OSSD,                                           /**< OSSD1/OSSD2 카운트 확정 */
+  kLAT_DECISION,                                       /**< 장애물/탈선 판정 */
+  kLAT_RELAY_CMD,                                      /**< EB1/EB2 릴레이 출력 명령 */
+  kLAT_RELAY_FB,                                       /**< EB1/EB2 릴레이 Feedback 확인 */
+  kNbrOfLatStages
+}LatStage_t;
+
+/** \brief 단계별 지연시간 통계(usec) */
+typedef struct
+{
+u32_t   count;                                         /**< 측정 횟수 */
+u32_t   min;
+u32_t   max;
+u32_t   last;                                          /**< 최근 이벤트의 측정값 */
+u32_t   p50;                                           /**< 히스토그램 bin 상한으로 구한 백분위 */
+u32_t   p90;
+u32_t   p99;
+}LatStat_t;
+
+/* Exported constants --------------------------------------------------------*/
+/** \defgroup Latency_Probe_Exported_Constants 감지 지연시간 측정 공개 상수
+  * \{ */
+#define LAT_HIST_BINS           96U                    /**< 옥타브당 4 bin, 약 33sec까지 */
+#define LAT_DUMP_VERSION        2U                     /**< binary 덤프 포맷 버전(2 : 끝을 Crc16_Krs로) */
+/** \} Latency_Probe_Exported_Constants */
+
+/* Exported macro ------------------------------------------------------------*/
+#ifdef LATENCY_HOST_CLOCK
+extern u32_t Latency_Host_Clock(void);
+#define LATENCY_CLOCK()         (Latency_Host_Clock())
+#define LATENCY_CLOCK_PER_usec  (1U)
+#else
+#define LATENCY_CLOCK()         (DWT->CYCCNT)
+#define LATENCY_CLOCK_PER_usec  (SystemCoreClock / 1000000U)
+#endif
+
+/* Exported variables --------------------------------------------------------*/
+/* Exported functions --------------------------------------------------------*/
+/** \defgroup Latency_Probe_Exported_Functions 감지 지연시간 측정 공개 함수
+  * \{ */
+extern void   Latency_Init(void);
+extern u32_t  Latency_Now(void);
+extern void   Latency_Start(u32_t t0);
+extern void   Latency_Mark(LatStage_t stage);
+extern void   Latency_Cancel(void);
+extern void   Latency_Clear(void);
+extern Bool_t Latency_Get_Stat(LatStage_t stage, LatStat_t * stat);
+extern const char_t * Latency_Stage_Name(LatStage_t stage);
+extern void   Latency_Dump(void (*out)(u08_t buf[], u32_t size));
+/** \} Latency_Probe_Exported_Functions */
+
+/** \} Latency_Probe */
+
+/** \} Applications */
+
+#endif /* __LATENCY_PROBE_H */
+
+/*************** (C) COPYRIGHT SHALOM ENGINEERING CO., LTD. ****END OF FILE****/
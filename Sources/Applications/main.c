@@ -18,6 +18,7 @@
 /* Includes ------------------------------------------------------------------*/
 #include "main.h"
 #include "device.h"
+#include "rs485com_thread.h"
 
 /** \defgroup Applications Applications
   * \brief 시스템의 기능을 수행하는 부분입니다.
@@ -78,6 +79,14 @@ int32_t main(void)
          PROJECT_NAME, VERSION_MAIN, VERSION_SUB1, VERSION_SUB2, 
          BUILD_DATE, BUILD_TIME);				 
 
+  /* 고장 관리, EB 동작 상태 초기화(자기진단 고장부터 기록) */
+   Dlog_Init();                                                      // 지연 binary 로그
+   Fault_Init();
+   Eb_Act_Init();
+   Rs485_Link_Init();                                                // RS-485 보드별 RTT, 통신 통계
+   Rs485_Baud_Init(Rs485_Baud_Code(Rs485Ch1_BaudRate_Max));          // RS-485 속도 협상 최대값
+   Rs485_Diag_Init();                                                // RS-485 보드별 확장 진단
+
   /* launch STL Tests */
 
 	 STL_Self_Test();
@@ -85,19 +94,33 @@ int32_t main(void)
 /* Relay 및 Sensor 자기 진단 테스트를 수행한다.  */
 	 Self_Diagnose_Perform();
 //	HAL_Delay(500);	
+
+/* 충돌 및 탈선 감지 채널 테이블 구성 */
+	 Deod_Init();
 	
    Rs232_Enable_Receiving(serial3);                                  // console port enable
+   Rs485com_Init();                                                  // 보드 역할 설정, RS-485 port enable
 
 	 while(1)
 	 {
+		/* 등록된 고장의 출력(EB, Watchdog) 반영 : loop 당 한번, HLT OFF는 Fault_Raise()에서 바로 */
+      Fault_Process();
+      Fault_Report_Process();                                       // 반복 고장 메시지 묶음 보고
+
 		/* System Monitoring 기능 수행  */
       Sysmon_Thread();
 
 	  /* 충돌 및 탈선 감지 기능 수행 */
       Deod_Thread();
     
+		/* DM/PC 보드간 RS-485 통신 */
+		  Rs485com_Thread();
+
 		/* 콘솔포트 명령어 처리 루틴  */
 		  Console_Thread();
+
+		/* 지연 로그 출력 : 콘솔 송신 버퍼 여유만큼 */
+		  Dlog_Thread();
 	 }	
 }
 /** \} Main_Exported_Functions */
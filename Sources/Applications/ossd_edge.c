@@ -0,0 +1,387 @@
+/** ****************************************************************************
+  * \file    ossd_edge.c
+  * \author  Jang Ho Jong
+  * \version V0.0.1
+  * \date    2026.10.17
+  * \brief   OSSD Edge Event Body
+  * ***************************************************************************/
+
+/* Includes ------------------------------------------------------------------*/
+#include "ossd_edge.h"
+#include "device.h"
+
+/** \addtogroup Applications
+  * \{ */
+
+/** \defgroup Ossd_Edge OSSD edge 이벤트
+  * \brief EXTI로 받은 OSSD edge의 glitch를 걸러내고 OSSD1/OSSD2 타이밍을 기록합니다.
+  * \{ */
+
+/* Private typedef -----------------------------------------------------------*/
+/** \brief Pin(kSO_x)별 edge 처리 상태 */
+typedef struct
+{
+u08_t   level;                                         /* 확정 level */
+u08_t   latch_high;                                    /* 마지막 Take 이후 확정 High가 있었음 */
+Bool_t  pend;                                          /* 확정 대기 중인 level 변화 있음 */
+u08_t   pend_level;
+u32_t   pend_usec;                                     /* 확정 대기 변화의 edge 시각 */
+u32_t   change_usec;                                   /* 마지막 확정 변화 시각 */
+u32_t   accepted;
+u32_t   glitch;
+}OssdPin_t;
+
+/* Private define ------------------------------------------------------------*/
+/* Private macro -------------------------------------------------------------*/
+/* Private variables ---------------------------------------------------------*/
+/** \defgroup Ossd_Edge_Private_Variables OSSD edge 비공개 변수
+  * \{ */
+static OssdPin_t      ossd_pin[kNbrOfSOs];
+static OssdSenStat_t  ossd_sen[kNbrOfSIs];
+static Bool_t         ossd_disc_on[kNbrOfSIs];         /* OSSD1 != OSSD2 진행 중 */
+static Bool_t         ossd_disc_counted[kNbrOfSIs];    /* 이번 불일치를 이미 셌음 */
+static u32_t          ossd_disc_usec[kNbrOfSIs];       /* 불일치 시작 시각 */
+static u08_t          ossd_disc_pin[kNbrOfSIs];        /* 불일치를 시작한 kSO_x, kNbrOfSOs면 모름(resync) */
+static u32_t          ossd_glitch_usec = OSSD_GLITCH_usec;
+static u32_t          ossd_overflow;                   /* 마지막으로 확인한 ring overflow 수 */
+static u32_t          ossd_resync;                     /* snapshot으로 다시 맞춘 횟수 */
+/** \} Ossd_Edge_Private_Variables */
+
+/* Private function prototypes -----------------------------------------------*/
+/** \defgroup Ossd_Edge_Private_Functions OSSD edge 비공개 함수
+  * \{ */
+static void Ossd_Edge_Event(const OssdEdge_t * e);
+static void Ossd_Edge_Commit(u08_t pin);
+static void Ossd_Edge_Commit_Due(u08_t ch, u32_t now);
+static void Ossd_Edge_Resync(void);
+/** \} Ossd_Edge_Private_Functions */
+
+/* Exported functions --------------------------------------------------------*/
+/** \addtogroup Ossd_Edge_Exported_Functions
+  * \{ */
+
+/** \brief  현재 OSSD 입력으로 Pin별 level을 맞추고 통계를 지운다.
+  * \note   Device_Init()에서 EXTI가 켜진 뒤 Deod_Init()에서 호출한다.
+  * \retval 없음
+  */
+void Ossd_Edge_Init(void)
+{
+  OssdEdge_t e;
+
+  while (Device_Ossd_Edge_Get(&e) == True)
+  {
+  }
+  ossd_overflow = Device_Ossd_Edge_Overflow();
+  Ossd_Edge_Resync();
+  Ossd_Edge_Clear();
+}
+
+/** \brief  ring에 쌓인 OSSD edge를 모두 처리하고 확정 시간이 지난 변화를 확정한다.
+  * \note   Deod_Thread에서 매 loop 호출한다.
+  * \retval 없음
+  */
+void Ossd_Edge_Process(void)
+{
+  OssdEdge_t e;
+  u32_t      ovf;
+  u32_t      now;
+  u08_t      i;
+
+  ovf = Device_Ossd_Edge_Overflow();
+  while (Device_Ossd_Edge_Get(&e) == True)
+  {
+    Ossd_Edge_Event(&e);
+  }
+  if (ovf != ossd_overflow)
+  {
+    ossd_overflow = ovf;
+    Ossd_Edge_Resync();                                                /* 버려진 edge가 있으므로 level을 다시 맞춤 */
+    return;
+  }
+
+  now = Device_Usec_Now();
+  for (i = 0; i < kNbrOfSIs; i++)
+  {
+    Ossd_Edge_Commit_Due(i, now);
+    if ((ossd_disc_on[i] == True) && (ossd_disc_counted[i] == False)
+        && ((now - ossd_disc_usec[i]) >= OSSD_DISCREPANCY_usec))
+    {
+      ossd_sen[i].discrepancy++;
+      ossd_disc_counted[i] = True;
+    }
+  }
+}
+
+/** \brief  마지막 호출 이후 확정 High가 있었던 OSSD를 센서별 bit로 반환한다.
+  * \param  ossd1 - bit ch : 센서 ch의 OSSD1이 High였음
+  * \param  ossd2 - bit ch : 센서 ch의 OSSD2가 High였음
+  * \note   현재 High이거나 판정 주기 사이에 glitch 폭 이상의 High pulse가 있었으면 1이다.
+  * \retval 없음
+  */
+void Ossd_Edge_Take(u08_t * ossd1, u08_t * ossd2)
+{
+  OssdPin_t * p;
+  u08_t       i;
+
+  *ossd1 = 0U;
+  *ossd2 = 0U;
+  for (i = 0; i < kNbrOfSOs; i++)
+  {
+    p = &ossd_pin[i];
+    if ((p->level != 0U) || (p->latch_high != 0U))
+    {
+      if ((i % 2U) == 0U)
+      {
+        *ossd1 |= (u08_t)(1U << (i / 2U));
+      }
+      else
+      {
+        *ossd2 |= (u08_t)(1U << (i / 2U));
+      }
+    }
+    p->latch_high = p->level;
+  }
+}
+
+/** \brief  glitch로 버릴 최대 pulse 폭을 설정한다.
+  * \param  usec - 최소 pulse 폭(usec), 0이면 filter 없음
+  * \retval 설정 범위(0 ~ OSSD_GLITCH_usec_MAX)이면 True
+  */
+Bool_t Ossd_Edge_Set_Glitch(u32_t usec)
+{
+  if (usec > OSSD_GLITCH_usec_MAX)
+  {
+    return False;
+  }
+  ossd_glitch_usec = usec;
+  return True;
+}
+
+/** \brief  현재 glitch filter 폭(usec)을 반환한다.
+  * \retval 최소 pulse 폭(usec)
+  */
+u32_t Ossd_Edge_Get_Glitch(void)
+{
+  return ossd_glitch_usec;
+}
+
+/** \brief  Pin(kSO_x)별 edge 통계를 구한다.
+  * \param  pin  - kSO_x
+  * \param  stat - 결과를 받을 OssdPinStat_t 구조체 포인터
+  * \retval 없음
+  */
+void Ossd_Edge_Get_Pin_Stat(u08_t pin, OssdPinStat_t * stat)
+{
+  stat->edges    = Device_Ossd_Edge_Count(pin);
+  stat->accepted = (pin < kNbrOfSOs) ? ossd_pin[pin].accepted : 0U;
+  stat->glitch   = (pin < kNbrOfSOs) ? ossd_pin[pin].glitch : 0U;
+}
+
+/** \brief  센서별 OSSD1/OSSD2 타이밍 통계를 구한다.
+  * \param  ch   - 센서 채널
+  * \param  stat - 결과를 받을 OssdSenStat_t 구조체 포인터
+  * \retval 없음
+  */
+void Ossd_Edge_Get_Sen_Stat(u08_t ch, OssdSenStat_t * stat)
+{
+  if (ch < kNbrOfSIs)
+  {
+    *stat = ossd_sen[ch];
+  }
+}
+
+/** \brief  ring overflow로 snapshot에 다시 맞춘 횟수를 반환한다.
+  * \retval 횟수
+  */
+u32_t Ossd_Edge_Resync_Count(void)
+{
+  return ossd_resync;
+}
+
+/** \brief  edge 통계를 지운다.
+  * \note   확정 level과 확정 대기 상태는 유지한다.
+  * \retval 없음
+  */
+void Ossd_Edge_Clear(void)
+{
+  u08_t i;
+
+  for (i = 0; i < kNbrOfSOs; i++)
+  {
+    ossd_pin[i].accepted = 0U;
+    ossd_pin[i].glitch   = 0U;
+  }
+  for (i = 0; i < kNbrOfSIs; i++)
+  {
+    ossd_sen[i].skew_last   = 0U;
+    ossd_sen[i].skew_max    = 0U;
+    ossd_sen[i].discrepancy = 0U;
+    ossd_sen[i].pulse       = 0U;
+  }
+  ossd_resync = 0U;
+  Device_Ossd_Edge_Clear_Count();
+}
+
+/** \} Ossd_Edge_Exported_Functions */
+
+/* Private functions ---------------------------------------------------------*/
+/** \addtogroup Ossd_Edge_Private_Functions
+  * \{ */
+
+/** \brief  edge 하나를 glitch filter에 넣는다.
+  * \param  e - OSSD edge
+  * \note   이 edge 시각까지 확정된 같은 센서의 변화를 먼저 확정하고,
+  *         확정 대기 중에 glitch 폭 안에 반대 edge가 오면 대기 중인 변화를 glitch로 버리며,
+  *         확정 level과 같은 level edge(ISR 전에 되돌아온 pulse)도 glitch로 센다.
+  * \retval 없음
+  */
+static void Ossd_Edge_Event(const OssdEdge_t * e)
+{
+  OssdPin_t * p;
+
+  if (e->pin >= kNbrOfSOs)
+  {
+    return;
+  }
+  p = &ossd_pin[e->pin];
+  Ossd_Edge_Commit_Due(e->pin / 2U, e->usec);
+  if (p->pend == True)
+  {
+    if (e->level == p->pend_level)
+    {
+      return;                                                          /* 중간 edge를 놓침, 먼저 온 시각 유지 */
+    }
+    p->glitch++;                                                       /* glitch 폭 안에 되돌아옴 */
+    p->pend = False;
+    return;
+  }
+  if (e->level == p->level)
+  {
+    p->glitch++;
+    return;
+  }
+  p->pend       = True;
+  p->pend_level = e->level;
+  p->pend_usec  = e->usec;
+}
+
+/** \brief  확정 대기 중인 level 변화를 확정하고 같은 센서의 반대쪽 OSSD와 비교한다.
+  * \param  pin - kSO_x
+  * \note   두 OSSD가 같은 level이 되었을 때 반대쪽이 따라 바뀐 것이면 먼저 바뀐 쪽과의 시각차를
+  *         skew로 기록하고, 먼저 바뀐 쪽이 혼자 되돌아온 것이면 한쪽 pulse로 센다.
+  *         어느 경우든 불일치 시간이 OSSD_DISCREPANCY_usec 이상이면 불일치로 센다.
+  * \retval 없음
+  */
+static void Ossd_Edge_Commit(u08_t pin)
+{
+  OssdPin_t * p  = &ossd_pin[pin];
+  OssdPin_t * o  = &ossd_pin[pin ^ 1U];
+  u08_t       ch = pin / 2U;
+  u32_t       span;
+
+  p->level       = p->pend_level;
+  p->change_usec = p->pend_usec;
+  p->pend        = False;
+  p->accepted++;
+  if (p->level != 0U)
+  {
+    p->latch_high = 1U;
+  }
+
+  if (o->level == p->level)
+  {
+    if (ossd_disc_on[ch] == True)
+    {
+      span = p->change_usec - ossd_disc_usec[ch];
+      if (ossd_disc_pin[ch] == (pin ^ 1U))
+      {
+        ossd_sen[ch].skew_last = span;                                 /* 반대쪽이 따라 바뀜 */
+        if (span > ossd_sen[ch].skew_max)
+        {
+          ossd_sen[ch].skew_max = span;
+        }
+      }
+      else if (ossd_disc_pin[ch] == pin)
+      {
+        ossd_sen[ch].pulse++;                                          /* 먼저 바뀐 쪽이 혼자 되돌아옴 */
+      }
+      if ((ossd_disc_counted[ch] == False) && (span >= OSSD_DISCREPANCY_usec))
+      {
+        ossd_sen[ch].discrepancy++;                                    /* Process() 전에 끝난 긴 불일치 */
+      }
+      ossd_disc_on[ch] = False;
+    }
+  }
+  else
+  {
+    ossd_disc_on[ch]      = True;
+    ossd_disc_counted[ch] = False;
+    ossd_disc_usec[ch]    = p->change_usec;
+    ossd_disc_pin[ch]     = pin;
+  }
+}
+
+/** \brief  센서 하나의 OSSD1/OSSD2 중 확정 시간이 지난 변화를 edge 시각 순서로 확정한다.
+  * \param  ch  - 센서 채널
+  * \param  now - 기준 시각(usec)
+  * \note   Pin 번호 순서로 확정하면 먼저 바뀐 쪽을 잘못 알게 되므로 시각이 빠른 쪽부터 확정한다.
+  * \retval 없음
+  */
+static void Ossd_Edge_Commit_Due(u08_t ch, u32_t now)
+{
+  u08_t   pin1 = ch * 2U;
+  u08_t   pin2 = pin1 + 1U;
+  Bool_t  due1 = ((ossd_pin[pin1].pend == True) && ((now - ossd_pin[pin1].pend_usec) >= ossd_glitch_usec)) ? True : False;
+  Bool_t  due2 = ((ossd_pin[pin2].pend == True) && ((now - ossd_pin[pin2].pend_usec) >= ossd_glitch_usec)) ? True : False;
+
+  if ((due1 == True) && (due2 == True) && ((i32_t)(ossd_pin[pin2].pend_usec - ossd_pin[pin1].pend_usec) < 0))
+  {
+    Ossd_Edge_Commit(pin2);
+    Ossd_Edge_Commit(pin1);
+    return;
+  }
+  if (due1 == True)
+  {
+    Ossd_Edge_Commit(pin1);
+  }
+  if (due2 == True)
+  {
+    Ossd_Edge_Commit(pin2);
+  }
+}
+
+/** \brief  Port snapshot으로 Pin별 확정 level을 다시 맞춘다.
+  * \retval 없음
+  */
+static void Ossd_Edge_Resync(void)
+{
+  InSnap_t snap;
+  u32_t    now;
+  u08_t    i;
+
+  Device_Input_Snapshot(&snap);
+  now = Device_Usec_Now();
+  for (i = 0; i < kNbrOfSOs; i++)
+  {
+    ossd_pin[i].level       = IN_SNAP_BIT(((i % 2U) == 0U) ? snap.ossd1 : snap.ossd2, i / 2U);
+    ossd_pin[i].latch_high |= ossd_pin[i].level;
+    ossd_pin[i].pend        = False;
+    ossd_pin[i].change_usec = now;
+  }
+  for (i = 0; i < kNbrOfSIs; i++)
+  {
+    ossd_disc_on[i]      = (ossd_pin[i * 2U].level != ossd_pin[(i * 2U) + 1U].level) ? True : False;
+    ossd_disc_counted[i] = False;
+    ossd_disc_usec[i]    = now;
+    ossd_disc_pin[i]     = kNbrOfSOs;                                  /* 어느 쪽이 먼저인지 모름 */
+  }
+  ossd_resync++;
+}
+
+/** \} Ossd_Edge_Private_Functions */
+
+/** \} Ossd_Edge */
+
+/** \} Applications */
+
+/*************** (C) COPYRIGHT SHALOM ENGINEERING CO., LTD. ****END OF FILE****/
@@ -0,0 +1,94 @@
+/** ****************************************************************************
+  * \file    ossd_edge.h
+  * \author  Jang Ho Jong
+  * \version V0.0.1
+  * \date    2026.10.17
+  * \brief   OSSD Edge Event Header
+  * ***************************************************************************/
+/*
+  - OSSD edge 이벤트 처리 모듈
+
+  - 개념:
+    EXTI ISR이 Device_Ossd_Edge_Get() ring에 넣은 (pin, level, usec) edge를
+    Deod_Thread에서 꺼내 glitch를 걸러내고 Pin별 안정 level을 유지한다.
+
+  - 동작:
+    새 level은 OSSD_GLITCH_usec 이상 유지되었을 때(다음 edge가 늦게 오거나 시간이 지남) 확정된다.
+    그보다 짧은 pulse는 glitch로 세고 버린다.
+    확정된 High는 다음 Ossd_Edge_Take() 까지 유지되므로 10msec 판정 주기보다 짧은 pulse도 판정에 반영된다.
+    같은 센서의 OSSD1/OSSD2 확정 시각 차이(skew)와 불일치 시간이 OSSD_DISCREPANCY_usec를
+    넘은 횟수를 센서별로 기록한다.
+    skew는 한쪽이 바뀐 뒤 다른 쪽이 따라 바뀐 경우만 잰다. 먼저 바뀐 쪽이 혼자 되돌아온 경우는
+    한쪽 pulse로 따로 센다.
+
+  - 고장:
+    ring overflow가 발생하면 edge 순서를 믿을 수 없으므로 Port snapshot으로 level을 다시 맞춘다.
+
+  - 모니터링:
+    콘솔 "OSSDEVT" 명령어로 Pin별 edge/확정/glitch 수와 센서별 skew, 불일치, 한쪽 pulse 횟수를 표시한다.
+
+  - Ossd_Edge 접두어를 사용한다.
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef __OSSD_EDGE_H
+#define __OSSD_EDGE_H
+
+/* Includes ------------------------------------------------------------------*/
+#include "main.h"
+
+/** \addtogroup Applications
+  * \{ */
+
+/** \addtogroup Ossd_Edge
+  * \{ */
+
+/* Exported types ------------------------------------------------------------*/
+/** \brief Pin(kSO_x)별 edge 통계 */
+typedef struct
+{
+u32_t   edges;                                         /**< EXTI edge 수 */
+u32_t   accepted;                                      /**< glitch filter를 통과한 level 변화 수 */
+u32_t   glitch;                                        /**< 버린 짧은 pulse 수 */
+}OssdPinStat_t;
+
+/** \brief 센서별 OSSD1/OSSD2 타이밍 통계 */
+typedef struct
+{
+u32_t   skew_last;                                     /**< 최근 OSSD1/OSSD2 같은 방향 변화 시각차(usec) */
+u32_t   skew_max;
+u32_t   discrepancy;                                   /**< 불일치가 OSSD_DISCREPANCY_usec를 넘은 횟수 */
+u32_t   pulse;                                         /**< 한쪽 OSSD만 바뀌었다 되돌아온 횟수 */
+}OssdSenStat_t;
+
+/* Exported constants --------------------------------------------------------*/
+/** \defgroup Ossd_Edge_Exported_Constants OSSD edge 공개 상수
+  * \{ */
+#define OSSD_GLITCH_usec           200U                /**< 기본 최소 pulse 폭(usec) */
+#define OSSD_GLITCH_usec_MAX       5000U               /**< 콘솔로 설정 가능한 최대 pulse 폭 */
+#define OSSD_DISCREPANCY_usec      5000U               /**< OSSD1/OSSD2 불일치 허용 시간(usec) */
+/** \} Ossd_Edge_Exported_Constants */
+
+/* Exported macro ------------------------------------------------------------*/
+/* Exported variables --------------------------------------------------------*/
+/* Exported functions --------------------------------------------------------*/
+/** \defgroup Ossd_Edge_Exported_Functions OSSD edge 공개 함수
+  * \{ */
+extern void   Ossd_Edge_Init(void);
+extern void   Ossd_Edge_Process(void);
+extern void   Ossd_Edge_Take(u08_t * ossd1, u08_t * ossd2);
+extern Bool_t Ossd_Edge_Set_Glitch(u32_t usec);
+extern u32_t  Ossd_Edge_Get_Glitch(void);
+extern void   Ossd_Edge_Get_Pin_Stat(u08_t pin, OssdPinStat_t * stat);
+extern void   Ossd_Edge_Get_Sen_Stat(u08_t ch, OssdSenStat_t * stat);
+extern u32_t  Ossd_Edge_Resync_Count(void);
+extern void   Ossd_Edge_Clear(void);
+/** \} Ossd_Edge_Exported_Functions */
+
+/** \} Ossd_Edge */
+
+/** \} Applications */
+
+#endif /* __OSSD_EDGE_H */
+
+/*************** (C) COPYRIGHT SHALOM ENGINEERING CO., LTD. ****END OF FILE****/
@@ -0,0 +1,267 @@
+/** ****************************************************************************
+  * \file    rs485_baud.c
+  * \author  Jang Ho Jong
+  * \version V0.0.1
+  * \date    2026.10.17
+  * \brief   RS-485 Baud-Rate Negotiation Body
+  * ***************************************************************************/
+
+/* Includes ------------------------------------------------------------------*/
+#include "rs485_baud.h"
+
+/** \addtogroup Applications
+  * \{ */
+
+/** \defgroup Rs485_Baud RS-485 통신 속도 협상
+  * \brief 보드 사이에 공통으로 쓸 수 있는 가장 빠른 속도를 정하고 오류 시 기본 속도로 되돌립니다.
+  * \{ */
+
+/* Private typedef -----------------------------------------------------------*/
+/* Private define ------------------------------------------------------------*/
+/* Private macro -------------------------------------------------------------*/
+/* Private variables ---------------------------------------------------------*/
+/** \defgroup Rs485_Baud_Private_Variables RS-485 baud 비공개 변수
+  * \{ */
+static const u32_t rs485_baud_rate[kNbrOfRs485Bauds] =
+{
+  38400U, 115200U, 230400U, 460800U
+};
+
+static Rs485BaudInfo_t _baud;
+/** \} Rs485_Baud_Private_Variables */
+
+/* Private function prototypes -----------------------------------------------*/
+/* Exported functions --------------------------------------------------------*/
+/** \addtogroup Rs485_Baud_Exported_Functions
+  * \{ */
+
+/** \brief  기본 속도에서 시작하고 설정 최대 속도까지 협상하도록 초기화한다.
+  * \param  max - 설정 최대 속도
+  * \retval 없음
+  */
+void Rs485_Baud_Init(Rs485Baud_t max)
+{
+  if (max >= kNbrOfRs485Bauds)
+  {
+    max = RS485_BAUD_BASE;
+  }
+  _baud.cur          = RS485_BAUD_BASE;
+  _baud.max          = max;
+  _baud.cap          = max;
+  _baud.propose      = RS485_BAUD_BASE;
+  _baud.nodes        = 0U;
+  _baud.acked        = 0U;
+  _baud.agreed       = RS485_BAUD_BASE;
+  _baud.need         = (max != RS485_BAUD_BASE) ? True : False;
+  _baud.win_ok       = 0U;
+  _baud.win_err      = 0U;
+  _baud.last_ok_tick = 0U;
+  _baud.negotiations = 0U;
+  _baud.fallbacks    = 0U;
+}
+
+/** \brief  속도 번호를 bps로 바꾼다.
+  * \retval bps, 범위 밖이면 기본 속도
+  */
+u32_t Rs485_Baud_Rate(Rs485Baud_t code)
+{
+  if (code >= kNbrOfRs485Bauds)
+  {
+    code = RS485_BAUD_BASE;
+  }
+  return rs485_baud_rate[code];
+}
+
+/** \brief  bps를 속도 번호로 바꾼다.
+  * \retval 속도 번호, 지원하지 않는 속도면 kNbrOfRs485Bauds
+  */
+Rs485Baud_t Rs485_Baud_Code(u32_t rate)
+{
+  u08_t i;
+
+  for (i = 0U; i < (u08_t)kNbrOfRs485Bauds; i++)
+  {
+    if (rs485_baud_rate[i] == rate)
+    {
+      return (Rs485Baud_t)i;
+    }
+  }
+  return kNbrOfRs485Bauds;
+}
+
+/** \brief  현재 속도를 얻는다.
+  * \retval 속도 번호
+  */
+Rs485Baud_t Rs485_Baud_Current(void)
+{
+  return _baud.cur;
+}
+
+/** \brief  설정 최대 속도를 바꾸고 다시 협상하게 한다.
+  * \note   되돌림으로 낮아진 허용 속도도 새 최대 속도로 되살린다.
+  * \retval 지원하는 속도면 True
+  */
+Bool_t Rs485_Baud_Set_Max(Rs485Baud_t max)
+{
+  if (max >= kNbrOfRs485Bauds)
+  {
+    return False;
+  }
+  _baud.max  = max;
+  _baud.cap  = max;
+  _baud.need = True;
+  return True;
+}
+
+/** \brief  협상이 필요한지 확인한다.
+  * \retval 필요하면 True
+  */
+Bool_t Rs485_Baud_Need_Negotiation(void)
+{
+  return _baud.need;
+}
+
+/** \brief  협상을 시작한다.
+  * \param  nodes - 답을 받아야 할 보드 수(ID 1 ~ nodes)
+  * \retval 보드에 제안할 속도
+  */
+Rs485Baud_t Rs485_Baud_Neg_Start(u08_t nodes)
+{
+  if (nodes > 8U)
+  {
+    nodes = 8U;
+  }
+  _baud.nodes   = nodes;
+  _baud.acked   = 0U;
+  _baud.propose = _baud.cap;
+  _baud.agreed  = _baud.cap;
+  _baud.need    = False;
+  return _baud.propose;
+}
+
+/** \brief  보드의 BAUD_ACK를 기록한다.
+  * \retval 없음
+  */
+void Rs485_Baud_Neg_Ack(u08_t id, Rs485Baud_t code)
+{
+  if ((id == 0U) || (id > _baud.nodes) || (code >= kNbrOfRs485Bauds))
+  {
+    return;
+  }
+  _baud.acked |= (u08_t)(1U << (id - 1U));
+  if (code < _baud.agreed)
+  {
+    _baud.agreed = code;
+  }
+}
+
+/** \brief  협상 결과 속도를 구한다.
+  * \retval 모든 보드가 답했으면 답한 속도 중 최소, 아니면 기본 속도
+  */
+Rs485Baud_t Rs485_Baud_Neg_Result(void)
+{
+  u08_t all = (u08_t)((1U << _baud.nodes) - 1U);
+
+  if (_baud.acked != all)
+  {
+    return RS485_BAUD_BASE;
+  }
+  return _baud.agreed;
+}
+
+/** \brief  속도를 바꿨음을 기록한다(UART 설정은 호출한 쪽에서 끝낸 뒤).
+  * \param  tick - 현재 시각(HAL_GetTick())
+  * \retval 없음
+  */
+void Rs485_Baud_Commit(Rs485Baud_t code, u32_t tick)
+{
+  if (code >= kNbrOfRs485Bauds)
+  {
+    code = RS485_BAUD_BASE;
+  }
+  _baud.cur          = code;
+  _baud.win_ok       = 0U;
+  _baud.win_err      = 0U;
+  _baud.last_ok_tick = tick;
+  _baud.negotiations++;
+}
+
+/** \brief  슬레이브가 제안 속도에 대해 답할 속도를 구한다.
+  * \retval 제안 속도와 자기 최대 속도 중 낮은 값
+  */
+Rs485Baud_t Rs485_Baud_Accept(Rs485Baud_t proposed)
+{
+  if (proposed >= kNbrOfRs485Bauds)
+  {
+    return RS485_BAUD_BASE;
+  }
+  return (proposed < _baud.max) ? proposed : _baud.max;
+}
+
+/** \brief  마스터의 수신 결과를 오류 창에 더한다.
+  * \param  ok  - 정상 frame 수
+  * \param  err - CRC 오류 + 무응답 수
+  * \note   기본 속도보다 빠를 때 창 안의 오류가 RS485_BAUD_ERR_MAX 이상이면
+  *         허용 속도를 한 단계 낮추고 다시 협상하게 한다.
+  * \retval 기본 속도로 되돌려야 하면 True
+  */
+Bool_t Rs485_Baud_Check_Errors(u32_t ok, u32_t err)
+{
+  _baud.win_ok  += ok;
+  _baud.win_err += err;
+  if ((_baud.cur != RS485_BAUD_BASE) && (_baud.win_err >= RS485_BAUD_ERR_MAX))
+  {
+    _baud.cap     = (Rs485Baud_t)(_baud.cur - 1);
+    _baud.need    = (_baud.cap != RS485_BAUD_BASE) ? True : False;
+    _baud.win_ok  = 0U;
+    _baud.win_err = 0U;
+    _baud.fallbacks++;
+    return True;
+  }
+  if ((_baud.win_ok + _baud.win_err) >= RS485_BAUD_ERR_WINDOW)
+  {
+    _baud.win_ok  = 0U;
+    _baud.win_err = 0U;
+  }
+  return False;
+}
+
+/** \brief  슬레이브가 정상 frame을 받은 시각을 기록한다.
+  * \retval 없음
+  */
+void Rs485_Baud_Rx_Ok(u32_t tick)
+{
+  _baud.last_ok_tick = tick;
+}
+
+/** \brief  슬레이브가 빠른 속도에서 마스터를 놓쳤는지 확인한다.
+  * \retval 기본 속도가 아니고 RS485_BAUD_SILENCE_msec 동안 정상 frame이 없으면 True
+  */
+Bool_t Rs485_Baud_Is_Silent(u32_t tick)
+{
+  if (_baud.cur == RS485_BAUD_BASE)
+  {
+    return False;
+  }
+  if ((tick - _baud.last_ok_tick) < RS485_BAUD_SILENCE_msec)
+  {
+    return False;
+  }
+  _baud.fallbacks++;
+  return True;
+}
+
+/** \brief  협상 상태를 복사한다.
+  * \retval 없음
+  */
+void Rs485_Baud_Get_Info(Rs485BaudInfo_t * info)
+{
+  *info = _baud;
+}
+/** \} Rs485_Baud_Exported_Functions */
+
+/** \} Rs485_Baud */
+
+/** \} Applications */
+
+/*************** (C) COPYRIGHT SHALOM ENGINEERING CO., LTD. ****END OF FILE****/
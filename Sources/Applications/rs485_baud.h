@@ -0,0 +1,112 @@
+/** ****************************************************************************
+  * \file    rs485_baud.h
+  * \author  Jang Ho Jong
+  * \version V0.0.1
+  * \date    2026.10.17
+  * \brief   RS-485 Baud-Rate Negotiation Header
+  * ***************************************************************************/
+/*
+  - RS-485 통신 속도를 실행 중에 올리고, 오류가 나면 기본 속도로 되돌린다.
+
+  - 속도 : 38400(기본, 전원 투입 시 모든 보드 공통), 115200, 230400, 460800 bps
+    설정 최대 속도는 Rs485Ch1_BaudRate_Max(device.h)로 시작하고 콘솔 "BAUD"로 바꾼다.
+
+  - 협상(마스터 주도, 현재 속도에서):
+    1. 마스터가 보드마다 BAUD_PROPOSE(제안 속도)를 보낸다.
+    2. 슬레이브는 BAUD_ACK(제안 속도와 자기 최대 속도 중 낮은 값)로 답한다.
+    3. 모든 보드가 답하면 그 중 가장 낮은 속도를, 하나라도 답이 없으면 기본 속도를 고른다.
+    4. 마스터가 BAUD_COMMIT(broadcast)를 보내고 송신이 끝나면 모두 그 속도로 바꾼다.
+
+  - 되돌림:
+    마스터는 수신 frame 대비 CRC 오류/무응답을 RS485_BAUD_ERR_WINDOW frame 창으로 세어,
+    기본 속도보다 빠른 속도에서 RS485_BAUD_ERR_MAX 개 이상이면 BAUD_COMMIT(기본)을 보내고
+    기본 속도로 돌아간 뒤, 그 속도 아래 단계까지만 다시 협상한다.
+    슬레이브는 기본 속도가 아닐 때 RS485_BAUD_SILENCE_msec 동안 정상 frame이 없으면
+    스스로 기본 속도로 돌아간다(COMMIT을 못 받은 보드의 복귀). 마스터는 되돌린 뒤
+    RS485_BAUD_HOLD_msec 동안 polling을 쉬어 모든 슬레이브가 돌아올 시간을 준다.
+
+  - Rs485_Baud 접두어를 사용한다.
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef __RS485_BAUD_H
+#define __RS485_BAUD_H
+
+/* Includes ------------------------------------------------------------------*/
+#include "main.h"
+
+/** \addtogroup Applications
+  * \{ */
+
+/** \addtogroup Rs485_Baud
+  * \{ */
+
+/* Exported types ------------------------------------------------------------*/
+/** \brief 지원 통신 속도(frame에는 이 번호를 싣는다) */
+typedef enum
+{
+  kRS485_BAUD_38400 = 0,                               /**< 기본 속도 */
+  kRS485_BAUD_115200,
+  kRS485_BAUD_230400,
+  kRS485_BAUD_460800,
+  kNbrOfRs485Bauds
+}Rs485Baud_t;
+
+/** \brief 통신 속도 협상 상태 */
+typedef struct
+{
+Rs485Baud_t  cur;                                      /**< 현재 속도 */
+Rs485Baud_t  max;                                      /**< 설정 최대 속도 */
+Rs485Baud_t  cap;                                      /**< 되돌림 후 허용 최대 속도 */
+Rs485Baud_t  propose;                                  /**< 진행 중 협상의 제안 속도 */
+u08_t        nodes;                                    /**< 협상 대상 보드 수 */
+u08_t        acked;                                    /**< 답한 보드 bitmap(bit0 = ID 1) */
+Rs485Baud_t  agreed;                                   /**< 답한 속도 중 최소 */
+Bool_t       need;                                     /**< 협상 필요 */
+u32_t        win_ok;                                   /**< 오류 창 : 정상 frame */
+u32_t        win_err;                                  /**< 오류 창 : CRC 오류 + 무응답 */
+u32_t        last_ok_tick;                             /**< 슬레이브 : 마지막 정상 frame 시각 */
+u32_t        negotiations;                             /**< 협상 완료 수 */
+u32_t        fallbacks;                                /**< 오류로 되돌린 수 */
+}Rs485BaudInfo_t;
+
+/* Exported constants --------------------------------------------------------*/
+/** \defgroup Rs485_Baud_Exported_Constants RS-485 baud 공개 상수
+  * \{ */
+#define RS485_BAUD_BASE            kRS485_BAUD_38400
+#define RS485_BAUD_ERR_WINDOW      32U                 /**< 오류를 세는 frame 창 */
+#define RS485_BAUD_ERR_MAX         2U                  /**< 창 안에서 이만큼 오류면 되돌림(재시도 한도 전에) */
+#define RS485_BAUD_SILENCE_msec    300U                /**< 슬레이브 무수신 복귀 시간 */
+#define RS485_BAUD_HOLD_msec       (RS485_BAUD_SILENCE_msec + 100U)
+#define RS485_BAUD_SWITCH_msec     10U                 /**< 슬레이브가 COMMIT 수신 후 속도를 바꾸기까지 */
+/** \} Rs485_Baud_Exported_Constants */
+
+/* Exported macro ------------------------------------------------------------*/
+/* Exported variables --------------------------------------------------------*/
+/* Exported functions --------------------------------------------------------*/
+/** \defgroup Rs485_Baud_Exported_Functions RS-485 baud 공개 함수
+  * \{ */
+extern void        Rs485_Baud_Init(Rs485Baud_t max);
+extern u32_t       Rs485_Baud_Rate(Rs485Baud_t code);
+extern Rs485Baud_t Rs485_Baud_Code(u32_t rate);
+extern Rs485Baud_t Rs485_Baud_Current(void);
+extern Bool_t      Rs485_Baud_Set_Max(Rs485Baud_t max);
+extern Bool_t      Rs485_Baud_Need_Negotiation(void);
+extern Rs485Baud_t Rs485_Baud_Neg_Start(u08_t nodes);
+extern void        Rs485_Baud_Neg_Ack(u08_t id, Rs485Baud_t code);
+extern Rs485Baud_t Rs485_Baud_Neg_Result(void);
+extern void        Rs485_Baud_Commit(Rs485Baud_t code, u32_t tick);
+extern Rs485Baud_t Rs485_Baud_Accept(Rs485Baud_t proposed);
+extern Bool_t      Rs485_Baud_Check_Errors(u32_t ok, u32_t err);
+extern void        Rs485_Baud_Rx_Ok(u32_t tick);
+extern Bool_t      Rs485_Baud_Is_Silent(u32_t tick);
+extern void        Rs485_Baud_Get_Info(Rs485BaudInfo_t * info);
+/** \} Rs485_Baud_Exported_Functions */
+
+/** \} Rs485_Baud */
+
+/** \} Applications */
+
+#endif /* __RS485_BAUD_H */
+
+/*************** (C) COPYRIGHT SHALOM ENGINEERING CO., LTD. ****END OF FILE****/
@@ -0,0 +1,325 @@
+/** ****************************************************************************
+  * \file    rs485_diag.c
+  * \author  Jang Ho Jong
+  * \version V0.0.1
+  * \date    2026.10.17
+  * \brief   RS-485 Extended Diagnostic Frame Body
+  * ***************************************************************************/
+
+/* Includes ------------------------------------------------------------------*/
+#include "rs485_diag.h"
+#include "device.h"
+#include "sysmon_thread.h"
+#include "lib_crc16.h"
+
+/** \addtogroup Applications
+  * \{ */
+
+/** \defgroup Rs485_Diag RS-485 확장 진단
+  * \brief 슬레이브의 센서 전압, OSSD, Feedback, 온도, 고장 상태를 진단 frame으로 주고받습니다.
+  * \{ */
+
+/* Private typedef -----------------------------------------------------------*/
+/* Private define ------------------------------------------------------------*/
+#define DIAG_FRAME_STX             0x02U
+#define DIAG_FRAME_ETX             0x03U
+
+/* Private macro -------------------------------------------------------------*/
+/* Private variables ---------------------------------------------------------*/
+/** \defgroup Rs485_Diag_Private_Variables RS-485 진단 비공개 변수
+  * \{ */
+static Rs485DiagNode_t _node[RS485_DIAG_NODE_MAX + 1U];        /**< [0]은 사용하지 않음 */
+static u08_t           _nextId;                                /**< 마지막으로 요구한 보드 */
+static u16_t           _seq;                                   /**< 슬레이브 : 다음에 보낼 seq */
+/** \} Rs485_Diag_Private_Variables */
+
+/* Private function prototypes -----------------------------------------------*/
+/** \defgroup Rs485_Diag_Private_Functions RS-485 진단 비공개 함수
+  * \{ */
+static u32_t Rs485_Diag_Put16(u08_t buf[], u32_t i, u32_t v);
+static u32_t Rs485_Diag_Put32(u08_t buf[], u32_t i, u32_t v);
+static u16_t Rs485_Diag_Get16(const u08_t buf[], u32_t i);
+static u32_t Rs485_Diag_Get32(const u08_t buf[], u32_t i);
+/** \} Rs485_Diag_Private_Functions */
+
+/* Exported functions --------------------------------------------------------*/
+/** \addtogroup Rs485_Diag_Exported_Functions
+  * \{ */
+
+/** \brief  모은 진단과 요구 순서를 초기화한다.
+  * \retval 없음
+  */
+void Rs485_Diag_Init(void)
+{
+  Rs485_Diag_Clear();
+  _nextId = 0U;
+  _seq    = 0U;
+}
+
+/** \brief  자기 보드의 진단 내용을 모은다(슬레이브).
+  * \param  id   - 자기 dmpc_id
+  * \param  diag - 채울 구조체
+  * \note   부를 때마다 seq가 1 증가한다. OSSD/Feedback은 Device_Input_Snapshot()으로 한 시점 값을 쓴다.
+  * \retval 없음
+  */
+void Rs485_Diag_Collect(u08_t id, Rs485Diag_t * diag)
+{
+  InSnap_t     snap;
+  FaultInfo_t  info;
+  FaultStat_t  stat;
+  u32_t        count = 0U;
+  u08_t        ch;
+
+  diag->id             = id;
+  diag->seq            = _seq++;
+  diag->uptime_msec    = HAL_GetTick();
+  diag->ossd_confirmed = 0U;
+  for (ch = 0U; ch < RS485_DIAG_SENSOR_NUM; ch++)
+  {
+    diag->sensor_mv[ch] = Device_ADC_To_mV(ch, sdin[ch]->Sensor_Adc);
+    if (sdin[ch]->Ossd_Confirmed == True)
+    {
+      diag->ossd_confirmed |= (u08_t)(1U << ch);
+    }
+  }
+  Device_Input_Snapshot(&snap);
+  diag->ossd1      = snap.ossd1;
+  diag->ossd2      = snap.ossd2;
+  diag->relay_fb   = snap.fb;
+  diag->temper_raw = g_device_temper_raw;
+
+  Fault_Get_Info(&info);
+  for (ch = 0U; ch < (u08_t)kNbrOfFaults; ch++)
+  {
+    Fault_Get_Stat((FaultCode_t)ch, &stat);
+    count += stat.count;
+  }
+  diag->fault_latched = info.latched;
+  diag->fault_count   = (count > 0xFFFFU) ? 0xFFFFU : (u16_t)count;
+  diag->fault_level   = (u08_t)info.level;
+}
+
+/** \brief  진단 frame을 만든다.
+  * \param  diag - 보낼 진단
+  * \param  buf  - frame을 넣을 버퍼
+  * \param  size - buf 크기
+  * \retval frame 길이, buf가 작으면 0
+  */
+u32_t Rs485_Diag_Build_Frame(const Rs485Diag_t * diag, u08_t buf[], u32_t size)
+{
+  u32_t i = 0U;
+  u08_t ch;
+  u16_t crc;
+
+  if (size < RS485_DIAG_FRAME_SIZE)
+  {
+    return 0U;
+  }
+  buf[i++] = DIAG_FRAME_STX;
+  buf[i++] = RS485_DIAG_PAYLOAD_SIZE;
+  buf[i++] = (u08_t)(diag->seq & 0xFFU);               /* heartbit */
+  buf[i++] = diag->id;
+  buf[i++] = RS485_DIAG_MSG;
+  buf[i++] = RS485_DIAG_FRAME_VER;
+  i = Rs485_Diag_Put16(buf, i, diag->seq);
+  i = Rs485_Diag_Put32(buf, i, diag->uptime_msec);
+  for (ch = 0U; ch < RS485_DIAG_SENSOR_NUM; ch++)
+  {
+    i = Rs485_Diag_Put16(buf, i, diag->sensor_mv[ch]);
+  }
+  buf[i++] = diag->ossd1;
+  buf[i++] = diag->ossd2;
+  buf[i++] = diag->ossd_confirmed;
+  buf[i++] = diag->relay_fb;
+  i = Rs485_Diag_Put16(buf, i, (u16_t)diag->temper_raw);
+  i = Rs485_Diag_Put32(buf, i, diag->fault_latched);
+  i = Rs485_Diag_Put16(buf, i, diag->fault_count);
+  buf[i++] = diag->fault_level;
+  crc = Crc16_Krs(&buf[1], i - 1U);                    /* LEN ~ PAYLOAD */
+  buf[i++] = (u08_t)(crc >> 8);
+  buf[i++] = (u08_t)(crc & 0xFFU);
+  buf[i++] = DIAG_FRAME_ETX;
+  return i;
+}
+
+/** \brief  parser가 확인한 frame에서 진단 내용을 꺼낸다.
+  * \param  frame - STX ~ ETX 원본(CRC는 parser가 확인함)
+  * \param  len   - frame 길이
+  * \retval 진단 frame이고 버전이 맞으면 True
+  */
+Bool_t Rs485_Diag_Parse_Frame(const u08_t frame[], u32_t len, Rs485Diag_t * diag)
+{
+  u32_t i = 6U;
+  u08_t ch;
+
+  if ((len != RS485_DIAG_FRAME_SIZE) || (frame[4] != RS485_DIAG_MSG) || (frame[5] != RS485_DIAG_FRAME_VER))
+  {
+    return False;
+  }
+  diag->id          = frame[3];
+  diag->seq         = Rs485_Diag_Get16(frame, i);
+  diag->uptime_msec = Rs485_Diag_Get32(frame, i + 2U);
+  i += 6U;
+  for (ch = 0U; ch < RS485_DIAG_SENSOR_NUM; ch++)
+  {
+    diag->sensor_mv[ch] = Rs485_Diag_Get16(frame, i);
+    i += 2U;
+  }
+  diag->ossd1          = frame[i++];
+  diag->ossd2          = frame[i++];
+  diag->ossd_confirmed = frame[i++];
+  diag->relay_fb       = frame[i++];
+  diag->temper_raw     = (i16_t)Rs485_Diag_Get16(frame, i);
+  diag->fault_latched  = Rs485_Diag_Get32(frame, i + 2U);
+  diag->fault_count    = Rs485_Diag_Get16(frame, i + 6U);
+  diag->fault_level    = frame[i + 8U];
+  return True;
+}
+
+/** \brief  다음에 진단을 요구할 보드를 고른다(마스터).
+  * \param  nodes - 연결된 보드 수
+  * \retval 보드 ID(1 ~ nodes), 보드가 없으면 0
+  */
+u08_t Rs485_Diag_Next_Id(u08_t nodes)
+{
+  if (nodes > RS485_DIAG_NODE_MAX)
+  {
+    nodes = RS485_DIAG_NODE_MAX;
+  }
+  if (nodes == 0U)
+  {
+    return 0U;
+  }
+  _nextId = (_nextId >= nodes) ? 1U : (u08_t)(_nextId + 1U);
+  return _nextId;
+}
+
+/** \brief  진단 요구를 보냈음을 기록한다.
+  * \retval 없음
+  */
+void Rs485_Diag_Sent(u08_t id)
+{
+  if ((id != 0U) && (id <= RS485_DIAG_NODE_MAX))
+  {
+    _node[id].requests++;
+  }
+}
+
+/** \brief  진단 요구에 응답이 없었음을 기록한다.
+  * \note   진단은 안전 판정에 쓰지 않으므로 fault를 올리지 않는다.
+  * \retval 없음
+  */
+void Rs485_Diag_Timeout(u08_t id)
+{
+  if ((id != 0U) && (id <= RS485_DIAG_NODE_MAX))
+  {
+    _node[id].timeouts++;
+  }
+}
+
+/** \brief  받은 진단을 보드별로 저장한다.
+  * \param  diag - Rs485_Diag_Parse_Frame()으로 꺼낸 진단
+  * \param  tick - 수신 시각(HAL_GetTick())
+  * \note   seq가 건너뛰었으면 그만큼 잃은 frame으로 센다. 보드가 재시작해 seq가 줄면 세지 않는다.
+  * \retval 없음
+  */
+void Rs485_Diag_Store(const Rs485Diag_t * diag, u32_t tick)
+{
+  Rs485DiagNode_t * n;
+  u16_t gap;
+
+  if ((diag->id == 0U) || (diag->id > RS485_DIAG_NODE_MAX))
+  {
+    return;
+  }
+  n = &_node[diag->id];
+  if ((n->valid == True) && (diag->uptime_msec >= n->last.uptime_msec))
+  {
+    gap = (u16_t)(diag->seq - n->last.seq);
+    if (gap > 1U)
+    {
+      n->seq_lost += (u32_t)(gap - 1U);
+    }
+  }
+  n->last    = *diag;
+  n->valid   = True;
+  n->rx_tick = tick;
+  n->frames++;
+}
+
+/** \brief  보드 하나의 진단을 복사한다.
+  * \retval id가 범위 안이면 True
+  */
+Bool_t Rs485_Diag_Get_Node(u08_t id, Rs485DiagNode_t * node)
+{
+  if ((id == 0U) || (id > RS485_DIAG_NODE_MAX))
+  {
+    return False;
+  }
+  *node = _node[id];
+  return True;
+}
+
+/** \brief  모은 진단과 통계를 지운다.
+  * \retval 없음
+  */
+void Rs485_Diag_Clear(void)
+{
+  u08_t i;
+
+  for (i = 0U; i <= RS485_DIAG_NODE_MAX; i++)
+  {
+    _node[i].valid    = False;
+    _node[i].rx_tick  = 0U;
+    _node[i].requests = 0U;
+    _node[i].frames   = 0U;
+    _node[i].timeouts = 0U;
+    _node[i].seq_lost = 0U;
+  }
+}
+/** \} Rs485_Diag_Exported_Functions */
+
+/** \addtogroup Rs485_Diag_Private_Functions
+  * \{ */
+
+/** \brief  v를 16bit big endian으로 넣는다.
+  * \retval 다음 위치
+  */
+static u32_t Rs485_Diag_Put16(u08_t buf[], u32_t i, u32_t v)
+{
+  buf[i++] = (u08_t)((v >> 8) & 0xFFU);
+  buf[i++] = (u08_t)(v & 0xFFU);
+  return i;
+}
+
+/** \brief  v를 32bit big endian으로 넣는다.
+  * \retval 다음 위치
+  */
+static u32_t Rs485_Diag_Put32(u08_t buf[], u32_t i, u32_t v)
+{
+  i = Rs485_Diag_Put16(buf, i, v >> 16);
+  return Rs485_Diag_Put16(buf, i, v & 0xFFFFU);
+}
+
+/** \brief  16bit big endian 값을 읽는다.
+  * \retval 값
+  */
+static u16_t Rs485_Diag_Get16(const u08_t buf[], u32_t i)
+{
+  return (u16_t)(((u16_t)buf[i] << 8) | buf[i + 1U]);
+}
+
+/** \brief  32bit big endian 값을 읽는다.
+  * \retval 값
+  */
+static u32_t Rs485_Diag_Get32(const u08_t buf[], u32_t i)
+{
+  return ((u32_t)Rs485_Diag_Get16(buf, i) << 16) | Rs485_Diag_Get16(buf, i + 2U);
+}
+/** \} Rs485_Diag_Private_Functions */
+
+/** \} Rs485_Diag */
+
+/** \} Applications */
+
+/*************** (C) COPYRIGHT SHALOM ENGINEERING CO., LTD. ****END OF FILE****/
@@ -0,0 +1,104 @@
+/** ****************************************************************************
+  * \file    rs485_diag.h
+  * \author  Jang Ho Jong
+  * \version V0.0.1
+  * \date    2026.10.17
+  * \brief   RS-485 Extended Diagnostic Frame Header
+  * ***************************************************************************/
+/*
+  - 슬레이브(DM/PC 보드)의 센서 상태를 마스터가 저우선으로 모아 콘솔에 보여준다.
+    안전 polling(REQUEST/BROADCAST)과 같은 bus를 쓰며, 마스터는 polling cycle 사이에
+    RS485_DIAG_PERIOD_msec마다 보드 하나씩 돌아가며 DIAG_REQUEST를 보낸다.
+
+  - 진단 frame(수신 parser와 같은 형식, big endian) :
+    STX | LEN | heartbit | id | msg_type | ver | PAYLOAD | CRC_H | CRC_L | ETX
+    heartbit, id, msg_type의 위치는 Curs485_Packet_t와 같아 같은 검증 경로를 쓴다.
+    heartbit = seq 하위 byte, msg_type = RS485_DIAG_MSG, ver = RS485_DIAG_FRAME_VER
+    PAYLOAD : seq(2) | uptime msec(4) | sensor mV(2 x 4) | ossd1 | ossd2 | ossd 확정
+              | relay feedback | 온도 TMP117 원본(2, 1/128 ℃, signed) | latch 고장 bit(4)
+              | 고장 등록 누계(2, 0xFFFF 포화) | 고장 심각도
+
+  - 버전이 다른 frame은 버린다. 필드를 늘릴 때는 ver을 올리고 LEN을 바꾼다.
+  - Rs485_Diag 접두어를 사용한다.
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef __RS485_DIAG_H
+#define __RS485_DIAG_H
+
+/* Includes ------------------------------------------------------------------*/
+#include "main.h"
+
+/** \addtogroup Applications
+  * \{ */
+
+/** \addtogroup Rs485_Diag
+  * \{ */
+
+/* Exported constants --------------------------------------------------------*/
+/** \defgroup Rs485_Diag_Exported_Constants RS-485 진단 공개 상수
+  * \{ */
+#define RS485_DIAG_NODE_MAX        6U                  /**< dmpc_id 1 ~ 6 */
+#define RS485_DIAG_SENSOR_NUM      4U                  /**< 센서 채널 수(kNbrOfSIs) */
+#define RS485_DIAG_MSG             0x09U               /**< 진단 frame msg_type(요구는 DIAG_REQUEST) */
+#define RS485_DIAG_FRAME_VER       0x01U
+#define RS485_DIAG_PAYLOAD_SIZE    31U
+#define RS485_DIAG_FRAME_SIZE      (RS485_DIAG_PAYLOAD_SIZE + 5U)
+#define RS485_DIAG_PERIOD_msec     200U                /**< 진단 요구 간격(보드 하나씩) */
+#define RS485_DIAG_REPLY_usec      10000U              /**< 슬레이브는 superloop에서 응답하므로 RTO에 더하는 여유 */
+/** \} Rs485_Diag_Exported_Constants */
+
+/* Exported types ------------------------------------------------------------*/
+/** \brief 보드 하나의 진단 내용 */
+typedef struct
+{
+u08_t   id;
+u16_t   seq;                                           /**< 보낼 때마다 1 증가 */
+u32_t   uptime_msec;                                   /**< HAL_GetTick() */
+u16_t   sensor_mv[RS485_DIAG_SENSOR_NUM];              /**< 센서 전류 전압(mV) */
+u08_t   ossd1;                                         /**< bit ch : OSSD1 High */
+u08_t   ossd2;                                         /**< bit ch : OSSD2 High */
+u08_t   ossd_confirmed;                                /**< bit ch : M-of-N 확정 */
+u08_t   relay_fb;                                      /**< bit kRYFBI_x : Feedback */
+i16_t   temper_raw;                                    /**< TMP117 원본(1/128 ℃) */
+u32_t   fault_latched;                                 /**< bit FaultCode_t */
+u16_t   fault_count;                                   /**< 고장 등록 누계 */
+u08_t   fault_level;                                   /**< FaultSev_t */
+}Rs485Diag_t;
+
+/** \brief 마스터가 모은 보드별 진단 */
+typedef struct
+{
+Rs485Diag_t last;                                      /**< 마지막으로 받은 진단 */
+Bool_t      valid;                                     /**< 한번이라도 받았으면 True */
+u32_t       rx_tick;                                   /**< 마지막 수신 시각(HAL_GetTick()) */
+u32_t       requests;                                  /**< 보낸 요구 수 */
+u32_t       frames;                                    /**< 받은 진단 frame 수 */
+u32_t       timeouts;                                  /**< 무응답 수 */
+u32_t       seq_lost;                                  /**< seq 건너뜀으로 센 잃은 frame 수 */
+}Rs485DiagNode_t;
+
+/* Exported macro ------------------------------------------------------------*/
+/* Exported variables --------------------------------------------------------*/
+/* Exported functions --------------------------------------------------------*/
+/** \defgroup Rs485_Diag_Exported_Functions RS-485 진단 공개 함수
+  * \{ */
+extern void   Rs485_Diag_Init(void);
+extern void   Rs485_Diag_Collect(u08_t id, Rs485Diag_t * diag);
+extern u32_t  Rs485_Diag_Build_Frame(const Rs485Diag_t * diag, u08_t buf[], u32_t size);
+extern Bool_t Rs485_Diag_Parse_Frame(const u08_t frame[], u32_t len, Rs485Diag_t * diag);
+extern u08_t  Rs485_Diag_Next_Id(u08_t nodes);
+extern void   Rs485_Diag_Sent(u08_t id);
+extern void   Rs485_Diag_Timeout(u08_t id);
+extern void   Rs485_Diag_Store(const Rs485Diag_t * diag, u32_t tick);
+extern Bool_t Rs485_Diag_Get_Node(u08_t id, Rs485DiagNode_t * node);
+extern void   Rs485_Diag_Clear(void);
+/** \} Rs485_Diag_Exported_Functions */
+
+/** \} Rs485_Diag */
+
+/** \} Applications */
+
+#endif /* __RS485_DIAG_H */
+
+/*************** (C) COPYRIGHT SHALOM ENGINEERING CO., LTD. ****END OF FILE****/
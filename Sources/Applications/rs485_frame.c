@@ -0,0 +1,372 @@
+/** ****************************************************************************
+  * \file    rs485_frame.c
+  * \author  Jang Ho Jong
+  * \version V0.0.1
+  * \date    2026.10.17
+  * \brief   RS-485 Frame Parser Body
+  * ***************************************************************************/
+
+/* Includes ------------------------------------------------------------------*/
+#include "rs485_frame.h"
+#include "lib_crc16.h"
+
+/** \addtogroup Applications
+  * \{ */
+
+/** \defgroup Rs485_Frame RS-485 frame parser
+  * \brief 수신 byte를 한개씩 해석하여 STX/LEN/PAYLOAD/CRC/ETX frame을 찾아냅니다.
+  * \{ */
+
+/* Private typedef -----------------------------------------------------------*/
+/** \brief parser 수신 단계 */
+enum
+{
+  kRX_STX = 0,
+  kRX_LEN,
+  kRX_BODY,                                            /* PAYLOAD + CRC */
+  kRX_ETX
+};
+
+/** \brief Rs485_Frame_Step() 결과 */
+enum
+{
+  kRX_MORE = 0,
+  kRX_DONE,
+  kRX_FAIL
+};
+
+/* Private define ------------------------------------------------------------*/
+/* Private macro -------------------------------------------------------------*/
+/* Private variables ---------------------------------------------------------*/
+/** \defgroup Rs485_Frame_Private_Variables RS-485 frame 비공개 변수
+  * \{ */
+
+static const char_t * const rs485_drop_name[kNbrOfRs485Drops] =
+{
+  "NOISE", "LEN", "ETX", "CRC", "QUEUE", "PARTIAL"
+};
+/** \} Rs485_Frame_Private_Variables */
+
+/* Private function prototypes -----------------------------------------------*/
+/** \defgroup Rs485_Frame_Private_Functions RS-485 frame 비공개 함수
+  * \{ */
+static u08_t Rs485_Frame_Step(Rs485Parser_t * p, u08_t byte, Rs485Drop_t * why);
+static void  Rs485_Frame_Push(Rs485Parser_t * p);
+/** \} Rs485_Frame_Private_Functions */
+
+/* Exported functions --------------------------------------------------------*/
+/** \addtogroup Rs485_Frame_Exported_Functions
+  * \{ */
+
+/** \brief  parser를 STX 대기 상태로 만들고 queue와 통계를 지운다.
+  * \param  p - parser 구조체 포인터
+  * \retval 없음
+  */
+void Rs485_Frame_Init(Rs485Parser_t * p)
+{
+  p->state = kRX_STX;
+  p->idx   = 0U;
+  p->need  = 0U;
+  p->q_in  = 0U;
+  p->q_out = 0U;
+  Rs485_Frame_Clear_Stat(p);
+}
+
+/** \brief  수신 byte 한개를 해석한다.
+  * \param  p    - parser 구조체 포인터
+  * \param  byte - 수신 byte
+  * \note   frame이 틀리면 이미 받은 byte 중 첫 STX 다음 STX부터 다시 해석한다.
+  *         다시 해석할 byte는 많아야 RS485_FRAME_MAX 개이므로 ISR에서 호출해도 시간이 제한된다.
+  * \retval 없음
+  */
+void Rs485_Frame_Feed(Rs485Parser_t * p, u08_t byte)
+{
+  u08_t        pend[RS485_FRAME_MAX];                  /* 다시 해석할 byte */
+  u32_t        n = 1U;
+  u32_t        k = 0U;
+  u32_t        j;
+  u32_t        m;
+  u32_t        rest;
+  u08_t        r;
+  Rs485Drop_t  why = kRS485_DROP_NOISE;
+
+  pend[0] = byte;
+  while (k < n)
+  {
+    r = Rs485_Frame_Step(p, pend[k], &why);
+    k++;
+    if (r == kRX_DONE)
+    {
+      Rs485_Frame_Push(p);
+      p->state = kRX_STX;
+      p->idx   = 0U;
+    }
+    else if (r == kRX_FAIL)
+    {
+      p->drop[why]++;
+      /* 받은 byte 중 두번째 이후 STX 위치를 찾는다. 없으면 모두 버린다. */
+      for (j = 1U; (j < p->idx) && (p->buf[j] != RS485_FRAME_STX); j++)
+      {
+      }
+      m    = p->idx - j;
+      rest = n - k;
+      /* pend = buf[j..idx) + pend[k..n) : 합은 RS485_FRAME_MAX 보다 작다. */
+      if (m > k)
+      {
+        for (j = rest; j > 0U; j--)
+        {
+          pend[m + j - 1U] = pend[k + j - 1U];
+        }
+      }
+      else
+      {
+        for (j = 0U; j < rest; j++)
+        {
+          pend[m + j] = pend[k + j];
+        }
+      }
+      for (j = 0U; j < m; j++)
+      {
+        pend[j] = p->buf[(p->idx - m) + j];
+      }
+      n = m + rest;
+      k = 0U;
+      p->state = kRX_STX;
+      p->idx   = 0U;
+    }
+    else
+    {
+    }
+  }
+}
+
+/** \brief  수신 buffer를 차례로 해석한다.
+  * \param  p   - parser 구조체 포인터
+  * \param  buf - 수신 byte 배열
+  * \param  n   - byte 수
+  * \retval 없음
+  */
+void Rs485_Frame_Feed_Buf(Rs485Parser_t * p, const u08_t * buf, u32_t n)
+{
+  u32_t i;
+
+  for (i = 0U; i < n; i++)
+  {
+    Rs485_Frame_Feed(p, buf[i]);
+  }
+}
+
+/** \brief  완성된 frame을 queue에서 꺼낸다.
+  * \param  p     - parser 구조체 포인터
+  * \param  frame - 복사할 frame 구조체 포인터
+  * \retval True - 꺼낸 frame 있음
+  */
+Bool_t Rs485_Frame_Get(Rs485Parser_t * p, Rs485Frame_t * frame)
+{
+  const Rs485Frame_t * f;
+  u32_t i;
+
+  if (p->q_in == p->q_out)
+  {
+    return False;
+  }
+  f = &p->queue[p->q_out & (RS485_FRAME_QUEUE_SIZE - 1U)];
+  frame->len = f->len;
+  for (i = 0U; i < f->len; i++)
+  {
+    frame->data[i] = f->data[i];
+  }
+  p->q_out++;
+  return True;
+}
+
+/** \brief  수신 버퍼에서 다음 frame을 찾아 복사하지 않고 view로 돌려준다.
+  * \param  p    - parser 구조체 포인터
+  * \param  buf  - 드라이버 수신 버퍼
+  * \param  n    - buf에 받은 byte 수
+  * \param  pos  - 이어서 볼 위치(처음 0), 돌아올 때 다음 위치로 바뀐다
+  * \param  view - 찾은 frame
+  * \note   STX 대기 중이고 frame 전체가 buf 안에 있으면 buf에서 바로 CRC를 계산하고 확인한다.
+  *         그 밖의 byte는 Rs485_Frame_Feed()로 넣고, 완성되면 queue 자리를 view로 돌려준다.
+  *         같은 parser의 queue를 Rs485_Frame_Get()과 함께 쓰지 않는다.
+  * \retval True - frame 있음
+  */
+Bool_t Rs485_Frame_Scan(Rs485Parser_t * p, const u08_t * buf, u32_t n, u32_t * pos, Rs485View_t * view)
+{
+  const Rs485Frame_t * f;
+  u32_t i = *pos;
+  u32_t total;
+  u16_t crc;
+
+  for (;;)
+  {
+    if (p->q_in != p->q_out)                           /* 한 byte씩 해석해 완성된 frame */
+    {
+      f = &p->queue[p->q_out & (RS485_FRAME_QUEUE_SIZE - 1U)];
+      view->data = f->data;
+      view->len  = f->len;
+      p->q_out++;
+      *pos = i;
+      return True;
+    }
+    if (i >= n)
+    {
+      break;
+    }
+    if ((p->idx == 0U) && (buf[i] == RS485_FRAME_STX) && ((i + 1U) < n) &&
+        (buf[i + 1U] != 0U) && (buf[i + 1U] <= RS485_FRAME_PAYLOAD_MAX))
+    {
+      total = (u32_t)buf[i + 1U] + RS485_FRAME_OVERHEAD;
+      if (((i + total) <= n) && (buf[i + total - 1U] == RS485_FRAME_ETX))
+      {
+        crc = Crc16_Krs(&buf[i + 1U], total - 4U);    /* LEN ~ PAYLOAD */
+        if ((buf[i + total - 3U] == (u08_t)(crc >> 8)) && (buf[i + total - 2U] == (u08_t)(crc & 0xFFU)))
+        {
+          p->frames++;
+          view->data = &buf[i];
+          view->len  = (u08_t)total;
+          *pos = i + total;
+          return True;
+        }
+      }
+    }
+    Rs485_Frame_Feed(p, buf[i]);                       /* 이어지는 frame, 잘린 frame, 오류 frame */
+    i++;
+  }
+  *pos = i;
+  return False;
+}
+
+/** \brief  받는 중인 frame을 버리고 STX 대기 상태로 돌아간다.
+  * \param  p - parser 구조체 포인터
+  * \note   통신 재시작, 수신 오류 등 byte 흐름이 끊겼을 때 호출한다. queue는 유지한다.
+  * \retval 없음
+  */
+void Rs485_Frame_Reset(Rs485Parser_t * p)
+{
+  if (p->idx != 0U)
+  {
+    p->drop[kRS485_DROP_PARTIAL]++;
+  }
+  p->state = kRX_STX;
+  p->idx   = 0U;
+}
+
+/** \brief  정상 frame 수와 이유별 버린 수를 지운다.
+  * \param  p - parser 구조체 포인터
+  * \retval 없음
+  */
+void Rs485_Frame_Clear_Stat(Rs485Parser_t * p)
+{
+  u32_t i;
+
+  p->frames = 0U;
+  for (i = 0U; i < kNbrOfRs485Drops; i++)
+  {
+    p->drop[i] = 0U;
+  }
+}
+
+/** \brief  버린 이유 이름을 돌려준다.
+  * \retval 이름 문자열
+  */
+const char_t * Rs485_Frame_Drop_Name(Rs485Drop_t reason)
+{
+  return (reason < kNbrOfRs485Drops) ? rs485_drop_name[reason] : "?";
+}
+/** \} Rs485_Frame_Exported_Functions */
+
+/* Private functions ---------------------------------------------------------*/
+/** \addtogroup Rs485_Frame_Private_Functions
+  * \{ */
+
+/** \brief  parser 상태를 byte 한개만큼 진행한다.
+  * \param  why - kRX_FAIL일 때 버린 이유
+  * \retval kRX_MORE, kRX_DONE(p->buf에 frame 완성), kRX_FAIL
+  */
+static u08_t Rs485_Frame_Step(Rs485Parser_t * p, u08_t byte, Rs485Drop_t * why)
+{
+  switch (p->state)
+  {
+  case kRX_STX :
+    if (byte != RS485_FRAME_STX)
+    {
+      p->drop[kRS485_DROP_NOISE]++;
+      return kRX_MORE;
+    }
+    p->buf[0] = byte;
+    p->idx    = 1U;
+    p->crc    = CRC16_KRS_INIT;
+    p->state  = kRX_LEN;
+    return kRX_MORE;
+
+  case kRX_LEN :
+    p->buf[p->idx++] = byte;
+    if ((byte == 0U) || (byte > RS485_FRAME_PAYLOAD_MAX))
+    {
+      *why = kRS485_DROP_LEN;
+      return kRX_FAIL;
+    }
+    p->crc   = Crc16_Krs_Byte(p->crc, byte);
+    p->need  = (u08_t)(byte + RS485_FRAME_OVERHEAD);
+    p->state = kRX_BODY;
+    return kRX_MORE;
+
+  case kRX_BODY :
+    if (p->idx < (u08_t)(p->need - 3U))                /* PAYLOAD : CRC를 받는 대로 누적 */
+    {
+      p->crc = Crc16_Krs_Byte(p->crc, byte);
+    }
+    p->buf[p->idx++] = byte;
+    if (p->idx >= (u08_t)(p->need - 1U))
+    {
+      p->state = kRX_ETX;
+    }
+    return kRX_MORE;
+
+  default :
+    p->buf[p->idx++] = byte;
+    if (byte != RS485_FRAME_ETX)
+    {
+      *why = kRS485_DROP_ETX;
+      return kRX_FAIL;
+    }
+    /* CRC : LEN ~ PAYLOAD, 수신하면서 누적한 값과 비교(두번 읽지 않음) */
+    if ((p->buf[p->need - 3U] != (u08_t)(p->crc >> 8)) || (p->buf[p->need - 2U] != (u08_t)(p->crc & 0xFFU)))
+    {
+      *why = kRS485_DROP_CRC;
+      return kRX_FAIL;
+    }
+    return kRX_DONE;
+  }
+}
+
+/** \brief  p->buf의 완성 frame을 queue에 넣는다.
+  * \retval 없음
+  */
+static void Rs485_Frame_Push(Rs485Parser_t * p)
+{
+  Rs485Frame_t * f;
+  u32_t i;
+
+  if ((p->q_in - p->q_out) >= RS485_FRAME_QUEUE_SIZE)
+  {
+    p->drop[kRS485_DROP_QUEUE]++;
+    return;
+  }
+  f = &p->queue[p->q_in & (RS485_FRAME_QUEUE_SIZE - 1U)];
+  f->len = p->idx;
+  for (i = 0U; i < p->idx; i++)
+  {
+    f->data[i] = p->buf[i];
+  }
+  p->q_in++;
+  p->frames++;
+}
+/** \} Rs485_Frame_Private_Functions */
+
+/** \} Rs485_Frame */
+
+/** \} Applications */
+
+/*************** (C) COPYRIGHT SHALOM ENGINEERING CO., LTD. ****END OF FILE****/
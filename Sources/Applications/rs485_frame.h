@@ -0,0 +1,121 @@
+/** ****************************************************************************
+  * \file    rs485_frame.h
+  * \author  Jang Ho Jong
+  * \version V0.0.1
+  * \date    2026.10.17
+  * \brief   RS-485 Frame Parser Header
+  * ***************************************************************************/
+/*
+  - RS-485 수신 frame parser
+
+  - Frame 구성:
+    STX(0x02) | LEN | PAYLOAD(LEN byte) | CRC_H | CRC_L | ETX(0x03)
+    CRC16(KRS, lib_crc16)는 LEN ~ PAYLOAD 끝까지 byte를 받는 대로 누적 계산한다.
+
+  - 동작:
+    수신 byte를 한개씩 Rs485_Frame_Feed()로 넣는다(RXNE ISR, DMA ring, thread 어디서든 가능).
+    STX를 찾을 때까지의 byte는 noise로 세고 버린다.
+    LEN, ETX, CRC 중 하나라도 틀리면 그 frame을 버리고, 이미 받은 byte 중 다음 STX부터
+    다시 해석한다(resync). 따라서 앞쪽 noise byte나 잘린 frame이 뒤의 정상 frame을 잃게 하지 않는다.
+    완성된 frame은 RS485_FRAME_QUEUE_SIZE 개의 queue에 넣고 Rs485_Frame_Get()으로 꺼낸다.
+    한번의 수신 burst에 여러 frame이 있어도 모두 queue에 들어간다.
+
+  - Queue는 Feed 쪽 하나, Get 쪽 하나(single producer/consumer)만 사용해야 한다.
+
+  - 복사 없는 수신(Rs485_Frame_Scan):
+    superloop에서 드라이버 수신 버퍼를 그대로 넘기면, 버퍼 안에 온전히 들어 있는 frame은
+    그 자리에서 LEN, CRC, ETX를 확인하고 버퍼를 가리키는 읽기 전용 view(Rs485View_t)로 돌려준다.
+    앞 수신 묶음에서 이어지는 frame이나 틀린 frame만 Rs485_Frame_Feed()로 한 byte씩 해석하므로
+    resync와 버린 이유 통계는 Feed와 같다. view는 다음 Scan/Feed 호출과 수신 버퍼를 비우기 전까지만 유효하다.
+
+  - Rs485_Frame 접두어를 사용한다.
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef __RS485_FRAME_H
+#define __RS485_FRAME_H
+
+/* Includes ------------------------------------------------------------------*/
+#include "main.h"
+
+/** \addtogroup Applications
+  * \{ */
+
+/** \addtogroup Rs485_Frame
+  * \{ */
+
+/* Exported constants --------------------------------------------------------*/
+/** \defgroup Rs485_Frame_Exported_Constants RS-485 frame 공개 상수
+  * \{ */
+#define RS485_FRAME_STX            0x02U
+#define RS485_FRAME_ETX            0x03U
+#define RS485_FRAME_OVERHEAD       5U                  /**< STX, LEN, CRC_H, CRC_L, ETX */
+#define RS485_FRAME_PAYLOAD_MAX    48U                 /**< 허용 LEN 최대값 */
+#define RS485_FRAME_MAX            (RS485_FRAME_PAYLOAD_MAX + RS485_FRAME_OVERHEAD)
+#define RS485_FRAME_QUEUE_SIZE     8U                  /**< 2의 승수, TDMA 6개 응답이 한 수신 묶음에 올 수 있음 */
+/** \} Rs485_Frame_Exported_Constants */
+
+/* Exported types ------------------------------------------------------------*/
+/** \brief frame을 버린 이유 */
+typedef enum
+{
+  kRS485_DROP_NOISE = 0,                               /**< STX 밖의 byte(byte 단위) */
+  kRS485_DROP_LEN,                                     /**< LEN이 0이거나 최대값 초과 */
+  kRS485_DROP_ETX,                                     /**< ETX 위치의 byte가 ETX 아님 */
+  kRS485_DROP_CRC,                                     /**< CRC 불일치 */
+  kRS485_DROP_QUEUE,                                   /**< 완성 frame queue full */
+  kRS485_DROP_PARTIAL,                                 /**< Reset으로 버린 미완성 frame */
+  kNbrOfRs485Drops
+}Rs485Drop_t;
+
+/** \brief 완성된 frame(STX ~ ETX 원본) */
+typedef struct
+{
+u08_t   len;                                           /**< frame 전체 길이 */
+u08_t   data[RS485_FRAME_MAX];
+}Rs485Frame_t;
+
+/** \brief 완성된 frame의 읽기 전용 view(수신 버퍼 또는 parser 안을 가리킴) */
+typedef struct
+{
+const u08_t * data;                                    /**< STX ~ ETX */
+u08_t         len;                                     /**< frame 전체 길이 */
+}Rs485View_t;
+
+/** \brief frame parser 상태 */
+typedef struct
+{
+u08_t          state;
+u08_t          idx;                                    /* buf에 받은 byte 수 */
+u08_t          need;                                   /* 현재 frame 전체 길이 */
+u16_t          crc;                                    /* LEN부터 누적한 CRC16(KRS) */
+u08_t          buf[RS485_FRAME_MAX];
+Rs485Frame_t   queue[RS485_FRAME_QUEUE_SIZE];
+volatile u32_t q_in;
+volatile u32_t q_out;
+u32_t          frames;                                 /**< 정상 frame 수 */
+u32_t          drop[kNbrOfRs485Drops];                 /**< 이유별 버린 수 */
+}Rs485Parser_t;
+
+/* Exported macro ------------------------------------------------------------*/
+/* Exported variables --------------------------------------------------------*/
+/* Exported functions --------------------------------------------------------*/
+/** \defgroup Rs485_Frame_Exported_Functions RS-485 frame 공개 함수
+  * \{ */
+extern void           Rs485_Frame_Init(Rs485Parser_t * p);
+extern void           Rs485_Frame_Feed(Rs485Parser_t * p, u08_t byte);
+extern void           Rs485_Frame_Feed_Buf(Rs485Parser_t * p, const u08_t * buf, u32_t n);
+extern Bool_t         Rs485_Frame_Get(Rs485Parser_t * p, Rs485Frame_t * frame);
+extern Bool_t         Rs485_Frame_Scan(Rs485Parser_t * p, const u08_t * buf, u32_t n, u32_t * pos, Rs485View_t * view);
+extern void           Rs485_Frame_Reset(Rs485Parser_t * p);
+extern void           Rs485_Frame_Clear_Stat(Rs485Parser_t * p);
+extern const char_t * Rs485_Frame_Drop_Name(Rs485Drop_t reason);
+/** \} Rs485_Frame_Exported_Functions */
+
+/** \} Rs485_Frame */
+
+/** \} Applications */
+
+#endif /* __RS485_FRAME_H */
+
+/*************** (C) COPYRIGHT SHALOM ENGINEERING CO., LTD. ****END OF FILE****/
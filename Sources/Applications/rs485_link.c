@@ -0,0 +1,343 @@
+/** ****************************************************************************
+  * \file    rs485_link.c
+  * \author  Jang Ho Jong
+  * \version V0.0.1
+  * \date    2026.10.17
+  * \brief   RS-485 Link Quality Body
+  * ***************************************************************************/
+
+/* Includes ------------------------------------------------------------------*/
+#include "rs485_link.h"
+#include "lib_crc16.h"
+
+/** \addtogroup Applications
+  * \{ */
+
+/** \defgroup Rs485_Link RS-485 link 품질
+  * \brief DM/PC 보드별 RTT, 응답 대기 시간, 재시도와 통신 오류 통계를 관리합니다.
+  * \{ */
+
+/* Private typedef -----------------------------------------------------------*/
+/* Private define ------------------------------------------------------------*/
+#define LINK_FRAME_STX             0x02U
+#define LINK_FRAME_ETX             0x03U
+
+/* Private macro -------------------------------------------------------------*/
+/* Private variables ---------------------------------------------------------*/
+/** \defgroup Rs485_Link_Private_Variables RS-485 link 비공개 변수
+  * \{ */
+static Rs485LinkStat_t _link[RS485_LINK_NODE_MAX + 1U];         /**< [0] = node를 알 수 없는 오류 */
+static u08_t           _retry = RS485_LINK_RETRY_DEF;
+/** \} Rs485_Link_Private_Variables */
+
+/* Private function prototypes -----------------------------------------------*/
+/** \defgroup Rs485_Link_Private_Functions RS-485 link 비공개 함수
+  * \{ */
+static Rs485LinkStat_t * Rs485_Link_Node(u08_t id);
+static u32_t             Rs485_Link_Put16(u08_t buf[], u32_t i, u32_t v);
+static u32_t             Rs485_Link_Put32(u08_t buf[], u32_t i, u32_t v);
+/** \} Rs485_Link_Private_Functions */
+
+/* Exported functions --------------------------------------------------------*/
+/** \addtogroup Rs485_Link_Exported_Functions
+  * \{ */
+
+/** \brief  통계와 RTT 추정값을 초기화한다.
+  * \retval 없음
+  */
+void Rs485_Link_Init(void)
+{
+  u08_t i;
+
+  for (i = 0U; i <= RS485_LINK_NODE_MAX; i++)
+  {
+    _link[i].srtt   = 0U;
+    _link[i].rttvar = 0U;
+    _link[i].rto    = RS485_LINK_RTO_INIT_usec;
+    _link[i].fails  = 0U;
+  }
+  Rs485_Link_Clear_Stat();
+}
+
+/** \brief  RTT 추정값만 처음 상태로 되돌린다.
+  * \note   통신 속도를 바꾸면 RTT가 달라지므로 새 속도에서 다시 잰다. 통계는 유지한다.
+  * \retval 없음
+  */
+void Rs485_Link_Reset_Rtt(void)
+{
+  u08_t i;
+
+  for (i = 0U; i <= RS485_LINK_NODE_MAX; i++)
+  {
+    _link[i].srtt   = 0U;
+    _link[i].rttvar = 0U;
+    _link[i].rto    = RS485_LINK_RTO_INIT_usec;
+  }
+}
+
+/** \brief  id node로 요구를 보냈음을 센다.
+  * \retval 없음
+  */
+void Rs485_Link_Sent(u08_t id)
+{
+  Rs485_Link_Node(id)->sent++;
+}
+
+/** \brief  id node의 응답을 받았을 때 RTT를 반영하고 연속 실패를 지운다.
+  * \param  rtt_usec - 요구 송신 시작부터 응답 수신까지
+  * \retval 없음
+  */
+void Rs485_Link_Reply(u08_t id, u32_t rtt_usec)
+{
+  Rs485LinkStat_t * s = Rs485_Link_Node(id);
+  i32_t err;
+
+  s->replies++;
+  s->fails = 0U;
+  s->rtt_sum += rtt_usec;
+  if ((s->rtt_min == 0U) || (rtt_usec < s->rtt_min))
+  {
+    s->rtt_min = rtt_usec;
+  }
+  if (rtt_usec > s->rtt_max)
+  {
+    s->rtt_max = rtt_usec;
+  }
+
+  if (s->srtt == 0U)                                   /* 첫 측정 */
+  {
+    s->srtt   = rtt_usec;
+    s->rttvar = rtt_usec / 2U;
+  }
+  else
+  {
+    err = (i32_t)rtt_usec - (i32_t)s->srtt;
+    s->srtt = (u32_t)((i32_t)s->srtt + (err / 8));
+    if (err < 0)
+    {
+      err = -err;
+    }
+    s->rttvar = (u32_t)((i32_t)s->rttvar + ((err - (i32_t)s->rttvar) / 4));
+  }
+  s->rto = s->srtt + (4U * s->rttvar);
+  if (s->rto < RS485_LINK_RTO_MIN_usec)
+  {
+    s->rto = RS485_LINK_RTO_MIN_usec;
+  }
+  else if (s->rto > RS485_LINK_RTO_MAX_usec)
+  {
+    s->rto = RS485_LINK_RTO_MAX_usec;
+  }
+}
+
+/** \brief  id node가 응답하지 않았음을 센다.
+  * \note   무응답이 이어지면 대기 시간을 두배씩 늘린다(최대 RS485_LINK_RTO_MAX_usec).
+  * \retval 연속 무응답이 재시도 한도를 넘었으면 True(통신 고장으로 처리), 아니면 False(재시도)
+  */
+Bool_t Rs485_Link_Timeout(u08_t id)
+{
+  Rs485LinkStat_t * s = Rs485_Link_Node(id);
+
+  s->timeouts++;
+  if (s->fails < 255U)
+  {
+    s->fails++;
+  }
+  s->rto *= 2U;
+  if (s->rto > RS485_LINK_RTO_MAX_usec)
+  {
+    s->rto = RS485_LINK_RTO_MAX_usec;
+  }
+  return (s->fails > _retry) ? True : False;
+}
+
+/** \brief  id node의 응답 구간에서 CRC 오류가 났음을 센다.
+  * \retval 없음
+  */
+void Rs485_Link_Crc_Error(u08_t id)
+{
+  Rs485_Link_Node(id)->crc_err++;
+}
+
+/** \brief  ID가 맞지 않는 응답을 센다.
+  * \param  id - 기다리던 node, 알 수 없으면 0
+  * \retval 없음
+  */
+void Rs485_Link_Id_Error(u08_t id)
+{
+  Rs485_Link_Node(id)->id_err++;
+}
+
+/** \brief  길이가 맞지 않는 frame을 센다.
+  * \param  id - 기다리던 node, 알 수 없으면 0
+  * \retval 없음
+  */
+void Rs485_Link_Len_Error(u08_t id)
+{
+  Rs485_Link_Node(id)->len_err++;
+}
+
+/** \brief  id node의 현재 응답 대기 시간을 구한다.
+  * \retval usec
+  */
+u32_t Rs485_Link_Rto(u08_t id)
+{
+  return Rs485_Link_Node(id)->rto;
+}
+
+/** \brief  id node의 평균 RTT를 구한다.
+  * \retval usec, 응답이 없었으면 0
+  */
+u32_t Rs485_Link_Rtt_Avg(u08_t id)
+{
+  Rs485LinkStat_t * s = Rs485_Link_Node(id);
+
+  if (s->replies == 0U)
+  {
+    return 0U;
+  }
+  return (u32_t)(s->rtt_sum / s->replies);
+}
+
+/** \brief  연속 무응답 허용 횟수를 바꾼다.
+  * \retval 범위(0 ~ RS485_LINK_RETRY_MAX) 안이면 True
+  */
+Bool_t Rs485_Link_Set_Retry(u08_t retry)
+{
+  if (retry > RS485_LINK_RETRY_MAX)
+  {
+    return False;
+  }
+  _retry = retry;
+  return True;
+}
+
+/** \brief  연속 무응답 허용 횟수를 얻는다.
+  * \retval 재시도 한도
+  */
+u08_t Rs485_Link_Get_Retry(void)
+{
+  return _retry;
+}
+
+/** \brief  id node의 통계를 복사한다.
+  * \retval id가 0 ~ RS485_LINK_NODE_MAX이면 True
+  */
+Bool_t Rs485_Link_Get_Stat(u08_t id, Rs485LinkStat_t * stat)
+{
+  if (id > RS485_LINK_NODE_MAX)
+  {
+    return False;
+  }
+  *stat = _link[id];
+  return True;
+}
+
+/** \brief  계수와 RTT min/avg/max를 지운다.
+  * \note   srtt, rto, 연속 실패는 동작 상태이므로 유지한다.
+  * \retval 없음
+  */
+void Rs485_Link_Clear_Stat(void)
+{
+  u08_t i;
+
+  for (i = 0U; i <= RS485_LINK_NODE_MAX; i++)
+  {
+    _link[i].sent     = 0U;
+    _link[i].replies  = 0U;
+    _link[i].crc_err  = 0U;
+    _link[i].timeouts = 0U;
+    _link[i].id_err   = 0U;
+    _link[i].len_err  = 0U;
+    _link[i].rtt_min  = 0U;
+    _link[i].rtt_max  = 0U;
+    _link[i].rtt_sum  = 0U;
+  }
+}
+
+/** \brief  id node의 통계 frame을 만든다.
+  * \param  buf  - frame을 넣을 버퍼
+  * \param  size - buf 크기
+  * \retval frame 길이, buf가 작거나 id가 범위 밖이면 0
+  */
+u32_t Rs485_Link_Build_Frame(u08_t id, u08_t buf[], u32_t size)
+{
+  Rs485LinkStat_t * s;
+  u32_t i = 0U;
+  u16_t crc;
+
+  if ((size < RS485_LINK_FRAME_SIZE) || (id > RS485_LINK_NODE_MAX))
+  {
+    return 0U;
+  }
+  s = &_link[id];
+  buf[i++] = LINK_FRAME_STX;
+  buf[i++] = RS485_LINK_PAYLOAD_SIZE;
+  buf[i++] = RS485_LINK_MSG;
+  buf[i++] = RS485_LINK_FRAME_VER;
+  buf[i++] = id;
+  i = Rs485_Link_Put32(buf, i, s->sent);
+  i = Rs485_Link_Put32(buf, i, s->replies);
+  i = Rs485_Link_Put16(buf, i, s->crc_err);
+  i = Rs485_Link_Put16(buf, i, s->timeouts);
+  i = Rs485_Link_Put16(buf, i, s->id_err);
+  i = Rs485_Link_Put16(buf, i, s->rtt_min);
+  i = Rs485_Link_Put16(buf, i, Rs485_Link_Rtt_Avg(id));
+  i = Rs485_Link_Put16(buf, i, s->rtt_max);
+  i = Rs485_Link_Put16(buf, i, s->rto);
+  i = Rs485_Link_Put16(buf, i, s->len_err);
+  crc = Crc16_Krs(&buf[1], i - 1U);                    /* LEN ~ PAYLOAD */
+  buf[i++] = (u08_t)(crc >> 8);
+  buf[i++] = (u08_t)(crc & 0xFFU);
+  buf[i++] = LINK_FRAME_ETX;
+  return i;
+}
+/** \} Rs485_Link_Exported_Functions */
+
+/** \addtogroup Rs485_Link_Private_Functions
+  * \{ */
+
+/** \brief  id에 해당하는 통계, 범위 밖이면 [0]을 돌려준다.
+  * \retval 통계 포인터
+  */
+static Rs485LinkStat_t * Rs485_Link_Node(u08_t id)
+{
+  if (id > RS485_LINK_NODE_MAX)
+  {
+    id = 0U;
+  }
+  return &_link[id];
+}
+
+/** \brief  v를 16bit big endian으로 넣는다(0xFFFF 포화).
+  * \retval 다음 위치
+  */
+static u32_t Rs485_Link_Put16(u08_t buf[], u32_t i, u32_t v)
+{
+  if (v > 0xFFFFU)
+  {
+    v = 0xFFFFU;
+  }
+  buf[i++] = (u08_t)(v >> 8);
+  buf[i++] = (u08_t)(v & 0xFFU);
+  return i;
+}
+
+/** \brief  v를 32bit big endian으로 넣는다.
+  * \retval 다음 위치
+  */
+static u32_t Rs485_Link_Put32(u08_t buf[], u32_t i, u32_t v)
+{
+  buf[i++] = (u08_t)(v >> 24);
+  buf[i++] = (u08_t)((v >> 16) & 0xFFU);
+  buf[i++] = (u08_t)((v >> 8) & 0xFFU);
+  buf[i++] = (u08_t)(v & 0xFFU);
+  return i;
+}
+/** \} Rs485_Link_Private_Functions */
+
+/** \} Rs485_Link */
+
+/** \} Applications */
+
+/*************** (C) COPYRIGHT SHALOM ENGINEERING CO., LTD. ****END OF FILE****/
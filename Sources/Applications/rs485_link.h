@@ -0,0 +1,107 @@
+/** ****************************************************************************
+  * \file    rs485_link.h
+  * \author  Jang Ho Jong
+  * \version V0.0.1
+  * \date    2026.10.17
+  * \brief   RS-485 Link Quality Header
+  * ***************************************************************************/
+/*
+  - 마스터가 DM/PC 보드(node)별 통신 품질을 기록하고 응답 대기 시간을 RTT로 정한다.
+
+  - RTT/RTO:
+    요구 송신 시작부터 응답 frame 수신까지(RTT)를 node마다 잰다.
+    srtt  += (rtt - srtt) / 8,  rttvar += (|rtt - srtt| - rttvar) / 4
+    rto    = srtt + 4 x rttvar, RS485_LINK_RTO_MIN_usec ~ RS485_LINK_RTO_MAX_usec로 제한.
+    처음 응답 전에는 RS485_LINK_RTO_INIT_usec(이전 고정값 10msec)를 쓴다.
+
+  - 재시도:
+    응답이 없으면 Rs485_Link_Timeout()이 연속 실패를 세고,
+    연속 실패가 재시도 한도(기본 RS485_LINK_RETRY_DEF)를 넘을 때만 True를 돌려준다.
+    이때만 통신 timeout fault를 올리므로 한번의 noise로 HLT가 떨어지지 않는다.
+
+  - 통계 frame:
+    Rs485_Link_Build_Frame()은 node 하나의 통계를 수신 parser와 같은 형식
+    STX | LEN | PAYLOAD | CRC_H | CRC_L | ETX 로 만든다. PAYLOAD(big endian) :
+    msg_type(RS485_LINK_MSG) | ver | id | sent(4) | replies(4) | crc(2) | timeout(2)
+    | id_err(2) | rtt_min(2) | rtt_avg(2) | rtt_max(2) | rto(2) | len_err(2)   (usec, 0xFFFF 포화)
+
+  - ID 0은 어느 node인지 알 수 없는 오류(범위 밖 ID 등)를 센다.
+  - Rs485_Link 접두어를 사용한다.
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef __RS485_LINK_H
+#define __RS485_LINK_H
+
+/* Includes ------------------------------------------------------------------*/
+#include "main.h"
+
+/** \addtogroup Applications
+  * \{ */
+
+/** \addtogroup Rs485_Link
+  * \{ */
+
+/* Exported constants --------------------------------------------------------*/
+/** \defgroup Rs485_Link_Exported_Constants RS-485 link 공개 상수
+  * \{ */
+#define RS485_LINK_NODE_MAX        6U                  /**< dmpc_id 1 ~ 6 */
+#define RS485_LINK_RTO_INIT_usec   10000U              /**< 첫 응답 전 대기 시간 */
+#define RS485_LINK_RTO_MIN_usec    2000U
+#define RS485_LINK_RTO_MAX_usec    50000U
+#define RS485_LINK_RETRY_DEF       2U                  /**< 연속 무응답 허용 횟수 */
+#define RS485_LINK_RETRY_MAX       10U
+#define RS485_LINK_MSG             0x04U               /**< 통계 frame msg_type */
+#define RS485_LINK_FRAME_VER       0x02U               /**< 2 : len_err 추가 */
+#define RS485_LINK_PAYLOAD_SIZE    27U
+#define RS485_LINK_FRAME_SIZE      (RS485_LINK_PAYLOAD_SIZE + 5U)
+/** \} Rs485_Link_Exported_Constants */
+
+/* Exported types ------------------------------------------------------------*/
+/** \brief node 하나의 통신 통계 */
+typedef struct
+{
+u32_t   sent;                                          /**< 보낸 요구 수 */
+u32_t   replies;                                       /**< 받은 응답 수 */
+u32_t   crc_err;                                       /**< 이 node 응답 구간의 CRC 오류 */
+u32_t   timeouts;                                      /**< 무응답 수 */
+u32_t   id_err;                                        /**< ID 불일치 */
+u32_t   len_err;                                       /**< CRC는 맞으나 길이가 packet과 다른 frame */
+u32_t   rtt_min;                                       /**< usec */
+u32_t   rtt_max;
+uint64_t rtt_sum;                                      /**< rtt_avg = rtt_sum / replies */
+u32_t   srtt;                                          /**< 평활 RTT, 0이면 아직 측정 없음 */
+u32_t   rttvar;
+u32_t   rto;                                           /**< 현재 응답 대기 시간 */
+u08_t   fails;                                         /**< 연속 무응답 */
+}Rs485LinkStat_t;
+
+/* Exported macro ------------------------------------------------------------*/
+/* Exported variables --------------------------------------------------------*/
+/* Exported functions --------------------------------------------------------*/
+/** \defgroup Rs485_Link_Exported_Functions RS-485 link 공개 함수
+  * \{ */
+extern void   Rs485_Link_Init(void);
+extern void   Rs485_Link_Reset_Rtt(void);
+extern void   Rs485_Link_Sent(u08_t id);
+extern void   Rs485_Link_Reply(u08_t id, u32_t rtt_usec);
+extern Bool_t Rs485_Link_Timeout(u08_t id);
+extern void   Rs485_Link_Crc_Error(u08_t id);
+extern void   Rs485_Link_Id_Error(u08_t id);
+extern void   Rs485_Link_Len_Error(u08_t id);
+extern u32_t  Rs485_Link_Rto(u08_t id);
+extern u32_t  Rs485_Link_Rtt_Avg(u08_t id);
+extern Bool_t Rs485_Link_Set_Retry(u08_t retry);
+extern u08_t  Rs485_Link_Get_Retry(void);
+extern Bool_t Rs485_Link_Get_Stat(u08_t id, Rs485LinkStat_t * stat);
+extern void   Rs485_Link_Clear_Stat(void);
+extern u32_t  Rs485_Link_Build_Frame(u08_t id, u08_t buf[], u32_t size);
+/** \} Rs485_Link_Exported_Functions */
+
+/** \} Rs485_Link */
+
+/** \} Applications */
+
+#endif /* __RS485_LINK_H */
+
+/*************** (C) COPYRIGHT SHALOM ENGINEERING CO., LTD. ****END OF FILE****/
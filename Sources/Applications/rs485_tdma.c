@@ -0,0 +1,216 @@
+/** ****************************************************************************
+  * \file    rs485_tdma.c
+  * \author  Jang Ho Jong
+  * \version V0.0.1
+  * \date    2026.10.17
+  * \brief   RS-485 Broadcast Poll(TDMA) Body
+  * ***************************************************************************/
+
+/* Includes ------------------------------------------------------------------*/
+#include "rs485_tdma.h"
+
+/** \addtogroup Applications
+  * \{ */
+
+/** \defgroup Rs485_Tdma RS-485 broadcast poll
+  * \brief broadcast 요구에 대한 슬레이브 응답 slot을 계산하고 마스터의 응답 수집을 관리합니다.
+  * \{ */
+
+/* Private typedef -----------------------------------------------------------*/
+/* Private define ------------------------------------------------------------*/
+/* Private macro -------------------------------------------------------------*/
+/* Private variables ---------------------------------------------------------*/
+/* Private function prototypes -----------------------------------------------*/
+/* Exported functions --------------------------------------------------------*/
+/** \addtogroup Rs485_Tdma_Exported_Functions
+  * \{ */
+
+/** \brief  bytes 길이의 frame이 선로에 실리는 시간을 구한다.
+  * \param  baud  - 통신 속도[bps]
+  * \param  bytes - frame 길이
+  * \retval 송신 시간[usec], 올림
+  */
+u32_t Rs485_Tdma_Frame_usec(u32_t baud, u32_t bytes)
+{
+  u32_t bits = bytes * RS485_TDMA_BIT_PER_BYTE;
+
+  if (baud == 0U)
+  {
+    return 0U;
+  }
+  return (u32_t)((((uint64_t)bits * 1000000U) + baud - 1U) / baud);
+}
+
+/** \brief  응답 frame 하나와 guard를 합한 slot 폭을 구한다.
+  * \note   frame에 실을 수 있도록 RS485_TDMA_SLOT_UNIT_usec 단위로 올림한다.
+  * \retval slot 폭[usec]
+  */
+u32_t Rs485_Tdma_Slot_usec(u32_t baud, u32_t bytes)
+{
+  u32_t slot = Rs485_Tdma_Frame_usec(baud, bytes) + RS485_TDMA_GUARD_usec;
+
+  return Rs485_Tdma_Slot_Decode(Rs485_Tdma_Slot_Code(slot));
+}
+
+/** \brief  slot 폭을 frame의 1byte 값으로 바꾼다.
+  * \retval RS485_TDMA_SLOT_UNIT_usec 단위 값(1 ~ 255)
+  */
+u08_t Rs485_Tdma_Slot_Code(u32_t slot_usec)
+{
+  u32_t code = (slot_usec + RS485_TDMA_SLOT_UNIT_usec - 1U) / RS485_TDMA_SLOT_UNIT_usec;
+
+  if (code == 0U)
+  {
+    code = 1U;
+  }
+  else if (code > 255U)
+  {
+    code = 255U;
+  }
+  return (u08_t)code;
+}
+
+/** \brief  frame의 slot 값을 usec로 바꾼다.
+  * \retval slot 폭[usec]
+  */
+u32_t Rs485_Tdma_Slot_Decode(u08_t code)
+{
+  return (u32_t)code * RS485_TDMA_SLOT_UNIT_usec;
+}
+
+/** \brief  슬레이브가 broadcast 수신 후 응답을 시작할 때까지의 지연을 구한다.
+  * \param  id - 슬레이브의 dmpc_id(1 ~ RS485_TDMA_NODE_MAX)
+  * \retval 지연 시간[usec], id가 범위 밖이면 0
+  */
+u32_t Rs485_Tdma_Offset_usec(u08_t id, u32_t slot_usec)
+{
+  if ((id == 0U) || (id > RS485_TDMA_NODE_MAX))
+  {
+    return 0U;
+  }
+  return (u32_t)(id - 1U) * slot_usec;
+}
+
+/** \brief  broadcast 송신 시작부터 마지막 slot이 끝날 때까지의 수집 창을 구한다.
+  * \param  request_usec - broadcast frame 송신 시간
+  * \retval 수집 창[usec]
+  */
+u32_t Rs485_Tdma_Window_usec(u08_t nodes, u32_t slot_usec, u32_t request_usec)
+{
+  return request_usec + ((u32_t)nodes * slot_usec) + RS485_TDMA_GUARD_usec;
+}
+
+/** \brief  broadcast를 송신하면서 새 수집 cycle을 시작한다.
+  * \param  now - broadcast 송신 시작 시각(Device_Usec_Now())
+  * \retval 없음
+  */
+void Rs485_Tdma_Start(Rs485Tdma_t * t, u08_t nodes, u32_t slot_usec, u32_t request_usec, u32_t now)
+{
+  if (nodes > RS485_TDMA_NODE_MAX)
+  {
+    nodes = RS485_TDMA_NODE_MAX;
+  }
+  t->nodes       = nodes;
+  t->seen        = 0U;
+  t->slot_usec   = slot_usec;
+  t->request_usec = request_usec;
+  t->window_usec = Rs485_Tdma_Window_usec(nodes, slot_usec, request_usec);
+  t->start_usec  = now;
+  t->last_usec   = 0U;
+  t->busy        = True;
+}
+
+/** \brief  응답을 받은 보드를 기록한다.
+  * \retval 이번 cycle의 대상이고 처음 받은 응답이면 True, 범위 밖/중복/창 밖이면 False
+  */
+Bool_t Rs485_Tdma_Mark(Rs485Tdma_t * t, u08_t id, u32_t now)
+{
+  u08_t bit;
+
+  if ((t->busy == False) || (id == 0U) || (id > t->nodes))
+  {
+    return False;
+  }
+  bit = (u08_t)(1U << (id - 1U));
+  if ((t->seen & bit) != 0U)
+  {
+    return False;
+  }
+  t->seen     |= bit;
+  t->last_usec = now - t->start_usec;
+  return True;
+}
+
+/** \brief  수집 cycle이 끝났는지 확인한다.
+  * \note   모든 보드가 응답했거나 수집 창이 지나면 끝난다.
+  *         끝날 때 응답하지 않은 보드의 miss를 증가시키고 cycle 시간을 기록한다.
+  *         결과는 다음 Rs485_Tdma_Start() 전까지 seen, miss로 확인한다.
+  * \retval 이번 호출에서 cycle이 끝났으면 True
+  */
+Bool_t Rs485_Tdma_Done(Rs485Tdma_t * t, u32_t now)
+{
+  u08_t all, i;
+  u32_t elapsed;
+
+  if (t->busy == False)
+  {
+    return False;
+  }
+  all     = (u08_t)((1U << t->nodes) - 1U);
+  elapsed = now - t->start_usec;
+  if ((t->seen != all) && (elapsed < t->window_usec))
+  {
+    return False;
+  }
+  for (i = 0U; i < t->nodes; i++)
+  {
+    if ((t->seen & (1U << i)) == 0U)
+    {
+      t->miss[i]++;
+    }
+  }
+  t->cycle_usec = elapsed;
+  t->cycles++;
+  t->busy = False;
+  return True;
+}
+
+/** \brief  직전(또는 진행 중) cycle에서 id 보드가 응답했는지 확인한다.
+  * \retval 응답했으면 True
+  */
+Bool_t Rs485_Tdma_Is_Seen(const Rs485Tdma_t * t, u08_t id)
+{
+  if ((id == 0U) || (id > RS485_TDMA_NODE_MAX))
+  {
+    return False;
+  }
+  return ((t->seen & (1U << (id - 1U))) != 0U) ? True : False;
+}
+
+/** \brief  now 시각이 어느 보드의 응답 slot인지 구한다.
+  * \note   수신 오류(CRC 등)를 어느 보드 구간에서 났는지 나누는데 쓴다.
+  * \retval 보드 ID(1 ~ nodes), broadcast 송신 중이거나 수집 중이 아니면 0
+  */
+u08_t Rs485_Tdma_Slot_At(const Rs485Tdma_t * t, u32_t now)
+{
+  u32_t elapsed = now - t->start_usec;
+  u32_t id;
+
+  if ((t->busy == False) || (t->slot_usec == 0U) || (elapsed < t->request_usec))
+  {
+    return 0U;
+  }
+  id = ((elapsed - t->request_usec) / t->slot_usec) + 1U;
+  if (id > t->nodes)
+  {
+    id = t->nodes;
+  }
+  return (u08_t)id;
+}
+/** \} Rs485_Tdma_Exported_Functions */
+
+/** \} Rs485_Tdma */
+
+/** \} Applications */
+
+/*************** (C) COPYRIGHT SHALOM ENGINEERING CO., LTD. ****END OF FILE****/
@@ -0,0 +1,90 @@
+/** ****************************************************************************
+  * \file    rs485_tdma.h
+  * \author  Jang Ho Jong
+  * \version V0.0.1
+  * \date    2026.10.17
+  * \brief   RS-485 Broadcast Poll(TDMA) Header
+  * ***************************************************************************/
+/*
+  - 마스터가 한번의 broadcast 요구로 모든 DM/PC 보드의 상태를 받는 TDMA 시간 계산
+
+  - 동작:
+    마스터는 dmpc_id = RS485_TDMA_BROADCAST_ID 인 요구 frame 하나를 보낸다.
+    frame에는 대상 보드 수와 slot 폭(RS485_TDMA_SLOT_UNIT_usec 단위)이 들어간다.
+    각 슬레이브는 broadcast를 받은 시점부터 (dmpc_id - 1) x slot 뒤에 응답한다.
+    마스터는 Rs485_Tdma_Window_usec() 동안 응답을 모아 응답한 보드를 bitmap으로 기록하고,
+    창이 끝나면 응답하지 않은 보드를 miss로 센다.
+
+  - slot 폭 = 응답 frame 시간 + RS485_TDMA_GUARD_usec
+    guard는 송수신 방향 전환과 슬레이브 superloop 지연(응답 송신 시작 지연)을 흡수한다.
+    38400bps, 10byte 응답이면 frame 2604usec + guard 500usec = 3.1msec,
+    6량 편성 전체 수집은 broadcast 포함 약 22msec(개별 polling은 6 x 10msec 이상).
+
+  - Rs485_Tdma 접두어를 사용한다.
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef __RS485_TDMA_H
+#define __RS485_TDMA_H
+
+/* Includes ------------------------------------------------------------------*/
+#include "main.h"
+
+/** \addtogroup Applications
+  * \{ */
+
+/** \addtogroup Rs485_Tdma
+  * \{ */
+
+/* Exported constants --------------------------------------------------------*/
+/** \defgroup Rs485_Tdma_Exported_Constants RS-485 TDMA 공개 상수
+  * \{ */
+#define RS485_TDMA_BROADCAST_ID    0xFFU               /**< broadcast 요구의 dmpc_id */
+#define RS485_TDMA_NODE_MAX        6U                  /**< dmpc_id 1 ~ 6 */
+#define RS485_TDMA_BIT_PER_BYTE    10U                 /**< start + 8 data + stop */
+#define RS485_TDMA_GUARD_usec      500U                /**< slot 사이 여유 시간 */
+#define RS485_TDMA_SLOT_UNIT_usec  100U                /**< frame에 싣는 slot 폭 단위 */
+/** \} Rs485_Tdma_Exported_Constants */
+
+/* Exported types ------------------------------------------------------------*/
+/** \brief 마스터의 broadcast 수집 cycle 상태 */
+typedef struct
+{
+u08_t   nodes;                                         /**< 이번 cycle 대상 보드 수 */
+u08_t   seen;                                          /**< 응답한 보드 bitmap(bit0 = ID 1) */
+Bool_t  busy;                                          /**< 수집 창 진행 중 */
+u32_t   slot_usec;                                     /**< slot 폭 */
+u32_t   request_usec;                                  /**< broadcast frame 송신 시간 */
+u32_t   window_usec;                                   /**< broadcast 송신 시작부터의 수집 창 */
+u32_t   start_usec;                                    /**< broadcast 송신 시작 시각 */
+u32_t   last_usec;                                     /**< 마지막 응답까지 걸린 시간 */
+u32_t   cycle_usec;                                    /**< 직전 cycle 전체 시간 */
+u32_t   cycles;                                        /**< 완료한 cycle 수 */
+u32_t   miss[RS485_TDMA_NODE_MAX];                     /**< 보드별 무응답 수 */
+}Rs485Tdma_t;
+
+/* Exported macro ------------------------------------------------------------*/
+/* Exported variables --------------------------------------------------------*/
+/* Exported functions --------------------------------------------------------*/
+/** \defgroup Rs485_Tdma_Exported_Functions RS-485 TDMA 공개 함수
+  * \{ */
+extern u32_t  Rs485_Tdma_Frame_usec(u32_t baud, u32_t bytes);
+extern u32_t  Rs485_Tdma_Slot_usec(u32_t baud, u32_t bytes);
+extern u08_t  Rs485_Tdma_Slot_Code(u32_t slot_usec);
+extern u32_t  Rs485_Tdma_Slot_Decode(u08_t code);
+extern u32_t  Rs485_Tdma_Offset_usec(u08_t id, u32_t slot_usec);
+extern u32_t  Rs485_Tdma_Window_usec(u08_t nodes, u32_t slot_usec, u32_t request_usec);
+extern void   Rs485_Tdma_Start(Rs485Tdma_t * t, u08_t nodes, u32_t slot_usec, u32_t request_usec, u32_t now);
+extern Bool_t Rs485_Tdma_Mark(Rs485Tdma_t * t, u08_t id, u32_t now);
+extern Bool_t Rs485_Tdma_Done(Rs485Tdma_t * t, u32_t now);
+extern Bool_t Rs485_Tdma_Is_Seen(const Rs485Tdma_t * t, u08_t id);
+extern u08_t  Rs485_Tdma_Slot_At(const Rs485Tdma_t * t, u32_t now);
+/** \} Rs485_Tdma_Exported_Functions */
+
+/** \} Rs485_Tdma */
+
+/** \} Applications */
+
+#endif /* __RS485_TDMA_H */
+
+/*************** (C) COPYRIGHT SHALOM ENGINEERING CO., LTD. ****END OF FILE****/
@@ -13,6 +13,12 @@
 #include "lib_command.h"
 #include "lib_buffer.h"
 #include "lib_string.h"
+#include "rs485_frame.h"
+#include "rs485_tdma.h"
+#include "rs485_link.h"
+#include "rs485_baud.h"
+#include "rs485_diag.h"
+#include "lib_crc16.h"
  
 
 /*----------------------------------------------------------------------------
@@ -22,47 +28,6 @@
 /** \addtogroup Applications
   * \{ */
 
-/*----------------------------------------------------------------------------
- *      한국철도표준규격(CRC_16)
- *      KRS SG 0062 철도신호시스템(점대점 정보전송방식)
- *      MSB(최상의비트)에서 최하위 비트(LSB)로 전송
- *---------------------------------------------------------------------------*/
-/* Polly : X16+X15+X2+1 : 0x8005  */
-const uint16_t KRS_CRC16_TABLE[256] = {
-		0x0000, 0x8005, 0x800F, 0x000A, 0x801B, 0x001E, 0x0014, 0x8011,
-		0x8033, 0x0036, 0x003C, 0x8039, 0x0028, 0x802D, 0x8027, 0x0022,
-		0x8063, 0x0066, 0x006C, 0x8069, 0x0078, 0x807D, 0x8077, 0x0072,
-		0x0050, 0x8055, 0x805F, 0x005A, 0x804B, 0x004E, 0x0044, 0x8041,
-		0x80C3, 0x00C6, 0x00CC, 0x80C9, 0x00D8, 0x80DD, 0x80D7, 0x00D2,
-		0x00F0, 0x80F5, 0x80FF, 0x00FA, 0x80EB, 0x00EE, 0x00E4, 0x80E1,
-		0x00A0, 0x80A5, 0x80AF, 0x00AA, 0x80BB, 0x00BE, 0x00B4, 0x80B1, 
-		0x8093, 0x0096, 0x009C, 0x8099, 0x0088, 0x808D, 0x8087, 0x0082, 
-		0x8183, 0x0186, 0x018C, 0x8189, 0x0198, 0x819D, 0x8197, 0x0192, 
-		0x01B0, 0x81B5, 0x81BF, 0x01BA, 0x81AB, 0x01AE, 0x01A4, 0x81A1, 
-		0x01E0, 0x81E5, 0x81EF, 0x01EA, 0x81FB, 0x01FE, 0x01F4, 0x81F1, 
-		0x81D3, 0x01D6, 0x01DC, 0x81D9, 0x01C8, 0x81CD, 0x81C7, 0x01C2, 
-		0x0140, 0x8145, 0x814F, 0x014A, 0x815B, 0x015E, 0x0154, 0x8151, 
-		0x8173, 0x0176, 0x017C, 0x8179, 0x0168, 0x816D, 0x8167, 0x0162, 
-		0x8123, 0x0126, 0x012C, 0x8129, 0x0138, 0x813D, 0x8137, 0x0132, 
-		0x0110, 0x8115, 0x811F, 0x011A, 0x810B, 0x010E, 0x0104, 0x8101, 
-		0x8303, 0x0306, 0x030C, 0x8309, 0x0318, 0x831D, 0x8317, 0x0312, 
-		0x0330, 0x8335, 0x833F, 0x033A, 0x832B, 0x032E, 0x0324, 0x8321, 
-		0x0360, 0x8365, 0x836F, 0x036A, 0x837B, 0x037E, 0x0374, 0x8371, 
-		0x8353, 0x0356, 0x035C, 0x8359, 0x0348, 0x834D, 0x8347, 0x0342, 
-		0x03C0, 0x83C5, 0x83CF, 0x03CA, 0x83DB, 0x03DE, 0x03D4, 0x83D1, 
-		0x83F3, 0x03F6, 0x03FC, 0x83F9, 0x03E8, 0x83ED, 0x83E7, 0x03E2, 
-		0x83A3, 0x03A6, 0x03AC, 0x83A9, 0x03B8, 0x83BD, 0x83B7, 0x03B2, 
-		0x0390, 0x8395, 0x839F, 0x039A, 0x838B, 0x038E, 0x0384, 0x8381, 
-		0x0280, 0x8285, 0x828F, 0x028A, 0x829B, 0x029E, 0x0294, 0x8291, 
-		0x82B3, 0x02B6, 0x02BC, 0x82B9, 0x02A8, 0x82AD, 0x82A7, 0x02A2, 
-		0x82E3, 0x02E6, 0x02EC, 0x82E9, 0x02F8, 0x82FD, 0x82F7, 0x02F2, 
-		0x02D0, 0x82D5, 0x82DF, 0x02DA, 0x82CB, 0x02CE, 0x02C4, 0x82C1, 
-		0x8243, 0x0246, 0x024C, 0x8249, 0x0258, 0x825D, 0x8257, 0x0252, 
-		0x0270, 0x8275, 0x827F, 0x027A, 0x826B, 0x026E, 0x0264, 0x8261, 
-		0x0220, 0x8225, 0x822F, 0x022A, 0x823B, 0x023E, 0x0234, 0x8231, 
-		0x8213, 0x0216, 0x021C, 0x8219, 0x0208, 0x820D, 0x8207, 0x0202
-};
-
 /** \defgroup Rs485com_Thread RS485통신을 담당하는 쓰레드
   * \brief  객차탈선 장치와 통신 데이타를 처리하는 쓰레드
   * \{ */
@@ -78,26 +43,94 @@ u08_t  Rx_Wait_Timer1c=0x01;
 Bool_t g_monitor_485_tx;                                             /**< console port를 통한 송신 송신 data monitoring 기능 on/off flag   */
 Bool_t g_monitor_485_rx;                                             /**< console port를 통한 송신 수신 data monitoring 기능 on/off flag   */
 u08_t  g_send_dmpc_cnt;
+Bool_t g_rs485_isr_reply = True;                                    /**< True : 슬레이브 응답을 USART1 수신 인터럽트에서 바로 송신 */
+Bool_t g_rs485_tdma = True;                                         /**< True : broadcast 요구 + TDMA 응답, False : 보드별 개별 polling */
 
 static void   Transmit_Data_To_Rs485(Rs485_t * rs);
+static void   Rs485_Broadcast_Poll(void);
+static void   Rs485_Broadcast_Done(void);
+static void   Rs485_Slot_Alarm(void);
+static Bool_t Rs485_Baud_Master_Process(void);
+static void   Rs485_Baud_Fallback(void);
+static void   Rs485_Baud_Slave_Process(void);
+static void   Rs485_Send_Control(u08_t id, u08_t msg_type, u08_t code);
+static Bool_t Rs485_Diag_Master_Process(void);
+static void   Rs485_Slave_Diag_Reply(void);
+static void   Rs485_Link_Reply_Record(u08_t id);
+static void   Rs485_Slave_Update_Response(void);
+static void   Rs485_Slave_Fault_Code(void);
+static u08_t  Rs485_Link_Pending_Id(void);
 static void   Slave_Transmit_Data_To_Rs485(Rs485_t * rs);
 static void   Rs485_Data_Fill_txBuf(void);
-static void   Rs485_Data_Fill_rxBuf(Rs485_t * rs);
+static void   Rs485_Rx_Process(void);
 static void   Rs485_Monitor_Tx(void);
-static void   Rs485_Monitor_Rx(void);
-static void   Receive_Data_From_Rs485(void);
-static Bool_t PCrs485Com_Validate_rx(void);
-static void   Check_DEPC_State(Curs485_Packet_t	*packet);
-static uint16_t getCRC16_KRS(uint8_t* buffer, uint32_t l);
+static void   Rs485_Monitor_Rx(const u08_t * buf, u32_t n);
+static void   Receive_Data_From_Rs485(const u08_t * buf, u32_t n);
+static Bool_t PCrs485Com_Validate_rx(const Rs485View_t * frame);
+static void   Check_DEPC_State(const Curs485_Packet_t	*packet);
+static void   Check_DEPC_Report(const Curs485_Packet_t * packet, const char_t tag[], const char_t text[]);
+
+/* 마스터 속도 협상 단계 */
+#define kBAUD_STEP_IDLE       0U                                     /**< 협상 없음 */
+#define kBAUD_STEP_PROPOSE    1U                                     /**< _negId에 제안 송신 */
+#define kBAUD_STEP_WAIT_ACK   2U                                     /**< _negId의 답 대기 */
+#define kBAUD_STEP_COMMIT     3U                                     /**< broadcast COMMIT 2회 송신 후 속도 변경 */
+#define kBAUD_STEP_HOLD       4U                                     /**< 슬레이브가 속도를 바꿀 때까지 대기 */
 
 /** \defgroup Rs485com_Thread_Private_Variables Rs485com_Thread 쓰레드 비공개 변수
   * \{ */
 
-static uint8_t        _rxBuf[MAX_SIZE_CMD_BUF];                      /**< 수신 버퍼 */
-static uint32_t       _rxCnt;                                        /**< 수신 버퍼의 입력 카운트 */
 static uint8_t        _txBuf[MAX_SIZE_CMD_BUF];                      /**< 송신 버퍼 */
 static uint32_t       _txCnt; 
 static uint8_t        g_heartbit;
+static Rs485Parser_t  _rxParser;                                     /**< 수신 frame parser (0 초기화 = STX 대기) */
+static Rs485Tdma_t    _tdma;                                         /**< 마스터 broadcast 수집 cycle */
+static Rs485Parser_t  _isrParser;                                    /**< 수신 인터럽트용 frame parser */
+static u08_t          _resp[2][sizeof(Curs485_Packet_t)];            /**< 미리 만든 슬레이브 응답(이중 버퍼) */
+static volatile u08_t _respIdx;                                      /**< 인터럽트가 송신할 _resp 번호 */
+static volatile u08_t _respId;                                       /**< _resp의 dmpc_id, 0이면 아직 없음 */
+static u08_t          _respState;
+static u08_t          _respDetail;
+static volatile u32_t _isrReplies;                                   /**< 인터럽트에서 보낸 응답 수 */
+static u32_t          _pollUsec;                                     /**< 개별 polling 요구 송신 시각 */
+static Bool_t         _pollRetry;                                    /**< True면 같은 보드에 다시 요구 */
+static u08_t          _baudStep;                                     /**< 마스터 속도 협상 단계(kBAUD_STEP_xxx) */
+static u08_t          _negId;                                        /**< 제안을 보낼/답을 기다리는 보드 ID */
+static Rs485Baud_t    _negCode;                                      /**< 제안/확정할 속도 */
+static u08_t          _commitSent;                                   /**< 보낸 COMMIT 수 */
+static Bool_t         _baudFallback;                                 /**< True면 오류로 인한 기본 속도 복귀 */
+static u32_t          _baudUsec;                                     /**< 제안 송신 시각 */
+static u32_t          _baudTick;                                     /**< 속도 변경 시각(HAL_GetTick()) */
+static volatile Bool_t _slaveSwitch;                                 /**< 슬레이브 속도 변경 대기 중 */
+static Rs485Baud_t    _slaveCode;                                    /**< 슬레이브가 바꿀 속도 */
+static u32_t          _slaveTick;                                    /**< 슬레이브 COMMIT 수신 시각 */
+static u32_t          _errFrames;                                    /**< 오류 창에 넣은 정상 frame 수 */
+static u32_t          _errCrc;                                       /**< 오류 창에 넣은 CRC 오류 수 */
+static Bool_t         _diagWait;                                     /**< 진단 응답 대기 중 */
+static u08_t          _diagId;                                       /**< 진단을 요구한 보드 */
+static u32_t          _diagUsec;                                     /**< 진단 요구 송신 시각 */
+static u32_t          _diagTick;                                     /**< 마지막 진단 요구 시각(HAL_GetTick()) */
+static u08_t          _diagBuf[RS485_DIAG_FRAME_SIZE];               /**< 슬레이브 진단 frame */
+
+/** \brief  보드 역할을 읽고 RS-485 수신을 시작한다.
+  * \note   HCR 입력이 ON이면 마스터(DM) 보드이다. PC BOARD 연결 갯수 Dip-Switch 값은 마스터에서는
+  *         연결된 PC 보드 수, 슬레이브에서는 자기 보드 ID이며 0이면 통신하지 않는다(g_OpMode = NOT_USE).
+  *         Device_Init() 이후, superloop 진입 전에 한번 호출한다.
+  * \retval 없음
+  */
+void Rs485com_Init(void)
+{
+  /* DI_Get_State()는 Pin이 OFF 값일 때 True */
+  g_Master_Board = (DI_Get_State(hcr_input) == False) ? True : False;
+  g_IdCnt        = cfg->value;
+  if (g_IdCnt > RS485_TDMA_NODE_MAX)
+  {
+    g_IdCnt = RS485_TDMA_NODE_MAX;
+  }
+  g_OpMode       = (g_IdCnt != 0U) ? MASTER : NOT_USE;
+  cprintf("RS-485 %s, ID/Count %d\n", (g_Master_Board == True) ? "Master" : "Slave", g_IdCnt);
+  Rs485_Enable_Receiving(serial1);
+}
 
 /** \brief  Rs485com_Thread 쓰레드 본체
   * \param  argument - 쓰레드로 전달된 인자
@@ -107,17 +140,41 @@ static uint8_t        g_heartbit;
   */
 void Rs485com_Thread(void)
 {
-   if(g_OpMode == MASTER && g_Master_Board == True)                   /**< 마스터 보드로 설정 되었음(HCR 입력됨). */
+   if(g_OpMode == MASTER && g_Master_Board == True && Rs485_Baud_Master_Process() == True)
+   {
+      return;                                                        /**< 속도 협상 중에는 polling을 쉰다 */
+   }
+   if(g_OpMode == MASTER && g_Master_Board == True && Rs485_Diag_Master_Process() == True)
+   {
+      return;                                                        /**< polling cycle 사이의 저우선 진단 요구 */
+   }
+   if(g_OpMode == MASTER && g_Master_Board == True && g_rs485_tdma == True)
+   {
+      Rs485_Broadcast_Poll();                                        /**< 한번의 요구로 전체 보드 응답 수집 */
+   }
+   else if(g_OpMode == MASTER && g_Master_Board == True)              /**< 마스터 보드로 설정 되었음(HCR 입력됨). */
    {
       switch(Rx_Wait_Timer1c)  {     
       case STOP :                                                     /**< 0x01 */
         Transmit_Data_To_Rs485(serial1);                              /**< PC로 데이타 송신 */
-        Rx_Wait_Timer1d = cT_10msec;                                  /**< 10msec 수신대기 타이머 동작 시킴 */
+        _pollUsec = Device_Usec_Now();                                /**< 수신대기 시간은 보드별 RTT로 정함(Rs485_Link_Rto) */
+        Rs485_Link_Sent(g_send_dmpc_cnt);
         Rx_Wait_Timer1c = RUN;
         Led_Toggle(comtx_led);
       break;
          
       case EXPIRED :                                                  /**< 0x02, PC로 부터 데이타 수신 대기 타이머가 아웃된 상태임 */     
+        Rx_Wait_Timer1c = STOP;
+        _pollRetry = (Rs485_Link_Timeout(g_send_dmpc_cnt) == True) ? False : True;
+        if (Rs485_Baud_Check_Errors(0U, 1U) == True)                  /**< 빠른 속도에서 무응답이 잦으면 기본 속도로 */
+        {
+           Rs485_Baud_Fallback();
+           break;
+        }
+        if (_pollRetry == True)                                      /**< 재시도 한도 안이면 같은 보드에 다시 요구 */
+        {
+           break;
+        }
         cprintf("============================================================\n\n");    
         cprintf("Data not received from DM/PC Board!!! Please Check the DM/PC Board\n\n");
         cprintf("============================================================\n\n");
@@ -125,51 +182,494 @@ void Rs485com_Thread(void)
         /**< 통신 error 발생시에 tcms쪽에 error 발생여부 통보는 어떤 방식으로......????  */    
         Led_Off(comrx_led);
         Led_On(com_err_led);                                         /**< 485_Com_Error */        
-        Relay_Off(hlt_out);                                          /**< Healty Relay Off */
-        Led_Off(hlt_led);                                            /**< Healty Led Off */        
+        Fault_Raise(kFLT_COM_TIMEOUT, g_send_dmpc_cnt);              /**< Healty Relay/Led Off */
       break;
          
       default :                                                      /**< 0x00,timer1c == RUN 상태(수신 대기 상태) */         
        /**< PC(Passenger Car)보드로 부터 데이타 입력이 발생하면 */
         if(serial1->rx_complete == True)  {
            Rx_Wait_Timer1c = STOP;                                   /**< 데이타 수신 완료 됨 */     
-           /* 명령어 버퍼를 수신된 데이터로 채운다. */
-           Rs485_Data_Fill_rxBuf(serial1);   
-           /* RS-232 시리얼 포트의 수신을 복구시킨다. */
-           Rs485_Restore_rx(serial1);      
-           /* 명령어 버퍼의 내용을 처리한다. */
-           Receive_Data_From_Rs485();
-           Led_Toggle(comrx_led);
-           Rs485_Monitor_Rx();
-           _rxCnt = 0;   
+           Rs485_Rx_Process();
+        }
+        else if ((Device_Usec_Now() - _pollUsec) >= Rs485_Link_Rto(g_send_dmpc_cnt))
+        {
+           Rx_Wait_Timer1c = EXPIRED;
         }
       break;
       }
    }
    else if(g_OpMode == MASTER && g_Master_Board == False)            /**< 슬레이브 보드로 설정 되었음.(HCR 입력 안됨) */
    {
+      Rs485_Slave_Update_Response();                                 /**< 상태가 바뀐 때만 응답 frame/CRC 재생성 */
+      serial1->rx_hook = (g_rs485_isr_reply == True) ? &Rs485com_Rx_Isr : NULL;
       if(serial1->rx_complete == True)                                /**< 데이타 수신 완료 됨 */ 
       {                                   
-         /* 명령어 버퍼를 수신된 데이터로 채운다. */
-         Rs485_Data_Fill_rxBuf(serial1);   
-         /* RS-232 시리얼 포트의 수신을 복구시킨다. */
-         Rs485_Restore_rx(serial1);      
-         /* 명령어 버퍼의 내용을 처리한다. */
-         Receive_Data_From_Rs485();
-         Led_Toggle(comrx_led);
-         Rs485_Monitor_Rx();
-         _rxCnt = 0;   
+         Rs485_Rx_Process();
       }
+      Rs485_Baud_Slave_Process();                                    /**< COMMIT 속도 적용, 무수신 시 기본 속도 복귀 */
     }      
 }
 
+/** \brief  broadcast 요구를 보내고 수집 창 동안 모든 보드의 응답을 모은다.
+  * \note   수집 창 = broadcast frame + 보드 수 x slot + guard.
+  *         응답이 모두 오거나 창이 지나면 cycle을 마치고 다음 호출에서 바로 다음 broadcast를 보낸다.
+  * \retval 없음
+  */
+static void Rs485_Broadcast_Poll(void)
+{
+  u32_t slot, request;
+  u08_t id;
+
+  if (_tdma.busy == False)
+  {
+    slot    = Rs485_Tdma_Slot_usec(Rs485_Baud_Rate(Rs485_Baud_Current()), sizeof(Curs485_Packet_t));
+    request = Rs485_Tdma_Frame_usec(Rs485_Baud_Rate(Rs485_Baud_Current()), sizeof(Curs485_Packet_t));
+    Rs485_Tdma_Start(&_tdma, g_IdCnt, slot, request, Device_Usec_Now());
+    for (id = 1U; id <= _tdma.nodes; id++)
+    {
+      Rs485_Link_Sent(id);
+    }
+    Rs485_Data_Fill_txBuf();
+    Rs485_Transmit_Data(serial1, _txBuf, _txCnt);
+    Rs485_Monitor_Tx();
+    Led_Toggle(comtx_led);
+    return;
+  }
+
+  if (serial1->rx_complete == True)                                  /**< 한 묶음에 여러 보드의 응답이 있을 수 있음 */
+  {
+    Rs485_Rx_Process();
+  }
+
+  if (Rs485_Tdma_Done(&_tdma, Device_Usec_Now()) == True)
+  {
+    Rs485_Broadcast_Done();
+  }
+}
+
+/** \brief  끝난 수집 cycle의 결과를 처리한다.
+  * \note   응답하지 않은 보드는 Rs485_Link_Timeout()으로 세고, 연속 무응답이 재시도 한도를 넘은
+  *         보드만 통신 timeout fault를 올린다(개별 polling의 EXPIRED와 같은 조치).
+  * \retval 없음
+  */
+static void Rs485_Broadcast_Done(void)
+{
+  u08_t id;
+  u32_t miss = 0U;
+
+  if (g_monitor_485_rx == True)
+  {
+    cprintf("TDMA cycle %d usec, last reply %d usec, seen %02X\n",
+            _tdma.cycle_usec, _tdma.last_usec, _tdma.seen);
+  }
+  for (id = 1U; id <= _tdma.nodes; id++)
+  {
+    if (Rs485_Tdma_Is_Seen(&_tdma, id) == False)
+    {
+      miss++;
+    }
+    if ((Rs485_Tdma_Is_Seen(&_tdma, id) == False) && (Rs485_Link_Timeout(id) == True))
+    {
+      cprintf("Data not received from DM/PC Board ID=%d\n", id);
+      Led_Off(comrx_led);
+      Led_On(com_err_led);
+      Fault_Raise(kFLT_COM_TIMEOUT, id);
+    }
+  }
+  if (Rs485_Baud_Check_Errors(0U, miss) == True)
+  {
+    Rs485_Baud_Fallback();
+  }
+}
+
+/** \brief  마스터가 받은 응답의 RTT를 보드별 link 통계에 넣는다.
+  * \note   개별 polling은 요구 송신부터, broadcast는 그 보드의 slot 시작부터 잰다.
+  * \retval 없음
+  */
+static void Rs485_Link_Reply_Record(u08_t id)
+{
+  u32_t now = Device_Usec_Now();
+
+  if (g_rs485_tdma == False)
+  {
+    Rs485_Link_Reply(id, now - _pollUsec);
+  }
+  else if (Rs485_Tdma_Mark(&_tdma, id, now) == True)
+  {
+    Rs485_Link_Reply(id, now - _tdma.start_usec - Rs485_Tdma_Offset_usec(id, _tdma.slot_usec));
+  }
+}
+
+/** \brief  지금 응답을 기다리는 보드를 구한다.
+  * \retval 보드 ID, 알 수 없으면 0
+  */
+static u08_t Rs485_Link_Pending_Id(void)
+{
+  if (g_rs485_tdma == False)
+  {
+    return g_send_dmpc_cnt;
+  }
+  return Rs485_Tdma_Slot_At(&_tdma, Device_Usec_Now());
+}
+
+/** \brief  슬레이브의 자기 slot 시각에 TDMA 응답을 보낸다.
+  * \note   broadcast 수신 때 Device_Usec_Alarm_Start()로 예약되어 USEC_TIM 인터럽트 안에서 불린다.
+  *         superloop를 거치지 않으므로 다른 쓰레드가 loop를 막아도(Sysmon 점검 등) slot을 놓치지 않는다.
+  *         USEC_TIM 인터럽트 우선순위가 USART1 수신 인터럽트와 같아 송신 버퍼를 두고 서로 끼어들지 않는다.
+  * \retval 없음
+  */
+static void Rs485_Slot_Alarm(void)
+{
+  if (Rs485_Transmit_Data_Isr(serial1, _resp[_respIdx], sizeof(Curs485_Packet_t)) == True)
+  {
+    _isrReplies++;
+  }
+}
+
+/** \brief  마스터의 통신 속도 협상을 진행한다.
+  * \note   협상이 필요하면 진행 중인 polling cycle이 끝난 뒤 시작한다.
+  *         보드마다 BAUD_PROPOSE를 보내 BAUD_ACK(받아들일 속도)를 받고, 답한 속도 중 최소를
+  *         broadcast BAUD_COMMIT로 두번 알린 뒤 자기 속도를 바꾼다. 답하지 않은 보드가 있으면 기본 속도로 정한다.
+  *         슬레이브는 COMMIT 후 RS485_BAUD_SWITCH_msec 뒤에 바꾸므로 그동안 polling을 쉰다.
+  * \retval 협상 중이면 True(이번 호출의 polling 생략)
+  */
+static Bool_t Rs485_Baud_Master_Process(void)
+{
+  u32_t tick = HAL_GetTick();
+  u32_t hold;
+
+  switch (_baudStep)
+  {
+  case kBAUD_STEP_IDLE :
+    if ((Rs485_Baud_Need_Negotiation() == False) || (_tdma.busy == True) || (Rx_Wait_Timer1c != STOP))
+    {
+      return False;
+    }
+    _negCode  = Rs485_Baud_Neg_Start(g_IdCnt);
+    _negId    = 1U;
+    _baudStep = kBAUD_STEP_PROPOSE;
+  break;
+
+  case kBAUD_STEP_PROPOSE :
+    if (_negId > g_IdCnt)                                            /**< 모든 보드에 물어봤음 */
+    {
+      _negCode      = Rs485_Baud_Neg_Result();
+      _commitSent   = 0U;
+      _baudFallback = False;
+      _baudStep     = kBAUD_STEP_COMMIT;
+    }
+    else if (Rs485_Is_Tx_Idle(serial1) == True)
+    {
+      Rs485_Send_Control(_negId, BAUD_PROPOSE, (u08_t)_negCode);
+      _baudUsec = Device_Usec_Now();
+      _baudStep = kBAUD_STEP_WAIT_ACK;
+    }
+  break;
+
+  case kBAUD_STEP_WAIT_ACK :
+    if (serial1->rx_complete == True)
+    {
+      Rs485_Rx_Process();                                            /**< BAUD_ACK면 다음 보드로 넘어감 */
+    }
+    else if ((Device_Usec_Now() - _baudUsec) >= Rs485_Link_Rto(_negId))
+    {
+      _negId++;                                                      /**< 무응답 : 결과는 기본 속도가 됨 */
+      _baudStep = kBAUD_STEP_PROPOSE;
+    }
+  break;
+
+  case kBAUD_STEP_COMMIT :
+    if (_commitSent < 2U)
+    {
+      if (Rs485_Is_Tx_Idle(serial1) == True)
+      {
+        Rs485_Send_Control(RS485_TDMA_BROADCAST_ID, BAUD_COMMIT, (u08_t)_negCode);
+        _commitSent++;
+      }
+    }
+    else if (Rs485_Set_Baud(serial1, Rs485_Baud_Rate(_negCode)) == True)  /**< 두번째 COMMIT 송신이 끝나야 바뀜 */
+    {
+      Rs485_Baud_Commit(_negCode, tick);
+      Rs485_Link_Reset_Rtt();                                        /**< RTT는 속도마다 다르므로 다시 잰다 */
+      cprintf("RS485 Baud %d bps%s\n", Rs485_Baud_Rate(_negCode), (_baudFallback == True) ? " (fallback)" : "");
+      _baudTick = tick;
+      _baudStep = kBAUD_STEP_HOLD;
+    }
+  break;
+
+  default :                                                          /**< kBAUD_STEP_HOLD */
+    hold = (_baudFallback == True) ? RS485_BAUD_HOLD_msec : (2U * RS485_BAUD_SWITCH_msec);
+    if ((tick - _baudTick) >= hold)                                  /**< 되돌림은 COMMIT을 못 받은 보드의 무수신 복귀까지 */
+    {
+      _baudStep = kBAUD_STEP_IDLE;
+    }
+  break;
+  }
+  return True;
+}
+
+/** \brief  오류가 잦은 빠른 속도를 버리고 기본 속도로 되돌린다.
+  * \note   진행 중인 polling cycle은 버린다. COMMIT을 못 받은 보드는 무수신 복귀로 기본 속도가 된다.
+  *         허용 속도가 한 단계 낮아졌으면 대기 후 그 속도로 다시 협상한다.
+  * \retval 없음
+  */
+static void Rs485_Baud_Fallback(void)
+{
+  _negCode        = RS485_BAUD_BASE;
+  _commitSent     = 0U;
+  _baudFallback   = True;
+  _tdma.busy      = False;
+  Rx_Wait_Timer1c = STOP;
+  _baudStep       = kBAUD_STEP_COMMIT;
+}
+
+/** \brief  슬레이브의 속도 변경을 처리한다.
+  * \note   COMMIT을 받으면 RS485_BAUD_SWITCH_msec 뒤에(마스터의 두번째 COMMIT이 끝난 뒤) 바꾸고,
+  *         빠른 속도에서 RS485_BAUD_SILENCE_msec 동안 정상 frame이 없으면 기본 속도로 돌아간다.
+  * \retval 없음
+  */
+static void Rs485_Baud_Slave_Process(void)
+{
+  u32_t tick = HAL_GetTick();
+
+  if ((_slaveSwitch == False) && (Rs485_Baud_Is_Silent(tick) == True))
+  {
+    _slaveCode   = RS485_BAUD_BASE;
+    _slaveTick   = tick - RS485_BAUD_SWITCH_msec;
+    _slaveSwitch = True;
+  }
+  if ((_slaveSwitch == False) || ((tick - _slaveTick) < RS485_BAUD_SWITCH_msec))
+  {
+    return;
+  }
+  if (Rs485_Set_Baud(serial1, Rs485_Baud_Rate(_slaveCode)) == True)  /**< 응답 송신 중이면 다음 호출에서 */
+  {
+    _slaveSwitch = False;
+    Rs485_Baud_Commit(_slaveCode, tick);
+    Rs485_Frame_Reset(&_rxParser);                                   /**< 이전 속도로 받던 조각은 버린다 */
+    Rs485_Frame_Reset(&_isrParser);
+  }
+}
+
+/** \brief  제어 frame(BAUD_PROPOSE/ACK/COMMIT, DIAG_REQUEST)을 보낸다.
+  * \param  id       - 받을 보드 ID(COMMIT은 RS485_TDMA_BROADCAST_ID)
+  * \param  msg_type - BAUD_PROPOSE, BAUD_ACK, BAUD_COMMIT, DIAG_REQUEST
+  * \param  code     - 속도 번호(Rs485Baud_t), DIAG_REQUEST는 NOT_USE
+  * \retval 없음
+  */
+static void Rs485_Send_Control(u08_t id, u08_t msg_type, u08_t code)
+{
+  Curs485_Packet_t *packet = (Curs485_Packet_t*)&_txBuf[0];
+  u16_t  crc;
+
+  packet->stx         = STX;
+  packet->data_len    = DEFAULT_DATA_LENGTH;
+  packet->heartbit    = 0x00;
+  packet->dmpc_id     = id;
+  packet->msg_type    = msg_type;
+  packet->state_code  = code;
+  packet->detail_code = NOT_USE;
+  crc = Crc16_Krs(&_txBuf[1], 6);
+  packet->crc_high    = (u08_t)(crc >> 8);
+  packet->crc_low     = (u08_t)(crc & 0xFF);
+  packet->etx         = ETX;
+  _txCnt = sizeof(Curs485_Packet_t);
+
+  __disable_irq();                                                   /**< 슬레이브 수신 인터럽트의 응답 송신과 송신 버퍼 공유 */
+  (void)Rs485_Transmit_Data_Isr(serial1, _txBuf, _txCnt);
+  __enable_irq();
+  Rs485_Monitor_Tx();
+  Led_Toggle(comtx_led);
+}
+
+/** \brief  polling cycle 사이에 보드 하나씩 확장 진단을 요구하고 응답을 받는다(마스터).
+  * \note   진행 중인 cycle/재시도가 없고 RS485_DIAG_PERIOD_msec가 지났을 때만 요구하므로
+  *         안전 polling은 진단 frame 하나 만큼만 늦어진다. 무응답은 진단 통계에만 센다.
+  * \retval 진단 요구/대기 중이면 True(이번 호출의 polling 생략)
+  */
+static Bool_t Rs485_Diag_Master_Process(void)
+{
+  u32_t tick = HAL_GetTick();
+  u32_t wait;
+
+  if (_diagWait == False)
+  {
+    if (((tick - _diagTick) < RS485_DIAG_PERIOD_msec) || (_tdma.busy == True) ||
+        (Rx_Wait_Timer1c != STOP) || (_pollRetry == True) || (Rs485_Is_Tx_Idle(serial1) == False))
+    {
+      return False;
+    }
+    _diagId = Rs485_Diag_Next_Id(g_IdCnt);
+    if (_diagId == 0U)
+    {
+      return False;
+    }
+    Rs485_Send_Control(_diagId, DIAG_REQUEST, NOT_USE);
+    Rs485_Diag_Sent(_diagId);
+    _diagUsec = Device_Usec_Now();
+    _diagTick = tick;
+    _diagWait = True;
+    return True;
+  }
+
+  wait = Rs485_Link_Rto(_diagId) + RS485_DIAG_REPLY_usec +
+         Rs485_Tdma_Frame_usec(Rs485_Baud_Rate(Rs485_Baud_Current()), RS485_DIAG_FRAME_SIZE);
+  if (serial1->rx_complete == True)
+  {
+    Rs485_Rx_Process();                                              /**< 진단 frame이면 _diagWait 해제 */
+  }
+  else if ((Device_Usec_Now() - _diagUsec) >= wait)
+  {
+    Rs485_Diag_Timeout(_diagId);
+    _diagWait = False;
+  }
+  return True;
+}
+
+/** \brief  자기 보드의 확장 진단 frame을 보낸다(슬레이브).
+  * \note   superloop에서 만들어 보낸다. 진단은 안전 응답보다 늦어도 되므로 수신 인터럽트에서 보내지 않는다.
+  * \retval 없음
+  */
+static void Rs485_Slave_Diag_Reply(void)
+{
+  Rs485Diag_t diag;
+  u32_t       len;
+
+  Rs485_Diag_Collect(g_IdCnt, &diag);
+  len = Rs485_Diag_Build_Frame(&diag, _diagBuf, sizeof(_diagBuf));
+  __disable_irq();                                                   /**< 수신 인터럽트의 응답 송신과 송신 버퍼 공유 */
+  (void)Rs485_Transmit_Data_Isr(serial1, _diagBuf, len);
+  __enable_irq();
+  Led_Toggle(comtx_led);
+}
+
+/** \brief  슬레이브 응답 frame을 미리 만들어 둔다.
+  * \note   ID, g_State_Code, g_Detail_Code가 바뀐 때만 쓰지 않는 쪽 버퍼에 새로 만들고 CRC를 계산한 뒤
+  *         _respIdx를 바꿔 인터럽트가 완성된 frame만 보내게 한다.
+  * \retval 없음
+  */
+static void Rs485_Slave_Update_Response(void)
+{
+  Curs485_Packet_t *packet;
+  u08_t  next;
+  u16_t  crc;
+
+  Rs485_Slave_Fault_Code();
+  if ((_respId == g_IdCnt) && (_respState == g_State_Code) && (_respDetail == g_Detail_Code))
+  {
+    return;
+  }
+  next   = (u08_t)(_respIdx ^ 1U);
+  packet = (Curs485_Packet_t*)&_resp[next][0];
+  packet->stx         = STX;
+  packet->data_len    = DEFAULT_DATA_LENGTH;
+  packet->heartbit    = 0x00;
+  packet->dmpc_id     = g_IdCnt;                                     /**< 객차 ID : 0x01~0x06  */
+  packet->msg_type    = RESPONCE;
+  packet->state_code  = g_State_Code;                                /**< Fault Code : 0x00(default)   */
+  packet->detail_code = g_Detail_Code;                               /**< 탈선 상태 : 0x00(정상),0x01(탈선)   */
+  crc = Crc16_Krs(&_resp[next][1], 6);
+  packet->crc_high    = (u08_t)(crc >> 8);
+  packet->crc_low     = (u08_t)(crc & 0xFF);
+  packet->etx         = ETX;
+
+  _respState  = g_State_Code;
+  _respDetail = g_Detail_Code;
+  _respIdx    = next;
+  _respId     = g_IdCnt;
+}
+
+/** \brief  latch된 자기 고장을 슬레이브 응답의 SELFTEST_FAIL 번호로 바꾼다.
+  * \note   번호는 마스터의 Check_DEPC_State()가 해석하는 F_105 ~ F_113 순서이다.
+  *         탈선(DERAILMENT_FAIL)은 Decide_DEOD_State()가 정하며 리셋 전까지 우선한다.
+  * \retval 없음
+  */
+static void Rs485_Slave_Fault_Code(void)
+{
+  static const u08_t code[][2] =
+  {
+    { (u08_t)kFLT_STL,          0x01U },
+    { (u08_t)kFLT_SENSOR_VOLT,  0x02U },
+    { (u08_t)kFLT_SELF_RELAY,   0x03U },
+    { (u08_t)kFLT_EB_FB,        0x03U },
+    { (u08_t)kFLT_TEMP_MAJ,     0x04U },
+    { (u08_t)kFLT_TEMP_MIN,     0x05U },
+    { (u08_t)kFLT_POWER,        0x06U },
+    { (u08_t)kFLT_ISOL,         0x07U },
+    { (u08_t)kFLT_WATCHDOG,     0x08U },
+    { (u08_t)kFLT_SELF_SENSOR,  0x09U },
+    { (u08_t)kFLT_SELF_OSSD,    0x09U },
+  };
+  u32_t i;
+
+  if (g_State_Code == DERAILMENT_FAIL)
+  {
+    return;
+  }
+  for (i = 0U; i < (sizeof(code) / sizeof(code[0])); i++)
+  {
+    if (Fault_Is_Latched((FaultCode_t)code[i][0]) == True)
+    {
+      g_State_Code  = SELFTEST_FAIL;
+      g_Detail_Code = code[i][1];
+      return;
+    }
+  }
+}
+
+/** \brief  USART1 수신 인터럽트에서 byte마다 호출되어 슬레이브 요구에 바로 응답한다.
+  * \param  byte - 수신된 byte
+  * \note   serial1->rx_hook로 등록된다. 자기 ID의 요구면 미리 만든 응답을 바로 송신 버퍼에 넣고,
+  *         broadcast면 자기 slot 시각에 USEC_TIM 비교 인터럽트로 송신하도록 예약한다(slot 0이면 바로 송신).
+  *         수신 묶음 처리(superloop)를 기다리지 않으므로 응답 시간이 superloop 위치와 무관하다.
+  * \retval 없음
+  */
+void Rs485com_Rx_Isr(u08_t byte)
+{
+  Rs485Frame_t            frame;
+  const Curs485_Packet_t *packet = (const Curs485_Packet_t*)&frame.data[0];
+  u32_t                   delay;
+
+  if ((g_Master_Board == True) || (_respId == 0U))
+  {
+    return;
+  }
+  Rs485_Frame_Feed(&_isrParser, byte);
+  if ((Rs485_Frame_Get(&_isrParser, &frame) == False) || (frame.len != sizeof(Curs485_Packet_t)))
+  {
+    return;
+  }
+  if ((packet->msg_type == REQUEST) && (packet->dmpc_id == _respId))
+  {
+    if (Rs485_Transmit_Data_Isr(serial1, _resp[_respIdx], sizeof(Curs485_Packet_t)) == True)
+    {
+      _isrReplies++;
+    }
+  }
+  else if ((packet->msg_type == BROADCAST) && (packet->dmpc_id == RS485_TDMA_BROADCAST_ID))
+  {
+    delay = Rs485_Tdma_Offset_usec(_respId, Rs485_Tdma_Slot_Decode(packet->detail_code));
+    if (delay == 0U)
+    {
+      Rs485_Slot_Alarm();
+    }
+    else
+    {
+      Device_Usec_Alarm_Start(Device_Usec_Now() + delay, &Rs485_Slot_Alarm);
+    }
+  }
+}
+
 
 static void Transmit_Data_To_Rs485(Rs485_t * rs)
 {
   u08_t i;  
   /**< 연결된 객차(PC(Passenger Car)보드)수 만큼 송신을 한다. */
 //    if(g_send_dmpc_cnt >= g_dmpc_cnt)  {                             /**< 최대 4대 연결  */
-    if(g_send_dmpc_cnt >= g_IdCnt)  {                             /**< 최대 4대 연결  */  
+    if(_pollRetry == True)  {                                     /**< 무응답 재시도 : 같은 보드 */
+        _pollRetry = False;
+    }
+    else if(g_send_dmpc_cnt >= g_IdCnt)  {                        /**< 최대 4대 연결  */  
         g_send_dmpc_cnt = 0;
     }
     else  {
@@ -186,6 +686,7 @@ static void Transmit_Data_To_Rs485(Rs485_t * rs)
 
 /** \brief  송신 버퍼를 채운다.
   * \note   송신할 내용으로 버퍼를 채우고 버퍼 카운트를 증가시킨다.
+  *         마스터 요구용이며, 슬레이브 응답은 Rs485_Slave_Update_Response()가 미리 만들어 둔다.
   * \retval 없음
 */
 static void Rs485_Data_Fill_txBuf(void)
@@ -205,28 +706,28 @@ static void Rs485_Data_Fill_txBuf(void)
   //  packet->seq_no = seq_no;       // D:\GIT\모터카관련\motocar_speed_meter_board(V060) 참조         
 //  packet->heartbit = 0x00;
 //  g_heartbit++;
-   if(g_OpMode == MASTER && g_Master_Board == True)
+   if(g_OpMode == MASTER && g_Master_Board == True && g_rs485_tdma == True)
+   {
+      packet->dmpc_id = RS485_TDMA_BROADCAST_ID;                     /**< 전체 보드 */
+      packet->msg_type = BROADCAST;
+      packet->state_code = _tdma.nodes;                              /**< 응답할 보드 수 */
+      packet->detail_code = Rs485_Tdma_Slot_Code(_tdma.slot_usec);   /**< slot 폭(100usec 단위) */
+   }
+   else if(g_OpMode == MASTER && g_Master_Board == True)
    {
       packet->dmpc_id = g_send_dmpc_cnt;	                           /**< 객차 ID : 0x01~0x06  */
       packet->msg_type = REQUEST;	                                   /**< Msg_Type : 0x01 : request , 0x02 : response   */
       packet->state_code = NOT_USE;	                                 /**< Fault Code : 0x00(default)  */
       packet->detail_code = NOT_USE;	                               /**< 탈선 상태 : 0x00(정상),0x01(탈선)  */
    }
-   else if(g_OpMode == MASTER && g_Master_Board == False)
-   {
-      packet->dmpc_id = g_IdCnt;	                                   /**< 객차 ID : 0x01~0x06  */
-      packet->msg_type = RESPONCE;	                                 /**< Msg_Type : 0x01 : request , 0x02 : response  */
-      packet->state_code = g_State_Code;	                           /**< Fault Code : 0x00(default)   */
-      packet->detail_code = g_Detail_Code;	                         /**< 탈선 상태 : 0x00(정상),0x01(탈선)   */  
-   }
    
   /* CRC 생성 */
-   temp_crc = getCRC16_KRS(&_txBuf[1],6);
+   temp_crc = Crc16_Krs(&_txBuf[1],6);
    temp_crcbuf[1] = (temp_crc & 0xFF);
 	 temp_crcbuf[0] = ((temp_crc & 0xFF00) >> 8);  
    packet->crc_high = temp_crcbuf[0];	                               // CRC High : 0x00(default)  /*0xC110 polynomial 0x8005 */
    packet->crc_low = temp_crcbuf[1];	                               // CRC Low  : 0x00(default)
-//  cprintf("Rx CRC Wrong high =%X,low=%X\n",packet->crc_high,packet->crc_low);
+   LOG2(TRACE, RS485, "Tx CRC high=%X, low=%X\n", packet->crc_high, packet->crc_low);
    packet->etx = ETX;	                                             // 메세지 테일(ETX)  
    _txCnt    = sizeof(Curs485_Packet_t);  	
 }
@@ -250,103 +751,217 @@ static void Rs485_Monitor_Tx(void)
      cprintf("%02X", _txBuf[i]);
   }
   cprintf("\n");
+  if (serial1->hdma_tx != NULL)                                      /**< DMA 송신 통계와 DE 해제 지연(직전 frame 기준) */
+  {
+     cprintf("  DMA Frame %d, Drop %d, Turnaround %d usec (max %d)\n",
+             serial1->dma_frames, serial1->dma_drop, serial1->turn_usec, serial1->turn_max_usec);
+  }
 }
 
-/** \brief  전역변수 _rx_buf를 DEPC로 수신된 데이터로 채운다.
-  * \param  rs - RS232 구조체 포인터
-  * \note   _rx_buf의 여유공간과 수신된 길이가 _rx_buf 버퍼 크기를 초과한다면
-            버퍼를 클리어하고 그렇지 않으면 수신된 길이만큼 버퍼에 복사한다.
+/** \brief  드라이버 수신 버퍼의 frame을 그 자리에서 처리하고 버퍼를 내보낸다.
+  * \note   수신 버퍼를 복사하지 않고 Rs485_Frame_Scan()이 돌려주는 view로 바로 처리한다.
+  *         parser는 수신 묶음 사이에서도 상태를 유지하므로 frame이 수신 timeout 경계에 걸려도 잃지 않는다.
+  *         처리를 시작할 때의 byte 수만큼만 내보내므로 처리하는 동안 받은 byte는 다음 호출에서 처리한다.
   * \retval 없음
   */
-static void Rs485_Data_Fill_rxBuf(Rs485_t * rs)
+static void Rs485_Rx_Process(void)
 {
+  u32_t n = serial1->rx_count;
+  u32_t crc_err;
 
-
-  if (rs->rx_count !=0U)                                          /**< 수신된 길이가 없다면 종료 */
-  {  
-		 if ((_rxCnt + rs->rx_count) > MAX_SIZE_CMD_BUF)              /**< 수신된 길이와 버퍼의 여유 길이의 합이 최대 크기를 초과했다면 버퍼를 클리어한다.*/
-		 {
-			  _rxCnt = 0U;
-			  Buffer08_Set(&_rxBuf[0], 0U, MAX_SIZE_CMD_BUF);
-		 }
-		 else                                                          /**< 수신된 길이가 적당하다면 버퍼에 복사하고 버퍼 카운트를 수신된 길이만큼 증가시킨다.*/
-		 {
-			  Buffer08_Copy(&_rxBuf[_rxCnt], rs->rx_buf, rs->rx_count);
-			  _rxCnt += rs->rx_count;
-		 }
-	}  
+  if (n == 0U)
+  {
+    Rs485_Restore_rx(serial1);
+    return;
+  }
+  crc_err = _rxParser.drop[kRS485_DROP_CRC];
+  Receive_Data_From_Rs485(serial1->rx_buf, n);
+  for (; crc_err != _rxParser.drop[kRS485_DROP_CRC]; crc_err++)     /**< CRC 오류는 응답을 기다리던 보드로 센다 */
+  {
+    Rs485_Link_Crc_Error(Rs485_Link_Pending_Id());
+  }
+  if ((g_Master_Board == True) && (_baudStep == kBAUD_STEP_IDLE) &&  /**< 정상/CRC 오류 frame을 속도 오류 창에 */
+      (Rs485_Baud_Check_Errors(_rxParser.frames - _errFrames, _rxParser.drop[kRS485_DROP_CRC] - _errCrc) == True))
+  {
+    Rs485_Baud_Fallback();
+  }
+  _errFrames = _rxParser.frames;
+  _errCrc    = _rxParser.drop[kRS485_DROP_CRC];
+  Rs485_Monitor_Rx(serial1->rx_buf, n);
+  Rs485_Release_rx(serial1, n);
+  Led_Toggle(comrx_led);
 }
 
 /** \brief  CU 보드에서 수신하는 내용을 모니터링한다.
+  * \param  buf - 드라이버 수신 버퍼
+  * \param  n   - 출력할 byte 수
   * \note   g_monitor_485_rx가 켜져 있으면 버퍼 카운트만큼 버퍼 내용을 출력한다.
   * \retval 없음
 */
-static void Rs485_Monitor_Rx(void)
+static void Rs485_Monitor_Rx(const u08_t * buf, u32_t n)
 {  
    uint32_t    i = 0U;
 
   /* 모니터링 플래그가 꺼져 있으면 종료 or 수신 버퍼 카운트가 0이면 종료*/
-   if (g_monitor_485_rx == False || _rxCnt == 0)
+   if (g_monitor_485_rx == False || n == 0)
    {
       return;
    }
 
    /* 수신 버퍼 카운트만큼 버퍼 내용을 출력한다. */
-   cprintf("PCrs485 Com RX[%3d] ", _rxCnt);
-   for (i = 0U; i < _rxCnt; i++)
+   cprintf("PCrs485 Com RX[%3d] ", n);
+   for (i = 0U; i < n; i++)
    {
-      cprintf("%02X", _rxBuf[i]);
+      cprintf("%02X", buf[i]);
    }
    cprintf("\n");
+
+   /* frame parser 통계 : 정상 frame 수와 이유별 버린 수 */
+   cprintf("  Frame %d, Drop", _rxParser.frames);
+   for (i = 0U; i < kNbrOfRs485Drops; i++)
+   {
+      cprintf(" %s=%d", Rs485_Frame_Drop_Name((Rs485Drop_t)i), _rxParser.drop[i]);
+   }
+   cprintf(", ISR Reply %d\n", _isrReplies);
 }
 
 /** \brief  RS 485 Port를 통하여 데이타를 수신한다.
-  * \note   
+  * \param  buf - 드라이버 수신 버퍼
+  * \param  n   - 받은 byte 수
+  * \note   parser가 찾아낸 frame을 모두 처리한다(한번의 수신에 여러 frame이 있을 수 있음).
+  *         packet은 수신 버퍼(또는 parser) 안의 frame을 가리키는 읽기 전용 view이다.
   * \retval 없음
 */
-static void Receive_Data_From_Rs485(void)
+static void Receive_Data_From_Rs485(const u08_t * buf, u32_t n)
 {    
-  
-   Curs485_Packet_t	*packet = (Curs485_Packet_t*)&_rxBuf[0];
+   Rs485View_t             frame;
+   const Curs485_Packet_t *packet;
+   Rs485Diag_t             diag;
+   u32_t                   pos = 0U;
 
-   if (PCrs485Com_Validate_rx() == False)
-   {
-      return;
-   }
-   if(g_OpMode == MASTER && g_Master_Board == True)  
-   {        
-      Check_DEPC_State(packet); 
-   }
-   else if(g_OpMode == MASTER && g_Master_Board == False)
+   while (Rs485_Frame_Scan(&_rxParser, buf, n, &pos, &frame) == True)
    {
-      Slave_Transmit_Data_To_Rs485(serial1);  
+      packet = (const Curs485_Packet_t*)frame.data;
+      if (PCrs485Com_Validate_rx(&frame) == False)
+      {
+         continue;
+      }
+      if (g_Master_Board == False)
+      {
+         Rs485_Baud_Rx_Ok(HAL_GetTick());                            /**< 무수신 복귀 판단용 */
+      }
+      if(g_OpMode == MASTER && g_Master_Board == True && packet->msg_type == RS485_DIAG_MSG)
+      {
+         if (Rs485_Diag_Parse_Frame(frame.data, frame.len, &diag) == True)
+         {
+            Rs485_Diag_Store(&diag, HAL_GetTick());
+            if ((_diagWait == True) && (diag.id == _diagId))
+            {
+               _diagWait = False;
+            }
+         }
+      }
+      else if(g_OpMode == MASTER && g_Master_Board == True && packet->msg_type == BAUD_ACK)
+      {
+         Rs485_Baud_Neg_Ack(packet->dmpc_id, (Rs485Baud_t)packet->state_code);
+         if ((_baudStep == kBAUD_STEP_WAIT_ACK) && (packet->dmpc_id == _negId))
+         {
+            _negId++;                                                /**< 다음 보드에 제안 */
+            _baudStep = kBAUD_STEP_PROPOSE;
+         }
+      }
+      else if(g_OpMode == MASTER && g_Master_Board == True)  
+      {        
+         Rs485_Link_Reply_Record(packet->dmpc_id);
+         Check_DEPC_State(packet); 
+      }
+      else if(packet->msg_type == BAUD_PROPOSE)
+      {
+         Rs485_Send_Control(g_IdCnt, BAUD_ACK, (u08_t)Rs485_Baud_Accept((Rs485Baud_t)packet->state_code));
+      }
+      else if(packet->msg_type == DIAG_REQUEST)
+      {
+         Rs485_Slave_Diag_Reply();
+      }
+      else if(packet->msg_type == BAUD_COMMIT)
+      {
+         _slaveCode   = (Rs485Baud_t)packet->state_code;             /**< 마스터의 두번째 COMMIT 송신이 끝난 뒤 바꾼다 */
+         _slaveTick   = HAL_GetTick();
+         _slaveSwitch = True;
+      }
+      else if(serial1->rx_hook != NULL)
+      {
+         continue;                                                   /**< 수신 인터럽트에서 이미 응답함 */
+      }
+      else if(g_OpMode == MASTER && g_Master_Board == False && packet->msg_type == BROADCAST)
+      {
+         Device_Usec_Alarm_Start(Device_Usec_Now() +                 /**< 자기 slot 시각에 USEC_TIM 인터럽트에서 응답 */
+                                 Rs485_Tdma_Offset_usec(g_IdCnt, Rs485_Tdma_Slot_Decode(packet->detail_code)),
+                                 &Rs485_Slot_Alarm);
+      }
+      else if(g_OpMode == MASTER && g_Master_Board == False)
+      {
+         Slave_Transmit_Data_To_Rs485(serial1);  
+      }
    }
 }
 
 /** \brief  수신된 데이터를 검증한다.
-  * \note   수신된 데이터의 길이, 헤드, command를 검사하여 이상이 감지되면 False를 반환하며 종료.
+  * \param  frame - parser가 STX, LEN, CRC, ETX를 확인한 frame
+  * \note   수신된 데이터의 길이, command, ID를 검사하여 이상이 감지되면 False를 반환하며 종료.
             모든 검사가 통과되면 True를 반한.
   * \retval 이상이 없으면 True, 그렇지 않으면 False를 반환한다.
 */
-static Bool_t PCrs485Com_Validate_rx(void)
+static Bool_t PCrs485Com_Validate_rx(const Rs485View_t * frame)
 {
-  uint8_t   seq_no;
-  uint16_t  temp_crc;
-  uint8_t   temp_crcbuf[2];
-  uint32_t  i = 0;
-  Curs485_Packet_t	*packet = (Curs485_Packet_t*)&_rxBuf[0];
+  const Curs485_Packet_t	*packet = (const Curs485_Packet_t*)frame->data;
 //  uint8_t         bcc1 = 0, bcc2 = 0;
 //  static uint8_t  heartbit;
   
 
-  /* 헤드 검사 */                    /* 길이 검사 */
-  if ((packet->stx != STX) || (_rxCnt != sizeof(Curs485_Packet_t))
-      || (packet->msg_type != REQUEST))
+  /* 진단 frame : 길이와 버전은 Rs485_Diag_Parse_Frame()에서 확인 */
+  if ((g_Master_Board == True) && (frame->len == RS485_DIAG_FRAME_SIZE) && (packet->msg_type == RS485_DIAG_MSG))
   {
-    cprintf("Rx Head Wrong or Rx Message Type Wrong or Rx Length Wrong (%d)\n",_rxCnt);
+    return ((packet->dmpc_id != 0U) && (packet->dmpc_id <= g_IdCnt)) ? True : False;
+  }
+
+  /* 길이 검사 */
+  if (frame->len != sizeof(Curs485_Packet_t))
+  {
+    Rs485_Link_Len_Error(((g_Master_Board == True) && (g_rs485_tdma == False)) ? g_send_dmpc_cnt : 0U);
+    LOG1(WARN, RS485, "Rx Length Wrong (%d)\n", frame->len);
     return False;
   }
 
+  /* Message Type, ID 검사 : 마스터는 응답만, 슬레이브는 자기 ID 요구와 broadcast만 받는다. */
+  if(g_OpMode == MASTER && g_Master_Board == True)
+  {
+    if ((packet->msg_type != RESPONCE) && (packet->msg_type != BAUD_ACK))
+    {
+      return False;                                                  /**< 자기 요구의 echo 등 */
+    }
+    if (((g_rs485_tdma == True) || (packet->msg_type == BAUD_ACK)) &&
+        ((packet->dmpc_id == 0U) || (packet->dmpc_id > g_IdCnt)))
+    {
+      Rs485_Link_Id_Error(0U);
+      LOG1(WARN, RS485, "Rx DEPC ID Mismatch ID=%d\n", packet->dmpc_id);
+      return False;
+    }
+  }
+  else
+  {
+    if ((packet->msg_type == BROADCAST) || (packet->msg_type == BAUD_COMMIT))
+    {
+      return (packet->dmpc_id == RS485_TDMA_BROADCAST_ID) ? True : False;
+    }
+    if (((packet->msg_type != REQUEST) && (packet->msg_type != BAUD_PROPOSE) && (packet->msg_type != DIAG_REQUEST)) ||
+        (packet->dmpc_id != g_IdCnt))
+    {
+      return False;                                                  /**< 다른 보드 요구/응답 */
+    }
+    return True;
+  }
+
   
   /* 길이 검사 */
 //  if (_rxCnt != sizeof(Curs485_Packet_t))
@@ -371,20 +986,13 @@ static Bool_t PCrs485Com_Validate_rx(void)
 //  }
 //  heartbit = packet->heartbit;
 
-  /* CRC 검사 */
-    temp_crc = getCRC16_KRS(&_rxBuf[1],6);
-    temp_crcbuf[1] = (temp_crc & 0xFF);
-  	temp_crcbuf[0] = ((temp_crc & 0xFF00) >> 8);
-    if ((temp_crcbuf[0] != packet->crc_high) || (temp_crcbuf[1] != packet->crc_low))
-    {
-       cprintf("Rx CRC Wrong high =%X,low=%X\n",packet->crc_high,packet->crc_low);
-       return False;
-    }
+  /* CRC 검사 : Rs485_Frame parser에서 확인함(불일치는 kRS485_DROP_CRC로 계수) */
 
   /* DM/PC ID 검사 */    
-    if(packet->dmpc_id != g_send_dmpc_cnt)
+    if((g_rs485_tdma == False) && (packet->msg_type == RESPONCE) && (packet->dmpc_id != g_send_dmpc_cnt))
     {
-       cprintf("Rx DEPC ID Mismatch ID=%d\n",packet->dmpc_id);
+       Rs485_Link_Id_Error(g_send_dmpc_cnt);
+       LOG1(WARN, RS485, "Rx DEPC ID Mismatch ID=%d\n", packet->dmpc_id);
        return False;      
     }
   /* 모두 통과했으면 합격 */    
@@ -414,16 +1022,18 @@ static Bool_t PCrs485Com_Validate_rx(void)
   * \note   수신된 데이타를 분석하여 DEPC Board의 탈선여부를 최종 결정한다.
   * \retval 없음.
 */
-static void Check_DEPC_State(Curs485_Packet_t	*packet)
+static void Check_DEPC_State(const Curs485_Packet_t	*packet)
 { 
   uint8_t State_Code;
-	Bool_t fb_eb1_state;
-	Bool_t fb_eb2_state;	  
   
   State_Code = packet->state_code;
   switch(State_Code)
   {      
   case DERAILMENT_FAIL :                                           // 탈선 상황 발생   
+    if(Eb_Act_Is_Tripped() == True)                                // 이미 EB 동작 중이면 안전 상태 유지
+    {
+       break;
+    }
     if(packet->detail_code == 0x01)                                // OBR 탈선 발생
     {  
        cprintf("======================================================\n\n");    
@@ -433,23 +1043,7 @@ static void Check_DEPC_State(Curs485_Packet_t	*packet)
        cprintf("\n\n\nF_101.(Derailment Activ)\n");                 // Fault Code 출력	
 //			  Led_On(led[i+2U]);	                                       // 감지된 해당 LED ON 		
 	     Led_On(obr_led);				
-		   Relay_On(eb1_out);
-			 Relay_On(eb2_out);
-//    		cprintf("\nEB1/EB2 Signal Output Command\n");			         // 퍼포먼스 테스트 코드	
-	  	 HAL_Delay(10);
-       fb_eb1_state = DI_Get_State(din[kRYFBI_EB1]);   
-       fb_eb2_state = DI_Get_State(din[kRYFBI_EB2]);           
-//			  eb1_state = (u08_t)(HAL_GPIO_ReadPin(GPIOD, GPIO_PIN_8));
-//			  eb2_state = (u08_t)(HAL_GPIO_ReadPin(GPIOD, GPIO_PIN_9));					
-				
-//				Relay_On(relay[i+4U]);                                     // 감지된 해당 릴레이 Signal ON 
-			 if((fb_eb1_state != True) || (fb_eb2_state != True))
-			 {  
-			    Relay_Off(hlt_out);                                        // HLT Signal OFF 
-          Led_Off(hlt_led);
-				  Watchdog_Lock(wdog);
-				  cprintf("Relay abnormal action then Health Relay On\n\n");
-			 }       
+		   (void)Eb_Act_Trip(kEB_CAUSE_DEPC, "Sensor 1");                       // EB1/EB2 ON, Feedback 확인은 Eb_Act_Process()
     }  
     else if(packet->detail_code == 0x02)
     {
@@ -460,23 +1054,7 @@ static void Check_DEPC_State(Curs485_Packet_t	*packet)
        cprintf("\n\n\nF_102.(Derailment Activ)\n");                 // Fault Code 출력	
 //			  Led_On(led[i+2U]);	                                       // 감지된 해당 LED ON 		
 		   Led_On(der_led);				
-		   Relay_On(eb1_out);
-			 Relay_On(eb2_out);
-//    		cprintf("\nEB1/EB2 Signal Output Command\n");			         // 퍼포먼스 테스트 코드	
-			 HAL_Delay(10);
-       fb_eb1_state = DI_Get_State(din[kRYFBI_EB1]);   
-       fb_eb2_state = DI_Get_State(din[kRYFBI_EB2]);         
-//			  eb1_state = (u08_t)(HAL_GPIO_ReadPin(GPIOD, GPIO_PIN_8));
-//			  eb2_state = (u08_t)(HAL_GPIO_ReadPin(GPIOD, GPIO_PIN_9));					
-				
-//				Relay_On(relay[i+4U]);                                     // 감지된 해당 릴레이 Signal ON 
-			 if((fb_eb1_state != True) || (fb_eb2_state != True))
-			 {
-			    Relay_Off(hlt_out);                                        // HLT Signal OFF 
-          Led_Off(hlt_led);          
-				  Watchdog_Lock(wdog);
-				  cprintf("Relay abnormal action then Health Relay On\n\n");
-			 }         
+		   (void)Eb_Act_Trip(kEB_CAUSE_DEPC, "Sensor 2");                       // EB1/EB2 ON, Feedback 확인은 Eb_Act_Process()
     }
     else if(packet->detail_code == 0x03)
     {
@@ -487,23 +1065,7 @@ static void Check_DEPC_State(Curs485_Packet_t	*packet)
           cprintf("\n\n\nF_103.(Derailment Activ)\n");                 // Fault Code 출력	
 //			  Led_On(led[i+2U]);	                                       // 감지된 해당 LED ON 		
 			    Led_On(obl_led);				
-				  Relay_On(eb1_out);
-				  Relay_On(eb2_out);
-//    		cprintf("\nEB1/EB2 Signal Output Command\n");			         // 퍼포먼스 테스트 코드	
-				  HAL_Delay(10);
-          fb_eb1_state = DI_Get_State(din[kRYFBI_EB1]);   
-          fb_eb2_state = DI_Get_State(din[kRYFBI_EB2]);         
-//			  eb1_state = (u08_t)(HAL_GPIO_ReadPin(GPIOD, GPIO_PIN_8));
-//			  eb2_state = (u08_t)(HAL_GPIO_ReadPin(GPIOD, GPIO_PIN_9));					
-				
-//				Relay_On(relay[i+4U]);                                     // 감지된 해당 릴레이 Signal ON 
-				  if((fb_eb1_state != True) || (fb_eb2_state != True))
-				  {
-					   Relay_Off(hlt_out);                                        // HLT Signal OFF 
-             Led_Off(hlt_led);      
-					   Watchdog_Lock(wdog);
-					   cprintf("Relay abnormal action then Health Relay On\n\n");
-				  }         
+				  (void)Eb_Act_Trip(kEB_CAUSE_DEPC, "Sensor 3");                       // EB1/EB2 ON, Feedback 확인은 Eb_Act_Process()
        }  
        else if(packet->detail_code == 0x04)
        {
@@ -514,154 +1076,89 @@ static void Check_DEPC_State(Curs485_Packet_t	*packet)
           cprintf("\n\n\nF_104.(Derailment Activ)\n");                 // Fault Code 출력	
 			    Relay_On(dmpc_out);	                                         // DMPC Relay ON 		
 			    Led_On(del_led);				
-				  Relay_On(eb1_out);
-				  Relay_On(eb2_out);
-//    		cprintf("\nEB1/EB2 Signal Output Command\n");			         // 퍼포먼스 테스트 코드	
-				  HAL_Delay(10);
-          fb_eb1_state = DI_Get_State(din[kRYFBI_EB1]);   
-          fb_eb2_state = DI_Get_State(din[kRYFBI_EB2]);         
-//			  eb1_state = (u08_t)(HAL_GPIO_ReadPin(GPIOD, GPIO_PIN_8));
-//			  eb2_state = (u08_t)(HAL_GPIO_ReadPin(GPIOD, GPIO_PIN_9));					
-				
-//				Relay_On(relay[i+4U]);  // 감지된 해당 릴레이 Signal ON 
-				  if((fb_eb1_state != True) || (fb_eb2_state != True))
-				  {
-					   Relay_Off(hlt_out);                                        // HLT Signal OFF 
-             Led_Off(hlt_led);     
-					   Watchdog_Lock(wdog);
-					   cprintf("Relay abnormal action then Health Relay On\n\n");
-				  }         
+				  (void)Eb_Act_Trip(kEB_CAUSE_DEPC, "Sensor 4");                       // EB1/EB2 ON, Feedback 확인은 Eb_Act_Process()
        } 
-       while (1) {}; 
     break;
       
     case SELFTEST_FAIL :                                             // 자기 진단시 오류 발생
       if(packet->detail_code == 0x01)                                // F_105 : stl 자기진단 이상
       {  
-         cprintf("===================================================\n\n");    
-         cprintf("DEPC Board STL Test Fail\n\n");
-         cprintf("===================================================\n\n");
-         cprintf("\n\n\nF_106.(Sensor Voltage Fail)\n");              // Fault Code 출력	
-		     Relay_Off(hlt_out);
-         Led_Off(hlt_led);        
-				 cprintf("System While Loop!\n\n");
-				 while (1) {};        
+         Check_DEPC_Report(packet, "F_105", "DEPC Board STL Test Fail");
+         Fault_Raise(kFLT_DEPC_FAIL, packet->detail_code);   // HLT OFF, Watchdog Lock
       }  
       else if(packet->detail_code == 0x02)                           // F_106 : Voltage 자기진단 이상
       {  
-         cprintf("===================================================\n\n");    
-         cprintf("DEPC Board Sensor Voltage Fail\n\n");
-         cprintf("===================================================\n\n");
-         cprintf("\n\n\nF_106.(Sensor Voltage Fail)\n");              // Fault Code 출력	
-		     Relay_Off(hlt_out);	 		
-         Led_Off(hlt_led);      
-				 cprintf("System While Loop!\n\n");
-				 while (1) {};
+         Check_DEPC_Report(packet, "F_106", "DEPC Board Sensor Voltage Fail");
+         Fault_Raise(kFLT_DEPC_FAIL, packet->detail_code);   // HLT OFF, Watchdog Lock
       }
       else if(packet->detail_code == 0x03)                           // F_107 : Relay 자기진단 이상
       {
-         cprintf("===================================================\n\n");    
-         cprintf("DEPC Board Relay FeedBack Fail\n\n");
-         cprintf("===================================================\n\n");
-         cprintf("\n\n\nF_107.(Relay FeedBack Test Fail)\n");        // Fault Code 출력	
+         Check_DEPC_Report(packet, "F_107", "DEPC Board Relay FeedBack Fail");
 				 DO_Off(snp_out);
-         Led_Off(hlt_led);      
-				 Watchdog_Lock(wdog);
-  			 while (1) {};
+         Fault_Raise(kFLT_DEPC_FAIL, packet->detail_code);   // HLT OFF, Watchdog Lock
       }
       else if(packet->detail_code == 0x04)                           // F_108 : 온도이상(Major) 자기진단 이상
       {
-         cprintf("===================================================\n\n");    
-         cprintf("DEPC Board Relay Temperature Fail\n\n");
-         cprintf("===================================================\n\n");       
-			   cprintf("\n\n\nF_108.(DEPC Board Temperature Major ALARM\n");      // Fault Code 출력
-			   Relay_Off(hlt_out);
-         Led_Off(hlt_led);        
+         Check_DEPC_Report(packet, "F_108", "DEPC Board Temperature Major ALARM");
+         Fault_Raise(kFLT_DEPC_FAIL, packet->detail_code);   // HLT OFF, Watchdog Lock
 			   DO_Off(snp_out);
-			   Watchdog_Lock(wdog);      
       }
       else if(packet->detail_code == 0x05)                           // F_109 : 온도이상(Minor) 자기진단 이상
       {
-         cprintf("===================================================\n\n");    
-         cprintf("DEPC Board Temperature Fail\n\n");
-         cprintf("===================================================\n\n");        
-			   cprintf("\n\n\nF_109.(DEPC Board Temperature Minor ALARM\n"); // Fault Code 출력
+         Check_DEPC_Report(packet, "F_109", "DEPC Board Temperature Minor ALARM");
+         Fault_Raise(kFLT_DEPC_WARN, packet->detail_code);
 //			  Led_On(error_led);        
       }
       else if(packet->detail_code == 0x06)    // F_110 : 입력 전원 자기진단 이상
       {
-         cprintf("===================================================\n\n");    
-         cprintf("DEPC Board Power OK Check PIN Fail\n\n");
-         cprintf("===================================================\n\n");          
-		     cprintf("\n\n\nF_110.(DEPC Board Sensor Power Check Fail)\n");      // Fault Code 출력			/* 주제어 보드로 동작  */
-			   Led_Off(hlt_led);
-			   Watchdog_Lock(wdog);
-			   while (1) {};     
+         Check_DEPC_Report(packet, "F_110", "DEPC Board Sensor Power Check Fail");
+         Fault_Raise(kFLT_DEPC_FAIL, packet->detail_code);   // HLT OFF, Watchdog Lock
       }
       else if(packet->detail_code == 0x07)                           // F_111 : Isolation 자기진단 이상
       {
-         cprintf("===================================================\n\n");    
-         cprintf("DEPC Board Isolation Fail\n\n");
-         cprintf("===================================================\n\n");         
-		     cprintf("\n\n\nF_111.(DEPC Board Isolation Fail)\n");        // Fault Code 출력		
-         Led_Off(hlt_led);     // system error led on
+         Check_DEPC_Report(packet, "F_111", "DEPC Board Isolation Fail");
+         Fault_Raise(kFLT_DEPC_FAIL, packet->detail_code);   // HLT OFF, Watchdog Lock
          DO_Off(snp_out);    // 릴레이 전원 공급 off
-         Relay_Off(hlt_out);    // hlt signal off
-         Watchdog_Lock(wdog);	 // watchdog 기능 off		      
       }
       else if(packet->detail_code == 0x08)                           // F_112 : Watchdog 자기진단 이상
       {
-         cprintf("===================================================\n\n");    
-         cprintf("DEPC Board WatchDog Function Fail\n\n");
-         cprintf("===================================================\n\n");  
- 		     cprintf("\n\n\nF_008.(DEPC Board WatchDog Function Fail)\n");      // Fault Code 출력      
-			   Led_Off(hlt_led);
-			   Watchdog_Lock(wdog);
-         while (1) {};   
+         Check_DEPC_Report(packet, "F_112", "DEPC Board WatchDog Function Fail");
+         Fault_Raise(kFLT_DEPC_FAIL, packet->detail_code);   // HLT OFF, Watchdog Lock
       }
       else if(packet->detail_code == 0x09)                           // F_113: Sensor 자기진단 이상
       {
-         cprintf("=======================================================================\n\n");    
-         cprintf("DEPC Board Sensor Selftest Fail\n\n");
-         cprintf("=======================================================================\n\n");  
-		     cprintf("\n\nF_113.(DEPC Board Sensor Selftest Fail)\n");	   // Fault Code 출력						
-			   Led_Off(hlt_led);				
-  		   Watchdog_Lock(wdog);
-         while (1) {};    
+         Check_DEPC_Report(packet, "F_113", "DEPC Board Sensor Selftest Fail");
+         Fault_Raise(kFLT_DEPC_FAIL, packet->detail_code);   // HLT OFF, Watchdog Lock
       }    
       break;
     default:
       break;
   }
 }
-  
-/** \brief  CRC16 계산하여 결과를 반환한다.
-  * \param  crc - 최초 계산에 사용할 값
-  * \param  buf - 계산할 데이터가 들어있는 배열
-  * \param  l - 계산할 길이
-  * \note   l 길이만큼 순차적으로 buf의 데이터와 crc를 연산하여 인덱스를 찾아내고
-            KRS_CRC16_TABLE[256]를 통해 crc를 계산한 다음 반환한다.
-  * \retval crc - 최종 계산된 CRC값
-  */
 
-static uint16_t getCRC16_KRS(uint8_t* buffer, uint32_t l)
+/** \brief  슬레이브 자기진단 고장을 보드별로 한번만 기록한다.
+  * \param  packet - 슬레이브 응답
+  * \param  tag    - 고장 코드(F_105 ~ F_113), 상수 문자열
+  * \param  text   - 고장 내용, 상수 문자열
+  * \note   고장 난 슬레이브는 TDMA cycle마다 같은 응답을 보내므로 반복은 Fault_Report()가 묶어서 보고한다.
+  * \retval 없음
+  */
+static void Check_DEPC_Report(const Curs485_Packet_t * packet, const char_t tag[], const char_t text[])
 {
-  uint32_t i;
-  uint16_t val=0;
+  static const char_t * const depc_name[RS485_LINK_NODE_MAX + 1U] = {"ID ?", "ID 1", "ID 2", "ID 3", "ID 4", "ID 5", "ID 6"};
+  u08_t id = (packet->dmpc_id <= RS485_LINK_NODE_MAX) ? packet->dmpc_id : 0U;
 
-  for (i = 0; i < l; i++)
+  if (Fault_Report(tag, depc_name[id]) == True)
   {
-    val = ((val & 0xFF) << 8) ^ KRS_CRC16_TABLE[((val >> 8) & 0xFF) ^ buffer[i]];
+    DLOG3("\n\n\n%s.(%s, DEPC %s)\n", tag, text, depc_name[id]);      // Fault Code 출력
   }
-  return val;
-
 }
-
-
+  
 static void Slave_Transmit_Data_To_Rs485(Rs485_t * rs)
 {
-    /** 송신 버퍼를 채운다. */
-    Rs485_Data_Fill_txBuf();
+    /** 미리 만든 응답을 송신 버퍼로 옮긴다(CRC 재계산 없음). */
+    Buffer08_Copy(&_txBuf[0], &_resp[_respIdx][0], sizeof(Curs485_Packet_t));
+    _txCnt = sizeof(Curs485_Packet_t);
   
     /** 송신 버퍼를 송신한다. */
     Rs485_Transmit_Data(serial1, _txBuf, _txCnt);
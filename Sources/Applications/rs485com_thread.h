@@ -23,6 +23,11 @@
 #define cT_10msec          10U
 #define REQUEST            0x01
 #define RESPONCE           0x02
+#define BROADCAST          0x03                              /**< 전체 보드 상태 요구(TDMA 응답), rs485_tdma.h */
+#define BAUD_PROPOSE       0x05                              /**< 속도 제안(state_code = 속도 번호), rs485_baud.h */
+#define BAUD_ACK           0x06                              /**< 속도 답(state_code = 받아들일 속도 번호) */
+#define BAUD_COMMIT        0x07                              /**< 속도 확정(broadcast, state_code = 속도 번호) */
+#define DIAG_REQUEST       0x08                              /**< 확장 진단 요구, 응답은 RS485_DIAG_MSG(rs485_diag.h) */
 #define Packet_Lenth       0x05
 #define NOT_USE            0x00
 #define STX                0x02
@@ -56,6 +61,7 @@ typedef struct
   * \{ */
 //#define RS485COM_REQUEST_TIME         150U     // 150msec  
 //#define RS485COM_COMM_OK_TIME         5000U     // 5초동안 데이타 통신 상태 점검
+extern void Rs485com_Init(void);
 extern void Rs485com_Thread(void);
 //extern u32_t  g_Rs485com_request_timer;
 //extern u32_t  g_Rs485com_comm_ok_timer;
@@ -64,7 +70,9 @@ extern u08_t   Rx_Wait_Timer1c;
 extern Bool_t g_monitor_485_tx;
 extern Bool_t g_monitor_485_rx;
 extern u08_t   g_send_dmpc_cnt;
-//extern Bool_t g_temper_flag;
+extern Bool_t g_rs485_tdma;
+extern Bool_t g_rs485_isr_reply;
+extern void   Rs485com_Rx_Isr(u08_t byte);
 //extern void Console_Thread(void);
 /** \} Console_Thread_Exported_Functions */
 
@@ -48,8 +48,7 @@ void Self_Diagnose_Perform(void)
 	/* 감지 센서의 연결 상태 점검  */
 	/* 센서의 연결 상태는 ADC1의 전류가 xxxmVolt ~ xxxxmVolt 상태를 유지 해야 함. */
 	HAL_Delay(50);
-	/* 콘솔 표시용 Flag "ON"하여 상태가 표시되도록 함.  */
-  g_monitor_flag = True;
+	/* 측정값은 LOG(DEBUG, DEOD)로 기록한다(콘솔 "LOG DEOD DEBUG").  */
 
   Relay_On(hlt_out);                                                 // SYSTEM HLT Signal On 
   Led_On(hlt_led);                                                   // SYSTEM HLT LED On
@@ -64,8 +63,6 @@ void Self_Diagnose_Perform(void)
 	/* 센서의 초기화 상태는 각 센서의 OSSD1, OSSD2의 입력상태가 Low 이어야 함. */
   
   Read_Sensor_OSSD_Input();                                          // PC로 동작할 경우에는 PB15 PIN를 읽어서 2CH or 4CH를 선택한다.  
-	/* 콘솔 표시용 Flag "OFF"하여 상태가 표시 안 되도록 함.  */  
-  g_monitor_flag = False;
   
 	/* 릴레이 피드백 상태 점검  */
 	/* 릴레이 피드백 상태를 점검하기 위해서는 릴레이 제어포트를 "ON"시켜야함  */
@@ -73,6 +70,9 @@ void Self_Diagnose_Perform(void)
 //  Read_Relay_FeedBack_State();   
 
 	Check_Temperature();
+
+	/* 자기진단 중 등록된 고장을 main loop 진입 전에 출력에 반영한다. */
+	Fault_Process();
 }
 
 /** \brief  ADUM4190으로부터 현재의 전압값을 읽어온다.
@@ -85,6 +85,7 @@ static void Read_Sensor_Current_Value(void)
 {
   static  u16_t cur_val1=0, cur_val2=0, cur_val3=0,cur_val4=0;
   u08_t  i;
+  AdcFrame_t  frame;
 //  Relay_t     * relayout[5];
   Led_t       * ledout[4];
   
@@ -102,12 +103,17 @@ static void Read_Sensor_Current_Value(void)
 /*****************************************************************************
   **************************** OBR Sensor  ***********************************
 ******************************************************************************/
-  HAL_ADC_Start(&hadc1);
-	while(HAL_ADC_PollForConversion(&hadc1, 100) == HAL_OK)
+  /* ADC1은 Device_Init()에서 DMA scan이 시작되어 있으므로 최근 프레임을 읽는다. */
+  if(Device_ADC_Get_Frame(&frame) != True)
+  {
+    frame.raw[kSI_1] = 0U;
+    frame.raw[kSI_2] = 0U;
+    frame.raw[kSI_3] = 0U;
+    frame.raw[kSI_4] = 0U;
+  }
   {  
-     cur_val1 = (u16_t)HAL_ADC_GetValue(&hadc1);
-		 cur_val1 = ((3300U * cur_val1) / 4095U);
-		 sdin[kSI_1]->Sensor_Voltage = (cur_val1);	
+     cur_val1 = frame.raw[kSI_1];
+		 sdin[kSI_1]->Sensor_Adc = cur_val1;	
 //      if(cur_val1 > cMIN_ACT_CUR || cur_val1 < cLOW_CUR)                       /** 측정볼트가 500 < ||  > 2700  */ 
 //      { 
 //        sdin[kSI_1]->Sensor_fail_flag = True;                                  /** 센서 이상 상태 이고 */
@@ -117,17 +123,14 @@ static void Read_Sensor_Current_Value(void)
 //        sdin[kSI_1]->Sensor_fail_flag = False;  // 센서는 정상 상태
 //      }		
 	}
-  if(g_monitor_flag == True) cprintf("OBR SENSOR Voltage = %d\r\n", cur_val1);
+  LOG1(DEBUG, DEOD, "OBR SENSOR Voltage = %d\n", Device_ADC_To_mV(kSI_1, cur_val1));
 		
 /*****************************************************************************
   **************************** DER Sensor  ***********************************
 ******************************************************************************/
-	HAL_ADC_Start(&hadc1);
-	while(HAL_ADC_PollForConversion(&hadc1, 100) == HAL_OK)
   {  
-		 cur_val2 = (u16_t)HAL_ADC_GetValue(&hadc1);
-		 cur_val2 = ((3300U * cur_val2) / 4095U);
-		 sdin[kSI_2]->Sensor_Voltage = (cur_val2);
+		 cur_val2 = frame.raw[kSI_2];
+		 sdin[kSI_2]->Sensor_Adc = cur_val2;
 //      if(cur_val2 > cMIN_ACT_CUR || cur_val2 < cLOW_CUR ) 
 //      { 
 //        sdin[kSI_2]->Sensor_fail_flag = True;        // 센서가 동작된 상태 이고 (250908)
@@ -137,17 +140,14 @@ static void Read_Sensor_Current_Value(void)
 //        sdin[kSI_2]->Sensor_fail_flag = False;
 //      }				
 	}
-  if(g_monitor_flag == True) cprintf("DER SENSOR Voltage = %d\r\n", cur_val2);
+  LOG1(DEBUG, DEOD, "DER SENSOR Voltage = %d\n", Device_ADC_To_mV(kSI_2, cur_val2));
 
 /*****************************************************************************
   **************************** OBL Sensor  ***********************************
 ******************************************************************************/
-	 HAL_ADC_Start(&hadc1);
-	 while(HAL_ADC_PollForConversion(&hadc1, 100) == HAL_OK)
 	 {
-		  cur_val3 = (u16_t)HAL_ADC_GetValue(&hadc1);
-			cur_val3 = ((3300U * cur_val3) / 4095U);
-			sdin[kSI_3]->Sensor_Voltage = (cur_val3);
+		  cur_val3 = frame.raw[kSI_3];
+			sdin[kSI_3]->Sensor_Adc = cur_val3;
 //      if(cur_val3 > cMIN_ACT_CUR || cur_val3 < cLOW_CUR ) 
 //      { 
 //        sdin[kSI_3]->Sensor_flag = True;
@@ -157,17 +157,14 @@ static void Read_Sensor_Current_Value(void)
 //        sdin[kSI_3]->Sensor_fail_flag = False;
 //      }				 
 	 }
-   if(g_monitor_flag == True) cprintf("OBL SENSOR Voltage = %d\r\n", cur_val3);
+   LOG1(DEBUG, DEOD, "OBL SENSOR Voltage = %d\n", Device_ADC_To_mV(kSI_3, cur_val3));
 
 /*****************************************************************************
   **************************** DEL Sensor  ***********************************
 ******************************************************************************/
-	 HAL_ADC_Start(&hadc1);
-	 while(HAL_ADC_PollForConversion(&hadc1, 100) == HAL_OK)
 	 {    
-		  cur_val4 = (u16_t)HAL_ADC_GetValue(&hadc1);
-			cur_val4 = ((3300U * cur_val4) / 4095U);
-			sdin[kSI_4]->Sensor_Voltage = (cur_val4);
+		  cur_val4 = frame.raw[kSI_4];
+			sdin[kSI_4]->Sensor_Adc = cur_val4;
 //		  if(cur_val4 > cMIN_ACT_CUR || cur_val4 < cLOW_CUR ) 
 //      { 
 //        sdin[kSI_4]->Sensor_flag = True;
@@ -177,7 +174,7 @@ static void Read_Sensor_Current_Value(void)
 //        sdin[kSI_4]->Sensor_fail_flag = False;
 //      }		
 	 }  	 
-   if(g_monitor_flag == True) cprintf("DEL SENSOR Voltage = %d\r\n", cur_val4);	
+   LOG1(DEBUG, DEOD, "DEL SENSOR Voltage = %d\n", Device_ADC_To_mV(kSI_4, cur_val4));	
 
 /***************************************************/
 /* Sensor Voltage 이상 유무 Check하여 이상있으면 이상 상태 표시 */
@@ -185,15 +182,14 @@ static void Read_Sensor_Current_Value(void)
 	
    HAL_Delay(1000);
   	 
-   for(i = 0; i < kNbrOfSIs ; i ++)    
+   for(i = 0; i < sensor_ch_num ; i ++)                             /** 사용 채널(2CH/4CH)만 검사 */
 	 {
-	    if((sdin[i]->Sensor_Voltage < cMAX_ACT_CUR)  && (sdin[i]->Sensor_Voltage > cMIN_ACT_CUR ))  //장애물 감지 상태(2700 ~ 500)
+	    if((sdin[i]->Sensor_Adc < sensor_thr[i].act_max)  && (sdin[i]->Sensor_Adc >= sensor_thr[i].act_min ))  //장애물 감지 상태(2700 ~ 500)
 		  {
 //		     if((sdin[i]->Sensor_OSSD1== True) && (sdin[i]->Sensor_OSSD2== True))   OSSD1,OSSD2는 현상태에서는 체크 안됨..
 //				 {
 	          cprintf("(Self Diagnostic)Active Sensor = %s\r\n",ledout[i]->name);
-		        Relay_Off(hlt_out);                                                /** HLT Signal Low 처리후 계속 프로세스 진행 */
-            Led_Off(hlt_led);
+		        Fault_Raise(kFLT_SELF_SENSOR, i);                                  /** HLT Signal Low 처리후 계속 프로세스 진행 */
             Led_On(ledout[i]);
             sdin[i]->Sensor_fail_flag = True;
 //		      cprintf("System While Loop!(Disconnect Sernsor)\n\n");
@@ -202,45 +198,36 @@ static void Read_Sensor_Current_Value(void)
 //         }
 			}
   //    else if((sdin[i]->Sensor_Voltage < cLOW_CUR ) && (sdin[i]->Sensor_fail_flag == False))      /** 500mvolt 이하 전압 감지 */
-      else if((sdin[i]->Sensor_Voltage < cLOW_CUR ))                           /** 500mvolt 이하 전압 감지 */
+      else if((sdin[i]->Sensor_Adc < sensor_thr[i].low ))                           /** 500mvolt 이하 전압 감지 */
       { 			
 			   cprintf("(Self Diagnostic)Disconnect Sernsor = %s)\n",ledout[i]->name);               /** Fault Code 출력	*/
-				 cprintf("\n\nLow Voltage  = %d\n",sdin[i]->Sensor_Voltage); 
+				 cprintf("\n\nLow Voltage  = %d\n",Device_ADC_To_mV(i, sdin[i]->Sensor_Adc)); 
          Led_On(ledout[i]);			
-			   Relay_Off(hlt_out);	                                                 /** HLT Signal OFF */
+			   Fault_Raise(kFLT_SELF_SENSOR, i);                                     /** HLT Signal OFF */
 //				 Relay_Off(relayout[4]);
-			   Led_Off(hlt_led);	                                                   /** HLT Signal OFF */
          sdin[i]->Sensor_fail_flag = True;                                     /**Falut Code 발생 **/ 
       }
-      else if(sdin[i]->Sensor_Voltage > cMAX_CUR)	
+      else if(sdin[i]->Sensor_Adc >= sensor_thr[i].max)	
       {
 			   cprintf("(Self Diagnostic)High Voltage = %s\n",ledout[i]->name);               /** Fault Code 출력	*/				
-				 cprintf(" Sernsor High Voltage = %d\n",sdin[i]->Sensor_Voltage);             /** Fault Code 출력	*/
+				 cprintf(" Sernsor High Voltage = %d\n",Device_ADC_To_mV(i, sdin[i]->Sensor_Adc));             /** Fault Code 출력	*/
          Led_On(ledout[i]);			
-			   Relay_Off(hlt_out);	                                                 /** HLT Signal OFF */
+			   Fault_Raise(kFLT_SELF_SENSOR, i);                                     /** HLT Signal OFF */
 //				 Relay_Off(relayout[4]);	
-			   Led_Off(hlt_led);	                                                   /** HLT Signal OFF */
          sdin[i]->Sensor_fail_flag = True;                                     /**Falut Code 발생 **/ 
       }	
 	 } 
 	 
-   for(i = 0; i < 3 ; i++)                                          // OBR,DER,OBL,DEL   
+   for(i = 0; (sensor_ch_num >= SEN_CH_NUM_4CH) && (i < (sensor_ch_num / 2U)) ; i++)   // OBR-OBL, DER-DEL   
    {
       if((sdin[i]->Sensor_fail_flag == True)  && (sdin[i+2]->Sensor_fail_flag == True)) /** Left,Right 동시에  Falut Code 발생 **/ 
       {  
-         cprintf("(Self Diagnostic)Sensor Abnormality Both= %s,%s\r\n",ledout[i]->name,ledout[i+1]->name);
+         cprintf("(Self Diagnostic)Sensor Abnormality Both= %s,%s\r\n",ledout[i]->name,ledout[i+2]->name);
          Led_On(ledout[i]);
          Led_On(ledout[i+2]);        
-				 Relay_Off(hlt_out);	
 //				 Relay_Off(relayout[4]);		
-         Led_Off(hlt_led);
-         Led_On(run_led);
-				 Led_On(e_eb_led);			
-  			 Relay_On(eb1_out);
-				 Relay_On(eb2_out);
+				 Fault_Raise(kFLT_SENSOR_BOTH, i);                                  /** HLT OFF, EB1/EB2 ON 후 안전 상태 유지 */
 //			   Watchdog_Lock(wdog);        
-				 while(1)
-         {};  
       }
    }
 }  
@@ -267,63 +254,55 @@ static void Read_Sensor_OSSD_Input(void)
   relayout[3] = del_out ;
  */ 
   static Bool_t    Sensor_Ossd[kNbrOfSOs];
+  InSnap_t         snap;
   
 	DO_On(mcu_test1);                                                  // 20231212 추가
   HAL_Delay(20);                                                     // 릴레이 동작 시간 필요함.
- 	Sensor_Ossd[kSO_1] = (Bool_t)(HAL_GPIO_ReadPin(GPIOC, GPIO_PIN_0));
-	Sensor_Ossd[kSO_2] = (Bool_t)(HAL_GPIO_ReadPin(GPIOC, GPIO_PIN_1));  
-  if(g_monitor_flag == True)
-  {
-    cprintf("SENSOR1_1(OBR) state = %s\n",(Sensor_Ossd[kSO_1]  == True) ? "1" : "0");
-    cprintf("SENSOR1_2(OBR) state = %s\n",(Sensor_Ossd[kSO_2]  == True) ? "1" : "0");
-  }
+	Device_Input_Snapshot(&snap);                                      // OSSD1/OSSD2를 같은 시점에 읽음
+	Sensor_Ossd[kSO_1] = IN_SNAP_BIT(snap.ossd1, kSI_1);
+	Sensor_Ossd[kSO_2] = IN_SNAP_BIT(snap.ossd2, kSI_1);  
+  LOG1(DEBUG, DEOD, "SENSOR1_1(OBR) state = %s\n",(Sensor_Ossd[kSO_1] == True) ? "1" : "0");
+  LOG1(DEBUG, DEOD, "SENSOR1_2(OBR) state = %s\n",(Sensor_Ossd[kSO_2] == True) ? "1" : "0");
 	DO_Off(mcu_test1);                                                  // 20231212 추가
 
 	DO_On(mcu_test2);                                                   // 20231212 추가
 	HAL_Delay(20);
-	Sensor_Ossd[kSO_3] = (Bool_t)(HAL_GPIO_ReadPin(GPIOC, GPIO_PIN_2));
-	Sensor_Ossd[kSO_4] = (Bool_t)(HAL_GPIO_ReadPin(GPIOC, GPIO_PIN_3));
-  if(g_monitor_flag == True)
-  {
-    cprintf("SENSOR2_1(DER) state = %s\n",(Sensor_Ossd[kSO_3] == True) ? "1" : "0");
-    cprintf("SENSOR2_2(DER) state = %s\n",(Sensor_Ossd[kSO_4] == True) ? "1" : "0");
-  }
+	Device_Input_Snapshot(&snap);                                      // OSSD1/OSSD2를 같은 시점에 읽음
+	Sensor_Ossd[kSO_3] = IN_SNAP_BIT(snap.ossd1, kSI_2);
+	Sensor_Ossd[kSO_4] = IN_SNAP_BIT(snap.ossd2, kSI_2);
+  LOG1(DEBUG, DEOD, "SENSOR2_1(DER) state = %s\n",(Sensor_Ossd[kSO_3] == True) ? "1" : "0");
+  LOG1(DEBUG, DEOD, "SENSOR2_2(DER) state = %s\n",(Sensor_Ossd[kSO_4] == True) ? "1" : "0");
 	DO_Off(mcu_test2);                                                 // 20231212 추가
 
 	DO_On(mcu_test3);                                                  // 20231212 추가
 	HAL_Delay(20);
-	Sensor_Ossd[kSO_5] = (Bool_t)(HAL_GPIO_ReadPin(GPIOC, GPIO_PIN_4));
-	Sensor_Ossd[kSO_6] = (Bool_t)(HAL_GPIO_ReadPin(GPIOC, GPIO_PIN_5));
-  if(g_monitor_flag == True)
-  {
-    cprintf("SENSOR3_1(OBL) state = %s\n",(Sensor_Ossd[kSO_5] == True) ? "1" : "0");
-    cprintf("SENSOR3_2(OBL) state = %s\n",(Sensor_Ossd[kSO_6] == True) ? "1" : "0");
-  }	
+	Device_Input_Snapshot(&snap);                                      // OSSD1/OSSD2를 같은 시점에 읽음
+	Sensor_Ossd[kSO_5] = IN_SNAP_BIT(snap.ossd1, kSI_3);
+	Sensor_Ossd[kSO_6] = IN_SNAP_BIT(snap.ossd2, kSI_3);
+  LOG1(DEBUG, DEOD, "SENSOR3_1(OBL) state = %s\n",(Sensor_Ossd[kSO_5] == True) ? "1" : "0");
+  LOG1(DEBUG, DEOD, "SENSOR3_2(OBL) state = %s\n",(Sensor_Ossd[kSO_6] == True) ? "1" : "0");
 	DO_Off(mcu_test3);                                                 // 20231212 추가
 
 	DO_On(mcu_test4);                                                  // 20231212 추가
 	HAL_Delay(20);
+	Device_Input_Snapshot(&snap);                                      // OSSD1/OSSD2를 같은 시점에 읽음
 //	Sensor_Ossd[kSO_7] = (Bool_t)(HAL_GPIO_ReadPin(GPIOC, GPIO_PIN_6));
-	Sensor_Ossd[kSO_8] = (Bool_t)(HAL_GPIO_ReadPin(GPIOC, GPIO_PIN_7));
-  if(g_monitor_flag == True)
-  {
-    cprintf("SENSOR4_1(DEL) state = %s\n",(Sensor_Ossd[kSO_7] == True) ? "1" : "0");
-    cprintf("SENSOR4_2(DEL) state = %s\n",(Sensor_Ossd[kSO_8] == True) ? "1" : "0");
-  }
+	Sensor_Ossd[kSO_8] = IN_SNAP_BIT(snap.ossd2, kSI_4);
+  LOG1(DEBUG, DEOD, "SENSOR4_1(DEL) state = %s\n",(Sensor_Ossd[kSO_7] == True) ? "1" : "0");
+  LOG1(DEBUG, DEOD, "SENSOR4_2(DEL) state = %s\n",(Sensor_Ossd[kSO_8] == True) ? "1" : "0");
 	DO_Off(mcu_test4);                                                 // 20231212 추가
 	
-  for(i = 0; i < kNbrOfSOs; i+=2)
+  for(i = 0; i < (sensor_ch_num * 2U); i+=2)                        // 사용 채널(2CH/4CH)만 검사
 	{
 		if((Sensor_Ossd[i] == True) || (Sensor_Ossd[i+1] == True))
 		{
 			 cprintf("==============Derailment or OBstacle Logic Value Error==================\r\n");
        sdin[i/2]->Sensor_fail_flag = True;      
-		   Relay_Off(hlt_out);                                         // HLT Signal Low 처리후 계속 프로세스 진행
-       Led_Off(hlt_led);
+		   Fault_Raise(kFLT_SELF_OSSD, i);                             // HLT Signal Low 처리후 계속 프로세스 진행
 			 Led_On(ledout[i/2]);
 		}
 	}
-   for(i = 0; i < 3 ; i += 2)   
+   for(i = 0; (sensor_ch_num >= SEN_CH_NUM_4CH) && (i < 3) ; i += 2)   
   {
 				if(((Sensor_Ossd[i] == True) && (Sensor_Ossd[i+1] == True)) && ((Sensor_Ossd[i+4] == True) && (Sensor_Ossd[i+5] == True)))
  //    if((sdin[i]->Sensor_fail_flag == True)  && (sdin[i+1]->Sensor_fail_flag == True)) // Left,Right 동시에 불량발생
@@ -331,16 +310,10 @@ static void Read_Sensor_OSSD_Input(void)
         cprintf(" Sensor Abnormality Both= %s,%s\r\n",ledout[i]->name,ledout[i+2]->name);
 					Led_On(ledout[i]);
           Led_On(ledout[i/2]);			
-			  Relay_Off(hlt_out);	
-        Led_Off(hlt_led);
 //        Led_On(run_led);
 //			  Led_On(e_led[i]);	                                                               /** 감지된 해당 LED ON */						
-        Led_On(e_eb_led);
-				Relay_On(eb1_out);
-				Relay_On(eb2_out);
+			  Fault_Raise(kFLT_SENSOR_BOTH, i);                                   /** HLT OFF, EB1/EB2 ON 후 안전 상태 유지 */
 	//	    Watchdog_Lock(wdog);        
-			  while(1)
-        {};  
       }
    }
 }
@@ -354,6 +327,7 @@ void Read_Relay_FeedBack_State(void)
 {
 u08_t 	i;
 Bool_t   fb_state[kNbrOfRYFBIs];
+InSnap_t snap;
 	
 	
 /* RY_EB1 릴레이 high로 설정   */
@@ -363,50 +337,58 @@ Bool_t   fb_state[kNbrOfRYFBIs];
 		Relay_On(eb1_out);
 		HAL_Delay(10);
 //    fb_state[kRYFBI_EB1] = (Bool_t)(HAL_GPIO_ReadPin(GPIOD, GPIO_PIN_8));
-    fb_state[kRYFBI_EB1] = DI_Get_State(din[kRYFBI_EB1]);
+    Device_Input_Snapshot(&snap);
+    fb_state[kRYFBI_EB1] = IN_SNAP_BIT(snap.fb, kRYFBI_EB1);
 		Relay_Off(eb1_out);
 	
 		Relay_On(eb2_out);
 		HAL_Delay(10);
 //		fb_state[kRYFBI_EB2] = (Bool_t)(HAL_GPIO_ReadPin(GPIOD, GPIO_PIN_9));
-		fb_state[kRYFBI_EB2] = DI_Get_State(din[kRYFBI_EB2]);  
+		Device_Input_Snapshot(&snap);
+		fb_state[kRYFBI_EB2] = IN_SNAP_BIT(snap.fb, kRYFBI_EB2);  
 		Relay_Off(eb2_out);
 	
 		Relay_On(dmpc_out);
 		HAL_Delay(10);
 //		fb_state[kRYFBI_DMPC] = (Bool_t)(HAL_GPIO_ReadPin(GPIOD, GPIO_PIN_10));
-		fb_state[kRYFBI_DMPC] = DI_Get_State(din[kRYFBI_DMPC]);     
+		Device_Input_Snapshot(&snap);
+		fb_state[kRYFBI_DMPC] = IN_SNAP_BIT(snap.fb, kRYFBI_DMPC);     
 		Relay_Off(dmpc_out);
 	
 		Relay_On(hlt_out);
 		HAL_Delay(10);
 //		fb_state[kRYFBI_HLT] = (Bool_t)(HAL_GPIO_ReadPin(GPIOD, GPIO_PIN_11));
-		fb_state[kRYFBI_HLT] = DI_Get_State(din[kRYFBI_HLT]);   
+		Device_Input_Snapshot(&snap);
+		fb_state[kRYFBI_HLT] = IN_SNAP_BIT(snap.fb, kRYFBI_HLT);   
 //		Relay_Off(hlt_out);     // HLT Signal OFF 되면 TCMS에 통보됨에 따라 셀프테스트 진행시에는 OFF 시키면 안됨
 
 		
 		Relay_On(obr_out);
 		HAL_Delay(10);
 //		fb_state[kRYFBI_OBR] = (Bool_t)(HAL_GPIO_ReadPin(GPIOD, GPIO_PIN_12));
-		fb_state[kRYFBI_OBR] = DI_Get_State(din[kRYFBI_OBR]);   
+		Device_Input_Snapshot(&snap);
+		fb_state[kRYFBI_OBR] = IN_SNAP_BIT(snap.fb, kRYFBI_OBR);   
 		Relay_Off(obr_out);
 
 		Relay_On(der_out);
 		HAL_Delay(10);
 //		fb_state[kRYFBI_DER] = (Bool_t)(HAL_GPIO_ReadPin(GPIOD, GPIO_PIN_13));
-    fb_state[kRYFBI_DER] = DI_Get_State(din[kRYFBI_DER]);
+    Device_Input_Snapshot(&snap);
+    fb_state[kRYFBI_DER] = IN_SNAP_BIT(snap.fb, kRYFBI_DER);
 		Relay_Off(der_out);
 
 		Relay_On(obl_out);
 		HAL_Delay(10);   
 //		fb_state[kRYFBI_OBL] = (Bool_t)(HAL_GPIO_ReadPin(GPIOD, GPIO_PIN_14));
-		fb_state[kRYFBI_OBL] = DI_Get_State(din[kRYFBI_OBL]);   
+		Device_Input_Snapshot(&snap);
+		fb_state[kRYFBI_OBL] = IN_SNAP_BIT(snap.fb, kRYFBI_OBL);   
 		Relay_Off(obl_out);
 
     Relay_On(del_out);
 		HAL_Delay(10);
 //		fb_state[kRYFBI_DEL] = (Bool_t)(HAL_GPIO_ReadPin(GPIOD, GPIO_PIN_15));
-		fb_state[kRYFBI_DEL] = DI_Get_State(din[kRYFBI_DEL]);    
+		Device_Input_Snapshot(&snap);
+		fb_state[kRYFBI_DEL] = IN_SNAP_BIT(snap.fb, kRYFBI_DEL);    
     Relay_Off(del_out);
 
   	for(i=2; i < kNbrOfRYFBIs; i++)
@@ -415,8 +397,7 @@ Bool_t   fb_state[kNbrOfRYFBIs];
 			 {  
 					cprintf("\n\n\nF_003.%d\n",i);                              // Fault Code 출력
 					cprintf("========== System Halt(Relay Fail) ==========\r\n");
-		      Relay_Off(hlt_out);                                         // HLT Signal Low 처리후 계속 프로세스 진행
-          Led_Off(hlt_led);
+		      Fault_Raise(kFLT_SELF_RELAY, i);                            // HLT Signal Low 처리후 계속 프로세스 진행
 				}
 		}
 }
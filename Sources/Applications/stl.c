@@ -50,7 +50,9 @@ void STL_Self_Test(void)
   */
 static void StlErrorHandler(u32_t LedToggleSpeed)
 {   
-
+   /* CPU 자체를 믿을 수 없으므로 출력만 반영하고 정지한다. */
+   Fault_Raise(kFLT_STL, LedToggleSpeed);
+   Fault_Process();
    while (1)
    {  
 		  HAL_Delay(LedToggleSpeed);
@@ -133,6 +133,7 @@ void SysTick_Handler(void)
   HAL_IncTick();
   HAL_SYSTICK_IRQHandler();	
   Rs232_CountDown_Receive_Tick(serial3);
+  Rs485_CountDown_Receive_Tick(serial1);
 	g_Run_Led_timer++;									                               // RUN LED 동작 Timer   500msec
 	g_Pwr_Ok_timer++;                                                  // 전원 입력 OK 신호 체크 timer
 	g_Temp_check_timer++;								                               // Temperator Check Timer
@@ -177,19 +178,159 @@ void USART3_IRQHandler(void)
     __HAL_UART_CLEAR_FLAG(serial3->handle, UART_FLAG_RXNE);
     /* serial 포트 수신 인터럽트 처리 */
     Rs232_IRQHandler_RXNE(serial3);
-    /* 수신 타이머를 설정한다. */
-    Rs232_Set_Receive_Tick(serial3, msec(5));
+    /* IDLE line을 쓰지 않으면 수신 타이머를 설정한다. */
+    if (serial3->rx_idle == False)
+    {
+      Rs232_Set_Receive_Tick(serial3, msec(5));
+    }
   }
 
-  /* 송신이 가능한 경우 */
+  /* 1 문자 시간 동안 수신이 없는 경우(IDLE line) : 수신 완료 */
+  if (((u08_t)__HAL_UART_GET_FLAG(serial3->handle, UART_FLAG_IDLE) != (u08_t)RESET) &&
+      ((u08_t)__HAL_UART_GET_IT_SOURCE(serial3->handle, UART_IT_IDLE) != (u08_t)RESET))
+  {
+    Rs232_IRQHandler_IDLE(serial3);
+  }
+
+  /* 송신이 가능한 경우 : TXE는 비어 있으면 늘 서 있으므로 인터럽트를 켠 경우만 처리(DMA 송신 중 제외) */
 //  if (__HAL_UART_GET_FLAG(serial3->handle, UART_FLAG_TXE) != 0U)
-  if((u08_t) __HAL_UART_GET_FLAG(serial3->handle, UART_FLAG_TXE)!= (u08_t)RESET)
+  if (((u08_t)__HAL_UART_GET_FLAG(serial3->handle, UART_FLAG_TXE) != (u08_t)RESET) &&
+      ((u08_t)__HAL_UART_GET_IT_SOURCE(serial3->handle, UART_IT_TXE) != (u08_t)RESET))
    {
     /* TXE 플래그 클리어 */
     __HAL_UART_CLEAR_FLAG(serial3->handle, UART_FLAG_TXE);
     /* serial 포트 송신 인터럽트 처리 */
     Rs232_IRQHandler_TXE(serial3);
    }
+
+  /* DMA로 보낸 구간의 송신이 끝난 경우 : 다음 구간 송신 */
+  if (((u08_t)__HAL_UART_GET_FLAG(serial3->handle, UART_FLAG_TC) != (u08_t)RESET) &&
+      ((u08_t)__HAL_UART_GET_IT_SOURCE(serial3->handle, UART_IT_TC) != (u08_t)RESET))
+  {
+    Rs232_IRQHandler_TC(serial3);
+  }
+}
+
+/**
+ * @brief  This function handles USART1(RS-485) interrupt request.
+ * @retval None
+ */
+void Rs485Ch1_IRQHandler(void)
+{
+  /* Overrun 에러가 발생한 경우 */
+  if ((u08_t)__HAL_UART_GET_FLAG(serial1->handle, UART_FLAG_ORE) != (u08_t)RESET)
+  {
+    /* Overrun 에러 플래그 클리어 */
+    __HAL_UART_CLEAR_OREFLAG(serial1->handle);
+  }
+
+  /* 데이터 수신이 발생한 경우 : 수신 byte는 rx_hook(슬레이브 즉시 응답)에도 전달된다. */
+  if ((u08_t)__HAL_UART_GET_FLAG(serial1->handle, UART_FLAG_RXNE) != (u08_t)RESET)
+  {
+    /* RXNE 플래그 클리어 */
+    __HAL_UART_CLEAR_FLAG(serial1->handle, UART_FLAG_RXNE);
+    /* serial 포트 수신 인터럽트 처리 */
+    Rs485_IRQHandler_RXNE(serial1);
+    /* IDLE line을 쓰지 않으면 수신 타이머를 설정한다. */
+    if (serial1->rx_idle == False)
+    {
+      Rs485_Set_Receive_Tick(serial1, msec(5));
+    }
+  }
+
+  /* 1 문자 시간 동안 수신이 없는 경우(IDLE line) : 수신 완료, 같은 호출의 RXNE 처리 뒤에 본다. */
+  if (((u08_t)__HAL_UART_GET_FLAG(serial1->handle, UART_FLAG_IDLE) != (u08_t)RESET) &&
+      ((u08_t)__HAL_UART_GET_IT_SOURCE(serial1->handle, UART_IT_IDLE) != (u08_t)RESET))
+  {
+    Rs485_IRQHandler_IDLE(serial1);
+  }
+
+  /* 송신이 가능한 경우 : 인터럽트를 켠 경우만 처리 */
+  if (((u08_t)__HAL_UART_GET_FLAG(serial1->handle, UART_FLAG_TXE) != (u08_t)RESET) &&
+      ((u08_t)__HAL_UART_GET_IT_SOURCE(serial1->handle, UART_IT_TXE) != (u08_t)RESET))
+  {
+    /* serial 포트 송신 인터럽트 처리 */
+    Rs485_IRQHandler_TXE(serial1);
+  }
+
+  /* 마지막 byte의 stop bit까지 송신 완료 : TXE(DE) 해제 */
+  if (((u08_t)__HAL_UART_GET_FLAG(serial1->handle, UART_FLAG_TC) != (u08_t)RESET) &&
+      ((u08_t)__HAL_UART_GET_IT_SOURCE(serial1->handle, UART_IT_TC) != (u08_t)RESET))
+  {
+    Rs485_IRQHandler_TC(serial1);
+  }
+}
+
+/**
+ * @brief  This function handles ADC1 DMA(DMA2 Stream0) interrupt request.
+ * @retval None
+ */
+void ADC_SCAN_DMA_IRQHandler(void)
+{
+  /* 프레임 완료(Half/Complete) 시 HAL_ADC_Conv(Half)CpltCallback 호출 */
+  HAL_DMA_IRQHandler(&hdma_adc1);
+}
+
+/**
+ * @brief  This function handles ADC1 interrupt request(Analog Watchdog).
+ * @retval None
+ */
+void ADC_IRQHandler(void)
+{
+  /* 동작 전류 초과 시 HAL_ADC_LevelOutOfWindowCallback 호출 */
+  HAL_ADC_IRQHandler(&hadc1);
+}
+
+/**
+ * @brief  This function handles EXTI line0~4 interrupt request(SI1~SI3 OSSD).
+ * @retval None
+ */
+void EXTI0_IRQHandler(void)
+{
+  /* OSSD edge 발생 시 HAL_GPIO_EXTI_Callback 호출 */
+  HAL_GPIO_EXTI_IRQHandler(GPIO_PIN_0);
+}
+
+void EXTI1_IRQHandler(void)
+{
+  HAL_GPIO_EXTI_IRQHandler(GPIO_PIN_1);
+}
+
+void EXTI2_IRQHandler(void)
+{
+  HAL_GPIO_EXTI_IRQHandler(GPIO_PIN_2);
+}
+
+void EXTI3_IRQHandler(void)
+{
+  HAL_GPIO_EXTI_IRQHandler(GPIO_PIN_3);
+}
+
+void EXTI4_IRQHandler(void)
+{
+  HAL_GPIO_EXTI_IRQHandler(GPIO_PIN_4);
+}
+
+/**
+ * @brief  This function handles EXTI line[9:5] interrupt request(SI3~SI4 OSSD).
+ * @retval None
+ */
+void EXTI9_5_IRQHandler(void)
+{
+  /* pending 된 Pin만 callback 호출 */
+  HAL_GPIO_EXTI_IRQHandler(GPIO_PIN_5);
+  HAL_GPIO_EXTI_IRQHandler(GPIO_PIN_6);
+  HAL_GPIO_EXTI_IRQHandler(GPIO_PIN_7);
+}
+
+/**
+ * @brief  This function handles TIM5(USEC_TIM) interrupt request(CC1 비교 alarm).
+ * @retval None
+ */
+void USEC_TIM_IRQHandler(void)
+{
+  /* 예약 시각 도달 시 등록된 callback(TDMA slot 응답 송신) 호출 */
+  Device_Usec_Alarm_Isr();
 }
 
 /** \} IRQs_Exported_Functions */
@@ -40,6 +40,15 @@ void DebugMon_Handler(void);
 void PendSV_Handler(void);
 void SysTick_Handler(void);
 void USART3_IRQHandler(void);
+void DMA2_Stream0_IRQHandler(void);
+void ADC_IRQHandler(void);
+void EXTI0_IRQHandler(void);
+void EXTI1_IRQHandler(void);
+void EXTI2_IRQHandler(void);
+void EXTI3_IRQHandler(void);
+void EXTI4_IRQHandler(void);
+void EXTI9_5_IRQHandler(void);
+void TIM5_IRQHandler(void);
 void Rs232Ch1_IRQHandler(void);
 /** \} IRQs_Exported_Functions */
 
@@ -38,8 +38,12 @@ u08_t  FLT1_Status,FLT2_Status;          /* Digital Isolator FLt Pin 체크 주
 //u32_t  g_Relay_FB_check_timer=0;       /* Relay FB check주기 타이머 */
 //u32_t  g_Sensor_Check_timer=0;         /* Sensor Logic Check 주기 타이머 */
 float  g_device_temper = 0;
+i16_t  g_device_temper_raw = 0;          /* TMP117 온도 register 원본(1/128 ℃, signed), 진단 frame용 */
 I2C_HandleTypeDef i2c1;
 u16_t  g_Watchdog_Check_Pin_Timer=0;      /* Watch Dog Check_Pin 주기 타이머 */
+Bool_t g_Master_Board = False;           /* True : 마스터(DM) 보드(HCR 입력됨), Rs485com_Init()에서 설정 */
+u08_t  g_State_Code = 0x00;              /* 슬레이브 응답 state_code(0 정상, DERAILMENT_FAIL, SELFTEST_FAIL) */
+u08_t  g_Detail_Code = 0x00;             /* 슬레이브 응답 detail_code(탈선 센서 번호, 자기진단 고장 번호) */
 /** \} Sysmon_Thread_Private_Variables */
 
 /* Exported variables --------------------------------------------------------*/
@@ -112,23 +116,23 @@ void  Sysmon_Thread(void)
   if (g_Temp_check_timer >= TEMPERATOR_CHECK_TIME)	 
   {
 	   g_Temp_check_timer = 0;
-     g_temper_flag = True;
 		 Check_Temperature();
-//    g_temper_flag = False;
   }
 	  /* 일정시간(1sec )마다 PWR_OK_CPU PORT를 체크하여 파워 입력 여부를 확인한다. */
 
   if (g_Pwr_Ok_timer >= POWER_OK_CHECK_TIME)			
   {  
-//		cprintf("\nPower OK Check Time\n");			// 모니터링 주기 테스트 코드
+		 LOG0(TRACE, SYSMON, "Power OK Check Time\n");                   // 모니터링 주기
      g_Pwr_Ok_timer = 0U;	
      pwrin->curr_state = DI_Get_State(pwrin);	  // power ok input pin read
-//		cprintf("pwrin->curr_state = %d\n",pwrin->curr_state);
+		 LOG1(TRACE, SYSMON, "pwrin->curr_state = %d\n", pwrin->curr_state);
   	 if(pwrin->curr_state == False)                                   
      { 
- 		    cprintf("\n\n\nF_006.\n");      // Fault Code 출력			/* 주제어 보드로 동작  */
-				Relay_Off(hlt_out);	
-        Led_Off(hlt_led);      
+ 		    if (Fault_Report("F_006", "PWR_OK") == True)                // 반복은 묶어서 보고
+ 		    {
+ 		      DLOG0("\n\n\nF_006.\n");    // Fault Code 출력			/* 주제어 보드로 동작  */
+ 		    }
+				Fault_Raise(kFLT_POWER, 0U);
 //		    Watchdog_Lock(wdog);
 //		    while (1) {};
 		 }
@@ -144,7 +148,7 @@ void  Sysmon_Thread(void)
 static void Check_Digital_Output_Isol(void)
 {
 
-//  cprintf("\nCheck_Digital_Output_Isol\n");			                   // 모니터링 주기 테스트 코드
+  LOG0(TRACE, SYSMON, "Check_Digital_Output_Isol\n");                 // 모니터링 주기
 //  fpin_1->curr_state = (Bool_t)(HAL_GPIO_ReadPin(GPIOD, GPIO_PIN_3));  
   fpin_1->curr_state = DI_Get_State(fpin_1);
 	HAL_Delay(50);
@@ -153,10 +157,12 @@ static void Check_Digital_Output_Isol(void)
 	HAL_Delay(50);
   if((fpin_1->curr_state == False) || (fpin_2->curr_state == False)) /**< activ low */
   {
-		  cprintf("\n\n\nF_007.\n");                                     /**< Fault Code 출력	*/
+		  if (Fault_Report("F_007", "ISOL") == True)                       /**< 반복은 묶어서 보고 */
+		  {
+		    DLOG0("\n\n\nF_007.\n");                                   /**< Fault Code 출력	*/
+		  }
 //      DO_Off(snp_out);                                               /**< 릴레이 전원 공급 off */
-      Relay_Off(hlt_out);                                            /**< hlt signal off */
-      Led_Off(hlt_led);                                              /**< hlt led on */ 
+      Fault_Raise(kFLT_ISOL, (fpin_1->curr_state == False) ? 1U : 2U);  /**< hlt signal off */
 //			Watchdog_Lock(wdog);
 //			while (1) {}; 
   }
@@ -171,30 +177,38 @@ static void Check_Digital_Output_Isol(void)
 void Check_Temperature(void)
 {
 	u32_t i2c_temper=0;
+	i32_t temper_mC=0;                                                 /**< 출력용 온도 크기(0.001 ℃) */
 	
   i2c_temper = (u32_t)TMP117_get_Temperature(hi2c1);
+  g_device_temper_raw = (i16_t)(u16_t)i2c_temper;
 /************************************************************************************
 * 영하의 온도 처리 ROUTINE
 *************************************************************************************/	
-//  cprintf("\nTemperature Check\n");			                           // 모니터링 주기 테스트 코드	
+  LOG0(TRACE, SYSMON, "Temperature Check\n");                         // 모니터링 주기
 	if(i2c_temper > MINUS_TEMPER)
 	{
 		g_device_temper=(((float)65535U-(float)i2c_temper)*(float)0.0078125);;
-	  if(g_temper_flag == True)
-    {		
-		  cprintf("\n DEOD Temperature : -%f\n",g_device_temper);	
-		}
+		temper_mC = (i32_t)(((65535U - i2c_temper) * 125U) / 16U);     /**< 1/128 ℃ -> 0.001 ℃ */
+	  LOG1(INFO, SYSMON, "\n DEOD Temperature : -%.3q\n", temper_mC);
 		if(g_device_temper >= (float)LOW_TEMPER)                         /**< 영하의 온도 측정 : -40도 이하상태 */
 	  {
 //    cprintf("\n DEOD Temperature : -%f\n",device_temper);	
-			 cprintf("\n\n\nF_004.\n");                                     /**< Fault Code 출력 */
+			 if (Fault_Report("F_004", "LOW") == True)                      /**< 반복은 묶어서 보고 */
+			 {
+			   DLOG0("\n\n\nF_004.\n");                                   /**< Fault Code 출력 */
+			 }
+       Fault_Raise(kFLT_TEMP_MAJ, 0U);
 //	     Relay_Off(hlt_out);
 //       Led_Off(hlt_led);      
 	  }
 		else if(g_device_temper >= (float)LOW_WARNING_TEMPER)            /**< 영하의 온도 측정 -30도 이하상태 */
 		{
-		   cprintf("\n DEOD Temperature : -%f\n",g_device_temper);
-			 cprintf("\n\n\nF_005.\n");                                    /**< Fault Code 출력 */
+		   if (Fault_Report("F_005", "LOW") == True)                      /**< 반복은 묶어서 보고 */
+		   {
+		     cprintf("\n DEOD Temperature : -%.3q\n",temper_mC);
+			   DLOG0("\n\n\nF_005.\n");                                  /**< Fault Code 출력 */
+		   }
+       Fault_Raise(kFLT_TEMP_MIN, 0U);
 		}
 	}
 /************************************************************************************
@@ -203,25 +217,31 @@ void Check_Temperature(void)
 	else 
 	{
 		g_device_temper=((float)(i2c_temper)*(float)0.0078125);
-    if(g_temper_flag == True)
-    {			
-		  cprintf("\n DEOD Temperature : %f\n",g_device_temper);	
-		}
+		temper_mC = (i32_t)((i2c_temper * 125U) / 16U);
+    LOG1(INFO, SYSMON, "\n DEOD Temperature : %.3q\n", temper_mC);
 		if(g_device_temper >= (float)HIGH_TEMPER )                       /**< 영하의 온도 측정 70~79도 이상상태 */
 		{
-			cprintf("\n DEOD Temperature : %f\n",g_device_temper);
-			cprintf("\n\n\nF_004.\n");                                     /**< Fault Code 출력 */
+			if (Fault_Report("F_004", "HIGH") == True)                      /**< 반복은 묶어서 보고 */
+			{
+			  cprintf("\n DEOD Temperature : %.3q\n",temper_mC);
+			  DLOG0("\n\n\nF_004.\n");                                   /**< Fault Code 출력 */
+			}
+      Fault_Raise(kFLT_TEMP_MAJ, 1U);
 
 //			   Relay_Off(hlt_out);
 //         Led_Off(hlt_led);      
 		}	
 		else if(g_device_temper >= (float)HIGH_WARNING_TEMPER)           /**< 영하의 온도 측정 80도 이상상태  */
 		{
-			cprintf("\n DEOD Temperature : %f\n",g_device_temper);
-			cprintf("\n\n\nF_005.\n");                                     /**< Fault Code 출력 */ 
+			if (Fault_Report("F_005", "HIGH") == True)                      /**< 반복은 묶어서 보고 */
+			{
+			  cprintf("\n DEOD Temperature : %.3q\n",temper_mC);
+			  DLOG0("\n\n\nF_005.\n");                                   /**< Fault Code 출력 */
+			}
+      Fault_Raise(kFLT_TEMP_MIN, 1U);
 		}	
 	}
-//	cprintf("\n DEOD Temperature : %f\n",g_device_temper);	         /**< 모니터링 주기 테스트 코드 */
+//	cprintf("\n DEOD Temperature : %.3q\n",temper_mC);	         /**< 모니터링 주기 테스트 코드 */
 }
 
 
@@ -244,15 +264,16 @@ void Check_Temperature(void)
 static void Watchdog_Check_Pin(void)
 {
 Bool_t watchdog_state;
-//		cprintf("\nWatchdog_Check_Pin\n");                             /**< 모니터링 주기 테스트 코드 */ 	
+  LOG0(TRACE, SYSMON, "Watchdog_Check_Pin\n");                        /**< 모니터링 주기 */
   g_Watchdog_Check_Pin_Timer = 0U;	
 	watchdog_state = DI_Get_State(wdt_ok);	    
   if(watchdog_state == False)		
 	{ 
-	  cprintf("\n\n\nF_008.\n");                                       /**< Fault Code 출력  */    
-		Watchdog_Lock(wdog);
-    while(1)
-    {};
+	  if (Fault_Report("F_008", "WDT_OK") == True)                      /**< 반복은 묶어서 보고 */
+	  {
+	    DLOG0("\n\n\nF_008.\n");                                     /**< Fault Code 출력  */
+	  }
+		Fault_Raise(kFLT_WATCHDOG, 0U);                                  /**< Watchdog Lock */
   }
 }
 
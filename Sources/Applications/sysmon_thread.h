@@ -66,6 +66,7 @@ extern u32_t  g_Relay_FB_check_timer;
 extern void   Sysmon_Thread(void);            /* Sysmon 쓰레드 생성한다. */
 extern void   Check_Temperature(void);
 extern float  g_device_temper;
+extern i16_t  g_device_temper_raw;
 extern u32_t  g_Flt_Signal_timer;
 extern u32_t  g_Sensor_Check_timer;
 extern u08_t  g_State_Code;
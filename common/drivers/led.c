@@ -47,6 +47,10 @@ void Led_Init(Led_t * led)
   */
 void Led_On(Led_t * led)
 {
+  if (led == NULL)                                   /* 보드에 없는 LED */
+  {
+    return;
+  }
   HAL_GPIO_WritePin(led->port, (u16_t)led->init.Pin, led->on);
 }
 
@@ -57,6 +61,10 @@ void Led_On(Led_t * led)
   */
 void Led_Off(Led_t * led)
 {
+  if (led == NULL)                                   /* 보드에 없는 LED */
+  {
+    return;
+  }
   HAL_GPIO_WritePin(led->port, (u16_t)led->init.Pin, led->off);
 }
 
@@ -67,6 +75,10 @@ void Led_Off(Led_t * led)
   */
 void Led_Toggle(Led_t * led)
 {
+  if (led == NULL)                                   /* 보드에 없는 LED */
+  {
+    return;
+  }
   HAL_GPIO_TogglePin(led->port, (u16_t)led->init.Pin);
 }
 /** \} LED_Driver_Exported_Functions */
@@ -9,10 +9,10 @@
 /* Includes ------------------------------------------------------------------*/
 #include "periph_stm32f4xx.h"
 #include "device.h"
+#include "lib_string.h"
 #ifndef __NOT_USE_ST__
 #include <stdarg.h>
 #endif
-#include <stdio.h>
 /** \addtogroup Applications
   * \{ */
 
@@ -24,8 +24,16 @@
 /* Private define ------------------------------------------------------------*/
 /* Private macro -------------------------------------------------------------*/
 /* Private variables ---------------------------------------------------------*/
+#ifdef RTE_DEVICE_HAL_UART
+static CprintfStat_t cprintf_stat;
+static u32_t         cprintf_put_clk;                  /* 이번 호출에서 Cprintf_Put()에 쓴 시간 */
+#endif
+
 /* Exported variables --------------------------------------------------------*/
 /* Private function prototypes -----------------------------------------------*/
+#if defined(RTE_DEVICE_HAL_UART) && !defined(__NOT_USE_ST__)
+static void Cprintf_Put(void * ctx, const char_t str[], u32_t len);
+#endif
 /* Exported functions --------------------------------------------------------*/
 /** \addtogroup PeriphCtrl_Exported_Functions
   * \{ */
@@ -107,40 +115,36 @@ void Periph_Control_UART_CLK(USART_TypeDef * uart, Bool_t ctrl)
 /** \brief  Console printf().
   * \param  format - 출력할 데이터 포맷형식
   * \param  ... - 데이터 포맷형식에 들어갈 데이터(가변인자)
+  * \note   송신 버퍼가 가득 차면 serial3의 넘침 정책을 따르며 호출자는 기다리지 않는다.
+  *         형식화는 String_Format()(정수 전용, %f 없음, 고정소수점은 %q)이 하며
+  *         printf_buf 크기 단위로 나눠 보내므로 긴 format도 버퍼를 넘지 않는다.
   * \retval None
   */
 #ifndef __NOT_USE_ST__
 void cprintf(const char_t format[], ...)
 {
-  u32_t  i = 0U;
-  u08_t nCh = 0;
+  u32_t  start = LATENCY_CLOCK();
+  u32_t  fmt_clk;
+  u32_t  chars;
   __va_list arglist = {(void *)0, };
 
+  cprintf_put_clk = 0U;
+  /* 줄 단위로 송신 버퍼에 넣는다 : 버퍼가 차면 줄째로 버려지고 기다리지 않는다. */
   va_start(arglist, format);
-  vsprintf((char_t *)serial3->printf_buf, format, arglist);
+  chars = String_Format((char_t *)serial3->printf_buf, serial3->printf_size, &Cprintf_Put, serial3, format, arglist);
   va_end(arglist);
 
-  while(serial3->printf_buf[i] != 0U)
+  fmt_clk = (LATENCY_CLOCK() - start) - cprintf_put_clk;
+  cprintf_stat.calls++;
+  cprintf_stat.chars   += chars;
+  cprintf_stat.fmt_last = fmt_clk;
+  if (fmt_clk > cprintf_stat.fmt_max)
   {
-    if (i < serial3->tx_size)
-    {
-      nCh = (u08_t)'\n';
-      if (serial3->printf_buf[i] == nCh)
-      {
-        Rs232_Send_Byte(serial3, (u08_t)'\r');
-      }
-      nCh = (u08_t)'\r';
-      if (serial3->printf_buf[i] == nCh)
-      {
-        Rs232_Send_Byte(serial3, (u08_t)'\n');
-      }
-      Rs232_Send_Byte(serial3, serial3->printf_buf[i]);
-      i++;
-    }
-    else
-    {
-      break;
-    }
+    cprintf_stat.fmt_max = fmt_clk;
+  }
+  if (cprintf_put_clk > cprintf_stat.put_max)
+  {
+    cprintf_stat.put_max = cprintf_put_clk;
   }
 }
 #endif
@@ -158,6 +162,26 @@ void cprint(u08_t buf[], u32_t size)
   Rs232_Transmit_Data(serial3, buf, size);
 }
 
+/** \brief  cprintf() 시간 통계를 복사한다.
+  * \param  stat - 통계를 받을 CprintfStat_t 구조체 포인터
+  * \retval 없음
+  */
+void Cprintf_Get_Stat(CprintfStat_t * stat)
+{
+  *stat = cprintf_stat;
+}
+
+/** \brief  cprintf() 시간 통계를 지운다.
+  * \retval 없음
+  */
+void Cprintf_Clear_Stat(void)
+{
+  cprintf_stat.calls    = 0U;
+  cprintf_stat.chars    = 0U;
+  cprintf_stat.fmt_last = 0U;
+  cprintf_stat.fmt_max  = 0U;
+  cprintf_stat.put_max  = 0U;
+}
 
 #endif /* RTE_DEVICE_HAL_UART */
 
@@ -166,6 +190,19 @@ void cprint(u08_t buf[], u32_t size)
 /* Private functions ---------------------------------------------------------*/
 /** \addtogroup PeriphCtrl_Private_Functions
   * \{ */
+#if defined(RTE_DEVICE_HAL_UART) && !defined(__NOT_USE_ST__)
+/** \brief  String_Format()이 채운 한 줄(또는 가득 찬 printf_buf)을 콘솔 송신 버퍼에 넣는다.
+  * \param  ctx - 송신할 Rs232_t 객체
+  * \retval 없음
+  */
+static void Cprintf_Put(void * ctx, const char_t str[], u32_t len)
+{
+  u32_t start = LATENCY_CLOCK();
+
+  (void)Rs232_Write((Rs232_t *)ctx, (const u08_t *)str, len, True);
+  cprintf_put_clk += LATENCY_CLOCK() - start;
+}
+#endif
 /** \} PeriphCtrl_Private_Functions */
 
 /** \} PeriphCtrl */
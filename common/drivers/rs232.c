@@ -12,6 +12,10 @@
   *            Rs232_Set_Receive_Tick(),
   *            Rs232_CountDown_Receive_Tick() 함수 추가
   * V0.0.3   - Rs232_Printf() 함수 이름을 Printf()로 변경
+  * V0.0.4   - 송신 DMA(ring을 연속 구간 단위로 전송)와 송신 버퍼 넘침 정책 추가
+  *            Rs232_Write(), Rs232_Set_Tx_Policy(), Rs232_Set_Tx_High(),
+  *            Rs232_Clear_Tx_Stat(), Rs232_IRQHandler_TC() 함수 추가
+  * V0.0.5   - Rs232_Get_Tx_Free() 함수 추가
 */
 
 /* Includes ------------------------------------------------------------------*/
@@ -28,10 +32,18 @@
 
 /* Private typedef -----------------------------------------------------------*/
 /* Private define ------------------------------------------------------------*/
+#define RS232_TX_BLOCK_usec     (50000U)      /**< 높은 우선순위 메시지가 송신 버퍼 공간을 기다리는 최대 시간 */
+
 /* Private macro -------------------------------------------------------------*/
 /* Private variables ---------------------------------------------------------*/
 /* Exported variables --------------------------------------------------------*/
 /* Private function prototypes -----------------------------------------------*/
+static u32_t Rs232_Tx_Free(const Rs232_t * rs);
+static u32_t Rs232_Tx_Put(Rs232_t * rs, u32_t in, u08_t byte);
+static void Rs232_Tx_Drop_Old(Rs232_t * rs, u32_t need);
+static void Rs232_Tx_Kick(Rs232_t * rs);
+static void Rs232_Dma_Init(Rs232_t * rs);
+static void Rs232_Dma_Start(Rs232_t * rs);
 /* Exported functions --------------------------------------------------------*/
 /** \addtogroup RS232_Driver_Exported_Functions
   * \{ */
@@ -52,6 +64,7 @@ void Rs232_Init(Rs232_t * rs)
   
   Periph_Control_UART_CLK(rs->handle->Instance,True);
   HAL_UART_Init(rs->handle);
+  Rs232_Dma_Init(rs);
   
   if (rs->usingIRQ != False)
   {
@@ -70,6 +83,7 @@ void Rs232_Init(Rs232_t * rs)
 
   HAL_ENABLE_UART_CLK((rs->handle->Instance));
   HAL_UART_Init(rs->handle);
+  Rs232_Dma_Init(rs);
 
   if (rs->usingIRQ != False)
   {
@@ -122,6 +136,13 @@ void Rs232_Enable_Receiving(Rs232_t * rs)
   
   /* Enable the UART Data Register not empty Interrupt */
   __HAL_UART_ENABLE_IT(rs->handle, UART_IT_RXNE);
+
+  /* Enable the UART IDLE line Interrupt : 수신 완료 판정 */
+  if (rs->rx_idle == True)
+  {
+    __HAL_UART_CLEAR_IDLEFLAG(rs->handle);
+    __HAL_UART_ENABLE_IT(rs->handle, UART_IT_IDLE);
+  }
 }
 #endif
 /** \brief  RS232 Driver의 수신 인터럽트를 처리한다.
@@ -183,6 +204,24 @@ void Rs232_Receive_TimeOut(Rs232_t * rs)
   rs->rx_complete = True;
 }
 
+/** \brief  RS232 Driver의 IDLE line 인터럽트를 처리한다.
+  * \param  rs - RS232 구조체 포인터
+  * \note   마지막 수신 문자 뒤로 1 문자 시간(8N1이면 10 bit, 115200bps에서 87usec) 동안
+            수신이 없으면 USART가 IDLE을 세우므로, 수신된 byte가 있으면 수신 완료로 처리한다.
+            수신 간격 판정이 baud-rate를 따라가므로 고정 msec 수신 타이머가 필요 없다.
+            IDLE 플래그는 SR, DR 순서로 읽어 지우므로 RXNE 처리 뒤에 호출해야 한다.
+  * \retval 없음
+  */
+void Rs232_IRQHandler_IDLE(Rs232_t * rs)
+{
+  __HAL_UART_CLEAR_IDLEFLAG(rs->handle);
+  rs->rx_tick = 0U;
+  if (rs->rx_count != 0U)
+  {
+    rs->rx_complete = True;
+  }
+}
+
 /** \brief  RS232 Driver의 수신 기능을 복원시킨다.
   * \param  rs - RS232 구조체 포인터
   * \note   수신된 데이터가 처리된 후 다시 수신할 수 있도록
@@ -205,53 +244,178 @@ void Rs232_Restore_rx(Rs232_t * rs)
   * \param  rs - RS232 구조체 포인터
   * \param  data - 송신할 데이터가 저장된 배열
   * \param  count - 송신할 데이터의 수
-  * \note   data를 송신 버퍼에 복사하면서 송신 인터럽트를 활성화하여 
-  *         송신 버퍼의 데이터가 전송되게끔한다.
+  * \note   data를 하나의 메시지로 송신 버퍼에 넣는다. 공간이 없으면 tx_policy를 따른다.
   * \retval 없음
   */
 void Rs232_Transmit_Data(Rs232_t * rs, u08_t data[], u32_t count)
 {
-  u32_t    i = 0;
-  
-  for (i = 0; i < count; i++)
-  {
-    Rs232_Send_Byte(rs, data[i]);
-  }
+  (void)Rs232_Write(rs, data, count, False);
 }
 
 /** \brief  RS232 Driver를 통해 byte를 rs로 전송한다.
   * \param  rs - RS232 구조체 포인터
   * \param  byte - 송신할 1byte의 데이터
-  * \note   송신할 데이터를 송신 버퍼에 복사하면서 송신 카운트를 조절하며,
-            송신 중이 아니면 송신 인터럽트를 활성화시킨다.
+  * \note   송신 버퍼가 가득 차도 기다리지 않고 tx_policy를 따른다.
   * \retval None
   */
 #ifndef __NOT_USE_ST__
 void Rs232_Send_Byte(Rs232_t * rs, u08_t byte)
 {
-  u32_t  tmp;
-  
-  tmp = rs->tx_count_in + 1U;
-  if (tmp >= rs->tx_size)
+  (void)Rs232_Write(rs, &byte, 1U, False);
+}
+#endif
+
+/** \brief  data를 count 만큼 하나의 메시지로 rs의 송신 버퍼에 넣고 송신을 시작한다.
+  * \param  rs - RS232 구조체 포인터
+  * \param  data - 송신할 데이터가 저장된 배열
+  * \param  count - 송신할 데이터의 수
+  * \param  crlf - True면 '\n' 앞에 '\r', '\r' 앞에 '\n'을 붙여 넣는다(cprintf 줄바꿈)
+  * \note   메시지는 통째로 들어가거나 통째로 버려지며, 공간이 모자라면 tx_policy에 따라
+  *         DROP_NEW는 새 메시지를, DROP_OLD는 아직 나가지 않은 오래된 byte를 버린다.
+  *         BLOCK_HIGH는 tx_high가 설정된 thread 문맥에서만 RS232_TX_BLOCK_usec까지 기다리고
+  *         그 외(일반 메시지, 인터럽트, 인터럽트 금지 구간)는 DROP_NEW와 같이 기다리지 않는다.
+  * \retval 송신 버퍼에 넣은 byte 수, 버렸으면 0
+  */
+u32_t Rs232_Write(Rs232_t * rs, const u08_t data[], u32_t count, Bool_t crlf)
+{
+  u32_t  need = count;
+  u32_t  i, in, used, primask, start;
+
+  if (crlf == True)
   {
-    tmp = 0;
+    for (i = 0U; i < count; i++)
+    {
+      if ((data[i] == (u08_t)'\n') || (data[i] == (u08_t)'\r'))
+      {
+        need++;
+      }
+    }
   }
-  
-  while (tmp == rs->tx_count_out)
+  if (need == 0U)
   {
-    HAL_Delay(msec(20));
+    return 0U;
   }
-  
-  rs->tx_buf[rs->tx_count_in] = byte;
-  rs->tx_count_in = tmp;
-  
-  if (rs->tx_ing == False)
+
+  primask = __get_PRIMASK();
+  __disable_irq();
+  if (Rs232_Tx_Free(rs) < need)
   {
-    rs->tx_ing = True;
-    __HAL_UART_ENABLE_IT(rs->handle, UART_IT_TXE);
+    if (rs->tx_policy == (u08_t)kRS232_TX_DROP_OLD)
+    {
+      Rs232_Tx_Drop_Old(rs, need);
+    }
+    else if ((rs->tx_policy == (u08_t)kRS232_TX_BLOCK_HIGH) && (rs->tx_high == True) &&
+             (primask == 0U) && (__get_IPSR() == 0U) && (need < rs->tx_size))
+    {
+      rs->tx_blocked++;
+      __set_PRIMASK(primask);
+      start = Device_Usec_Now();
+      while ((Device_Usec_Now() - start) < RS232_TX_BLOCK_usec)
+      {
+        __disable_irq();
+        if (Rs232_Tx_Free(rs) >= need)
+        {
+          break;
+        }
+        __set_PRIMASK(primask);
+      }
+      __disable_irq();
+    }
+    else
+    {
+      /* DROP_NEW */
+    }
+    if (Rs232_Tx_Free(rs) < need)
+    {
+      rs->tx_drop_new++;
+      __set_PRIMASK(primask);
+      return 0U;
+    }
+  }
+
+  in = rs->tx_count_in;
+  for (i = 0U; i < count; i++)
+  {
+    if ((crlf == True) && (data[i] == (u08_t)'\n'))
+    {
+      in = Rs232_Tx_Put(rs, in, (u08_t)'\r');
+    }
+    else if ((crlf == True) && (data[i] == (u08_t)'\r'))
+    {
+      in = Rs232_Tx_Put(rs, in, (u08_t)'\n');
+    }
+    else
+    {
+      /* 그대로 */
+    }
+    in = Rs232_Tx_Put(rs, in, data[i]);
+  }
+  rs->tx_count_in = in;
+  rs->tx_msgs++;
+  used = (rs->tx_size - 1U) - Rs232_Tx_Free(rs);
+  if (used > rs->tx_peak)
+  {
+    rs->tx_peak = used;
   }
+  Rs232_Tx_Kick(rs);
+  __set_PRIMASK(primask);
+  return need;
+}
+
+/** \brief  rs의 송신 버퍼 넘침 정책을 설정한다.
+  * \param  rs - RS232 구조체 포인터
+  * \param  policy - Rs232TxPolicy_t 값
+  * \retval 범위를 벗어난 값이면 False
+  */
+Bool_t Rs232_Set_Tx_Policy(Rs232_t * rs, u08_t policy)
+{
+  if (policy >= (u08_t)kRS232_TX_POLICY_MAX)
+  {
+    return False;
+  }
+  rs->tx_policy = policy;
+  return True;
+}
+
+/** \brief  이후 rs에 쓰는 메시지의 우선순위를 설정한다.
+  * \param  rs - RS232 구조체 포인터
+  * \param  high - True면 높은 우선순위(BLOCK_HIGH 정책에서 공간을 기다림)
+  * \note   콘솔 명령어 응답처럼 사용자가 기다리는 출력에만 설정하고 끝나면 해제한다.
+  * \retval 없음
+  */
+void Rs232_Set_Tx_High(Rs232_t * rs, Bool_t high)
+{
+  rs->tx_high = high;
+}
+
+/** \brief  rs의 송신 메시지/버림 계수를 지우고 최대 사용량을 현재 사용량으로 되돌린다.
+  * \param  rs - RS232 구조체 포인터
+  * \retval 없음
+  */
+void Rs232_Clear_Tx_Stat(Rs232_t * rs)
+{
+  u32_t  primask;
+
+  primask = __get_PRIMASK();
+  __disable_irq();
+  rs->tx_msgs     = 0U;
+  rs->tx_drop_new = 0U;
+  rs->tx_drop_old = 0U;
+  rs->tx_blocked  = 0U;
+  rs->dma_xfers   = 0U;
+  rs->tx_peak     = (rs->tx_size - 1U) - Rs232_Tx_Free(rs);
+  __set_PRIMASK(primask);
+}
+
+/** \brief  rs의 송신 버퍼 여유 공간을 구한다.
+  * \param  rs - RS232 구조체 포인터
+  * \note   부르는 사이에도 송신이 진행되므로 여유는 늘기만 한다(쓰는 쪽이 하나일 때).
+  * \retval 여유 byte 수
+  */
+u32_t Rs232_Get_Tx_Free(const Rs232_t * rs)
+{
+  return Rs232_Tx_Free(rs);
 }
-#endif
 /** \brief  RS232 Driver의 송신 인터럽트를 처리한다.
   * \param  rs - RS232 구조체 포인터
   * \note   송신 버퍼에 들어있는 데이터를 1byte씩 전송하고 송신 카운트를 조절하며,
@@ -279,10 +443,187 @@ void Rs232_IRQHandler_TXE(Rs232_t * rs)
 }
 #endif
 
+/** \brief  RS232 Driver의 송신 완료(UART TC) 인터럽트를 처리한다.
+  * \param  rs - RS232 구조체 포인터
+  * \note   DMA로 보낸 구간의 마지막 byte가 나가면 stream을 정리하고,
+  *         그 사이 송신 버퍼에 쌓인 다음 구간을 이어서 보낸다.
+  * \retval 없음
+  */
+void Rs232_IRQHandler_TC(Rs232_t * rs)
+{
+  __HAL_UART_DISABLE_IT(rs->handle, UART_IT_TC);
+  if (rs->dma_count == 0U)
+  {
+    return;
+  }
+  CLEAR_BIT(rs->handle->Instance->CR3, USART_CR3_DMAT);
+  (void)HAL_DMA_Abort(rs->hdma_tx);                        /* 완료된 stream을 READY로 되돌림 */
+  rs->dma_count = 0U;
+  rs->tx_ing = False;
+  Rs232_Dma_Start(rs);
+}
+
 /** \} RS232_Driver_Exported_Functions */
 
 /* Private functions ---------------------------------------------------------*/
 
+/** \brief  rs의 송신 버퍼 여유 공간을 구한다.
+  * \param  rs - RS232 구조체 포인터
+  * \note   DMA가 보내는 중인 구간은 끝날 때까지 비지 않은 것으로 본다.
+  * \retval 여유 byte 수
+  */
+static u32_t Rs232_Tx_Free(const Rs232_t * rs)
+{
+  u32_t  tail = (rs->dma_count != 0U) ? rs->dma_start : rs->tx_count_out;
+
+  return (rs->tx_size - 1U) - (((rs->tx_count_in + rs->tx_size) - tail) % rs->tx_size);
+}
+
+/** \brief  rs의 송신 버퍼 in 위치에 byte를 넣는다.
+  * \param  rs - RS232 구조체 포인터
+  * \param  in - 넣을 위치
+  * \param  byte - 넣을 데이터
+  * \retval 다음 위치
+  */
+static u32_t Rs232_Tx_Put(Rs232_t * rs, u32_t in, u08_t byte)
+{
+  rs->tx_buf[in] = byte;
+  in++;
+  if (in >= rs->tx_size)
+  {
+    in = 0U;
+  }
+  return in;
+}
+
+/** \brief  need byte가 들어가도록 아직 송신하지 않은 오래된 byte를 버린다.
+  * \param  rs - RS232 구조체 포인터
+  * \param  need - 필요한 byte 수
+  * \note   인터럽트 금지 상태에서 호출한다. 빈 공간은 DMA가 보내는 중인 구간 앞에서 끝나므로
+  *         그 구간을 멈추고 아직 못 보낸 byte부터 버린 뒤, 모자라면 대기 byte를 버린다.
+  * \retval 없음
+  */
+static void Rs232_Tx_Drop_Old(Rs232_t * rs, u32_t need)
+{
+  u32_t  pending, drop;
+
+  if (rs->dma_count != 0U)
+  {
+    __HAL_UART_DISABLE_IT(rs->handle, UART_IT_TC);
+    CLEAR_BIT(rs->handle->Instance->CR3, USART_CR3_DMAT);
+    rs->tx_drop_old += __HAL_DMA_GET_COUNTER(rs->hdma_tx);
+    (void)HAL_DMA_Abort(rs->hdma_tx);
+    rs->dma_count = 0U;
+    rs->tx_ing = False;
+    if (Rs232_Tx_Free(rs) >= need)
+    {
+      return;
+    }
+  }
+  pending = ((rs->tx_count_in + rs->tx_size) - rs->tx_count_out) % rs->tx_size;
+  drop    = need - Rs232_Tx_Free(rs);
+  if (drop > pending)
+  {
+    drop = pending;
+  }
+  rs->tx_count_out = (rs->tx_count_out + drop) % rs->tx_size;
+  rs->tx_drop_old += drop;
+}
+
+/** \brief  송신 중이 아니면 송신을 시작한다.
+  * \param  rs - RS232 구조체 포인터
+  * \note   인터럽트 금지 상태에서 호출한다.
+  * \retval 없음
+  */
+static void Rs232_Tx_Kick(Rs232_t * rs)
+{
+  if (rs->hdma_tx != NULL)
+  {
+    Rs232_Dma_Start(rs);
+  }
+  else if (rs->tx_ing == False)
+  {
+    rs->tx_ing = True;
+    __HAL_UART_ENABLE_IT(rs->handle, UART_IT_TXE);
+  }
+  else
+  {
+    /* TXE 인터럽트가 이어서 보냄 */
+  }
+}
+
+/** \brief  rs의 송신 DMA를 초기화한다.
+  * \param  rs - RS232 구조체 포인터
+  * \note   hdma_tx의 Instance(Stream)와 Init.Channel은 디바이스 정의에서 정하고,
+  *         전송 형식(memory -> DR, byte, normal)은 여기서 정한다. DMA 인터럽트는 쓰지 않고
+  *         구간 끝은 UART TC로 판정한다.
+  * \retval 없음
+  */
+static void Rs232_Dma_Init(Rs232_t * rs)
+{
+  DMA_HandleTypeDef * hdma = rs->hdma_tx;
+
+  rs->dma_count = 0U;
+  if (hdma == NULL)
+  {
+    return;
+  }
+  if ((rs->dma_chunk == 0U) || (rs->dma_chunk >= rs->tx_size))
+  {
+    rs->dma_chunk = rs->tx_size - 1U;
+  }
+  __HAL_RCC_DMA1_CLK_ENABLE();                            /* USART3 TX는 DMA1 */
+  hdma->Init.Direction           = DMA_MEMORY_TO_PERIPH;
+  hdma->Init.PeriphInc           = DMA_PINC_DISABLE;
+  hdma->Init.MemInc              = DMA_MINC_ENABLE;
+  hdma->Init.PeriphDataAlignment = DMA_PDATAALIGN_BYTE;
+  hdma->Init.MemDataAlignment    = DMA_MDATAALIGN_BYTE;
+  hdma->Init.Mode                = DMA_NORMAL;
+  hdma->Init.Priority            = DMA_PRIORITY_LOW;
+  hdma->Init.FIFOMode            = DMA_FIFOMODE_DISABLE;
+  if (HAL_DMA_Init(hdma) != HAL_OK)
+  {
+    rs->hdma_tx = NULL;                                    /* TXE 인터럽트 송신으로 동작 */
+    return;
+  }
+  __HAL_LINKDMA(rs->handle, hdmatx, *hdma);
+}
+
+/** \brief  송신 버퍼에서 다음 연속 구간을 DMA로 보낸다.
+  * \param  rs - RS232 구조체 포인터
+  * \note   인터럽트 금지 상태나 TC 인터럽트에서 호출한다. 구간은 ring 끝에서 끊기고
+  *         dma_chunk를 넘지 않으며, tx_count_out은 시작할 때 구간 뒤로 옮긴다.
+  * \retval 없음
+  */
+static void Rs232_Dma_Start(Rs232_t * rs)
+{
+  u32_t  n;
+
+  if ((rs->dma_count != 0U) || (rs->tx_count_out == rs->tx_count_in))
+  {
+    return;
+  }
+  n = (rs->tx_count_in > rs->tx_count_out) ? (rs->tx_count_in - rs->tx_count_out)
+                                           : (rs->tx_size - rs->tx_count_out);
+  if (n > rs->dma_chunk)
+  {
+    n = rs->dma_chunk;
+  }
+  rs->dma_start = rs->tx_count_out;
+  rs->dma_count = n;
+  rs->tx_count_out += n;
+  if (rs->tx_count_out >= rs->tx_size)
+  {
+    rs->tx_count_out = 0U;
+  }
+  rs->tx_ing = True;
+  __HAL_UART_CLEAR_FLAG(rs->handle, UART_FLAG_TC);
+  (void)HAL_DMA_Start(rs->hdma_tx, (u32_t)&rs->tx_buf[rs->dma_start], (u32_t)&rs->handle->Instance->DR, n);
+  SET_BIT(rs->handle->Instance->CR3, USART_CR3_DMAT);
+  __HAL_UART_ENABLE_IT(rs->handle, UART_IT_TC);
+  rs->dma_xfers++;
+}
+
 /** \} RS232_Driver */
 
 /** \} Drivers */
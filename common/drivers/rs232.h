@@ -12,6 +12,10 @@
   *            Rs232_Set_Receive_Tick(),
   *            Rs232_CountDown_Receive_Tick() 함수 추가
   * V0.0.3   - Rs232_Printf() 함수 이름을 Printf()로 변경
+  * V0.0.4   - 송신 DMA(ring을 연속 구간 단위로 전송)와 송신 버퍼 넘침 정책 추가
+  *            Rs232_Write(), Rs232_Set_Tx_Policy(), Rs232_Set_Tx_High(),
+  *            Rs232_Clear_Tx_Stat(), Rs232_IRQHandler_TC() 함수 추가
+  * V0.0.5   - Rs232_Get_Tx_Free() 함수 추가
 */
 
 /* Define to prevent recursive inclusion -------------------------------------*/
@@ -34,6 +38,15 @@
 /** \defgroup RS232_Driver_Exported_Types RS232 드라이버 공개 타입
   * \{ */
 
+/** \brief 송신 버퍼가 가득 찼을 때의 처리 정책 */
+typedef enum
+{
+  kRS232_TX_DROP_NEW = 0,                 /**< 새 메시지를 버린다(기본) */
+  kRS232_TX_DROP_OLD,                     /**< 아직 송신하지 않은 오래된 byte를 버린다 */
+  kRS232_TX_BLOCK_HIGH,                   /**< 높은 우선순위 메시지만 제한 시간까지 기다리고 나머지는 버린다 */
+  kRS232_TX_POLICY_MAX
+}Rs232TxPolicy_t;
+
 /** \brief RS232 구조체 타입 */
 typedef struct
 {
@@ -49,11 +62,24 @@ typedef struct
   u32_t            tx_count_in;        /**< RS232 Transmission Buffer Input Count */
   u32_t            tx_count_out;       /**< RS232 Transmission Buffer Output Count */
   Bool_t              tx_ing;             /**< RS232 Flag for Transmission Ongoing */
+  u08_t               tx_policy;          /**< 송신 버퍼 넘침 정책(Rs232TxPolicy_t) */
+  volatile Bool_t     tx_high;            /**< True면 지금 쓰는 메시지가 높은 우선순위(BLOCK_HIGH에서 대기 허용) */
+  u32_t               tx_msgs;            /**< 송신 버퍼에 넣은 메시지 수 */
+  u32_t               tx_drop_new;        /**< 공간이 없어 버린 새 메시지 수 */
+  u32_t               tx_drop_old;        /**< 새 메시지를 위해 버린 오래된 byte 수 */
+  u32_t               tx_blocked;         /**< 높은 우선순위 메시지가 공간을 기다린 횟수 */
+  u32_t               tx_peak;            /**< 송신 버퍼 최대 사용량[byte] */
+  DMA_HandleTypeDef  *hdma_tx;            /**< 송신 DMA Handle(Instance, Init.Channel 지정), NULL이면 TXE 인터럽트 송신 */
+  u32_t               dma_chunk;          /**< DMA 1회 전송 최대 byte 수 */
+  volatile u32_t      dma_start;          /**< DMA 전송 중인 구간의 시작 위치 */
+  volatile u32_t      dma_count;          /**< DMA 전송 중인 구간의 byte 수, 0이면 idle */
+  u32_t               dma_xfers;          /**< DMA 전송 횟수 */
   u08_t            *rx_buf;             /**< RS232 Receiving Buffer Pointer */
   u32_t            rx_size;            /**< RS232 Receiving Buffer Size */
   u32_t            rx_count;           /**< RS232 Receiving Buffer Count */
   u32_t            rx_tick;            /**< RS232 Receiving Complete Tick */
   Bool_t              rx_complete;        /**< RS232 Flag for Receiving Complete */
+  Bool_t              rx_idle;            /**< True면 USART IDLE line(1 문자 시간 무수신)으로 수신 완료, rx_tick 미사용 */
   u08_t            *printf_buf;         /**< RS232 Buffer for Printf() */
   u32_t            printf_size;        /**< RS232 Printf-Buffer Size */
   Bool_t              usingIRQ;           /**< RS232 Flag of Using IRQ */
@@ -76,10 +102,17 @@ void Rs232_IRQHandler_RXNE(Rs232_t * rs);
 void Rs232_Set_Receive_Tick(Rs232_t * rs, u32_t tick);
 void Rs232_CountDown_Receive_Tick(Rs232_t * rs);
 void Rs232_Receive_TimeOut(Rs232_t * rs);
+void Rs232_IRQHandler_IDLE(Rs232_t * rs);
 void Rs232_Restore_rx(Rs232_t * rs);
 void Rs232_Transmit_Data(Rs232_t * rs, u08_t data[], u32_t count);
 void Rs232_Send_Byte(Rs232_t * rs, u08_t byte);
+u32_t Rs232_Write(Rs232_t * rs, const u08_t data[], u32_t count, Bool_t crlf);
+Bool_t Rs232_Set_Tx_Policy(Rs232_t * rs, u08_t policy);
+void Rs232_Set_Tx_High(Rs232_t * rs, Bool_t high);
+void Rs232_Clear_Tx_Stat(Rs232_t * rs);
+u32_t Rs232_Get_Tx_Free(const Rs232_t * rs);
 void Rs232_IRQHandler_TXE(Rs232_t * rs);
+void Rs232_IRQHandler_TC(Rs232_t * rs);
 void Printf(Rs232_t * rs, const char_t format[], ...);
 /** \} RS232_Driver_Exported_Functions */
 
@@ -28,6 +28,9 @@
 /* Private variables ---------------------------------------------------------*/
 /* Exported variables --------------------------------------------------------*/
 /* Private function prototypes -----------------------------------------------*/
+static void Rs485_Dma_Init(Rs485_t * rs);
+static void Rs485_Dma_Complete(Rs485_t * rs);
+
 /* Exported functions --------------------------------------------------------*/
 /** \addtogroup RS485_Driver_Exported_Functions
   * \{ */
@@ -50,6 +53,7 @@ void Rs485_Init(Rs485_t * rs)
 
   Periph_Control_UART_CLK(rs->handle->Instance, True);
   HAL_UART_Init(rs->handle);
+  Rs485_Dma_Init(rs);
   
   if (rs->usingIRQ == False)
   {
@@ -81,6 +85,14 @@ void Rs485_Disable_IRQ(Rs485_t * rs)
   /* Disable the UART Transmit data register empty Interrupt */
   __HAL_UART_DISABLE_IT(rs->handle, UART_IT_TXE);
 
+  /* 진행 중인 DMA 송신을 멈춘다. */
+  if ((rs->hdma_tx != NULL) && (rs->dma_busy == True))
+  {
+    CLEAR_BIT(rs->handle->Instance->CR3, USART_CR3_DMAT);
+    (void)HAL_DMA_Abort(rs->hdma_tx);
+    rs->dma_busy = False;
+  }
+
   /* rs의 인터럽트를 비활성화한다. */
   HAL_NVIC_DisableIRQ(rs->irqn);
 }
@@ -100,6 +112,13 @@ void Rs485_Enable_Receiving(Rs485_t * rs)
   
   /* Enable the UART Data Register not empty Interrupt */
   __HAL_UART_ENABLE_IT(rs->handle, UART_IT_RXNE);
+
+  /* Enable the UART IDLE line Interrupt : 수신 완료 판정 */
+  if (rs->rx_idle == True)
+  {
+    __HAL_UART_CLEAR_IDLEFLAG(rs->handle);
+    __HAL_UART_ENABLE_IT(rs->handle, UART_IT_IDLE);
+  }
 }
 
 /** \brief  RS485 Driver의 수신 인터럽트를 처리한다.
@@ -118,6 +137,10 @@ void Rs485_IRQHandler_RXNE(Rs485_t * rs)
   {
     rs->rx_count = 0;
   }
+  if (rs->rx_hook != NULL)
+  {
+    rs->rx_hook((uint8_t)(dr & (uint8_t)0x00FF));
+  }
 }
 
 /** \brief  RS485의 수신 타이머를 tick으로 설정한다.
@@ -161,24 +184,66 @@ void Rs485_Receive_TimeOut(Rs485_t * rs)
   rs->rx_complete = True;
 }
 
+/** \brief  RS485 Driver의 IDLE line 인터럽트를 처리한다.
+  * \param  rs - RS485 구조체 포인터
+  * \note   마지막 수신 문자 뒤로 1 문자 시간(38400bps에서 260usec) 수신이 없으면 수신 완료로 처리한다.
+            SysTick에서 Rs485_CountDown_Receive_Tick()을 부르지 않아도 rx_complete가 선다.
+            IDLE 플래그는 SR, DR 순서로 읽어 지우므로 RXNE 처리 뒤에 호출해야 한다.
+  * \retval 없음
+  */
+void Rs485_IRQHandler_IDLE(Rs485_t * rs)
+{
+  __HAL_UART_CLEAR_IDLEFLAG(rs->handle);
+  rs->rx_tick = 0;
+  if (rs->rx_count != 0)
+  {
+    rs->rx_complete = True;
+  }
+}
+
 /** \brief  RS485 Driver의 수신 기능을 복원시킨다.
   * \param  rs - RS485 구조체 포인터
   * \note   수신된 데이터가 처리된 후 다시 수신할 수 있도록
-            수신 버퍼와 수신 카운트, 수신 완료 플래그를 클리어한다.
+            수신 카운트, 수신 완료 플래그를 클리어한다.
+            버퍼 내용은 rx_count 까지만 유효하므로 지우지 않는다.
   * \retval None
   */
 void Rs485_Restore_rx(Rs485_t * rs)
 {
-  uint32_t i = 0;
-  
-  for (i = 0; i < rs->rx_count; i++)
-  {
-    rs->rx_buf[i] = 0;
-  }
   rs->rx_count = 0;
   rs->rx_complete = False;
 }
 
+/** \brief  수신 버퍼에서 처리한 앞쪽 count byte를 내보낸다.
+  * \param  rs - RS485 구조체 포인터
+  * \param  count - 처리한 byte 수(처리를 시작할 때의 rx_count)
+  * \note   수신 버퍼를 복사하지 않고 그 자리에서 처리한 뒤 호출한다.
+  *         처리하는 동안 새로 받은 byte가 있으면 버퍼 앞으로 옮기고 수신 완료 플래그는 그대로 둔다.
+  * \retval None
+  */
+void Rs485_Release_rx(Rs485_t * rs, uint32_t count)
+{
+  uint32_t  i, rest, primask;
+
+  primask = __get_PRIMASK();
+  __disable_irq();
+  if (count >= rs->rx_count)                              /* 보통 : 새로 받은 byte 없음 */
+  {
+    rs->rx_count = 0;
+    rs->rx_complete = False;
+  }
+  else
+  {
+    rest = rs->rx_count - count;
+    for (i = 0; i < rest; i++)
+    {
+      rs->rx_buf[i] = rs->rx_buf[count + i];
+    }
+    rs->rx_count = rest;
+  }
+  __set_PRIMASK(primask);
+}
+
 /** \brief  RS485 Driver를 통해 data를 그 count 만큼 rs로 전송한다.
   * \param  rs - RS485 구조체 포인터
   * \param  data - 송신할 데이터가 저장된 배열
@@ -191,12 +256,149 @@ void Rs485_Transmit_Data(Rs485_t * rs, uint8_t data[], uint32_t count)
 {
   uint32_t    i = 0;
   
+  if (rs->hdma_tx != NULL)                                 /* DMA 사용 포트는 기다리지 않는다. */
+  {
+    (void)Rs485_Transmit_Dma(rs, data, count);
+    return;
+  }
   for (i = 0; i < count; i++)
   {
     Rs485_Send_Byte(rs, data[i]);
   }
 }
 
+/** \brief  인터럽트 안에서 data를 그 count 만큼 rs로 전송한다.
+  * \param  rs - RS485 구조체 포인터
+  * \param  data - 송신할 데이터가 저장된 배열
+  * \param  count - 송신할 데이터의 수
+  * \note   Rs485_Send_Byte()와 달리 송신 버퍼가 찰 때까지 기다리지 않는다.
+  *         여유가 없으면 아무것도 넣지 않고 False를 반환한다.
+  * \retval 송신 버퍼에 넣었으면 True
+  */
+Bool_t Rs485_Transmit_Data_Isr(Rs485_t * rs, const uint8_t data[], uint32_t count)
+{
+  uint32_t  used, i;
+
+  if (rs->hdma_tx != NULL)
+  {
+    return Rs485_Transmit_Dma(rs, data, count);
+  }
+  used = (rs->tx_count_in + rs->tx_size - rs->tx_count_out) % rs->tx_size;
+  if ((used + count) >= rs->tx_size)
+  {
+    return False;
+  }
+  for (i = 0; i < count; i++)
+  {
+    rs->tx_buf[rs->tx_count_in] = data[i];
+    rs->tx_count_in++;
+    if (rs->tx_count_in >= rs->tx_size)
+    {
+      rs->tx_count_in = 0;
+    }
+  }
+  if (rs->tx_ing == False)
+  {
+    HAL_GPIO_WritePin(rs->port_txe, rs->init_txe.Pin, rs->on_txe);
+    rs->tx_ing = True;
+    __HAL_UART_ENABLE_IT(rs->handle, UART_IT_TXE);
+    __HAL_UART_ENABLE_IT(rs->handle, UART_IT_TC);
+  }
+  return True;
+}
+
+/** \brief  DMA로 frame 하나를 rs로 전송한다.
+  * \param  rs - RS485 구조체 포인터
+  * \param  data - 송신할 frame
+  * \param  count - frame 길이
+  * \note   frame을 DMA 버퍼에 복사하고 TXE(DE)를 켠 뒤 DMA를 시작하고 바로 돌아온다(대기 없음).
+  *         이전 frame이 아직 송신 중이거나 버퍼보다 길면 보내지 않고 dma_drop을 센다.
+  *         TXE(DE)는 UART TC 인터럽트(마지막 stop bit 송신 완료)에서 Rs485_Dma_Complete()가 해제한다.
+  *         인터럽트와 thread 양쪽에서 호출할 수 있다.
+  * \retval 송신을 시작했으면 True
+  */
+Bool_t Rs485_Transmit_Dma(Rs485_t * rs, const uint8_t data[], uint32_t count)
+{
+  uint32_t  i, primask;
+
+  primask = __get_PRIMASK();
+  __disable_irq();
+  if ((rs->dma_busy == True) || (count == 0U) || (count > rs->dma_size))
+  {
+    rs->dma_drop++;
+    __set_PRIMASK(primask);
+    return False;
+  }
+  rs->dma_busy = True;
+  __set_PRIMASK(primask);
+
+  for (i = 0; i < count; i++)
+  {
+    rs->dma_buf[i] = data[i];
+  }
+  rs->tx_frame_usec = (uint32_t)((((uint64_t)count * 10U * 1000000U) + rs->handle->Init.BaudRate - 1U)
+                                 / rs->handle->Init.BaudRate);
+  HAL_GPIO_WritePin(rs->port_txe, rs->init_txe.Pin, rs->on_txe);
+  rs->tx_start_usec = Device_Usec_Now();
+  __HAL_UART_CLEAR_FLAG(rs->handle, UART_FLAG_TC);
+  (void)HAL_DMA_Start(rs->hdma_tx, (uint32_t)rs->dma_buf, (uint32_t)&rs->handle->Instance->DR, count);
+  SET_BIT(rs->handle->Instance->CR3, USART_CR3_DMAT);
+  __HAL_UART_ENABLE_IT(rs->handle, UART_IT_TC);
+  rs->dma_frames++;
+  return True;
+}
+
+/** \brief  rs의 송신이 모두 끝났는지 확인한다.
+  * \param  rs - RS485 구조체 포인터
+  * \retval DMA, 송신 버퍼, 마지막 byte shift가 모두 끝났으면 True
+  */
+Bool_t Rs485_Is_Tx_Idle(Rs485_t * rs)
+{
+  if ((rs->dma_busy == True) || (rs->tx_ing == True) ||
+      (__HAL_UART_GET_FLAG(rs->handle, UART_FLAG_TC) == RESET))
+  {
+    return False;
+  }
+  return True;
+}
+
+/** \brief  rs의 통신 속도를 바꾼다.
+  * \param  rs - RS485 구조체 포인터
+  * \param  baud - 새 통신 속도[bps]
+  * \note   송신 중(DMA, 송신 버퍼, 마지막 byte shift 중)이면 바꾸지 않는다.
+  *         UART를 잠시 끄고 BRR만 다시 쓰므로 인터럽트 설정과 버퍼는 그대로 유지된다.
+  * \retval 바꿨으면 True, 송신 중이면 False(나중에 다시 호출)
+  */
+Bool_t Rs485_Set_Baud(Rs485_t * rs, uint32_t baud)
+{
+  uint32_t  pclk;
+
+  if (Rs485_Is_Tx_Idle(rs) == False)
+  {
+    return False;
+  }
+  if ((rs->handle->Instance == USART1) || (rs->handle->Instance == USART6))
+  {
+    pclk = HAL_RCC_GetPCLK2Freq();
+  }
+  else
+  {
+    pclk = HAL_RCC_GetPCLK1Freq();
+  }
+  __HAL_UART_DISABLE(rs->handle);
+  rs->handle->Init.BaudRate = baud;
+  if (rs->handle->Init.OverSampling == UART_OVERSAMPLING_8)
+  {
+    rs->handle->Instance->BRR = UART_BRR_SAMPLING8(pclk, baud);
+  }
+  else
+  {
+    rs->handle->Instance->BRR = UART_BRR_SAMPLING16(pclk, baud);
+  }
+  __HAL_UART_ENABLE(rs->handle);
+  return True;
+}
+
 /** \brief  RS485 Driver를 통해 byte를 rs로 전송한다.
   * \param  rs - RS485 구조체 포인터
   * \param  byte - 송신할 1byte의 데이터
@@ -264,9 +466,15 @@ void Rs485_IRQHandler_TXE(Rs485_t * rs)
 */
 void Rs485_IRQHandler_TC(Rs485_t * rs)
 {
+  if (rs->dma_busy == True)
+  {
+    Rs485_Dma_Complete(rs);
+    return;
+  }
   if (rs->tx_count_out == rs->tx_count_in)
   {
     HAL_GPIO_WritePin(rs->port_txe, rs->init_txe.Pin, rs->off_txe);
+    __HAL_UART_DISABLE_IT(rs->handle, UART_IT_TC);        /* TC 플래그는 다음 송신까지 서 있음 */
 //    Led_Off(dbg02_led);
   }
 }
@@ -274,6 +482,62 @@ void Rs485_IRQHandler_TC(Rs485_t * rs)
 
 /* Private functions ---------------------------------------------------------*/
 
+/** \brief  rs의 송신 DMA를 초기화한다.
+  * \param  rs - RS485 구조체 포인터
+  * \note   hdma_tx의 Instance(Stream)와 Init.Channel은 디바이스 정의에서 정하고,
+  *         전송 형식(memory -> DR, byte, normal)은 여기서 정한다. DMA 인터럽트는 쓰지 않는다.
+  * \retval 없음
+  */
+static void Rs485_Dma_Init(Rs485_t * rs)
+{
+  DMA_HandleTypeDef * hdma = rs->hdma_tx;
+
+  if (hdma == NULL)
+  {
+    return;
+  }
+  __HAL_RCC_DMA2_CLK_ENABLE();                            /* USART1/6 TX는 DMA2 */
+  hdma->Init.Direction           = DMA_MEMORY_TO_PERIPH;
+  hdma->Init.PeriphInc           = DMA_PINC_DISABLE;
+  hdma->Init.MemInc              = DMA_MINC_ENABLE;
+  hdma->Init.PeriphDataAlignment = DMA_PDATAALIGN_BYTE;
+  hdma->Init.MemDataAlignment    = DMA_MDATAALIGN_BYTE;
+  hdma->Init.Mode                = DMA_NORMAL;
+  hdma->Init.Priority            = DMA_PRIORITY_MEDIUM;
+  hdma->Init.FIFOMode            = DMA_FIFOMODE_DISABLE;
+  if (HAL_DMA_Init(hdma) != HAL_OK)
+  {
+    rs->hdma_tx = NULL;                                    /* TXE 인터럽트 송신으로 동작 */
+    return;
+  }
+  __HAL_LINKDMA(rs->handle, hdmatx, *hdma);
+  rs->dma_busy = False;
+}
+
+/** \brief  DMA frame 송신 완료(UART TC)를 처리한다.
+  * \param  rs - RS485 구조체 포인터
+  * \note   TC는 마지막 byte의 stop bit까지 나간 뒤에 서므로 여기서 바로 TXE(DE)를 끈다.
+  *         송신 시작부터 계산한 frame 끝 시각과 DE 해제 시각의 차이를 turnaround로 기록한다.
+  * \retval 없음
+  */
+static void Rs485_Dma_Complete(Rs485_t * rs)
+{
+  uint32_t  elapsed;
+
+  HAL_GPIO_WritePin(rs->port_txe, rs->init_txe.Pin, rs->off_txe);
+  elapsed = Device_Usec_Now() - rs->tx_start_usec;
+  __HAL_UART_DISABLE_IT(rs->handle, UART_IT_TC);
+  CLEAR_BIT(rs->handle->Instance->CR3, USART_CR3_DMAT);
+  (void)HAL_DMA_Abort(rs->hdma_tx);                        /* 완료된 stream을 READY로 되돌림 */
+
+  rs->turn_usec = (elapsed > rs->tx_frame_usec) ? (elapsed - rs->tx_frame_usec) : 0U;
+  if (rs->turn_usec > rs->turn_max_usec)
+  {
+    rs->turn_max_usec = rs->turn_usec;
+  }
+  rs->dma_busy = False;
+}
+
 /** \} RS485_Driver */
 
 /** \} Drivers */
@@ -58,12 +58,24 @@ typedef struct
   uint32_t            rx_count;           /**< RS485 Receiving Buffer Count */
   uint32_t            rx_tick;            /**< RS485 Receiving Complete Tick */
   Bool_t              rx_complete;        /**< RS485 Flag for Receiving Complete */
+  Bool_t              rx_idle;            /**< True면 USART IDLE line(1 문자 시간 무수신)으로 수신 완료, rx_tick 미사용 */
   uint8_t            *printf_buf;         /**< RS485 Buffer for Printf() */
   uint32_t            printf_size;        /**< RS485 Printf-Buffer Size */
   Bool_t              usingIRQ;           /**< RS485 Flag of Using IRQ */
   IRQn_Type           irqn;               /**< RS485 IRQn */
   uint32_t            irq_priority;       /**< RS485 IRQ Priority */
   UART_HandleTypeDef *handle;             /**< RS485 UART Handle Structure Pointer */
+  void              (*rx_hook)(uint8_t byte); /**< RXNE 인터럽트에서 수신 byte마다 호출, NULL이면 호출 안함 */
+  DMA_HandleTypeDef  *hdma_tx;            /**< 송신 DMA Handle(Instance, Init.Channel 지정), NULL이면 TXE 인터럽트 송신 */
+  uint8_t            *dma_buf;            /**< DMA 송신 frame 버퍼 */
+  uint32_t            dma_size;           /**< DMA 송신 frame 버퍼 크기 */
+  volatile Bool_t     dma_busy;           /**< DMA frame 송신 중(TC까지) */
+  uint32_t            dma_frames;         /**< DMA로 보낸 frame 수 */
+  uint32_t            dma_drop;           /**< 송신 중이거나 길어서 못 보낸 frame 수 */
+  uint32_t            tx_start_usec;      /**< DMA frame 송신 시작 시각 */
+  uint32_t            tx_frame_usec;      /**< 그 frame의 선로 송신 시간 */
+  uint32_t            turn_usec;          /**< 마지막 stop bit 끝에서 TXE(DE) 해제까지, 마지막 값 */
+  uint32_t            turn_max_usec;      /**< turn_usec 최대값 */
 }Rs485_t;
 /** \} RS485_Driver_Exported_Types */
 
@@ -80,8 +92,14 @@ void Rs485_IRQHandler_RXNE(Rs485_t * rs);
 void Rs485_Set_Receive_Tick(Rs485_t * rs, uint32_t tick);
 void Rs485_CountDown_Receive_Tick(Rs485_t * rs);
 void Rs485_Receive_TimeOut(Rs485_t * rs);
+void Rs485_IRQHandler_IDLE(Rs485_t * rs);
 void Rs485_Restore_rx(Rs485_t * rs);
+void Rs485_Release_rx(Rs485_t * rs, uint32_t count);
 void Rs485_Transmit_Data(Rs485_t * rs, uint8_t data[], uint32_t count);
+Bool_t Rs485_Transmit_Data_Isr(Rs485_t * rs, const uint8_t data[], uint32_t count);
+Bool_t Rs485_Transmit_Dma(Rs485_t * rs, const uint8_t data[], uint32_t count);
+Bool_t Rs485_Is_Tx_Idle(Rs485_t * rs);
+Bool_t Rs485_Set_Baud(Rs485_t * rs, uint32_t baud);
 void Rs485_Send_Byte(Rs485_t * rs, uint8_t byte);
 void Rs485_IRQHandler_TXE(Rs485_t * rs);
 void Rs485_IRQHandler_TC(Rs485_t * rs);
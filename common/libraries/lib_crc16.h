@@ -0,0 +1,74 @@
+/** ****************************************************************************
+  * \file    lib_crc16.h
+  * \author  Jang Ho Jong
+  * \version V0.0.1
+  * \date    2026.10.17
+  * \brief   CRC16(KRS) Library Header
+  * ***************************************************************************/
+/*
+  - CRC16 라이브러리
+
+  - 개념:
+    한국철도표준규격 KRS SG 0062 CRC16 (Poly X16+X15+X2+1 : 0x8005, 초기값 0, MSB 우선, 최종 XOR 없음).
+    "123456789"의 CRC는 0xFEE8 이다.
+
+  - 동작:
+    Crc16_Krs_Update()는 CRC16_KRS_SLICE(1, 4, 8) byte씩 묶어 계산한다(slice-by-N).
+    byte 단위 table(256 entry) 외에 slice 수만큼 table이 더 필요하다(table당 512 byte Flash).
+    STM32F4의 CRC 주변장치는 CRC32 고정이므로 사용하지 않는다.
+    Crc16_Krs_Byte()/Update()는 이전 CRC를 이어받으므로 byte가 들어오는 대로 누적 계산할 수 있다.
+
+  - 고장:
+    Crc16_Krs_Self_Test()로 표준 check 값과 byte 단위 구현과의 일치를 확인한다.
+
+  - 모니터링:
+    콘솔 "CRC [len]" 명령어로 자기시험과 byte 단위/slice 구현의 cycle을 비교한다.
+
+  - Crc16 접두어를 사용한다.
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef __LIB_CRC16_H
+#define __LIB_CRC16_H
+
+/* Includes ------------------------------------------------------------------*/
+#include "typedef.h"
+
+/** \addtogroup Libraries
+  * \{ */
+
+/** \addtogroup Lib_Crc16
+  * \{ */
+
+/* Exported types ------------------------------------------------------------*/
+/** \brief benchmark 용 clock 함수(target : DWT cycle, host : 임의 clock) */
+typedef u32_t (*Crc16Clock_t)(void);
+
+/* Exported constants --------------------------------------------------------*/
+#ifndef CRC16_KRS_SLICE
+#define CRC16_KRS_SLICE         8                      /**< 1, 4, 8 */
+#endif
+#define CRC16_KRS_INIT          0x0000U
+#define CRC16_KRS_CHECK         0xFEE8U                /**< CRC("123456789") */
+
+/* Exported macro ------------------------------------------------------------*/
+/* Exported variables --------------------------------------------------------*/
+/* Exported functions --------------------------------------------------------*/
+/** \defgroup Lib_Crc16_Exported_Functions CRC16 라이브러리 공개 함수
+  * \{ */
+extern u16_t  Crc16_Krs(const u08_t buf[], u32_t len);
+extern u16_t  Crc16_Krs_Update(u16_t crc, const u08_t buf[], u32_t len);
+extern u16_t  Crc16_Krs_Byte(u16_t crc, u08_t data);
+extern u16_t  Crc16_Krs_Bytewise(const u08_t buf[], u32_t len);
+extern Bool_t Crc16_Krs_Self_Test(void);
+extern void   Crc16_Krs_Bench(const u08_t buf[], u32_t len, u32_t loops, Crc16Clock_t clock,
+                              u32_t * byte_clk, u32_t * slice_clk);
+/** \} Lib_Crc16_Exported_Functions */
+
+/** \} Lib_Crc16 */
+
+/** \} Libraries */
+
+#endif /* __LIB_CRC16_H */
+
+/*************** (C) COPYRIGHT SHALOM ENGINEERING CO., LTD. ****END OF FILE****/
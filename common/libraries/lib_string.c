@@ -7,6 +7,7 @@
   * ***************************************************************************/
 /** \remark Version History
   * V0.0.1  - 최초 버전 - 2016.05.06
+  * V0.0.5  - String_Format(), String_Printf() 추가
 
 */
 /* Includes ------------------------------------------------------------------*/
@@ -21,7 +22,25 @@
   * \{ */
 
 /* Private typedef -----------------------------------------------------------*/
+/** \brief String_Format() 출력 상태 */
+typedef struct
+{
+char_t      *buf;
+u32_t        size;
+u32_t        len;                                      /**< buf에 들어 있는 글자 수 */
+u32_t        total;                                    /**< 만든 전체 글자 수 */
+StringPut_t  put;                                      /**< NULL이면 buf에서 자른다 */
+void        *ctx;
+}StrOut_t;
+
 /* Private define ------------------------------------------------------------*/
+#define FMT_LEFT                0x01U                  /* '-' 왼쪽 정렬 */
+#define FMT_ZERO                0x02U                  /* '0' 앞을 0으로 채움 */
+#define FMT_PLUS                0x04U                  /* '+' 양수에도 부호 */
+#define FMT_SPACE               0x08U                  /* ' ' 양수 부호 자리에 공백 */
+#define FMT_ALT                 0x10U                  /* '#' 16진수 앞에 0x */
+#define FMT_NUM_SIZE            24U                    /* 숫자 하나의 최대 글자 수(%q : 10 + '.' + 9) */
+
 /* Private macro -------------------------------------------------------------*/
 /* Private variables ---------------------------------------------------------*/
 #if 0
@@ -35,6 +54,12 @@ static void safestrrev(char_t buffer[], const u32_t bufferSize, const u32_t strl
 static u32_t negateBuffer(char_t buf[], const u32_t buf_size, const u32_t strlen, const u32_t radix);
 static int32_t twosNegation(const int32_t x, const u32_t radix);
 #endif
+static void  Fmt_Put(StrOut_t * out, char_t ch);
+static void  Fmt_Pad(StrOut_t * out, char_t ch, u32_t count);
+static void  Fmt_Field(StrOut_t * out, const char_t prefix[], const char_t body[], u32_t body_len, u32_t zeros, u32_t width, u08_t flags);
+static u32_t Fmt_Digits(char_t str[], u32_t value, u32_t base, Bool_t upper);
+static void  Fmt_Integer(StrOut_t * out, const char_t prefix[], u32_t value, u32_t base, Bool_t upper,
+                         u32_t width, u32_t prec, Bool_t has_prec, u08_t flags);
 
 /* Exported functions --------------------------------------------------------*/
 /** \addtogroup Lib_String_Exported_Functions
@@ -513,7 +538,7 @@ uint32_t Char_Compare_woCase(char_t ch1, char_t ch2)
   * \retval ret - 모든 문자열이 대소문자 구별없이 일치하면 SAME, 
             불일치하면 0이 아닌 값을 반환한다.
   */
-uint32_t String_Compare_woCase(char_t str1[], char_t str2[])
+uint32_t String_Compare_woCase(const char_t str1[], const char_t str2[])
 {
   u32_t  i = 0U;
   uint32_t   ret = 0U;
@@ -605,7 +630,417 @@ u32_t String_Get_Length(const char_t str[])
   return (u32_t)i;
 }
 
+/** \brief  format대로 만든 문자열을 buf에 쓴다. vsprintf 대신 쓰는 정수 전용 formatter이다.
+  * \param  buf    - 출력 버퍼
+  * \param  size   - buf 크기(byte)
+  * \param  put    - NULL이면 buf에 넣고 넘치는 글자는 버리며 끝에 '\0'을 붙인다.
+  *                  NULL이 아니면 '\n'을 쓸 때와 buf가 찰 때마다 put(ctx, buf, 길이)로 내보내고
+  *                  buf를 다시 쓰므로 출력 길이에 제한이 없다('\0'은 붙이지 않는다).
+  * \param  ctx    - put에 넘길 값
+  * \param  format - 형식 문자열(지원 형식은 lib_string.h 설명 참조)
+  * \param  args   - 가변 인자
+  * \note   malloc, 실수 연산, 재귀가 없고 stack은 숫자 하나의 자리(FMT_NUM_SIZE)만 쓴다.
+  *         지원하지 않는 변환(%f 등)은 글자 그대로 내보내며 인자는 읽지 않는다.
+  * \retval 만든 전체 글자 수(put이 NULL이면 잘려서 버려진 글자도 센다, '\0' 제외)
+  */
+u32_t String_Format(char_t buf[], u32_t size, StringPut_t put, void * ctx, const char_t format[], va_list args)
+{
+  StrOut_t      out;
+  const char_t *p = format;
+  const char_t *s;
+  char_t        num[FMT_NUM_SIZE];
+  char_t        sign[3];
+  u32_t         width, prec, value, scale, frac, n, i;
+  i32_t         sval;
+  u08_t         flags, half;
+  Bool_t        has_prec;
+  char_t        conv;
+
+  if ((put != NULL) && ((buf == NULL) || (size == 0U)))
+  {
+    return 0U;
+  }
+  out.buf   = buf;
+  out.size  = size;
+  out.len   = 0U;
+  out.total = 0U;
+  out.put   = put;
+  out.ctx   = ctx;
+
+  while (*p != '\0')
+  {
+    if (*p != '%')
+    {
+      Fmt_Put(&out, *p);
+      p++;
+      continue;
+    }
+    p++;
+
+    /* flag */
+    flags = 0U;
+    while ((*p == '-') || (*p == '0') || (*p == '+') || (*p == ' ') || (*p == '#'))
+    {
+      if (*p == '-')      { flags |= FMT_LEFT;  }
+      else if (*p == '0') { flags |= FMT_ZERO;  }
+      else if (*p == '+') { flags |= FMT_PLUS;  }
+      else if (*p == ' ') { flags |= FMT_SPACE; }
+      else                { flags |= FMT_ALT;   }
+      p++;
+    }
+    /* 폭 */
+    width = 0U;
+    if (*p == '*')
+    {
+      sval = va_arg(args, i32_t);
+      if (sval < 0)
+      {
+        flags |= FMT_LEFT;
+        sval = -sval;
+      }
+      width = (u32_t)sval;
+      p++;
+    }
+    while ((*p >= '0') && (*p <= '9'))
+    {
+      width = (width * 10U) + (u32_t)(*p - '0');
+      p++;
+    }
+    /* 정밀도 */
+    prec = 0U;
+    has_prec = False;
+    if (*p == '.')
+    {
+      has_prec = True;
+      p++;
+      if (*p == '*')
+      {
+        sval = va_arg(args, i32_t);
+        if (sval < 0)
+        {
+          has_prec = False;
+        }
+        else
+        {
+          prec = (u32_t)sval;
+        }
+        p++;
+      }
+      while ((*p >= '0') && (*p <= '9'))
+      {
+        prec = (prec * 10U) + (u32_t)(*p - '0');
+        p++;
+      }
+    }
+    /* 길이 : 32bit이므로 l은 int와 같고, h/hh는 short/char로 자른다 */
+    half = 0U;
+    while ((*p == 'l') || (*p == 'h'))
+    {
+      if (*p == 'h')
+      {
+        half++;
+      }
+      p++;
+    }
+
+    conv = *p;
+    if (conv == '\0')
+    {
+      break;
+    }
+    p++;
+    sign[0] = '\0';
+    switch (conv)
+    {
+      case 'd':
+      case 'i':
+      case 'q':
+        sval = va_arg(args, i32_t);
+        if (half == 1U)
+        {
+          sval = (i16_t)sval;
+        }
+        else if (half >= 2U)
+        {
+          sval = (i08_t)sval;
+        }
+        else
+        {
+          /* 32bit 그대로 */
+        }
+        value = (sval < 0) ? (0U - (u32_t)sval) : (u32_t)sval;
+        sign[0] = (sval < 0) ? '-' : (((flags & FMT_PLUS) != 0U) ? '+' : (((flags & FMT_SPACE) != 0U) ? ' ' : '\0'));
+        sign[1] = '\0';
+        if (conv != 'q')
+        {
+          Fmt_Integer(&out, sign, value, 10U, False, width, prec, has_prec, flags);
+          break;
+        }
+        /* 고정소수점 : value / 10^prec */
+        if (prec > STRING_FMT_Q_PREC_MAX)
+        {
+          prec = STRING_FMT_Q_PREC_MAX;
+        }
+        scale = 1U;
+        for (i = 0U; i < prec; i++)
+        {
+          scale *= 10U;
+        }
+        n = Fmt_Digits(num, value / scale, 10U, False);
+        if (prec != 0U)
+        {
+          num[n] = '.';
+          n++;
+          frac = value % scale;
+          for (i = prec; i > 0U; i--)
+          {
+            num[n + i - 1U] = (char_t)('0' + (frac % 10U));
+            frac /= 10U;
+          }
+          n += prec;
+        }
+        Fmt_Field(&out, sign, num, n, 0U, width, flags);
+        break;
+
+      case 'u':
+      case 'x':
+      case 'X':
+        value = va_arg(args, u32_t);
+        if (half == 1U)
+        {
+          value &= 0xFFFFU;
+        }
+        else if (half >= 2U)
+        {
+          value &= 0xFFU;
+        }
+        else
+        {
+          /* 32bit 그대로 */
+        }
+        if ((conv != 'u') && ((flags & FMT_ALT) != 0U) && (value != 0U))
+        {
+          sign[0] = '0';
+          sign[1] = conv;
+          sign[2] = '\0';
+        }
+        Fmt_Integer(&out, sign, value, (conv == 'u') ? 10U : 16U, (conv == 'X') ? True : False, width, prec, has_prec, flags);
+        break;
+
+      case 'p':
+        value = (u32_t)va_arg(args, void *);
+        sign[0] = '0';
+        sign[1] = 'x';
+        sign[2] = '\0';
+        Fmt_Integer(&out, sign, value, 16U, False, width, 8U, True, flags);
+        break;
+
+      case 'c':
+        num[0] = (char_t)va_arg(args, i32_t);
+        Fmt_Field(&out, sign, num, 1U, 0U, width, flags & (u08_t)~FMT_ZERO);
+        break;
+
+      case 's':
+        s = va_arg(args, const char_t *);
+        if (s == NULL)
+        {
+          s = "(null)";
+        }
+        n = 0U;
+        while ((s[n] != '\0') && ((has_prec == False) || (n < prec)))
+        {
+          n++;
+        }
+        Fmt_Field(&out, sign, s, n, 0U, width, flags & (u08_t)~FMT_ZERO);
+        break;
+
+      case '%':
+        Fmt_Put(&out, '%');
+        break;
+
+      default:
+        Fmt_Put(&out, '%');
+        Fmt_Put(&out, conv);
+        break;
+    }
+  }
+
+  if (put != NULL)
+  {
+    if (out.len != 0U)
+    {
+      put(ctx, buf, out.len);
+    }
+  }
+  else if (size != 0U)
+  {
+    buf[out.len] = '\0';
+  }
+  else
+  {
+    /* 글자 수만 센다 */
+  }
+  return out.total;
+}
+
+/** \brief  snprintf처럼 format대로 만든 문자열을 buf에 쓴다.
+  * \param  buf    - 출력 버퍼, 항상 '\0'으로 끝난다(size가 0이면 쓰지 않음)
+  * \param  size   - buf 크기(byte)
+  * \param  format - 형식 문자열
+  * \retval 만든 전체 글자 수(size 이상이면 잘렸음)
+  */
+u32_t String_Printf(char_t buf[], u32_t size, const char_t format[], ...)
+{
+  va_list args;
+  u32_t   total;
+
+  va_start(args, format);
+  total = String_Format(buf, size, NULL, NULL, format, args);
+  va_end(args);
+  return total;
+}
+
+/** \} Lib_String_Exported_Functions */
+
+/* Private functions ---------------------------------------------------------*/
+/** \addtogroup Lib_String_Private_Functions
+  * \{ */
+
+/** \brief  한 글자를 출력한다.
+  * \note   put이 있으면 '\n'이나 buf가 찰 때 내보내고, 없으면 '\0' 자리를 남기고 나머지는 버린다.
+  * \retval 없음
+  */
+static void Fmt_Put(StrOut_t * out, char_t ch)
+{
+  out->total++;
+  if (out->put != NULL)
+  {
+    out->buf[out->len] = ch;
+    out->len++;
+    if ((ch == '\n') || (out->len >= out->size))
+    {
+      out->put(out->ctx, out->buf, out->len);
+      out->len = 0U;
+    }
+  }
+  else if ((out->len + 1U) < out->size)
+  {
+    out->buf[out->len] = ch;
+    out->len++;
+  }
+  else
+  {
+    /* 넘치는 글자는 버린다 */
+  }
+}
+
+/** \brief  ch를 count번 출력한다.
+  * \retval 없음
+  */
+static void Fmt_Pad(StrOut_t * out, char_t ch, u32_t count)
+{
+  while (count != 0U)
+  {
+    Fmt_Put(out, ch);
+    count--;
+  }
+}
+
+/** \brief  prefix(부호, 0x), 앞의 0, body 순서로 폭에 맞춰 출력한다.
+  * \param  zeros - body 앞에 붙일 0의 수(정수 정밀도)
+  * \note   FMT_LEFT면 뒤를 공백으로, FMT_ZERO면 prefix 뒤를 0으로, 아니면 앞을 공백으로 채운다.
+  * \retval 없음
+  */
+static void Fmt_Field(StrOut_t * out, const char_t prefix[], const char_t body[], u32_t body_len, u32_t zeros, u32_t width, u08_t flags)
+{
+  u32_t pre_len = 0U;
+  u32_t pad = 0U;
+  u32_t i;
+
+  while (prefix[pre_len] != '\0')
+  {
+    pre_len++;
+  }
+  if (width > (pre_len + zeros + body_len))
+  {
+    pad = width - (pre_len + zeros + body_len);
+  }
+  if ((flags & FMT_LEFT) == 0U)
+  {
+    if ((flags & FMT_ZERO) != 0U)
+    {
+      zeros += pad;
+    }
+    else
+    {
+      Fmt_Pad(out, ' ', pad);
+    }
+    pad = 0U;
+  }
+  for (i = 0U; i < pre_len; i++)
+  {
+    Fmt_Put(out, prefix[i]);
+  }
+  Fmt_Pad(out, '0', zeros);
+  for (i = 0U; i < body_len; i++)
+  {
+    Fmt_Put(out, body[i]);
+  }
+  Fmt_Pad(out, ' ', pad);
+}
+
+/** \brief  value를 base 진수 숫자열로 str에 쓴다('\0' 없음).
+  * \retval 숫자 수(1 ~ 10)
+  */
+static u32_t Fmt_Digits(char_t str[], u32_t value, u32_t base, Bool_t upper)
+{
+  static const char_t lower_digit[] = "0123456789abcdef";
+  static const char_t upper_digit[] = "0123456789ABCDEF";
+  const char_t *digit = (upper == True) ? upper_digit : lower_digit;
+  char_t        tmp[10];
+  u32_t         n = 0U;
+  u32_t         i;
+
+  do
+  {
+    tmp[n] = digit[value % base];
+    n++;
+    value /= base;
+  } while (value != 0U);
+  for (i = 0U; i < n; i++)
+  {
+    str[i] = tmp[n - 1U - i];
+  }
+  return n;
+}
+
+/** \brief  부호 없는 정수를 정밀도(최소 자릿수)와 폭에 맞춰 출력한다.
+  * \note   정밀도가 있으면 '0' flag는 무시하고, 정밀도 0에 값 0이면 숫자를 쓰지 않는다(C 표준과 같음).
+  * \retval 없음
+  */
+static void Fmt_Integer(StrOut_t * out, const char_t prefix[], u32_t value, u32_t base, Bool_t upper,
+                        u32_t width, u32_t prec, Bool_t has_prec, u08_t flags)
+{
+  char_t num[FMT_NUM_SIZE];
+  u32_t  n = 0U;
+  u32_t  zeros = 0U;
+
+  if ((has_prec == False) || (prec != 0U) || (value != 0U))
+  {
+    n = Fmt_Digits(num, value, base, upper);
+  }
+  if (has_prec == True)
+  {
+    flags &= (u08_t)~FMT_ZERO;
+    if (prec > n)
+    {
+      zeros = prec - n;
+    }
+  }
+  Fmt_Field(out, prefix, num, n, zeros, width, flags);
+}
 
+/** \} Lib_String_Private_Functions */
 
 /** \} Lib_String */
 
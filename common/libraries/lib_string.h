@@ -11,6 +11,8 @@
   * V0.0.3  - String_Convert_IntegerToString() 함수에 digit, firstzero 인자 추가
   * V0.0.4  - 2019.02.18 
               Char_Compare_woCase() 함수에서 알파벳만 대소 구별없이 비교하도록 보완
+  * V0.0.5  - String_Format(), String_Printf() 함수 추가(vsprintf 대체 정수 전용 formatter)
+  * V0.0.6  - String_Compare_woCase() 인자를 const로 변경(상수 문자열 표와 비교할 때 경고 제거)
 */
 /*
   - String 라이브러리
@@ -27,6 +29,11 @@
   - String 접두어를 사용한다.
 
   - 사용법
+    String_Format()/String_Printf()는 C library의 vsprintf 대신 쓰는 작은 formatter이다.
+    %d %i %u %x %X %c %s %p %% 와 flag(- 0 + 공백 #), 폭, 정밀도, *, 길이 h hh l을 지원한다.
+    실수(%f %e %g)와 64bit(%ll)는 지원하지 않는다. 고정소수점은 %q로 출력한다 :
+    정수 값을 10^정밀도로 나눈 소수로 보여 준다. 예) String_Printf(buf, size, "%.2q", -1234) -> "-12.34"
+    출력은 항상 buf 크기 안에서 끝나며, 숫자 하나에 쓰는 stack과 시간은 자릿수(최대 10자리)로 정해진다.
   */
 
 /* Define to prevent recursive inclusion -------------------------------------*/
@@ -35,6 +42,7 @@
 
 /* Includes ------------------------------------------------------------------*/
 #include "typedef.h"
+#include <stdarg.h>
 
 /** \addtogroup Libraries
   * \{ */
@@ -43,6 +51,9 @@
   * \{ */
 
 /* Exported types ------------------------------------------------------------*/
+/** \brief String_Format()이 채운 buf를 내보내는 함수, ctx는 String_Format()에 넘긴 값 */
+typedef void (*StringPut_t)(void * ctx, const char_t str[], u32_t len);
+
 /* Exported constants --------------------------------------------------------*/
 /** \defgroup Lib_String_Exported_Constants String 라이브러리 공개 상수
   * \{ */
@@ -54,6 +65,8 @@
 //};
 #define		SAME		0U
 #define   DIFF    1U
+
+#define STRING_FMT_Q_PREC_MAX   9U                     /**< %q 소수점 아래 최대 자릿수 */
 /** \} Lib_String_Exported_Constants */
 
 /* Exported macro ------------------------------------------------------------*/
@@ -74,9 +87,11 @@ Bool_t String_Convert_StringToHex(char_t str[], uint32_t *hex);
 char_t* String_Extract_Word(char_t str[], char_t* next[], char_t separator);
 uint32_t String_Compare(char_t str1[], char_t str2[]);
 uint32_t Char_Compare_woCase(char_t ch1, char_t ch2);
-uint32_t String_Compare_woCase(char_t str1[], char_t str2[]);
+uint32_t String_Compare_woCase(const char_t str1[], const char_t str2[]);
 uint32_t String_Compare_woCase_wLength(char_t str1[], const char_t str2[], uint32_t length);
 uint32_t String_Get_Length(const char_t str[]);
+u32_t String_Format(char_t buf[], u32_t size, StringPut_t put, void * ctx, const char_t format[], va_list args);
+u32_t String_Printf(char_t buf[], u32_t size, const char_t format[], ...);
 
 /** \} Lib_String_Exported_Functions */
 
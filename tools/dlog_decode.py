@@ -0,0 +1,231 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+"""
+dlog_decode.py - DEOD 지연 binary 로그(dlog) 복원 도구
+
+  사용법:
+    dlog_decode.py FIRMWARE.axf CAPTURE [--text]
+
+    FIRMWARE.axf : 로그를 보낸 보드와 같은 빌드의 .axf(ELF32)
+    CAPTURE      : 콘솔 UART에서 받은 raw byte 파일, '-'면 표준입력(실시간)
+    --text       : frame 사이의 콘솔 글자도 함께 출력한다.
+
+  예) stty -F /dev/ttyUSB0 115200 raw -echo
+      cat /dev/ttyUSB0 | tools/dlog_decode.py "Objects/DEOD.axf" -
+
+  형식 문자열 ID는 Flash의 형식 문자열 주소이므로 .axf에서 그 주소의 문자열을 읽어
+  printf 형식(%d %i %u %x %X %c %s %p, flag/폭/정밀도)과 고정소수점 %q(String_Format)대로 복원한다.
+  %s 인자도 Flash 상수 문자열 주소로 보고 .axf에서 찾는다.
+  frame 형식은 Sources/Applications/dlog.h 를 본다.
+"""
+
+import os
+import re
+import struct
+import sys
+
+FRAME_VER = 0x01
+FRAME_HEAD = 12
+FRAME_WORDS_MAX = 64
+ANCHOR = "DLOG ANCHOR V1"
+ADDR_MASK = 0x0FFFFFFF
+ARGC_SHIFT = 28
+
+_SPEC = re.compile(r"%([-+ #0]*)(\d*)(?:\.(\d+))?(?:hh|h|ll|l)?([diuxXcspq%])")
+
+
+def crc16_krs(data):
+    """KRS SG 0062 CRC16 : poly 0x8005, 초기값 0, MSB 우선, 최종 XOR 없음(lib_crc16.c와 같음)."""
+    crc = 0
+    for b in data:
+        crc ^= b << 8
+        for _ in range(8):
+            crc = ((crc << 1) ^ 0x8005) if (crc & 0x8000) else (crc << 1)
+            crc &= 0xFFFF
+    return crc
+
+
+class Elf32(object):
+    """ELF little endian의 적재(ALLOC) section에서 주소로 byte를 읽는다.
+
+    target .axf는 ELF32이다. host 시험(tools/host_test/test_dlog.c)이 자기 실행 파일을 넘기므로
+    ELF64도 읽는다.
+    """
+
+    def __init__(self, path):
+        with open(path, "rb") as f:
+            self.data = f.read()
+        d = self.data
+        if d[:4] != b"\x7fELF" or d[4] not in (1, 2) or d[5] != 1:
+            raise ValueError("%s : ELF little endian 파일이 아님" % path)
+        if d[4] == 1:
+            shoff, = struct.unpack_from("<I", d, 0x20)
+            shentsize, shnum = struct.unpack_from("<HH", d, 0x2E)
+            shfmt = "<IIIIII"
+        else:
+            shoff, = struct.unpack_from("<Q", d, 0x28)
+            shentsize, shnum = struct.unpack_from("<HH", d, 0x3A)
+            shfmt = "<IIQQQQ"
+        self.sections = []
+        for i in range(shnum):
+            _, sh_type, sh_flags, sh_addr, sh_offset, sh_size = struct.unpack_from(
+                shfmt, d, shoff + i * shentsize)
+            if sh_type == 1 and (sh_flags & 0x2) and sh_size > 0:      # PROGBITS, ALLOC
+                self.sections.append((sh_addr, sh_offset, sh_size))
+
+    def cstr(self, addr):
+        for sh_addr, sh_offset, sh_size in self.sections:
+            if sh_addr <= addr < sh_addr + sh_size:
+                start = sh_offset + (addr - sh_addr)
+                end = self.data.find(b"\0", start, sh_offset + sh_size)
+                if end < 0:
+                    return None
+                return self.data[start:end].decode("utf-8", "replace")
+        return None
+
+
+def cformat(elf, fmt, args):
+    """C printf 형식을 u32 인자로 복원한다."""
+    out = []
+    pos = 0
+    it = iter(args)
+    for m in _SPEC.finditer(fmt):
+        out.append(fmt[pos:m.start()])
+        pos = m.end()
+        flags, width, prec, conv = m.groups()
+        if conv == "%":
+            out.append("%")
+            continue
+        v = next(it, 0)
+        if conv in "di":
+            v = v - (1 << 32) if v & 0x80000000 else v
+            spec = "d"
+        elif conv == "u":
+            spec = "d"
+        elif conv in "xX":
+            spec = conv
+        elif conv == "c":
+            v = chr(v & 0xFF)
+            spec = "s"
+        elif conv == "q":
+            v = v - (1 << 32) if v & 0x80000000 else v
+            n = min(int(prec or 0), 9)
+            v = ("-" if v < 0 else "") + ("%d.%0*d" % (abs(v) // 10 ** n, n, abs(v) % 10 ** n) if n else "%d" % abs(v))
+            prec = None
+            spec = "s"
+        elif conv == "s":
+            s = elf.cstr(v)
+            v = s if s is not None else "<0x%08X>" % v
+            spec = "s"
+        else:                                                          # p
+            v = "0x%08x" % v
+            spec = "s"
+        out.append(("%" + flags + width + ("." + prec if prec else "") + spec) % v)
+    out.append(fmt[pos:])
+    return "".join(out)
+
+
+class Decoder(object):
+    def __init__(self, elf, text, write):
+        self.elf = elf
+        self.text = text
+        self.write = write
+        self.buf = bytearray()
+        self.drops = None
+        self.anchor_checked = False
+        self.frames = 0
+        self.bad = 0
+
+    def feed(self, data, eof=False):
+        self.buf += data
+        while True:
+            pos = self.buf.find(b"DL")
+            if pos < 0:
+                keep = 1 if (self.buf[-1:] == b"D" and not eof) else 0
+                self._text(self.buf[:len(self.buf) - keep])
+                del self.buf[:len(self.buf) - keep]
+                return
+            self._text(self.buf[:pos])
+            del self.buf[:pos]
+            if len(self.buf) < FRAME_HEAD:
+                if eof:
+                    self._text(self.buf)
+                    del self.buf[:]
+                return
+            words = self.buf[3]
+            size = FRAME_HEAD + words * 4 + 2
+            if self.buf[2] != FRAME_VER or words == 0 or words > FRAME_WORDS_MAX:
+                self._text(self.buf[:1])
+                del self.buf[:1]
+                continue
+            if len(self.buf) < size:
+                if eof:
+                    self._text(self.buf)
+                    del self.buf[:]
+                return
+            frame = bytes(self.buf[:size])
+            crc, = struct.unpack_from("<H", frame, size - 2)
+            if crc16_krs(frame[:size - 2]) != crc:
+                self.bad += 1
+                self._text(self.buf[:1])
+                del self.buf[:1]
+                continue
+            del self.buf[:size]
+            self._frame(frame, words)
+
+    def _text(self, data):
+        if self.text and data:
+            self.write(bytes(data).decode("latin-1"), raw=True)
+
+    def _frame(self, frame, words):
+        anchor, drops = struct.unpack_from("<II", frame, 4)
+        if not self.anchor_checked:
+            self.anchor_checked = True
+            if self.elf.cstr(anchor) != ANCHOR:
+                sys.stderr.write("warning: .axf가 로그를 보낸 빌드와 다름(anchor 0x%08X)\n" % anchor)
+        if self.drops is not None and drops > self.drops:
+            self.write("--- %d record(s) dropped ---" % (drops - self.drops))
+        self.drops = drops
+        self.frames += 1
+        w = struct.unpack_from("<%dI" % words, frame, FRAME_HEAD)
+        i = 0
+        while i + 2 <= words:
+            hdr, ts = w[i], w[i + 1]
+            argc = hdr >> ARGC_SHIFT
+            args = w[i + 2:i + 2 + argc]
+            i += 2 + argc
+            fmt = self.elf.cstr(hdr & ADDR_MASK)
+            if fmt is None:
+                line = "<unknown fmt 0x%08X> %s" % (hdr & ADDR_MASK, " ".join("0x%08X" % a for a in args))
+            else:
+                line = cformat(self.elf, fmt, args).strip("\r\n")
+            self.write("[%11.6f] %s" % (ts / 1000000.0, line))
+
+
+def main(argv):
+    args = [a for a in argv[1:] if not a.startswith("--")]
+    if len(args) != 2:
+        sys.stderr.write(__doc__)
+        return 2
+    elf = Elf32(args[0])
+    out = sys.stdout
+
+    def write(s, raw=False):
+        out.write(s if raw else s + "\n")
+        out.flush()
+
+    dec = Decoder(elf, "--text" in argv, write)
+    fd = sys.stdin.fileno() if args[1] == "-" else os.open(args[1], os.O_RDONLY)
+    while True:
+        data = os.read(fd, 4096)
+        if not data:
+            break
+        dec.feed(data)
+    dec.feed(b"", eof=True)
+    if dec.bad:
+        sys.stderr.write("%d frame(s) with CRC error\n" % dec.bad)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main(sys.argv))
@@ -0,0 +1,31 @@
+/** ****************************************************************************
+  * \file    host_stub.c
+  * \author  Jang Ho Jong
+  * \version V0.0.1
+  * \date    2026.10.17
+  * \brief   Host 시험용 HAL/Device 대체 함수
+  * ***************************************************************************/
+/*
+  - 시험 대상 모듈이 부르는 시각, 인터럽트 함수를 host에서 대신한다.
+  - 시각은 시험이 g_host_tick, g_host_usec을 직접 바꿔서 진행시킨다.
+  - weak로 정의하므로 시험 파일에서 같은 함수를 다시 정의할 수 있다.
+  */
+
+#include "stm32f4xx_hal.h"
+#include "typedef.h"
+
+#define HT_WEAK __attribute__((weak))
+
+u32_t g_host_tick;
+u32_t g_host_usec;
+
+static u32_t host_primask;
+
+HT_WEAK uint32_t HAL_GetTick(void)           { return g_host_tick; }
+HT_WEAK u32_t    Device_Usec_Now(void)       { return g_host_usec; }
+HT_WEAK void     __disable_irq(void)         { host_primask = 1U; }
+HT_WEAK void     __enable_irq(void)          { host_primask = 0U; }
+HT_WEAK uint32_t __get_PRIMASK(void)         { return host_primask; }
+HT_WEAK void     __set_PRIMASK(uint32_t pm)  { host_primask = pm; }
+
+/*************** (C) COPYRIGHT SHALOM ENGINEERING CO., LTD. ****END OF FILE****/
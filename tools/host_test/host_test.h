@@ -0,0 +1,57 @@
+/** ****************************************************************************
+  * \file    host_test.h
+  * \author  Jang Ho Jong
+  * \version V0.0.1
+  * \date    2026.10.17
+  * \brief   Host 시험 공통 Header
+  * ***************************************************************************/
+/*
+  - PC gcc로 target 모듈을 그대로 빌드해 확인하는 시험의 공통 매크로.
+  - 시험 하나가 실행 파일 하나이며, 틀린 확인이 있으면 main()이 1을 돌려준다.
+  - 빌드/실행은 tools/host_test/run.sh 를 본다.
+  */
+
+#ifndef __HOST_TEST_H
+#define __HOST_TEST_H
+
+#include <stdio.h>
+#include "typedef.h"
+
+static u32_t ht_checks;                                /* 확인 수 */
+static u32_t ht_fails;                                 /* 틀린 확인 수 */
+
+/** \brief 조건 확인 */
+#define CHECK(c)                                                                \
+  do {                                                                          \
+    ht_checks++;                                                                \
+    if (!(c)) {                                                                 \
+      ht_fails++;                                                               \
+      printf("%s:%d: FAIL %s\n", __FILE__, __LINE__, #c);                     \
+    }                                                                           \
+  } while (0)
+
+/** \brief 정수 값 확인(틀리면 두 값을 출력) */
+#define CHECK_EQ(a, b)                                                          \
+  do {                                                                          \
+    unsigned long ht_a = (unsigned long)(a);                                    \
+    unsigned long ht_b = (unsigned long)(b);                                    \
+    ht_checks++;                                                                \
+    if (ht_a != ht_b) {                                                         \
+      ht_fails++;                                                               \
+      printf("%s:%d: FAIL %s == %s (%lu != %lu)\n",                             \
+             __FILE__, __LINE__, #a, #b, ht_a, ht_b);                          \
+    }                                                                           \
+  } while (0)
+
+/** \brief 결과 출력, main()의 반환값 */
+#define HT_RESULT(name)                                                         \
+  (printf("%-20s : %u checks, %u fail\n", (name), ht_checks, ht_fails),         \
+   (ht_fails == 0U) ? 0 : 1)
+
+/* host_stub.c : 시험에서 정하는 시각 */
+extern u32_t g_host_tick;                              /**< HAL_GetTick() 값(msec) */
+extern u32_t g_host_usec;                              /**< Device_Usec_Now() 값(usec) */
+
+#endif /* __HOST_TEST_H */
+
+/*************** (C) COPYRIGHT SHALOM ENGINEERING CO., LTD. ****END OF FILE****/
@@ -0,0 +1,32 @@
+/** ****************************************************************************
+  * \file    rs485_baud_slave.c
+  * \author  Jang Ho Jong
+  * \version V0.0.1
+  * \date    2026.10.17
+  * \brief   RS-485 baud 협상 host 시험용 슬레이브 쪽 rs485_baud
+  * ***************************************************************************/
+/*
+  - rs485_baud.c는 보드 하나의 상태(static)만 가지므로, 마스터와 슬레이브를 한 시험 안에서 같이 돌리려고
+    같은 소스를 함수 이름만 Slave_Baud_xxx로 바꿔 한번 더 빌드한다(상태도 따로 생긴다).
+  - test_rs485_baud.c가 마스터(원래 이름)와 함께 쓴다.
+  */
+
+#define Rs485_Baud_Init              Slave_Baud_Init
+#define Rs485_Baud_Rate              Slave_Baud_Rate
+#define Rs485_Baud_Code              Slave_Baud_Code
+#define Rs485_Baud_Current           Slave_Baud_Current
+#define Rs485_Baud_Set_Max           Slave_Baud_Set_Max
+#define Rs485_Baud_Need_Negotiation  Slave_Baud_Need_Negotiation
+#define Rs485_Baud_Neg_Start         Slave_Baud_Neg_Start
+#define Rs485_Baud_Neg_Ack           Slave_Baud_Neg_Ack
+#define Rs485_Baud_Neg_Result        Slave_Baud_Neg_Result
+#define Rs485_Baud_Commit            Slave_Baud_Commit
+#define Rs485_Baud_Accept            Slave_Baud_Accept
+#define Rs485_Baud_Check_Errors      Slave_Baud_Check_Errors
+#define Rs485_Baud_Rx_Ok             Slave_Baud_Rx_Ok
+#define Rs485_Baud_Is_Silent         Slave_Baud_Is_Silent
+#define Rs485_Baud_Get_Info          Slave_Baud_Get_Info
+
+#include "rs485_baud.c"
+
+/*************** (C) COPYRIGHT SHALOM ENGINEERING CO., LTD. ****END OF FILE****/
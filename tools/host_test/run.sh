@@ -0,0 +1,71 @@
+#!/bin/sh
+#
+# run.sh - DEOD host 시험
+#
+#   사용법:
+#     tools/host_test/run.sh [시험이름 ...]
+#
+#   target 소스(Sources/, common/)를 PC gcc로 그대로 빌드해 모듈 단위로 확인한다.
+#   HAL은 stub/ 의 형 정의로 대신하고, 시각/인터럽트 함수는 host_stub.c 가 대신한다.
+#   시험 이름을 주지 않으면 아래 TESTS의 시험을 모두 빌드하고 실행한다.
+#   시험 하나라도 실패하면 종료 코드가 1이다.
+#
+#   시험 추가 : test_xxx.c(또는 sim_xxx.c)를 만들고 TESTS에 "이름 : 대상 소스" 한 줄을 넣는다.
+#               대상 소스 자리에 -DXXX, -Wno-xxx 처럼 -로 시작하는 옵션을 쓰면 그 시험에만 적용된다.
+#               "test_xxx.변형" 이름은 같은 test_xxx.c를 다른 옵션으로 한번 더 빌드한다.
+#
+
+TESTS="
+test_rs485_frame : Sources/Applications/rs485_frame.c common/libraries/lib_crc16.c
+test_rs485_link  : Sources/Applications/rs485_link.c Sources/Applications/rs485_frame.c common/libraries/lib_crc16.c
+test_rs485_diag  : Sources/Applications/rs485_diag.c Sources/Applications/rs485_frame.c common/libraries/lib_crc16.c
+test_rs485_baud  : Sources/Applications/rs485_baud.c tools/host_test/rs485_baud_slave.c
+test_crc16.slice8 : common/libraries/lib_crc16.c
+test_crc16.slice4 : -DCRC16_KRS_SLICE=4 common/libraries/lib_crc16.c
+test_crc16.slice1 : -DCRC16_KRS_SLICE=1 common/libraries/lib_crc16.c
+test_string_format : -Wno-pointer-to-int-cast common/libraries/lib_string.c
+test_dlog        : -no-pie -Wno-pointer-to-int-cast Sources/Applications/dlog.c common/libraries/lib_crc16.c
+test_ossd_edge   : Sources/Applications/ossd_edge.c
+sim_deod_latency : -DLATENCY_HOST_CLOCK Sources/Applications/latency_probe.c common/libraries/lib_crc16.c
+sim_rs485_tdma   : Sources/Applications/rs485_tdma.c Sources/Applications/rs485_frame.c common/libraries/lib_crc16.c
+"
+
+HERE=$(cd "$(dirname "$0")" && pwd)
+ROOT=$(cd "$HERE/../.." && pwd)
+OUT=${HOST_TEST_OUT:-${TMPDIR:-/tmp}/deod_host_test}
+CC=${CC:-gcc}
+CFLAGS="-std=gnu99 -O1 -g -Wall -Wno-unused-function -Wno-multichar -DRTE_DEVICE_HAL_UART -D__CC_ARM"
+INC="-I$HERE -I$HERE/stub -I$ROOT/Sources -I$ROOT/Sources/Applications -I$ROOT/common/drivers \
+     -I$ROOT/common/libraries -I$ROOT/STM32_Safety_STL/Inc -I$ROOT/STM32_Safety_STL/Lib"
+
+mkdir -p "$OUT" || exit 1
+export HOST_TEST_ROOT="$ROOT" HOST_TEST_OUT="$OUT"           # 시험이 tools/ 도구와 출력 폴더를 찾을 때 씀
+rm -f "$OUT/.fail"
+echo "$TESTS" | while IFS=: read -r name srcs; do
+  name=$(echo $name)
+  [ -z "$name" ] && continue
+  if [ $# -ne 0 ]; then
+    case " $* " in *" $name "*) ;; *) continue ;; esac
+  fi
+  files=""
+  for s in $srcs; do
+    case $s in
+      -*) files="$files $s" ;;                        # 시험별 컴파일 옵션
+      *)  files="$files $ROOT/$s" ;;
+    esac
+  done
+  if ! $CC $CFLAGS $INC -o "$OUT/$name" "$HERE/${name%%.*}.c" "$HERE/host_stub.c" $files -lm; then
+    echo "$name : BUILD FAIL"
+    echo 1 > "$OUT/.fail"
+    continue
+  fi
+  if ! "$OUT/$name"; then
+    echo 1 > "$OUT/.fail"
+  fi
+done
+
+if [ -f "$OUT/.fail" ]; then
+  rm -f "$OUT/.fail"
+  exit 1
+fi
+exit 0
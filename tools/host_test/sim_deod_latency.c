@@ -0,0 +1,159 @@
+/** ****************************************************************************
+  * \file    sim_deod_latency.c
+  * \author  Jang Ho Jong
+  * \version V0.0.1
+  * \date    2026.10.17
+  * \brief   센서 동작 전류 감지 지연시간 host 모의 시험(주기 scan / Analog Watchdog)
+  * ***************************************************************************/
+/*
+  - 센서 전류가 동작 전류(cMIN_ACT_CUR)를 넘은 시각부터 Deod_Thread가 그 프레임을 읽을 때까지의
+    지연을 usec 단위 시간축으로 모의하고 latency_probe.c의 히스토그램으로 통계를 낸다.
+
+  - 모의 방식:
+    ADC1은 ADC_SCAN_PERIOD_usec마다 CH0~CH3을 차례로 변환하고, 프레임은 마지막 채널 변환 뒤 완료된다.
+    superloop 한 바퀴는 SIM_LOOP_MIN_usec ~ SIM_LOOP_MAX_usec 사이의 무작위 시간이 걸린다.
+    주기 scan  : g_DEOD_Check_timer(1msec SysTick)가 DEOD_SYS_CHECK_TIME이 된 loop에서 최근 프레임을 읽는다.
+    AWD 사용   : 넘은 값을 변환한 프레임이 완료된 뒤 첫 loop에서 읽는다(Device_ADC_Awd_Get_Event).
+                 주기 scan도 교차 확인으로 그대로 돈다.
+  */
+
+#include <stdlib.h>
+#include <string.h>
+#include "host_test.h"
+#include "latency_probe.h"
+#include "device.h"
+#include "deod_thread.h"
+#include "lib_crc16.h"
+
+#define SIM_EVENTS           5000U
+#define SIM_CH_CONV_usec     5U                        /* 채널 하나 변환 시간(sampling 포함) */
+#define SIM_FRAME_usec       (SIM_CH_CONV_usec * kNbrOfSIs)
+#define SIM_LOOP_MIN_usec    50U                       /* superloop 한 바퀴 */
+#define SIM_LOOP_MAX_usec    400U
+#define SIM_GAP_MIN_usec     20000U                    /* 감지 사이 간격 */
+
+/** \brief Latency 측정 clock(LATENCY_HOST_CLOCK) */
+u32_t Latency_Host_Clock(void)
+{
+  return g_host_usec;
+}
+
+/** \brief 채널 ch가 frame k에서 변환된 시각 */
+static u32_t Sample_usec(u32_t k, u08_t ch)
+{
+  return (k * ADC_SCAN_PERIOD_usec) + ((u32_t)(ch + 1U) * SIM_CH_CONV_usec);
+}
+
+/** \brief 모의 한 회
+  * \param  awd - True면 Analog Watchdog 깨우기 사용
+  * \retval 없음
+  */
+static void Sim_Run(Bool_t awd, LatStat_t * stat)
+{
+  u32_t t = 1000U, tc, k, avail, latest;
+  u32_t check_ms = 0U;                                 /* 마지막 판정 시각(msec), g_DEOD_Check_timer = 0 */
+  u32_t events = 0U;
+  u08_t ch;
+  Bool_t due, seen;
+
+  Latency_Clear();
+  tc = SIM_GAP_MIN_usec + ((u32_t)rand() % SIM_GAP_MIN_usec);
+  ch = (u08_t)(rand() % kNbrOfSIs);
+  while (events < SIM_EVENTS)
+  {
+    /* 넘은 값을 처음 변환한 프레임과 그 완료 시각 */
+    k     = tc / ADC_SCAN_PERIOD_usec;
+    if (Sample_usec(k, ch) < tc)
+    {
+      k++;
+    }
+    avail = (k * ADC_SCAN_PERIOD_usec) + SIM_FRAME_usec;
+
+    due  = (((t / 1000U) - check_ms) >= DEOD_SYS_CHECK_TIME) ? True : False;
+    seen = False;
+    if ((awd == True) && (t >= avail))
+    {
+      due  = True;                                     /* awd_wake */
+      seen = True;
+    }
+    if (due == True)
+    {
+      check_ms = t / 1000U;
+      latest   = (t >= SIM_FRAME_usec) ? ((t - SIM_FRAME_usec) / ADC_SCAN_PERIOD_usec) : 0U;
+      if ((t >= avail) && (latest >= k))
+      {
+        seen = True;
+      }
+    }
+    if (seen == True)
+    {
+      g_host_usec = t;
+      Latency_Start(tc);
+      Latency_Mark(kLAT_SAMPLE);
+      Latency_Cancel();
+      events++;
+      tc = t + SIM_GAP_MIN_usec + ((u32_t)rand() % SIM_GAP_MIN_usec);
+      ch = (u08_t)(rand() % kNbrOfSIs);
+    }
+    t += SIM_LOOP_MIN_usec + ((u32_t)rand() % (SIM_LOOP_MAX_usec - SIM_LOOP_MIN_usec + 1U));
+  }
+  (void)Latency_Get_Stat(kLAT_SAMPLE, stat);
+}
+
+/* "LATENCY BIN" 덤프를 모으는 출력 함수 */
+static u08_t _dump[8192];
+static u32_t _dumpLen;
+
+static void Dump_Out(u08_t buf[], u32_t size)
+{
+  if ((_dumpLen + size) <= sizeof(_dump))
+  {
+    memcpy(&_dump[_dumpLen], buf, size);
+  }
+  _dumpLen += size;
+}
+
+/** \brief 덤프 크기와 끝의 Crc16_Krs */
+static void Check_Dump(void)
+{
+  u16_t crc;
+
+  _dumpLen = 0U;
+  Latency_Dump(&Dump_Out);
+  CHECK_EQ(_dumpLen, 6U + (kNbrOfLatStages * (16U + (LAT_HIST_BINS * 4U))) + 2U);
+  CHECK_EQ(_dump[3], LAT_DUMP_VERSION);
+  crc = Crc16_Krs(_dump, _dumpLen - 2U);
+  CHECK_EQ(_dump[_dumpLen - 2U] | ((u32_t)_dump[_dumpLen - 1U] << 8), crc);
+  _dump[20] ^= 0x01U;                                  /* byte 하나가 틀리면 CRC가 다름 */
+  CHECK(Crc16_Krs(_dump, _dumpLen - 2U) != crc);
+}
+
+int main(void)
+{
+  LatStat_t scan, awd;
+  u32_t bound;
+
+  srand(4);
+  Sim_Run(False, &scan);
+  Sim_Run(True, &awd);
+
+  printf("  crossing -> frame read [usec]   min    p50    p90    p99    max\n");
+  printf("  periodic scan (%2u msec)     %6u %6u %6u %6u %6u\n", (unsigned)DEOD_SYS_CHECK_TIME,
+         (unsigned)scan.min, (unsigned)scan.p50, (unsigned)scan.p90, (unsigned)scan.p99, (unsigned)scan.max);
+  printf("  analog watchdog            %6u %6u %6u %6u %6u\n",
+         (unsigned)awd.min, (unsigned)awd.p50, (unsigned)awd.p90, (unsigned)awd.p99, (unsigned)awd.max);
+
+  CHECK_EQ(scan.count, SIM_EVENTS);
+  CHECK_EQ(awd.count, SIM_EVENTS);
+  /* 주기 scan은 최악 한 주기(+ ADC 프레임, tick 경계, loop)를 기다린다. */
+  CHECK(scan.max > ((DEOD_SYS_CHECK_TIME - 1U) * 1000U));
+  /* AWD는 변환 주기 + 프레임 완료 + loop 한 바퀴 이내 */
+  bound = ADC_SCAN_PERIOD_usec + SIM_FRAME_usec + SIM_LOOP_MAX_usec;
+  CHECK(awd.max <= bound);
+  CHECK(awd.p99 < scan.p50);
+  CHECK((awd.max * 5U) < scan.max);
+  Check_Dump();
+  return HT_RESULT("sim_deod_latency");
+}
+
+/*************** (C) COPYRIGHT SHALOM ENGINEERING CO., LTD. ****END OF FILE****/
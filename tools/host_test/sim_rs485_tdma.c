@@ -0,0 +1,414 @@
+/** ****************************************************************************
+  * \file    sim_rs485_tdma.c
+  * \author  Jang Ho Jong
+  * \version V0.0.2
+  * \date    2026.10.17
+  * \brief   RS-485 broadcast poll(TDMA) 다중 보드 bus host 모의 시험
+  * ***************************************************************************/
+/*
+  - 마스터 하나와 슬레이브(DM/PC 보드) 여러개가 한 RS-485 bus를 쓰는 것을 byte 단위로 모의한다.
+    rs485_tdma.c, rs485_frame.c를 target 그대로 빌드해 마스터의 수집 cycle을 돌린다.
+
+  - 모의 방식:
+    마스터가 broadcast frame을 보내고, 각 슬레이브는 broadcast 수신 완료 시점부터
+    Rs485_Tdma_Offset_usec() 뒤(자기 slot 시각)에 응답 frame을 보낸다. 실제 송신 시각은 슬레이브 모델로 정한다.
+      kSIM_ALARM : USEC_TIM 비교 인터럽트에서 송신(현재 target), 지연은 인터럽트 지연(jitter)뿐이다.
+      kSIM_LOOP  : superloop(Rs485_Slot_Process)에서 송신(이전 target), slot 시각 뒤 첫 loop에서 보내고
+                   Sysmon_Thread의 Check_Digital_Output_Isol()이 10sec마다 loop를 100msec 막으면 그 뒤에 보낸다.
+                   slot 0(ID 1)은 두 모델 모두 수신 인터럽트에서 바로 보낸다.
+    창을 넘긴 응답은 다음 broadcast에 밀려 보내지 않는 것으로 본다.
+    두 송신 byte가 시간상 겹치면 충돌로 세고 수신 byte를 깨뜨린다.
+    마스터는 byte 수신 시 parser에 넣고(수신 인터럽트), superloop 주기마다 frame을 꺼내
+    Rs485_Tdma_Mark(), Rs485_Tdma_Done()을 부른다.
+
+  - 결과로 속도별 전체 보드 수집 cycle 시간을 개별 polling(보드당 10msec 대기)과 비교해 출력하고,
+    보드별 연속 무응답이 RS485_LINK_RETRY_DEF를 넘은 횟수(kFLT_COM_TIMEOUT)를 센다.
+  */
+
+#include <stdlib.h>
+#include <string.h>
+#include "host_test.h"
+#include "rs485_tdma.h"
+#include "rs485_frame.h"
+#include "rs485_link.h"
+#include "lib_crc16.h"
+
+#define SIM_FRAME_LEN        10U                       /* Curs485_Packet_t */
+#define SIM_POLL_usec        10000U                    /* 개별 polling의 보드당 대기 */
+#define SIM_LOOP_usec        200U                      /* 마스터 superloop 주기 */
+#define SIM_TX_MAX           (RS485_TDMA_NODE_MAX + 1U)
+#define SIM_CYCLES           500U
+#define SIM_ISR_usec         50U                       /* 슬레이브 USEC_TIM 인터럽트 지연(같은 우선순위 USART1 ISR 포함) */
+#define SIM_SLAVE_LOOP_usec  200U                      /* 슬레이브 superloop 주기 */
+#define SIM_BLOCK_usec       100000U                   /* Check_Digital_Output_Isol() : HAL_Delay(50) x 2 */
+#define SIM_BLOCK_PERIOD_usec 10000000U                /* FLT_SIGNAL_CHECK_TIME(10sec) */
+#define SIM_BLOCK_PHASE_usec 1500000U                  /* 보드 ID별 첫 점검 시각 간격 */
+
+/** \brief 슬레이브 slot 응답 송신 모델 */
+typedef enum
+{
+  kSIM_ALARM = 0,                                      /* USEC_TIM 비교 인터럽트에서 송신 */
+  kSIM_LOOP                                            /* superloop에서 송신 */
+}SimSlave_t;
+
+/** \brief bus에 실린 frame 하나 */
+typedef struct
+{
+u08_t  id;                                             /* 0 : 마스터 */
+u32_t  start;                                          /* 송신 시작 시각[usec] */
+u08_t  data[SIM_FRAME_LEN];
+}SimTx_t;
+
+/** \brief 모의 조건 */
+typedef struct
+{
+u32_t  baud;
+u08_t  nodes;
+u08_t  dead;                                           /* 응답하지 않는 보드 ID, 0 : 없음 */
+u32_t  jitter;                                         /* 슬레이브 응답 지연 최대값[usec] */
+SimSlave_t slave;                                      /* 슬레이브 응답 송신 모델 */
+}SimCfg_t;
+
+/** \brief 모의 결과 */
+typedef struct
+{
+u32_t  cycle_max;
+u32_t  cycle_sum;
+u32_t  all_seen;                                       /* 모든 살아있는 보드가 응답한 cycle 수 */
+u32_t  collision;                                      /* 겹친 byte 수 */
+u32_t  slot_err;                                       /* Slot_At()이 응답 보드와 다른 수 */
+u32_t  miss[RS485_TDMA_NODE_MAX];
+u32_t  run[RS485_TDMA_NODE_MAX];                       /* 연속 무응답 수 */
+u32_t  timeout[RS485_TDMA_NODE_MAX];                   /* 연속 무응답이 재시도 한도를 넘은 cycle 수 */
+}SimResult_t;
+
+static SimTx_t _tx[SIM_TX_MAX];
+static u32_t   _txCnt;
+
+/** \brief Curs485_Packet_t 모양의 frame을 만든다. */
+static void Sim_Make(u08_t out[], u08_t id, u08_t msg, u08_t detail)
+{
+  u16_t crc;
+
+  out[0] = RS485_FRAME_STX;
+  out[1] = SIM_FRAME_LEN - RS485_FRAME_OVERHEAD;
+  out[2] = 0x00U;                                      /* heartbit */
+  out[3] = id;
+  out[4] = msg;
+  out[5] = 0x00U;                                      /* state_code */
+  out[6] = detail;
+  crc = Crc16_Krs(&out[1], SIM_FRAME_LEN - 4U);
+  out[7] = (u08_t)(crc >> 8);
+  out[8] = (u08_t)(crc & 0xFFU);
+  out[9] = RS485_FRAME_ETX;
+}
+
+/** \brief bus에 frame을 싣는다. */
+static void Sim_Put(u08_t id, u32_t start, u08_t msg, u08_t detail)
+{
+  if (_txCnt < SIM_TX_MAX)
+  {
+    _tx[_txCnt].id    = id;
+    _tx[_txCnt].start = start;
+    Sim_Make(_tx[_txCnt].data, id, msg, detail);
+    _txCnt++;
+  }
+}
+
+/** \brief 슬레이브가 자기 slot 응답을 실제로 보내는 시각을 구한다.
+  * \param  id  - 보드 ID
+  * \param  due - 자기 slot 시각
+  * \param  isr - True : 수신 인터럽트에서 바로 보냄(slot 0)
+  * \retval 송신 시작 시각
+  */
+static u32_t Sim_Reply_At(const SimCfg_t * cfg, u08_t id, u32_t due, Bool_t isr)
+{
+  u32_t at = due;
+  u32_t phase, blk;
+
+  if ((cfg->slave == kSIM_LOOP) && (isr == False))
+  {
+    phase = (u32_t)id * 37U;                           /* 보드마다 다른 loop 위상 */
+    at   += (SIM_SLAVE_LOOP_usec - ((at - phase) % SIM_SLAVE_LOOP_usec)) % SIM_SLAVE_LOOP_usec;
+    phase = (u32_t)id * SIM_BLOCK_PHASE_usec;
+    if (at >= phase)
+    {
+      blk = phase + (((at - phase) / SIM_BLOCK_PERIOD_usec) * SIM_BLOCK_PERIOD_usec);
+      if ((at - blk) < SIM_BLOCK_usec)
+      {
+        at = blk + SIM_BLOCK_usec;                     /* loop가 막힌 동안은 보내지 못함 */
+      }
+    }
+  }
+  return at + ((u32_t)rand() % (cfg->jitter + 1U));
+}
+
+/** \brief 한 수집 cycle을 모의한다.
+  * \param  t0 - broadcast 송신 시작 시각
+  * \retval 없음
+  */
+static void Sim_Cycle(const SimCfg_t * cfg, Rs485Tdma_t * t, Rs485Parser_t * p, SimResult_t * r, u32_t t0)
+{
+  u32_t byte_usec = Rs485_Tdma_Frame_usec(cfg->baud, 1U);
+  u32_t slot      = Rs485_Tdma_Slot_usec(cfg->baud, SIM_FRAME_LEN);
+  u32_t request   = Rs485_Tdma_Frame_usec(cfg->baud, SIM_FRAME_LEN);
+  u32_t rx_end    = t0 + (SIM_FRAME_LEN * byte_usec);  /* 슬레이브의 broadcast 수신 완료 */
+  u32_t now, next_loop, end, i, j, k, b, e;
+  u32_t offset;
+  u08_t byte, id, all;
+  Bool_t clash;
+  Rs485Frame_t f;
+
+  _txCnt = 0U;
+  Sim_Put(0U, t0, 0x00U, Rs485_Tdma_Slot_Code(slot));
+  for (id = 1U; id <= cfg->nodes; id++)
+  {
+    if (id != cfg->dead)
+    {
+      offset = Rs485_Tdma_Offset_usec(id, slot);
+      Sim_Put(id, Sim_Reply_At(cfg, id, rx_end + offset, (offset == 0U) ? True : False), id, 0x00U);
+    }
+  }
+
+  Rs485_Tdma_Start(t, cfg->nodes, slot, request, t0);
+  next_loop = t0 + (u32_t)rand() % SIM_LOOP_usec;
+  end       = t0 + t->window_usec + (2U * SIM_LOOP_usec);
+
+  for (now = t0; now <= end; now++)
+  {
+    /* 이 시각에 수신이 끝나는 byte(마스터 자신의 broadcast는 받지 않음) */
+    for (i = 1U; i < _txCnt; i++)
+    {
+      for (k = 0U; k < SIM_FRAME_LEN; k++)
+      {
+        b = _tx[i].start + (k * byte_usec);
+        e = b + byte_usec;
+        if (e != now)
+        {
+          continue;
+        }
+        byte  = _tx[i].data[k];
+        clash = False;
+        for (j = 0U; j < _txCnt; j++)
+        {
+          u32_t jb = _tx[j].start;
+          u32_t je = jb + (SIM_FRAME_LEN * byte_usec);
+
+          if ((j != i) && (jb < e) && (b < je))
+          {
+            clash = True;
+          }
+        }
+        if (clash == True)
+        {
+          r->collision++;
+          byte ^= 0x5AU;
+        }
+        Rs485_Frame_Feed(p, byte);
+      }
+    }
+
+    /* 마스터 superloop */
+    if (now == next_loop)
+    {
+      next_loop += SIM_LOOP_usec;
+      while (Rs485_Frame_Get(p, &f) == True)
+      {
+        if (Rs485_Tdma_Slot_At(t, now - SIM_LOOP_usec) > f.data[3])
+        {
+          r->slot_err++;                               /* 자기 slot을 넘겨 끝난 응답 */
+        }
+        (void)Rs485_Tdma_Mark(t, f.data[3], now);
+      }
+      if (Rs485_Tdma_Done(t, now) == True)
+      {
+        break;
+      }
+    }
+  }
+
+  all = (u08_t)((1U << cfg->nodes) - 1U);
+  if (cfg->dead != 0U)
+  {
+    all &= (u08_t)~(1U << (cfg->dead - 1U));
+  }
+  if ((t->seen & all) == all)
+  {
+    r->all_seen++;
+  }
+  for (id = 1U; id <= cfg->nodes; id++)
+  {
+    if (Rs485_Tdma_Is_Seen(t, id) == True)
+    {
+      r->run[id - 1U] = 0U;
+    }
+    else if (++r->run[id - 1U] > RS485_LINK_RETRY_DEF)
+    {
+      r->timeout[id - 1U]++;                           /* Rs485_Broadcast_Done()의 kFLT_COM_TIMEOUT */
+    }
+  }
+  if (t->cycle_usec > r->cycle_max)
+  {
+    r->cycle_max = t->cycle_usec;
+  }
+  r->cycle_sum += t->cycle_usec;
+}
+
+/** \brief 조건 하나로 SIM_CYCLES cycle을 돌린다. */
+static void Sim_Run(const SimCfg_t * cfg, SimResult_t * r)
+{
+  static Rs485Tdma_t   t;
+  static Rs485Parser_t p;
+  u32_t c, t0 = 1000U;
+
+  memset(&t, 0, sizeof(t));
+  memset(r, 0, sizeof(*r));
+  Rs485_Frame_Init(&p);
+  for (c = 0U; c < SIM_CYCLES; c++)
+  {
+    Sim_Cycle(cfg, &t, &p, r, t0);
+    t0 += t.window_usec + 5000U;
+  }
+  memcpy(r->miss, t.miss, sizeof(r->miss));
+}
+
+/** \brief 속도별 6보드 수집 cycle, 슬레이브는 USEC_TIM 비교 인터럽트에서 송신 */
+static void Sim_Baud(void)
+{
+  static const u32_t baud[] = { 9600U, 19200U, 38400U, 57600U, 115200U };
+  SimCfg_t    cfg;
+  SimResult_t r;
+  u32_t i, slot;
+
+  printf("  baud    slot  window  cycle avg/max[usec]  poll[usec]  collision\n");
+  for (i = 0U; i < (sizeof(baud) / sizeof(baud[0])); i++)
+  {
+    cfg.baud   = baud[i];
+    cfg.nodes  = RS485_TDMA_NODE_MAX;
+    cfg.dead   = 0U;
+    cfg.jitter = SIM_ISR_usec;
+    cfg.slave  = kSIM_ALARM;
+    Sim_Run(&cfg, &r);
+    slot = Rs485_Tdma_Slot_usec(cfg.baud, SIM_FRAME_LEN);
+    printf("  %6u  %4u  %6u  %6u/%-6u        %6u      %u\n",
+           (unsigned)cfg.baud, (unsigned)slot,
+           (unsigned)Rs485_Tdma_Window_usec(cfg.nodes, slot, Rs485_Tdma_Frame_usec(cfg.baud, SIM_FRAME_LEN)),
+           (unsigned)(r.cycle_sum / SIM_CYCLES), (unsigned)r.cycle_max,
+           (unsigned)(cfg.nodes * SIM_POLL_usec), (unsigned)r.collision);
+
+    CHECK_EQ(r.all_seen, SIM_CYCLES);
+    CHECK_EQ(r.collision, 0U);
+    CHECK_EQ(r.slot_err, 0U);
+    /* 전체 수집 = broadcast + 보드당 slot 하나 + superloop 주기 이내 */
+    CHECK(r.cycle_max <= (Rs485_Tdma_Frame_usec(cfg.baud, SIM_FRAME_LEN) + (cfg.nodes * slot) + SIM_LOOP_usec));
+    if (cfg.baud >= 38400U)
+    {
+      CHECK(r.cycle_max < ((cfg.nodes * SIM_POLL_usec) / 2U));
+    }
+  }
+}
+
+/** \brief 한 보드가 응답하지 않으면 그 보드만 miss, cycle은 수집 창에서 끝난다. */
+static void Sim_Dead_Node(void)
+{
+  SimCfg_t    cfg;
+  SimResult_t r;
+  u32_t i, slot;
+
+  cfg.baud   = 38400U;
+  cfg.nodes  = RS485_TDMA_NODE_MAX;
+  cfg.dead   = 4U;
+  cfg.jitter = SIM_ISR_usec;
+  cfg.slave  = kSIM_ALARM;
+  Sim_Run(&cfg, &r);
+  slot = Rs485_Tdma_Slot_usec(cfg.baud, SIM_FRAME_LEN);
+  printf("  dead ID %u : miss %u/%u, cycle max %u usec\n",
+         (unsigned)cfg.dead, (unsigned)r.miss[cfg.dead - 1U], (unsigned)SIM_CYCLES, (unsigned)r.cycle_max);
+
+  CHECK_EQ(r.all_seen, SIM_CYCLES);
+  for (i = 0U; i < RS485_TDMA_NODE_MAX; i++)
+  {
+    CHECK_EQ(r.miss[i], ((i + 1U) == cfg.dead) ? SIM_CYCLES : 0U);
+    CHECK_EQ(r.timeout[i], ((i + 1U) == cfg.dead) ? (SIM_CYCLES - RS485_LINK_RETRY_DEF) : 0U);
+  }
+  CHECK(r.cycle_max >= Rs485_Tdma_Window_usec(cfg.nodes, slot, Rs485_Tdma_Frame_usec(cfg.baud, SIM_FRAME_LEN)));
+  CHECK(r.cycle_max < (Rs485_Tdma_Window_usec(cfg.nodes, slot, Rs485_Tdma_Frame_usec(cfg.baud, SIM_FRAME_LEN)) + SIM_LOOP_usec));
+}
+
+/** \brief 응답 지연이 guard를 넘으면 이웃 slot과 겹친다(guard 크기 근거). */
+static void Sim_Over_Guard(void)
+{
+  SimCfg_t    cfg;
+  SimResult_t r;
+
+  cfg.baud   = 38400U;
+  cfg.nodes  = RS485_TDMA_NODE_MAX;
+  cfg.dead   = 0U;
+  cfg.jitter = RS485_TDMA_GUARD_usec * 4U;
+  cfg.slave  = kSIM_ALARM;
+  Sim_Run(&cfg, &r);
+  printf("  jitter %u usec : collision %u byte, all seen %u/%u\n",
+         (unsigned)cfg.jitter, (unsigned)r.collision, (unsigned)r.all_seen, (unsigned)SIM_CYCLES);
+
+  CHECK(r.collision > 0U);
+  CHECK(r.all_seen < SIM_CYCLES);
+}
+
+/** \brief 슬레이브 superloop가 막히면(Sysmon 점검 100msec) superloop 송신은 slot을 놓쳐 timeout이 나고,
+  *        USEC_TIM 비교 인터럽트 송신은 loop가 막혀도 모든 slot에 응답한다.
+  */
+static void Sim_Slave_Block(void)
+{
+  static const char_t * const name[] = { "alarm", "loop" };
+  SimCfg_t    cfg;
+  SimResult_t r;
+  u32_t i, sum;
+  u08_t m;
+
+  for (m = (u08_t)kSIM_ALARM; m <= (u08_t)kSIM_LOOP; m++)
+  {
+    cfg.baud   = 38400U;
+    cfg.nodes  = RS485_TDMA_NODE_MAX;
+    cfg.dead   = 0U;
+    cfg.jitter = SIM_ISR_usec;
+    cfg.slave  = (SimSlave_t)m;
+    Sim_Run(&cfg, &r);
+    printf("  slave %-5s : all seen %u/%u, timeout", name[m], (unsigned)r.all_seen, (unsigned)SIM_CYCLES);
+    for (i = 0U, sum = 0U; i < RS485_TDMA_NODE_MAX; i++)
+    {
+      printf(" %u", (unsigned)r.timeout[i]);
+      sum += r.timeout[i];
+    }
+    printf(", collision %u\n", (unsigned)r.collision);
+
+    /* 모의 구간에 보드마다 점검 대기가 한번 이상 들어가야 비교가 된다 */
+    CHECK((SIM_CYCLES * 20000U) > ((u32_t)RS485_TDMA_NODE_MAX * SIM_BLOCK_PHASE_usec));
+    if (cfg.slave == kSIM_ALARM)
+    {
+      CHECK_EQ(r.all_seen, SIM_CYCLES);
+      CHECK_EQ(sum, 0U);
+      CHECK_EQ(r.collision, 0U);
+    }
+    else
+    {
+      CHECK(r.all_seen < SIM_CYCLES);
+      CHECK_EQ(r.timeout[0], 0U);                      /* slot 0은 수신 인터럽트에서 바로 응답 */
+      for (i = 1U; i < RS485_TDMA_NODE_MAX; i++)
+      {
+        CHECK(r.timeout[i] > 0U);
+      }
+    }
+  }
+}
+
+int main(void)
+{
+  srand(485);
+  Sim_Baud();
+  Sim_Dead_Node();
+  Sim_Over_Guard();
+  Sim_Slave_Block();
+  return HT_RESULT("sim_rs485_tdma");
+}
+
+/*************** (C) COPYRIGHT SHALOM ENGINEERING CO., LTD. ****END OF FILE****/
@@ -0,0 +1,307 @@
+/** ****************************************************************************
+  * \file    stm32f4xx_hal.h
+  * \brief   Host 시험용 STM32F4 HAL 대체 Header
+  * ***************************************************************************/
+/*
+  - PC gcc로 target 소스를 빌드하기 위한 형, 상수, 함수 선언만 둔다.
+  - 레지스터는 포인터 선언뿐이므로 주변장치를 건드리는 함수는 host 시험에서 호출하지 않는다.
+  - 함수 정의가 필요한 것은 host_stub.c 또는 각 시험 파일에 둔다.
+  */
+#ifndef __HOST_STM32F4XX_HAL_H
+#define __HOST_STM32F4XX_HAL_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdarg.h>
+#define __IO volatile
+typedef enum {RESET=0, SET=!RESET} FlagStatus, ITStatus;
+typedef enum {DISABLE=0, ENABLE=!DISABLE} FunctionalState;
+typedef enum {HAL_OK=0, HAL_ERROR, HAL_BUSY, HAL_TIMEOUT} HAL_StatusTypeDef;
+typedef enum {GPIO_PIN_RESET=0, GPIO_PIN_SET} GPIO_PinState;
+typedef struct { __IO uint32_t MODER, OTYPER, OSPEEDR, PUPDR, IDR, ODR, BSRR, LCKR, AFR[2]; } GPIO_TypeDef;
+typedef struct { __IO uint32_t SR, DR, BRR, CR1, CR2, CR3, GTPR; } USART_TypeDef;
+typedef struct { __IO uint32_t CR1,CR2,SMCR,DIER,SR,EGR,CCMR1,CCMR2,CCER,CNT,PSC,ARR,RCR,CCR1,CCR2,CCR3,CCR4,BDTR,DCR,DMAR,OR; } TIM_TypeDef;
+typedef struct { __IO uint32_t SR,CR1,CR2,SMPR1,SMPR2,JOFR1,JOFR2,JOFR3,JOFR4,HTR,LTR,SQR1,SQR2,SQR3,JSQR,JDR1,JDR2,JDR3,JDR4,DR; } ADC_TypeDef;
+typedef struct { __IO uint32_t CR, NDTR, PAR, M0AR, M1AR, FCR; } DMA_Stream_TypeDef;
+typedef struct { __IO uint32_t LISR, HISR, LIFCR, HIFCR; } DMA_TypeDef;
+typedef struct { __IO uint32_t IMR, EMR, RTSR, FTSR, SWIER, PR; } EXTI_TypeDef;
+typedef struct { __IO uint32_t MEMRMP, PMC, EXTICR[4]; } SYSCFG_TypeDef;
+typedef struct { __IO uint32_t CTRL, CYCCNT; } DWT_Type;
+typedef struct { __IO uint32_t DHCSR, DCRSR, DCRDR, DEMCR; } CoreDebug_Type;
+typedef struct { __IO uint32_t I2C_DUMMY; } I2C_TypeDef;
+typedef struct { __IO uint32_t CRC_DUMMY; } CRC_TypeDef;
+typedef struct { __IO uint32_t CR, PLLCFGR, CFGR, CIR, AHB1RSTR; __IO uint32_t AHB1ENR, APB1ENR, APB2ENR; } RCC_TypeDef;
+extern GPIO_TypeDef *GPIOA,*GPIOB,*GPIOC,*GPIOD,*GPIOE;
+extern USART_TypeDef *USART1,*USART2,*USART3;
+extern TIM_TypeDef *TIM2,*TIM3,*TIM4,*TIM5;
+extern ADC_TypeDef *ADC1;
+extern DMA_Stream_TypeDef *DMA2_Stream0,*DMA2_Stream7,*DMA2_Stream2,*DMA2_Stream5,*DMA1_Stream3,*DMA1_Stream1;
+extern DMA_TypeDef *DMA1,*DMA2;
+extern EXTI_TypeDef *EXTI; extern SYSCFG_TypeDef *SYSCFG; extern DWT_Type *DWT; extern CoreDebug_Type *CoreDebug;
+extern I2C_TypeDef *I2C1; extern RCC_TypeDef *RCC;
+typedef enum { DMA2_Stream0_IRQn=56, DMA2_Stream7_IRQn=70, DMA2_Stream2_IRQn=58, DMA2_Stream5_IRQn=68, DMA1_Stream3_IRQn=14, DMA1_Stream1_IRQn=12, USART1_IRQn=37, USART3_IRQn=39, ADC_IRQn=18, EXTI0_IRQn=6, EXTI1_IRQn, EXTI2_IRQn, EXTI3_IRQn, EXTI4_IRQn, EXTI9_5_IRQn=23, EXTI15_10_IRQn=40, TIM2_IRQn=28 } IRQn_Type;
+typedef struct { uint32_t Pin, Mode, Pull, Speed, Alternate; } GPIO_InitTypeDef;
+#define GPIO_PIN_0 ((uint16_t)0x0001)
+#define GPIO_PIN_1 ((uint16_t)0x0002)
+#define GPIO_PIN_2 ((uint16_t)0x0004)
+#define GPIO_PIN_3 ((uint16_t)0x0008)
+#define GPIO_PIN_4 ((uint16_t)0x0010)
+#define GPIO_PIN_5 ((uint16_t)0x0020)
+#define GPIO_PIN_6 ((uint16_t)0x0040)
+#define GPIO_PIN_7 ((uint16_t)0x0080)
+#define GPIO_PIN_8 ((uint16_t)0x0100)
+#define GPIO_PIN_9 ((uint16_t)0x0200)
+#define GPIO_PIN_10 ((uint16_t)0x0400)
+#define GPIO_PIN_11 ((uint16_t)0x0800)
+#define GPIO_PIN_12 ((uint16_t)0x1000)
+#define GPIO_PIN_13 ((uint16_t)0x2000)
+#define GPIO_PIN_14 ((uint16_t)0x4000)
+#define GPIO_PIN_15 ((uint16_t)0x8000)
+#define GPIO_MODE_INPUT 0u
+#define GPIO_MODE_OUTPUT_PP 1u
+#define GPIO_MODE_AF_PP 2u
+#define GPIO_MODE_AF_OD 0x12u
+#define GPIO_MODE_ANALOG 3u
+#define GPIO_MODE_IT_RISING_FALLING 0x10310000u
+#define GPIO_NOPULL 0u
+#define GPIO_PULLUP 1u
+#define GPIO_PULLDOWN 2u
+#define GPIO_SPEED_HIGH 2u
+#define GPIO_SPEED_FREQ_VERY_HIGH 3u
+#define GPIO_SPEED_FREQ_HIGH 2u
+#define GPIO_AF4_I2C1 4u
+#define GPIO_AF7_USART1 7u
+#define GPIO_AF7_USART3 7u
+void HAL_GPIO_Init(GPIO_TypeDef*, GPIO_InitTypeDef*);
+GPIO_PinState HAL_GPIO_ReadPin(GPIO_TypeDef*, uint16_t);
+void HAL_GPIO_WritePin(GPIO_TypeDef*, uint16_t, GPIO_PinState);
+void HAL_GPIO_TogglePin(GPIO_TypeDef*, uint16_t);
+void HAL_GPIO_EXTI_IRQHandler(uint16_t);
+void HAL_GPIO_EXTI_Callback(uint16_t);
+/* DMA */
+typedef struct { uint32_t Channel, Direction, PeriphInc, MemInc, PeriphDataAlignment, MemDataAlignment, Mode, Priority, FIFOMode, FIFOThreshold, MemBurst, PeriphBurst; } DMA_InitTypeDef;
+typedef struct __DMA_HandleTypeDef { DMA_Stream_TypeDef *Instance; DMA_InitTypeDef Init; void *Parent; void (*XferCpltCallback)(struct __DMA_HandleTypeDef*); void (*XferHalfCpltCallback)(struct __DMA_HandleTypeDef*); void (*XferErrorCallback)(struct __DMA_HandleTypeDef*); uint32_t State; } DMA_HandleTypeDef;
+#define DMA_CHANNEL_0 0u
+#define DMA_CHANNEL_4 0x08000000u
+#define DMA_PERIPH_TO_MEMORY 0u
+#define DMA_MEMORY_TO_PERIPH 0x40u
+#define DMA_PINC_DISABLE 0u
+#define DMA_MINC_ENABLE 0x400u
+#define DMA_PDATAALIGN_HALFWORD 0x800u
+#define DMA_MDATAALIGN_HALFWORD 0x2000u
+#define DMA_PDATAALIGN_BYTE 0u
+#define DMA_MDATAALIGN_BYTE 0u
+#define DMA_CIRCULAR 0x100u
+#define DMA_NORMAL 0u
+#define DMA_PRIORITY_HIGH 0x20000u
+#define DMA_PRIORITY_MEDIUM 0x10000u
+#define DMA_PRIORITY_LOW 0u
+#define DMA_FIFOMODE_DISABLE 0u
+#define __HAL_LINKDMA(__HANDLE__, __PPP_DMA_FIELD__, __DMA_HANDLE__) do{ (__HANDLE__)->__PPP_DMA_FIELD__ = &(__DMA_HANDLE__); (__DMA_HANDLE__).Parent = (__HANDLE__);} while(0U)
+HAL_StatusTypeDef HAL_DMA_Init(DMA_HandleTypeDef*);
+void HAL_DMA_IRQHandler(DMA_HandleTypeDef*);
+HAL_StatusTypeDef HAL_DMA_Start_IT(DMA_HandleTypeDef*, uint32_t, uint32_t, uint32_t);
+HAL_StatusTypeDef HAL_DMA_Abort(DMA_HandleTypeDef*);
+HAL_StatusTypeDef HAL_DMA_Abort_IT(DMA_HandleTypeDef*);
+#define __HAL_DMA_GET_COUNTER(h) ((h)->Instance->NDTR)
+#define __HAL_DMA_DISABLE(h) ((h)->Instance->CR &= ~1u)
+#define __HAL_DMA_ENABLE(h) ((h)->Instance->CR |= 1u)
+/* ADC */
+typedef struct { uint32_t ClockPrescaler, Resolution, DataAlign, ScanConvMode, EOCSelection, ContinuousConvMode, NbrOfConversion, DiscontinuousConvMode, NbrOfDiscConversion, ExternalTrigConv, ExternalTrigConvEdge, DMAContinuousRequests; } ADC_InitTypeDef;
+typedef struct { ADC_TypeDef *Instance; ADC_InitTypeDef Init; DMA_HandleTypeDef *DMA_Handle; uint32_t State; } ADC_HandleTypeDef;
+typedef struct { uint32_t Channel, Rank, SamplingTime, Offset; } ADC_ChannelConfTypeDef;
+typedef struct { uint32_t WatchdogMode, HighThreshold, LowThreshold, Channel, ITMode, WatchdogNumber; } ADC_AnalogWDGConfTypeDef;
+#define ADC_CLOCK_SYNC_PCLK_DIV2 0u
+#define ADC_RESOLUTION_12B 0u
+#define ADC_EXTERNALTRIGCONVEDGE_NONE 0u
+#define ADC_EXTERNALTRIGCONVEDGE_RISING 0x10000000u
+#define ADC_SOFTWARE_START 0x0F000001u
+#define ADC_EXTERNALTRIGCONV_T2_TRGO 0x06000000u
+#define ADC_DATAALIGN_RIGHT 0u
+#define ADC_EOC_SINGLE_CONV 1u
+#define ADC_EOC_SEQ_CONV 0u
+#define ADC_CHANNEL_0 0u
+#define ADC_CHANNEL_1 1u
+#define ADC_CHANNEL_2 2u
+#define ADC_CHANNEL_3 3u
+#define ADC_SAMPLETIME_3CYCLES 0u
+#define ADC_ANALOGWATCHDOG_SINGLE_REG 0x00800200u
+#define ADC_ANALOGWATCHDOG_ALL_REG 0x00800000u
+#define ADC_FLAG_AWD 1u
+#define ADC_IT_AWD 0x40u
+HAL_StatusTypeDef HAL_ADC_Init(ADC_HandleTypeDef*);
+HAL_StatusTypeDef HAL_ADC_ConfigChannel(ADC_HandleTypeDef*, ADC_ChannelConfTypeDef*);
+HAL_StatusTypeDef HAL_ADC_AnalogWDGConfig(ADC_HandleTypeDef*, ADC_AnalogWDGConfTypeDef*);
+HAL_StatusTypeDef HAL_ADC_Start(ADC_HandleTypeDef*);
+HAL_StatusTypeDef HAL_ADC_Start_DMA(ADC_HandleTypeDef*, uint32_t*, uint32_t);
+HAL_StatusTypeDef HAL_ADC_PollForConversion(ADC_HandleTypeDef*, uint32_t);
+uint32_t HAL_ADC_GetValue(ADC_HandleTypeDef*);
+void HAL_ADC_IRQHandler(ADC_HandleTypeDef*);
+/* UART */
+typedef struct { uint32_t BaudRate, WordLength, StopBits, Parity, Mode, HwFlowCtl, OverSampling; } UART_InitTypeDef;
+typedef struct { USART_TypeDef *Instance; UART_InitTypeDef Init; DMA_HandleTypeDef *hdmatx, *hdmarx; uint32_t gState; } UART_HandleTypeDef;
+#define UART_WORDLENGTH_8B 0u
+#define UART_STOPBITS_1 0u
+#define UART_PARITY_NONE 0u
+#define UART_MODE_TX_RX 0xCu
+#define UART_HWCONTROL_NONE 0u
+#define UART_OVERSAMPLING_16 0u
+#define UART_FLAG_ORE 0x08u
+#define UART_FLAG_RXNE 0x20u
+#define UART_FLAG_TXE 0x80u
+#define UART_FLAG_TC 0x40u
+#define UART_FLAG_IDLE 0x10u
+#define UART_FLAG_FE 0x02u
+#define UART_FLAG_NE 0x04u
+#define UART_IT_RXNE 0x20u
+#define UART_IT_TXE 0x80u
+#define UART_IT_TC 0x40u
+#define UART_IT_IDLE 0x10u
+#define __HAL_UART_GET_FLAG(h,f) (((h)->Instance->SR & (f)) == (f))
+#define __HAL_UART_CLEAR_FLAG(h,f) ((h)->Instance->SR = ~(f))
+#define __HAL_UART_CLEAR_OREFLAG(h) do{ (void)(h)->Instance->SR; (void)(h)->Instance->DR; }while(0)
+#define __HAL_UART_CLEAR_IDLEFLAG(h) do{ (void)(h)->Instance->SR; (void)(h)->Instance->DR; }while(0)
+#define __HAL_UART_ENABLE_IT(h,i) ((h)->Instance->CR1 |= (i))
+#define __HAL_UART_DISABLE_IT(h,i) ((h)->Instance->CR1 &= ~(i))
+#define __HAL_UART_GET_IT_SOURCE(h,i) ((h)->Instance->CR1 & (i))
+HAL_StatusTypeDef HAL_UART_Init(UART_HandleTypeDef*);
+HAL_StatusTypeDef HAL_UART_DeInit(UART_HandleTypeDef*);
+HAL_StatusTypeDef HAL_UART_Transmit_DMA(UART_HandleTypeDef*, uint8_t*, uint16_t);
+void HAL_UART_IRQHandler(UART_HandleTypeDef*);
+/* I2C */
+typedef struct { uint32_t ClockSpeed, DutyCycle, OwnAddress1, AddressingMode, DualAddressMode, OwnAddress2, GeneralCallMode, NoStretchMode; } I2C_InitTypeDef;
+typedef struct { I2C_TypeDef *Instance; I2C_InitTypeDef Init; } I2C_HandleTypeDef;
+#define I2C_DUTYCYCLE_2 0u
+#define I2C_ADDRESSINGMODE_7BIT 0u
+#define I2C_DUALADDRESS_DISABLE 0u
+#define I2C_GENERALCALL_DISABLE 0u
+#define I2C_NOSTRETCH_DISABLE 0u
+HAL_StatusTypeDef HAL_I2C_Init(I2C_HandleTypeDef*);
+HAL_StatusTypeDef HAL_I2C_Master_Transmit(I2C_HandleTypeDef*, uint16_t, uint8_t*, uint16_t, uint32_t);
+HAL_StatusTypeDef HAL_I2C_Master_Receive(I2C_HandleTypeDef*, uint16_t, uint8_t*, uint16_t, uint32_t);
+HAL_StatusTypeDef HAL_I2C_Mem_Read(I2C_HandleTypeDef*, uint16_t, uint16_t, uint16_t, uint8_t*, uint16_t, uint32_t);
+HAL_StatusTypeDef HAL_I2C_Mem_Write(I2C_HandleTypeDef*, uint16_t, uint16_t, uint16_t, uint8_t*, uint16_t, uint32_t);
+#define I2C_MEMADD_SIZE_8BIT 1u
+/* RCC */
+typedef struct { uint32_t OscillatorType, HSEState, HSIState, HSICalibrationValue, LSEState, LSIState; struct { uint32_t PLLState, PLLSource, PLLM, PLLN, PLLP, PLLQ; } PLL; } RCC_OscInitTypeDef;
+typedef struct { uint32_t ClockType, SYSCLKSource, AHBCLKDivider, APB1CLKDivider, APB2CLKDivider; } RCC_ClkInitTypeDef;
+uint32_t HAL_RCC_GetPCLK1Freq(void);
+uint32_t HAL_RCC_GetPCLK2Freq(void);
+uint32_t HAL_RCC_GetHCLKFreq(void);
+#define CLK_EN_STUB do{}while(0)
+#define __HAL_RCC_TIM2_CLK_ENABLE() CLK_EN_STUB
+#define __HAL_RCC_DMA2_CLK_ENABLE() CLK_EN_STUB
+#define __HAL_RCC_DMA1_CLK_ENABLE() CLK_EN_STUB
+#define __HAL_RCC_ADC1_CLK_ENABLE() CLK_EN_STUB
+#define __HAL_RCC_GPIOA_CLK_ENABLE() CLK_EN_STUB
+#define __HAL_RCC_GPIOB_CLK_ENABLE() CLK_EN_STUB
+#define __HAL_RCC_GPIOC_CLK_ENABLE() CLK_EN_STUB
+#define __HAL_RCC_GPIOD_CLK_ENABLE() CLK_EN_STUB
+#define __HAL_RCC_GPIOE_CLK_ENABLE() CLK_EN_STUB
+#define __HAL_RCC_I2C1_CLK_ENABLE() CLK_EN_STUB
+#define __HAL_RCC_SYSCFG_CLK_ENABLE() CLK_EN_STUB
+#define __HAL_RCC_CRC_CLK_ENABLE() CLK_EN_STUB
+/* TIM bits */
+#define TIM_CR1_CEN 1u
+#define TIM_CR2_MMS_1 0x20u
+#define TIM_EGR_UG 1u
+#define TIM_DIER_UIE 1u
+#define TIM_SR_UIF 1u
+/* ADC bits */
+#define ADC_CR1_AWDIE 0x40u
+#define ADC_CR1_AWDEN 0x800000u
+#define ADC_CR1_AWDSGL 0x200u
+#define ADC_SR_AWD 1u
+/* USART bits */
+#define USART_CR1_UE 0x2000u
+#define USART_CR1_TE 0x8u
+#define USART_CR1_RE 0x4u
+#define USART_CR1_RXNEIE 0x20u
+#define USART_CR1_TCIE 0x40u
+#define USART_CR1_TXEIE 0x80u
+#define USART_CR1_IDLEIE 0x10u
+#define USART_CR3_DMAT 0x80u
+#define USART_CR3_DMAR 0x40u
+#define USART_SR_TC 0x40u
+#define USART_SR_IDLE 0x10u
+#define USART_SR_RXNE 0x20u
+/* DWT */
+#define CoreDebug_DEMCR_TRCENA_Msk (1u<<24)
+#define DWT_CTRL_CYCCNTENA_Msk 1u
+/* DMA bits */
+#define DMA_SxCR_EN 1u
+#define DMA_SxCR_TCIE 0x10u
+#define DMA_LIFCR_CTCIF0 0x20u
+/* misc */
+void HAL_Init(void);
+void HAL_IncTick(void);
+uint32_t HAL_GetTick(void);
+void HAL_Delay(uint32_t);
+void HAL_NVIC_SetPriority(IRQn_Type, uint32_t, uint32_t);
+void HAL_NVIC_EnableIRQ(IRQn_Type);
+void HAL_NVIC_DisableIRQ(IRQn_Type);
+void HAL_NVIC_SystemReset(void);
+void HAL_SYSTICK_IRQHandler(void);
+void NVIC_SystemReset(void);
+extern uint32_t SystemCoreClock;
+void __disable_irq(void);
+void __enable_irq(void);
+uint32_t __get_PRIMASK(void);
+void __set_PRIMASK(uint32_t);
+void __DMB(void);
+void __NOP(void);
+
+typedef struct { __IO uint32_t X; } CAN_TypeDef, DAC_TypeDef, SPI_TypeDef, UART_TypeDef_unused;
+#define PWR_REGULATOR_VOLTAGE_SCALE1 1u
+#define RCC_OSCILLATORTYPE_HSE 1u
+#define RCC_HSE_ON 1u
+#define RCC_PLL_ON 1u
+#define RCC_PLLSOURCE_HSE 1u
+#define RCC_PLLP_DIV2 2u
+#define RCC_CLOCKTYPE_SYSCLK 1u
+#define RCC_CLOCKTYPE_HCLK 2u
+#define RCC_CLOCKTYPE_PCLK1 4u
+#define RCC_CLOCKTYPE_PCLK2 8u
+#define RCC_SYSCLKSOURCE_PLLCLK 2u
+#define RCC_SYSCLK_DIV1 0u
+#define RCC_HCLK_DIV4 5u
+#define RCC_HCLK_DIV2 4u
+#define FLASH_LATENCY_5 5u
+#define __HAL_RCC_PWR_CLK_ENABLE() CLK_EN_STUB
+#define __HAL_PWR_VOLTAGESCALING_CONFIG(x) CLK_EN_STUB
+HAL_StatusTypeDef HAL_RCC_OscConfig(RCC_OscInitTypeDef*);
+HAL_StatusTypeDef HAL_RCC_ClockConfig(RCC_ClkInitTypeDef*, uint32_t);
+uint32_t HAL_GetREVID(void);
+uint32_t HAL_GetDEVID(void);
+
+extern GPIO_TypeDef *GPIOF,*GPIOG,*GPIOH,*GPIOI; extern USART_TypeDef *UART4,*UART5,*USART6;
+#define RCC_AHB1ENR_GPIOAEN 1u
+#define RCC_AHB1ENR_GPIOBEN 2u
+#define RCC_AHB1ENR_GPIOCEN 4u
+#define RCC_AHB1ENR_GPIODEN 8u
+#define RCC_AHB1ENR_GPIOEEN 16u
+#define RCC_AHB1ENR_GPIOFEN 32u
+#define RCC_AHB1ENR_GPIOGEN 64u
+#define RCC_AHB1ENR_GPIOHEN 128u
+#define RCC_AHB1ENR_GPIOIEN 256u
+#define UART_IT_PE 0x100u
+#define UART_IT_ERR 0x1u
+
+#define __va_list va_list
+#define RCC_APB2ENR_USART1EN 16u
+#define RCC_APB1ENR_USART2EN 1u
+#define RCC_APB1ENR_USART3EN 2u
+#define RCC_APB1ENR_UART4EN 4u
+#define RCC_APB1ENR_UART5EN 8u
+#define RCC_APB2ENR_USART6EN 32u
+
+#define __HAL_ADC_CLEAR_FLAG(h,f) ((h)->Instance->SR = ~(f))
+#define __HAL_ADC_ENABLE_IT(h,i) ((h)->Instance->CR1 |= (i))
+#define __HAL_ADC_DISABLE_IT(h,i) ((h)->Instance->CR1 &= ~(i))
+#define __HAL_RCC_TIM5_CLK_ENABLE() CLK_EN_STUB
+#define __HAL_GPIO_EXTI_CLEAR_IT(p) (EXTI->PR = (p))
+#define UART_OVERSAMPLING_8 0x8000u
+#define UART_BRR_SAMPLING16(p,b) ((p)/(b))
+#define UART_BRR_SAMPLING8(p,b) ((p)/(b))
+
+#endif /* __HOST_STM32F4XX_HAL_H */
@@ -0,0 +1,2 @@
+/* host 시험용 : stm32f4xx_hal_uart.h 대신 stm32f4xx_hal.h(형 정의만) 사용 */
+#include "stm32f4xx_hal.h"
@@ -0,0 +1,226 @@
+/** ****************************************************************************
+  * \file    test_crc16.c
+  * \author  Jang Ho Jong
+  * \version V0.0.1
+  * \date    2026.10.17
+  * \brief   CRC16(KRS) host 시험과 benchmark
+  * ***************************************************************************/
+/*
+  - lib_crc16의 Crc16_Krs(slice), Crc16_Krs_Update(이어 계산), Crc16_Krs_Byte(ISR 누적),
+    Crc16_Krs_Bytewise가 아래 두 기준과 같은 값을 내는지 확인한다.
+      1) 기존 rs485com_thread.c의 KRS_CRC16_TABLE / getCRC16_KRS() (그대로 옮김)
+      2) 다항식 0x8005, 초기값 0, MSB first 비트 단위 계산
+  - run.sh가 CRC16_KRS_SLICE 8, 4, 1로 각각 빌드한다.
+  - 끝에 host에서 byte 단위와 slice 구현의 1회 시간을 출력한다(target은 Console "CRC"로 DWT cycle).
+  */
+
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "host_test.h"
+#include "lib_crc16.h"
+
+/* 기존 구현(rs485com_thread.c) ----------------------------------------------*/
+/* Polly : X16+X15+X2+1 : 0x8005  */
+static const uint16_t KRS_CRC16_TABLE[256] = {
+		0x0000, 0x8005, 0x800F, 0x000A, 0x801B, 0x001E, 0x0014, 0x8011,
+		0x8033, 0x0036, 0x003C, 0x8039, 0x0028, 0x802D, 0x8027, 0x0022,
+		0x8063, 0x0066, 0x006C, 0x8069, 0x0078, 0x807D, 0x8077, 0x0072,
+		0x0050, 0x8055, 0x805F, 0x005A, 0x804B, 0x004E, 0x0044, 0x8041,
+		0x80C3, 0x00C6, 0x00CC, 0x80C9, 0x00D8, 0x80DD, 0x80D7, 0x00D2,
+		0x00F0, 0x80F5, 0x80FF, 0x00FA, 0x80EB, 0x00EE, 0x00E4, 0x80E1,
+		0x00A0, 0x80A5, 0x80AF, 0x00AA, 0x80BB, 0x00BE, 0x00B4, 0x80B1, 
+		0x8093, 0x0096, 0x009C, 0x8099, 0x0088, 0x808D, 0x8087, 0x0082, 
+		0x8183, 0x0186, 0x018C, 0x8189, 0x0198, 0x819D, 0x8197, 0x0192, 
+		0x01B0, 0x81B5, 0x81BF, 0x01BA, 0x81AB, 0x01AE, 0x01A4, 0x81A1, 
+		0x01E0, 0x81E5, 0x81EF, 0x01EA, 0x81FB, 0x01FE, 0x01F4, 0x81F1, 
+		0x81D3, 0x01D6, 0x01DC, 0x81D9, 0x01C8, 0x81CD, 0x81C7, 0x01C2, 
+		0x0140, 0x8145, 0x814F, 0x014A, 0x815B, 0x015E, 0x0154, 0x8151, 
+		0x8173, 0x0176, 0x017C, 0x8179, 0x0168, 0x816D, 0x8167, 0x0162, 
+		0x8123, 0x0126, 0x012C, 0x8129, 0x0138, 0x813D, 0x8137, 0x0132, 
+		0x0110, 0x8115, 0x811F, 0x011A, 0x810B, 0x010E, 0x0104, 0x8101, 
+		0x8303, 0x0306, 0x030C, 0x8309, 0x0318, 0x831D, 0x8317, 0x0312, 
+		0x0330, 0x8335, 0x833F, 0x033A, 0x832B, 0x032E, 0x0324, 0x8321, 
+		0x0360, 0x8365, 0x836F, 0x036A, 0x837B, 0x037E, 0x0374, 0x8371, 
+		0x8353, 0x0356, 0x035C, 0x8359, 0x0348, 0x834D, 0x8347, 0x0342, 
+		0x03C0, 0x83C5, 0x83CF, 0x03CA, 0x83DB, 0x03DE, 0x03D4, 0x83D1, 
+		0x83F3, 0x03F6, 0x03FC, 0x83F9, 0x03E8, 0x83ED, 0x83E7, 0x03E2, 
+		0x83A3, 0x03A6, 0x03AC, 0x83A9, 0x03B8, 0x83BD, 0x83B7, 0x03B2, 
+		0x0390, 0x8395, 0x839F, 0x039A, 0x838B, 0x038E, 0x0384, 0x8381, 
+		0x0280, 0x8285, 0x828F, 0x028A, 0x829B, 0x029E, 0x0294, 0x8291, 
+		0x82B3, 0x02B6, 0x02BC, 0x82B9, 0x02A8, 0x82AD, 0x82A7, 0x02A2, 
+		0x82E3, 0x02E6, 0x02EC, 0x82E9, 0x02F8, 0x82FD, 0x82F7, 0x02F2, 
+		0x02D0, 0x82D5, 0x82DF, 0x02DA, 0x82CB, 0x02CE, 0x02C4, 0x82C1, 
+		0x8243, 0x0246, 0x024C, 0x8249, 0x0258, 0x825D, 0x8257, 0x0252, 
+		0x0270, 0x8275, 0x827F, 0x027A, 0x826B, 0x026E, 0x0264, 0x8261, 
+		0x0220, 0x8225, 0x822F, 0x022A, 0x823B, 0x023E, 0x0234, 0x8231, 
+		0x8213, 0x0216, 0x021C, 0x8219, 0x0208, 0x820D, 0x8207, 0x0202
+};
+
+static uint16_t getCRC16_KRS(const uint8_t* buffer, uint32_t l)
+{
+  uint32_t i;
+  uint16_t val=0;
+
+  for (i = 0; i < l; i++)
+  {
+    val = ((val & 0xFF) << 8) ^ KRS_CRC16_TABLE[((val >> 8) & 0xFF) ^ buffer[i]];
+  }
+  return val;
+}
+
+/* 비트 단위 기준 ------------------------------------------------------------*/
+static u16_t Crc16_Bitwise(const u08_t buf[], u32_t len)
+{
+  u16_t crc = 0U;
+  u32_t i;
+  u08_t b;
+
+  for (i = 0U; i < len; i++)
+  {
+    crc ^= (u16_t)((u16_t)buf[i] << 8);
+    for (b = 0U; b < 8U; b++)
+    {
+      crc = ((crc & 0x8000U) != 0U) ? (u16_t)((crc << 1) ^ 0x8005U) : (u16_t)(crc << 1);
+    }
+  }
+  return crc;
+}
+
+/* 시험 ----------------------------------------------------------------------*/
+#define TEST_LEN     300U
+#define STR_(x)      #x
+#define STR(x)       STR_(x)
+
+static u08_t _buf[TEST_LEN + 8U];
+
+/** \brief 표준 check 값, 기존 table이 0x8005 table인지 */
+static void Test_Reference(void)
+{
+  static const u08_t check[9] = { '1', '2', '3', '4', '5', '6', '7', '8', '9' };
+  u32_t i;
+  u08_t one;
+  Bool_t same = True;
+
+  CHECK_EQ(Crc16_Bitwise(check, 9U), CRC16_KRS_CHECK);
+  CHECK_EQ(getCRC16_KRS(check, 9U), CRC16_KRS_CHECK);
+  CHECK_EQ(Crc16_Krs(check, 9U), CRC16_KRS_CHECK);
+  for (i = 0U; i < 256U; i++)                          /* table[i] = CRC(i, 0) */
+  {
+    one = (u08_t)i;
+    if ((KRS_CRC16_TABLE[i] != Crc16_Bitwise(&one, 1U)) || (Crc16_Krs_Byte(0U, one) != KRS_CRC16_TABLE[i]))
+    {
+      same = False;
+    }
+  }
+  CHECK(same == True);
+  CHECK(Crc16_Krs_Self_Test() == True);
+}
+
+/** \brief 길이 0 ~ TEST_LEN, 정렬 안 된 시작 주소에서 기존 구현과 같은 값 */
+static void Test_Conformance(void)
+{
+  u32_t len, off, i, bad = 0U, n = 0U;
+  u16_t ref, crc;
+
+  srand(12);
+  for (i = 0U; i < sizeof(_buf); i++)
+  {
+    _buf[i] = (u08_t)rand();
+  }
+  for (off = 0U; off < 8U; off++)
+  {
+    for (len = 0U; len <= TEST_LEN; len++)
+    {
+      ref = getCRC16_KRS(&_buf[off], len);
+      if ((Crc16_Bitwise(&_buf[off], len) != ref) || (Crc16_Krs(&_buf[off], len) != ref) ||
+          (Crc16_Krs_Bytewise(&_buf[off], len) != ref))
+      {
+        bad++;
+      }
+      crc = CRC16_KRS_INIT;
+      for (i = 0U; i < len; i++)
+      {
+        crc = Crc16_Krs_Byte(crc, _buf[off + i]);
+      }
+      if (crc != ref)
+      {
+        bad++;
+      }
+      n++;
+    }
+  }
+  CHECK_EQ(bad, 0U);
+  CHECK_EQ(n, 8U * (TEST_LEN + 1U));
+
+  /* 기존 frame(STX, LEN ~ detail_code 6 byte, CRC, ETX) */
+  {
+    static const u08_t frame[10] = { 0x02U, 0x05U, 0x11U, 0x03U, 0x01U, 0x00U, 0x00U, 0x00U, 0x00U, 0x03U };
+
+    CHECK_EQ(Crc16_Krs(&frame[1], 6U), getCRC16_KRS(&frame[1], 6U));
+  }
+}
+
+/** \brief 이어 계산 : 모든 분할 위치, 여러 조각 */
+static void Test_Streaming(void)
+{
+  u32_t cut, pos, step, bad = 0U;
+  u16_t ref, crc;
+
+  ref = getCRC16_KRS(_buf, TEST_LEN);
+  for (cut = 0U; cut <= TEST_LEN; cut++)
+  {
+    crc = Crc16_Krs_Update(Crc16_Krs(_buf, cut), &_buf[cut], TEST_LEN - cut);
+    if (crc != ref)
+    {
+      bad++;
+    }
+  }
+  for (step = 1U; step <= 13U; step++)                 /* 수신 묶음 크기 */
+  {
+    crc = CRC16_KRS_INIT;
+    for (pos = 0U; pos < TEST_LEN; pos += step)
+    {
+      crc = Crc16_Krs_Update(crc, &_buf[pos], ((pos + step) <= TEST_LEN) ? step : (TEST_LEN - pos));
+    }
+    if (crc != ref)
+    {
+      bad++;
+    }
+  }
+  CHECK_EQ(bad, 0U);
+}
+
+/** \brief host clock(nsec) */
+static u32_t Host_Clock(void)
+{
+  struct timespec ts;
+
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (u32_t)(((u32_t)ts.tv_sec * 1000000000UL) + (u32_t)ts.tv_nsec);
+}
+
+/** \brief host 1회 시간(참고용) */
+static void Bench(void)
+{
+  static const u32_t lens[] = { 6U, 36U, 64U, 256U };
+  u32_t k, byte_ns, slice_ns;
+
+  for (k = 0U; k < (sizeof(lens) / sizeof(lens[0])); k++)
+  {
+    Crc16_Krs_Bench(_buf, lens[k], 20000U, &Host_Clock, &byte_ns, &slice_ns);
+    printf("  host slice %d, %3u byte : bytewise %4u nsec, Crc16_Krs %4u nsec\n",
+           CRC16_KRS_SLICE, (unsigned)lens[k], (unsigned)byte_ns, (unsigned)slice_ns);
+  }
+}
+
+int main(void)
+{
+  Test_Reference();
+  Test_Conformance();
+  Test_Streaming();
+  Bench();
+  return HT_RESULT("test_crc16.slice" STR(CRC16_KRS_SLICE));
+}
+
+/*************** (C) COPYRIGHT SHALOM ENGINEERING CO., LTD. ****END OF FILE****/
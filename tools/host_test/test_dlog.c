@@ -0,0 +1,360 @@
+/** ****************************************************************************
+  * \file    test_dlog.c
+  * \author  Jang Ho Jong
+  * \version V0.0.1
+  * \date    2026.10.17
+  * \brief   지연 binary 로그(dlog)와 PC 복원 도구 host 시험
+  * ***************************************************************************/
+/*
+  - 콘솔 UART 대신 송신 byte를 버퍼에 모아 dlog frame의 머리, record, CRC16, 버린 record 누계,
+    송신 버퍼 여유에 따른 분할과 재송신, TEXT 모드, 레벨/모듈 거르기를 확인한다.
+  - 여러 형식의 record 900개를 콘솔 글자와 섞어 파일로 쓰고 tools/dlog_decode.py에
+    이 실행 파일(ELF)과 함께 넘겨 복원한 줄이 printf 결과와 같은지 확인한다.
+    형식 문자열 주소가 28bit 안에 들도록 -no-pie로 빌드한다(run.sh). python3가 없으면 건너뛴다.
+  */
+
+#include <stdlib.h>
+#include <string.h>
+#include <stdarg.h>
+#include "host_test.h"
+#include "dlog.h"
+#include "device.h"
+#include "lib_crc16.h"
+
+/* 대체 콘솔 UART -------------------------------------------------------------*/
+#define CAP_SIZE   65536U
+#define TEXT_SIZE  4096U
+
+static Rs232_t  _serial3 = { .printf_size = 128U };
+Rs232_t       * serial3  = &_serial3;
+static u08_t    _cap[CAP_SIZE];                        /* 보낸 byte */
+static u32_t    _capLen;
+static u32_t    _room    = 1024U;                      /* Rs232_Get_Tx_Free() 값 */
+static Bool_t   _refuse;                               /* True면 Rs232_Write()가 받지 않음 */
+static char     _text[TEXT_SIZE];                      /* cprintf() 출력 */
+static u32_t    _textLen;
+
+u32_t Rs232_Get_Tx_Free(const Rs232_t * rs)
+{
+  (void)rs;
+  return _room;
+}
+
+u32_t Rs232_Write(Rs232_t * rs, const u08_t data[], u32_t count, Bool_t crlf)
+{
+  (void)rs;
+  (void)crlf;
+  if ((_refuse == True) || ((_capLen + count) > CAP_SIZE))
+  {
+    return 0U;
+  }
+  memcpy(&_cap[_capLen], data, count);
+  _capLen += count;
+  return count;
+}
+
+void cprintf(const char_t format[], ...)
+{
+  va_list ap;
+  int     n;
+
+  va_start(ap, format);
+  n = vsnprintf(&_text[_textLen], TEXT_SIZE - _textLen, format, ap);
+  va_end(ap);
+  if (n > 0)
+  {
+    _textLen += (u32_t)n;
+  }
+}
+
+/** \brief 콘솔 글자를 보낸 byte 사이에 섞는다 */
+static void Console(const char * s)
+{
+  (void)Rs232_Write(serial3, (const u08_t *)s, (u32_t)strlen(s), False);
+}
+
+static u32_t Get32(const u08_t * p)
+{
+  return (u32_t)p[0] | ((u32_t)p[1] << 8) | ((u32_t)p[2] << 16) | ((u32_t)p[3] << 24);
+}
+
+/** \brief 모두 비우고 다시 시작 */
+static void Reset(void)
+{
+  Dlog_Init();
+  _capLen  = 0U;
+  _textLen = 0U;
+  _text[0] = '\0';
+  _room    = 1024U;
+  _refuse  = False;
+}
+
+/* 시험 ----------------------------------------------------------------------*/
+/** \brief frame 하나의 머리, record, CRC */
+static void Test_Frame(void)
+{
+  static const char_t fmt[] = "A %d %d\n";
+  DlogStat_t st;
+  u16_t      crc;
+
+  Reset();
+  g_host_usec = 1000U;
+  DLOG2(fmt, 1, -2);
+  Dlog_Thread();
+  CHECK_EQ(_capLen, DLOG_FRAME_HEAD + 16U + 2U);
+  CHECK_EQ(_cap[0], 'D');
+  CHECK_EQ(_cap[1], 'L');
+  CHECK_EQ(_cap[2], DLOG_FRAME_VER);
+  CHECK_EQ(_cap[3], 4U);
+  CHECK_EQ(Get32(&_cap[8]), 0U);                       /* 버린 record 누계 */
+  CHECK_EQ(Get32(&_cap[12]), (((u32_t)(uintptr_t)fmt) & 0x0FFFFFFFUL) | (2UL << 28));
+  CHECK_EQ(Get32(&_cap[16]), 1000U);
+  CHECK_EQ(Get32(&_cap[20]), 1U);
+  CHECK_EQ(Get32(&_cap[24]), 0xFFFFFFFEUL);
+  crc = Crc16_Krs(_cap, _capLen - 2U);
+  CHECK_EQ(_cap[_capLen - 2U], crc & 0xFFU);
+  CHECK_EQ(_cap[_capLen - 1U], crc >> 8);
+  Dlog_Get_Stat(&st);
+  CHECK_EQ(st.records, 1U);
+  CHECK_EQ(st.frames, 1U);
+  CHECK_EQ(st.bytes, _capLen);
+  CHECK_EQ(st.used, 0U);
+  CHECK_EQ(st.mode, kDLOG_BIN);
+}
+
+/** \brief 송신 버퍼 여유만큼 record를 통째로 담고, 못 보내면 다음에 다시 보냄 */
+static void Test_Room(void)
+{
+  DlogStat_t st;
+
+  Reset();
+  DLOG2("B %d %d\n", 1, 2);                            /* 4 word */
+  DLOG0("C\n");                                        /* 2 word */
+  _room = DLOG_FRAME_HEAD + 2U + (3U * 4U);            /* 3 word : 첫 record도 들어가지 않음 */
+  Dlog_Thread();
+  CHECK_EQ(_capLen, 0U);
+  _room = DLOG_FRAME_HEAD + 2U + (5U * 4U);            /* 5 word : 첫 record만 */
+  Dlog_Thread();
+  CHECK_EQ(_capLen, DLOG_FRAME_HEAD + 16U + 2U);
+  CHECK_EQ(_cap[3], 4U);
+
+  _refuse = True;                                      /* 송신 버퍼에 넣지 못함 */
+  _room   = 1024U;
+  Dlog_Thread();
+  Dlog_Get_Stat(&st);
+  CHECK_EQ(st.used, 2U);
+  CHECK_EQ(st.frames, 1U);
+  _refuse = False;
+  Dlog_Thread();
+  Dlog_Get_Stat(&st);
+  CHECK_EQ(st.used, 0U);
+  CHECK_EQ(st.frames, 2U);
+  CHECK_EQ(_cap[DLOG_FRAME_HEAD + 18U + 3U], 2U);
+}
+
+/** \brief ring이 차면 버리고 세며, 누계가 frame에 실림 */
+static void Test_Drops(void)
+{
+  DlogStat_t st;
+  u32_t      i;
+
+  Reset();
+  for (i = 0U; i < (DLOG_RING_WORDS / 2U) + 10U; i++)
+  {
+    DLOG0("D\n");
+  }
+  Dlog_Get_Stat(&st);
+  CHECK_EQ(st.records, (DLOG_RING_WORDS / 2U) - 1U);   /* ring은 1 word를 비워 둠 */
+  CHECK_EQ(st.drops, 11U);
+  CHECK_EQ(st.peak, DLOG_RING_WORDS - 2U);
+  Dlog_Thread();
+  CHECK_EQ(_cap[3], DLOG_FRAME_WORDS);
+  CHECK_EQ(Get32(&_cap[8]), 11U);
+}
+
+/** \brief TEXT 모드는 cprintf()로 DLOG_TEXT_RECORDS개씩 */
+static void Test_Text(void)
+{
+  u32_t i;
+
+  Reset();
+  CHECK(Dlog_Set_Mode(kDLOG_TEXT) == True);
+  CHECK(Dlog_Set_Mode(kNbrOfDlogModes) == False);
+  for (i = 0U; i < (DLOG_TEXT_RECORDS + 1U); i++)
+  {
+    DLOG3("T %d %u %s\n", -(i32_t)i, i, "ok");
+  }
+  Dlog_Thread();
+  CHECK_EQ(_capLen, 0U);
+  CHECK(strcmp(_text, "T 0 0 ok\nT -1 1 ok\nT -2 2 ok\nT -3 3 ok\n") == 0);
+  Dlog_Thread();
+  CHECK(strcmp(_text, "T 0 0 ok\nT -1 1 ok\nT -2 2 ok\nT -3 3 ok\nT -4 4 ok\n") == 0);
+
+  Reset();
+  CHECK(Dlog_Set_Mode(kDLOG_OFF) == True);
+  DLOG0("O\n");
+  Dlog_Thread();
+  CHECK_EQ(_capLen, 0U);
+  CHECK_EQ(_textLen, 0U);
+}
+
+/** \brief 모듈별 실행 레벨과 LOG_LEVEL_BUILD */
+static void Test_Level(void)
+{
+  DlogStat_t st;
+
+  Reset();
+  LOG1(INFO, RS485, "I %d\n", 1);
+  LOG1(DEBUG, RS485, "G %d\n", 2);                     /* 실행 레벨 INFO : 기록하지 않음 */
+  Dlog_Get_Stat(&st);
+  CHECK_EQ(st.records, 1U);
+  CHECK(Dlog_Set_Level(kLOG_RS485, LOG_LVL_TRACE) == True);
+  CHECK(Dlog_Set_Level(kNbrOfLogMods, LOG_LVL_INFO) == False);
+  CHECK(Dlog_Set_Level(kLOG_DEOD, LOG_LVL_TRACE + 1U) == False);
+  LOG1(DEBUG, RS485, "G %d\n", 3);
+  LOG1(TRACE, RS485, "R %d\n", 4);                     /* LOG_LEVEL_BUILD(DEBUG)에서 빠짐 */
+  LOG1(DEBUG, DEOD, "E %d\n", 5);                      /* 다른 모듈은 INFO 그대로 */
+  Dlog_Get_Stat(&st);
+  CHECK_EQ(st.records, 2U);
+}
+
+/* PC 도구 복원 ----------------------------------------------------------------*/
+#define DEC_RECORDS  900U
+#define DEC_LINE     96U
+
+static char _expect[DEC_RECORDS][DEC_LINE];
+
+/** \brief 형식 i % 7의 record 하나를 남기고 도구가 낼 줄을 만든다 */
+static void Dec_Record(u32_t i)
+{
+  static const char_t * const state[2] = { "CLEAR", "DETECT" };
+  char   *e = _expect[i];
+  i32_t   v = (i32_t)(i * 37U) - 9000;
+  u32_t   q;
+  int     n;
+
+  g_host_usec = (i * 1234U) + 7U;
+  n = snprintf(e, DEC_LINE, "[%11.6f] ", g_host_usec / 1000000.0);
+  switch (i % 7U)
+  {
+  case 0U :
+    DLOG2("SENSOR%d = %d mV\n", i % 4U, v);
+    (void)snprintf(&e[n], DEC_LINE - n, "SENSOR%d = %d mV", (int)(i % 4U), (int)v);
+    break;
+  case 1U :
+    DLOG3("Node %u Seq %u Skew %x\n", i % 7U, i * 100000U, i);
+    (void)snprintf(&e[n], DEC_LINE - n, "Node %u Seq %u Skew %x", i % 7U, i * 100000U, i);
+    break;
+  case 2U :
+    DLOG2("Frame 0x%08X Err %5d\n", i * 0x01010101U, v);
+    (void)snprintf(&e[n], DEC_LINE - n, "Frame 0x%08X Err %5d", i * 0x01010101U, (int)v);
+    break;
+  case 3U :
+    DLOG2("Ch %c State %s\n", 'A' + (i % 4U), state[i & 1U]);
+    (void)snprintf(&e[n], DEC_LINE - n, "Ch %c State %s", (int)('A' + (i % 4U)), state[i & 1U]);
+    break;
+  case 4U :
+    DLOG1("Temp %.3q C\n", v);                         /* 0.001 단위 고정소수점 */
+    q = (u32_t)((v < 0) ? -v : v);
+    (void)snprintf(&e[n], DEC_LINE - n, "Temp %s%u.%03u C", (v < 0) ? "-" : "", q / 1000U, q % 1000U);
+    break;
+  case 5U :
+    DLOG0("No Arg Event\n");
+    (void)snprintf(&e[n], DEC_LINE - n, "No Arg Event");
+    break;
+  default :
+    DLOG4("%d %d %d %d\n", i, v, -1, 0);
+    (void)snprintf(&e[n], DEC_LINE - n, "%d %d %d %d", (int)i, (int)v, -1, 0);
+    break;
+  }
+}
+
+/** \brief record 900개를 콘솔 글자와 섞어 보내고 dlog_decode.py로 복원 */
+static void Test_Decode(const char * self)
+{
+  const char *root = getenv("HOST_TEST_ROOT");
+  const char *out  = getenv("HOST_TEST_OUT");
+  char        cap[512], txt[512], cmd[2048], line[256];
+  DlogStat_t  st;
+  FILE       *f;
+  u32_t       i, n;
+
+  Reset();
+  for (i = 0U; i < DEC_RECORDS; i++)
+  {
+    Dec_Record(i);
+    if ((i % 13U) == 12U)
+    {
+      for (n = 0U; n < 4U; n++)
+      {
+        _room = 60U + (((i + n) * 7U) % 240U);         /* frame 크기가 매번 다름 */
+        Dlog_Thread();
+      }
+      Console("console text DL\r\n");                  /* 'D','L'이 섞인 콘솔 글자 */
+    }
+  }
+  _room = 1024U;
+  for (i = 0U; i < 100U; i++)
+  {
+    Dlog_Thread();
+  }
+  Dlog_Get_Stat(&st);
+  CHECK_EQ(st.used, 0U);
+  CHECK_EQ(st.drops, 0U);
+
+  if ((root == NULL) || (system("python3 -c 1 > /dev/null 2>&1") != 0))
+  {
+    printf("test_dlog : python3 또는 HOST_TEST_ROOT 없음, 복원 시험 건너뜀\n");
+    return;
+  }
+  (void)snprintf(cap, sizeof(cap), "%s/test_dlog.cap", (out != NULL) ? out : "/tmp");
+  (void)snprintf(txt, sizeof(txt), "%s/test_dlog.txt", (out != NULL) ? out : "/tmp");
+  f = fopen(cap, "wb");
+  CHECK(f != NULL);
+  if (f == NULL)
+  {
+    return;
+  }
+  (void)fwrite(_cap, 1U, _capLen, f);
+  (void)fclose(f);
+  (void)snprintf(cmd, sizeof(cmd), "python3 \"%s/tools/dlog_decode.py\" \"%s\" \"%s\" > \"%s\"", root, self, cap, txt);
+  CHECK(system(cmd) == 0);
+
+  f = fopen(txt, "r");
+  CHECK(f != NULL);
+  if (f == NULL)
+  {
+    return;
+  }
+  n = 0U;
+  while (fgets(line, sizeof(line), f) != NULL)
+  {
+    line[strcspn(line, "\n")] = '\0';
+    ht_checks++;
+    if ((n >= DEC_RECORDS) || (strcmp(line, _expect[n]) != 0))
+    {
+      ht_fails++;
+      if (ht_fails < 10U)
+      {
+        printf("decode %u : \"%s\" != \"%s\"\n", n, line, (n < DEC_RECORDS) ? _expect[n] : "");
+      }
+    }
+    n++;
+  }
+  (void)fclose(f);
+  CHECK_EQ(n, DEC_RECORDS);
+}
+
+int main(int argc, char * argv[])
+{
+  (void)argc;
+  Test_Frame();
+  Test_Room();
+  Test_Drops();
+  Test_Text();
+  Test_Level();
+  Test_Decode(argv[0]);
+  return HT_RESULT("test_dlog");
+}
+
+/*************** (C) COPYRIGHT SHALOM ENGINEERING CO., LTD. ****END OF FILE****/
@@ -0,0 +1,229 @@
+/** ****************************************************************************
+  * \file    test_ossd_edge.c
+  * \author  Jang Ho Jong
+  * \version V0.0.1
+  * \date    2026.10.17
+  * \brief   OSSD edge 이벤트 host 시험
+  * ***************************************************************************/
+/*
+  - 시험이 정한 edge 열을 Device_Ossd_Edge_Get() 대신 넣고 Ossd_Edge_Process()가 만든
+    확정 level, glitch, skew, 불일치, 한쪽 pulse 통계를 확인한다.
+  - skew는 반대쪽이 따라 바뀐 경우만, 먼저 바뀐 쪽이 혼자 되돌아온 경우는 pulse로 세는지 본다.
+  */
+
+#include <string.h>
+#include "host_test.h"
+#include "ossd_edge.h"
+#include "device.h"
+
+/* 대체 EXTI edge ring ---------------------------------------------------------*/
+#define EDGE_MAX  32U
+
+static OssdEdge_t _edge[EDGE_MAX];
+static u32_t      _edgeHead;
+static u32_t      _edgeTail;
+static u32_t      _overflow;
+static InSnap_t   _snap;
+
+Bool_t Device_Ossd_Edge_Get(OssdEdge_t * edge)
+{
+  if (_edgeTail == _edgeHead)
+  {
+    return False;
+  }
+  *edge = _edge[_edgeTail % EDGE_MAX];
+  _edgeTail++;
+  return True;
+}
+
+u32_t Device_Ossd_Edge_Count(u08_t pin)
+{
+  (void)pin;
+  return 0U;
+}
+
+u32_t Device_Ossd_Edge_Overflow(void)
+{
+  return _overflow;
+}
+
+void Device_Ossd_Edge_Clear_Count(void)
+{
+}
+
+void Device_Input_Snapshot(InSnap_t * snap)
+{
+  *snap = _snap;
+}
+
+/** \brief edge 하나를 ring에 넣는다 */
+static void Edge(u08_t pin, u08_t level, u32_t usec)
+{
+  _edge[_edgeHead % EDGE_MAX].pin   = pin;
+  _edge[_edgeHead % EDGE_MAX].level = level;
+  _edge[_edgeHead % EDGE_MAX].usec  = usec;
+  _edgeHead++;
+}
+
+/** \brief usec 시각에서 Process() 한번 */
+static void Process_At(u32_t usec)
+{
+  g_host_usec = usec;
+  Ossd_Edge_Process();
+}
+
+/** \brief 모든 입력 Low로 다시 시작 */
+static void Reset(void)
+{
+  u08_t o1, o2;
+
+  _edgeHead = 0U;
+  _edgeTail = 0U;
+  _overflow = 0U;
+  memset(&_snap, 0, sizeof(_snap));
+  g_host_usec = 0U;
+  (void)Ossd_Edge_Set_Glitch(OSSD_GLITCH_usec);
+  Ossd_Edge_Init();
+  Ossd_Edge_Take(&o1, &o2);                            /* 앞 시험의 High latch를 지움 */
+}
+
+/* 시험 ----------------------------------------------------------------------*/
+/** \brief 반대쪽이 따라 바뀌면 skew */
+static void Test_Follow(void)
+{
+  OssdSenStat_t s;
+  u08_t o1, o2;
+
+  Reset();
+  Edge(kSO_1, 1U, 1000U);
+  Process_At(1500U);                                   /* OSSD1 확정, 불일치 시작 */
+  Edge(kSO_2, 1U, 1300U);
+  Process_At(2000U);
+  Ossd_Edge_Get_Sen_Stat(kSI_1, &s);
+  CHECK_EQ(s.skew_last, 300U);
+  CHECK_EQ(s.skew_max, 300U);
+  CHECK_EQ(s.pulse, 0U);
+  CHECK_EQ(s.discrepancy, 0U);
+  Ossd_Edge_Take(&o1, &o2);
+  CHECK_EQ(o1, 0x01U);
+  CHECK_EQ(o2, 0x01U);
+
+  Edge(kSO_2, 0U, 3000U);                              /* 내려갈 때는 OSSD2가 먼저 */
+  Edge(kSO_1, 0U, 3050U);
+  Process_At(4000U);
+  Ossd_Edge_Get_Sen_Stat(kSI_1, &s);
+  CHECK_EQ(s.skew_last, 50U);
+  CHECK_EQ(s.skew_max, 300U);
+  CHECK_EQ(s.pulse, 0U);
+
+  Edge(kSO_1, 1U, 50000U);                             /* 한 번에 처리해도 edge 시각 순서로 확정 */
+  Edge(kSO_2, 1U, 50400U);
+  Edge(kSO_2, 0U, 60000U);
+  Edge(kSO_1, 0U, 60100U);
+  Process_At(61000U);
+  Ossd_Edge_Get_Sen_Stat(kSI_1, &s);
+  CHECK_EQ(s.skew_last, 100U);
+  CHECK_EQ(s.skew_max, 400U);
+  CHECK_EQ(s.pulse, 0U);
+}
+
+/** \brief 먼저 바뀐 쪽이 혼자 되돌아오면 skew가 아니라 pulse */
+static void Test_Pulse(void)
+{
+  OssdSenStat_t s;
+  u08_t o1, o2;
+
+  Reset();
+  Edge(kSO_1, 1U, 1000U);
+  Edge(kSO_2, 1U, 1100U);
+  Process_At(2000U);
+  Ossd_Edge_Get_Sen_Stat(kSI_1, &s);
+  CHECK_EQ(s.skew_last, 100U);
+
+  Edge(kSO_1, 0U, 10000U);                             /* OSSD1만 1msec Low */
+  Edge(kSO_1, 1U, 11000U);
+  Process_At(12000U);
+  Ossd_Edge_Get_Sen_Stat(kSI_1, &s);
+  CHECK_EQ(s.pulse, 1U);
+  CHECK_EQ(s.skew_last, 100U);                         /* 1000usec가 skew로 잡히면 안됨 */
+  CHECK_EQ(s.skew_max, 100U);
+  CHECK_EQ(s.discrepancy, 0U);
+
+  Reset();
+  Edge(kSO_3, 1U, 20000U);                             /* OSSD1만 10msec High, 한 번에 처리 */
+  Edge(kSO_3, 0U, 30000U);
+  Process_At(31000U);
+  Ossd_Edge_Get_Sen_Stat(kSI_2, &s);
+  CHECK_EQ(s.pulse, 1U);
+  CHECK_EQ(s.skew_last, 0U);
+  CHECK_EQ(s.discrepancy, 1U);                         /* Process() 사이에 끝난 긴 불일치도 셈 */
+  Ossd_Edge_Take(&o1, &o2);
+  CHECK_EQ(o1, 0x02U);                                 /* 판정 주기 안의 pulse도 반영 */
+  CHECK_EQ(o2, 0x00U);
+  Ossd_Edge_Take(&o1, &o2);
+  CHECK_EQ(o1, 0x00U);
+}
+
+/** \brief 늦게 따라오면 skew와 불일치를 한번씩 */
+static void Test_Discrepancy(void)
+{
+  OssdSenStat_t s;
+
+  Reset();
+  Edge(kSO_5, 1U, 1000U);
+  Process_At(1500U);
+  Process_At(1000U + OSSD_DISCREPANCY_usec);           /* 진행 중 불일치 */
+  Ossd_Edge_Get_Sen_Stat(kSI_3, &s);
+  CHECK_EQ(s.discrepancy, 1U);
+  Edge(kSO_6, 1U, 8000U);
+  Process_At(9000U);
+  Ossd_Edge_Get_Sen_Stat(kSI_3, &s);
+  CHECK_EQ(s.discrepancy, 1U);                         /* 이미 셈 */
+  CHECK_EQ(s.skew_last, 7000U);
+  CHECK_EQ(s.pulse, 0U);
+
+  Edge(kSO_7, 1U, 20000U);                             /* 한 번에 처리되는 늦은 추종 */
+  Edge(kSO_8, 1U, 27000U);
+  Process_At(28000U);
+  Ossd_Edge_Get_Sen_Stat(kSI_4, &s);
+  CHECK_EQ(s.discrepancy, 1U);
+  CHECK_EQ(s.skew_last, 7000U);
+}
+
+/** \brief 짧은 pulse는 glitch, overflow 후에는 먼저 바뀐 쪽을 모름 */
+static void Test_Glitch_Resync(void)
+{
+  OssdSenStat_t s;
+  OssdPinStat_t p;
+
+  Reset();
+  Edge(kSO_1, 1U, 1000U);
+  Edge(kSO_1, 0U, 1100U);
+  Process_At(2000U);
+  Ossd_Edge_Get_Pin_Stat(kSO_1, &p);
+  CHECK_EQ(p.glitch, 1U);
+  CHECK_EQ(p.accepted, 0U);
+  Ossd_Edge_Get_Sen_Stat(kSI_1, &s);
+  CHECK_EQ(s.pulse, 0U);
+
+  _snap.ossd1 = 0x01U;                                 /* edge를 잃고 OSSD1만 High */
+  _overflow++;
+  Process_At(3000U);
+  CHECK_EQ(Ossd_Edge_Resync_Count(), 1U);
+  Edge(kSO_2, 1U, 3500U);
+  Process_At(4000U);
+  Ossd_Edge_Get_Sen_Stat(kSI_1, &s);
+  CHECK_EQ(s.skew_last, 0U);
+  CHECK_EQ(s.pulse, 0U);
+}
+
+int main(void)
+{
+  Test_Follow();
+  Test_Pulse();
+  Test_Discrepancy();
+  Test_Glitch_Resync();
+  return HT_RESULT("test_ossd_edge");
+}
+
+/*************** (C) COPYRIGHT SHALOM ENGINEERING CO., LTD. ****END OF FILE****/
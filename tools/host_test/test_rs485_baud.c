@@ -0,0 +1,223 @@
+/** ****************************************************************************
+  * \file    test_rs485_baud.c
+  * \author  Jang Ho Jong
+  * \version V0.0.1
+  * \date    2026.10.17
+  * \brief   RS-485 통신 속도 협상 host 시험
+  * ***************************************************************************/
+/*
+  - 마스터(rs485_baud.c)와 슬레이브(rs485_baud_slave.c, 같은 소스의 두번째 상태)로
+    rs485com_thread.c의 협상 순서(PROPOSE -> ACK -> COMMIT)를 frame 없이 따라 돌린다.
+    슬레이브 상태 하나를 보드마다 설정 최대 속도만 바꿔 쓴다.
+  - 확인 :
+    PROPOSE/ACK : 모든 보드가 답하면 답한 속도 중 최소를 고른다.
+    ACK 누락    : 한 보드라도 답이 없으면 기본 속도를 고른다.
+    오류 되돌림 : RS485_BAUD_ERR_WINDOW(32) frame 창 안에 오류 RS485_BAUD_ERR_MAX(2)개면
+                  기본 속도로 되돌리고 허용 속도를 한 단계 낮춘다. 창이 지나면 오류 수를 지운다.
+    무수신 복귀 : 슬레이브는 기본 속도가 아닐 때 RS485_BAUD_SILENCE_msec(300) 동안 정상 frame이 없으면 되돌린다.
+  */
+
+#include <string.h>
+#include "host_test.h"
+#include "rs485_baud.h"
+
+/* rs485_baud_slave.c : 슬레이브 쪽 상태 */
+extern void        Slave_Baud_Init(Rs485Baud_t max);
+extern Rs485Baud_t Slave_Baud_Current(void);
+extern void        Slave_Baud_Commit(Rs485Baud_t code, u32_t tick);
+extern Rs485Baud_t Slave_Baud_Accept(Rs485Baud_t proposed);
+extern void        Slave_Baud_Rx_Ok(u32_t tick);
+extern Bool_t      Slave_Baud_Is_Silent(u32_t tick);
+extern void        Slave_Baud_Get_Info(Rs485BaudInfo_t * info);
+
+#define NODES      3U
+
+/** \brief 마스터가 nodes 보드와 협상한다(Rs485_Baud_Master_Process()의 순서).
+  * \param  max   - 보드별 설정 최대 속도
+  * \param  alive - 답하는 보드 bitmap(bit0 = ID 1)
+  * \retval COMMIT한 속도
+  */
+static Rs485Baud_t Negotiate(u08_t nodes, const Rs485Baud_t max[], u08_t alive)
+{
+  Rs485Baud_t propose, code;
+  u08_t id;
+
+  CHECK(Rs485_Baud_Need_Negotiation() == True);
+  propose = Rs485_Baud_Neg_Start(nodes);
+  CHECK(Rs485_Baud_Need_Negotiation() == False);
+  for (id = 1U; id <= nodes; id++)                     /* BAUD_PROPOSE(id) -> BAUD_ACK */
+  {
+    if ((alive & (1U << (id - 1U))) != 0U)
+    {
+      Slave_Baud_Init(max[id - 1U]);
+      Rs485_Baud_Neg_Ack(id, Slave_Baud_Accept(propose));
+    }
+  }
+  code = Rs485_Baud_Neg_Result();
+  Rs485_Baud_Commit(code, g_host_tick);                /* 두번째 BAUD_COMMIT 송신 뒤 */
+  return code;
+}
+
+/** \brief 속도 번호와 bps 변환, 초기화 */
+static void Test_Code(void)
+{
+  Rs485BaudInfo_t info;
+
+  CHECK_EQ(Rs485_Baud_Rate(kRS485_BAUD_38400), 38400U);
+  CHECK_EQ(Rs485_Baud_Rate(kRS485_BAUD_460800), 460800U);
+  CHECK_EQ(Rs485_Baud_Rate(kNbrOfRs485Bauds), 38400U);
+  CHECK_EQ(Rs485_Baud_Code(230400U), kRS485_BAUD_230400);
+  CHECK_EQ(Rs485_Baud_Code(57600U), kNbrOfRs485Bauds);
+
+  Rs485_Baud_Init(kNbrOfRs485Bauds);                   /* 잘못된 최대 속도는 기본 속도 */
+  CHECK_EQ(Rs485_Baud_Current(), RS485_BAUD_BASE);
+  CHECK(Rs485_Baud_Need_Negotiation() == False);
+  Rs485_Baud_Init(kRS485_BAUD_460800);
+  Rs485_Baud_Get_Info(&info);
+  CHECK_EQ(info.cur, RS485_BAUD_BASE);                 /* 전원 투입 시 모든 보드 공통 속도 */
+  CHECK_EQ(info.cap, kRS485_BAUD_460800);
+  CHECK(Rs485_Baud_Need_Negotiation() == True);
+  CHECK(Rs485_Baud_Set_Max(kNbrOfRs485Bauds) == False);
+}
+
+/** \brief PROPOSE/ACK : 제안 속도는 허용 최대, 결과는 답한 속도 중 최소 */
+static void Test_Propose_Min(void)
+{
+  static const Rs485Baud_t max[NODES] = { kRS485_BAUD_460800, kRS485_BAUD_115200, kRS485_BAUD_230400 };
+  Rs485BaudInfo_t info;
+
+  Slave_Baud_Init(kRS485_BAUD_230400);
+  CHECK_EQ(Slave_Baud_Accept(kRS485_BAUD_460800), kRS485_BAUD_230400);
+  CHECK_EQ(Slave_Baud_Accept(kRS485_BAUD_115200), kRS485_BAUD_115200);
+  CHECK_EQ(Slave_Baud_Accept(kNbrOfRs485Bauds), RS485_BAUD_BASE);
+
+  Rs485_Baud_Init(kRS485_BAUD_460800);
+  CHECK_EQ(Rs485_Baud_Neg_Start(NODES), kRS485_BAUD_460800);
+  Rs485_Baud_Neg_Ack(0U, kRS485_BAUD_38400);           /* 범위 밖 ID, 잘못된 속도는 무시 */
+  Rs485_Baud_Neg_Ack(NODES + 1U, kRS485_BAUD_38400);
+  Rs485_Baud_Neg_Ack(1U, kNbrOfRs485Bauds);
+  Rs485_Baud_Get_Info(&info);
+  CHECK_EQ(info.acked, 0U);
+  CHECK_EQ(info.agreed, kRS485_BAUD_460800);
+
+  Rs485_Baud_Init(kRS485_BAUD_460800);
+  CHECK_EQ(Negotiate(NODES, max, 0x07U), kRS485_BAUD_115200);
+  CHECK_EQ(Rs485_Baud_Current(), kRS485_BAUD_115200);
+  Rs485_Baud_Get_Info(&info);
+  CHECK_EQ(info.acked, 0x07U);
+  CHECK_EQ(info.negotiations, 1U);
+
+  Rs485_Baud_Init(kRS485_BAUD_230400);                 /* 마스터 최대가 더 낮으면 그 속도까지만 */
+  CHECK_EQ(Negotiate(1U, max, 0x01U), kRS485_BAUD_230400);
+}
+
+/** \brief ACK 누락 : 한 보드라도 답이 없으면 기본 속도 */
+static void Test_Missing_Ack(void)
+{
+  static const Rs485Baud_t max[NODES] = { kRS485_BAUD_460800, kRS485_BAUD_460800, kRS485_BAUD_460800 };
+
+  Rs485_Baud_Init(kRS485_BAUD_460800);
+  CHECK_EQ(Negotiate(NODES, max, 0x05U), RS485_BAUD_BASE);   /* ID 2 무응답(Rs485_Link_Rto 경과) */
+  CHECK_EQ(Rs485_Baud_Current(), RS485_BAUD_BASE);
+
+  Rs485_Baud_Init(kRS485_BAUD_460800);                 /* 같은 보드가 두번 답해도 채워지지 않음 */
+  (void)Rs485_Baud_Neg_Start(NODES);
+  Rs485_Baud_Neg_Ack(1U, kRS485_BAUD_460800);
+  Rs485_Baud_Neg_Ack(1U, kRS485_BAUD_460800);
+  Rs485_Baud_Neg_Ack(3U, kRS485_BAUD_460800);
+  CHECK_EQ(Rs485_Baud_Neg_Result(), RS485_BAUD_BASE);
+
+  Rs485_Baud_Init(kRS485_BAUD_460800);
+  CHECK_EQ(Negotiate(NODES, max, 0x07U), kRS485_BAUD_460800);
+}
+
+/** \brief 오류 되돌림 : 32 frame 창 안에 오류 2개면 되돌리고 한 단계 낮춰 다시 협상 */
+static void Test_Err_Fallback(void)
+{
+  static const Rs485Baud_t max[NODES] = { kRS485_BAUD_460800, kRS485_BAUD_460800, kRS485_BAUD_460800 };
+  Rs485BaudInfo_t info;
+  u32_t i;
+
+  Rs485_Baud_Init(kRS485_BAUD_460800);
+  CHECK_EQ(Negotiate(NODES, max, 0x07U), kRS485_BAUD_460800);
+
+  /* 창마다 오류 1개는 되돌리지 않음 */
+  for (i = 0U; i < 4U; i++)
+  {
+    CHECK(Rs485_Baud_Check_Errors(0U, 1U) == False);
+    CHECK(Rs485_Baud_Check_Errors(RS485_BAUD_ERR_WINDOW - 1U, 0U) == False);
+  }
+  /* 창 끝의 오류와 다음 창 첫 오류는 다른 창 */
+  CHECK(Rs485_Baud_Check_Errors(RS485_BAUD_ERR_WINDOW - 1U, 0U) == False);
+  CHECK(Rs485_Baud_Check_Errors(0U, 1U) == False);
+  CHECK(Rs485_Baud_Check_Errors(0U, 1U) == False);
+  CHECK(Rs485_Baud_Check_Errors(RS485_BAUD_ERR_WINDOW - 1U, 0U) == False);
+
+  /* 같은 창 안 두번째 오류 */
+  CHECK(Rs485_Baud_Check_Errors(10U, 1U) == False);
+  CHECK(Rs485_Baud_Check_Errors(20U, 0U) == False);
+  CHECK(Rs485_Baud_Check_Errors(0U, 1U) == True);
+  Rs485_Baud_Get_Info(&info);
+  CHECK_EQ(info.cap, kRS485_BAUD_230400);
+  CHECK_EQ(info.fallbacks, 1U);
+  CHECK(Rs485_Baud_Need_Negotiation() == True);
+
+  Rs485_Baud_Commit(RS485_BAUD_BASE, g_host_tick);     /* Rs485_Baud_Fallback() : BAUD_COMMIT(기본) */
+  CHECK(Rs485_Baud_Check_Errors(0U, 5U) == False);     /* 기본 속도에서는 되돌리지 않음 */
+  CHECK_EQ(Negotiate(NODES, max, 0x07U), kRS485_BAUD_230400);
+
+  CHECK(Rs485_Baud_Check_Errors(0U, RS485_BAUD_ERR_MAX) == True);   /* TDMA cycle 하나의 무응답 2 보드 */
+  Rs485_Baud_Commit(RS485_BAUD_BASE, g_host_tick);
+  CHECK_EQ(Negotiate(NODES, max, 0x07U), kRS485_BAUD_115200);
+  CHECK(Rs485_Baud_Check_Errors(0U, RS485_BAUD_ERR_MAX) == True);
+  Rs485_Baud_Get_Info(&info);
+  CHECK_EQ(info.cap, RS485_BAUD_BASE);
+  CHECK(Rs485_Baud_Need_Negotiation() == False);       /* 더 낮출 곳이 없으면 기본 속도에 머묾 */
+
+  CHECK(Rs485_Baud_Set_Max(kRS485_BAUD_460800) == True);    /* 콘솔 BAUD : 허용 속도 되살림 */
+  Rs485_Baud_Get_Info(&info);
+  CHECK_EQ(info.cap, kRS485_BAUD_460800);
+  CHECK(Rs485_Baud_Need_Negotiation() == True);
+}
+
+/** \brief 무수신 복귀 : 슬레이브는 빠른 속도에서 300msec 동안 정상 frame이 없으면 기본 속도로 */
+static void Test_Slave_Silence(void)
+{
+  Rs485BaudInfo_t info;
+
+  Slave_Baud_Init(kRS485_BAUD_460800);
+  CHECK(Slave_Baud_Is_Silent(1000000U) == False);       /* 기본 속도에서는 복귀할 곳이 없음 */
+
+  g_host_tick = 1000U;
+  Slave_Baud_Commit(kRS485_BAUD_230400, g_host_tick);  /* BAUD_COMMIT 수신 후 전환 */
+  CHECK_EQ(Slave_Baud_Current(), kRS485_BAUD_230400);
+  CHECK(Slave_Baud_Is_Silent(1000U + RS485_BAUD_SILENCE_msec - 1U) == False);
+  Slave_Baud_Rx_Ok(1200U);
+  CHECK(Slave_Baud_Is_Silent(1200U + RS485_BAUD_SILENCE_msec - 1U) == False);
+  CHECK(Slave_Baud_Is_Silent(1200U + RS485_BAUD_SILENCE_msec) == True);
+  Slave_Baud_Commit(RS485_BAUD_BASE, 1200U + RS485_BAUD_SILENCE_msec);    /* Rs485_Baud_Slave_Process() */
+  CHECK_EQ(Slave_Baud_Current(), RS485_BAUD_BASE);
+  CHECK(Slave_Baud_Is_Silent(1200U + (10U * RS485_BAUD_SILENCE_msec)) == False);
+  Slave_Baud_Get_Info(&info);
+  CHECK_EQ(info.fallbacks, 1U);
+
+  /* HAL_GetTick() wrap */
+  Slave_Baud_Commit(kRS485_BAUD_115200, 0xFFFFFF00U);
+  CHECK(Slave_Baud_Is_Silent(0xFFFFFF00U + RS485_BAUD_SILENCE_msec - 1U) == False);
+  CHECK(Slave_Baud_Is_Silent(0xFFFFFF00U + RS485_BAUD_SILENCE_msec) == True);
+
+  /* 되돌림 시 마스터는 RS485_BAUD_HOLD_msec 동안 쉬므로 COMMIT을 못 받은 보드도 그 안에 돌아온다 */
+  CHECK(RS485_BAUD_HOLD_msec > RS485_BAUD_SILENCE_msec);
+}
+
+int main(void)
+{
+  Test_Code();
+  Test_Propose_Min();
+  Test_Missing_Ack();
+  Test_Err_Fallback();
+  Test_Slave_Silence();
+  return HT_RESULT("test_rs485_baud");
+}
+
+/*************** (C) COPYRIGHT SHALOM ENGINEERING CO., LTD. ****END OF FILE****/
@@ -0,0 +1,276 @@
+/** ****************************************************************************
+  * \file    test_rs485_diag.c
+  * \author  Jang Ho Jong
+  * \version V0.0.1
+  * \date    2026.10.17
+  * \brief   RS-485 확장 진단 frame host 시험
+  * ***************************************************************************/
+/*
+  - 슬레이브가 만드는 진단 frame(Rs485_Diag_Collect, Build_Frame)을 마스터가
+    parser(Rs485_Frame)와 Rs485_Diag_Parse_Frame으로 꺼냈을 때 모든 값이 같은지 확인한다.
+  - 보드 상태는 아래 대체 함수(sdin, 입력 snapshot, 고장 관리, 온도)로 시험이 정한다.
+  - seq 건너뜀으로 잃은 frame 수, 보드 순환 선택도 확인한다.
+  */
+
+#include <stdlib.h>
+#include <string.h>
+#include "host_test.h"
+#include "rs485_diag.h"
+#include "rs485_frame.h"
+#include "device.h"
+#include "fault_mgr.h"
+#include "sysmon_thread.h"
+
+/* 대체 보드 상태 -------------------------------------------------------------*/
+static DEOD_t      _sensor[kNbrOfSIs];
+DEOD_t           * sdin[kNbrOfSIs] = { &_sensor[0], &_sensor[1], &_sensor[2], &_sensor[3] };
+i16_t              g_device_temper_raw;
+static InSnap_t    _snap;
+static FaultInfo_t _info;
+static u32_t       _faultCount[kNbrOfFaults];
+
+u16_t Device_ADC_To_mV(u08_t ch, u16_t code)
+{
+  return (u16_t)((((u32_t)code * 3300U) / 4095U) + ch);
+}
+
+void Device_Input_Snapshot(InSnap_t * snap)
+{
+  *snap = _snap;
+}
+
+void Fault_Get_Info(FaultInfo_t * info)
+{
+  *info = _info;
+}
+
+void Fault_Get_Stat(FaultCode_t code, FaultStat_t * stat)
+{
+  memset(stat, 0, sizeof(*stat));
+  stat->count = _faultCount[code];
+}
+
+/* 시험 ----------------------------------------------------------------------*/
+/** \brief 두 진단이 같은지 */
+static Bool_t Same(const Rs485Diag_t * a, const Rs485Diag_t * b)
+{
+  u08_t ch;
+
+  if ((a->id != b->id) || (a->seq != b->seq) || (a->uptime_msec != b->uptime_msec) ||
+      (a->ossd1 != b->ossd1) || (a->ossd2 != b->ossd2) || (a->ossd_confirmed != b->ossd_confirmed) ||
+      (a->relay_fb != b->relay_fb) || (a->temper_raw != b->temper_raw) ||
+      (a->fault_latched != b->fault_latched) || (a->fault_count != b->fault_count) ||
+      (a->fault_level != b->fault_level))
+  {
+    return False;
+  }
+  for (ch = 0U; ch < RS485_DIAG_SENSOR_NUM; ch++)
+  {
+    if (a->sensor_mv[ch] != b->sensor_mv[ch])
+    {
+      return False;
+    }
+  }
+  return True;
+}
+
+/** \brief Build -> parser -> Parse, 틀리면 False */
+static Bool_t Round_Trip(const Rs485Diag_t * in, Rs485Diag_t * out)
+{
+  static Rs485Parser_t p;
+  Rs485Frame_t f;
+  u08_t buf[RS485_DIAG_FRAME_SIZE];
+  u32_t n;
+
+  n = Rs485_Diag_Build_Frame(in, buf, sizeof(buf));
+  if (n != RS485_DIAG_FRAME_SIZE)
+  {
+    return False;
+  }
+  Rs485_Frame_Init(&p);
+  Rs485_Frame_Feed_Buf(&p, buf, n);
+  if ((Rs485_Frame_Get(&p, &f) == False) || (f.len != n))
+  {
+    return False;
+  }
+  return Rs485_Diag_Parse_Frame(f.data, f.len, out);
+}
+
+/** \brief 무작위, 경계 값 round-trip */
+static void Test_Round_Trip(void)
+{
+  Rs485Diag_t in, out;
+  u32_t i, ok = 0U;
+  u08_t ch;
+
+  CHECK(RS485_DIAG_PAYLOAD_SIZE <= RS485_FRAME_PAYLOAD_MAX);
+
+  memset(&in, 0xFF, sizeof(in));                       /* 모든 값 최대 */
+  in.temper_raw = -1;
+  CHECK(Round_Trip(&in, &out) == True);
+  CHECK(Same(&in, &out) == True);
+  memset(&in, 0, sizeof(in));
+  in.temper_raw = (i16_t)-32768;                       /* 부호 있는 값 */
+  CHECK(Round_Trip(&in, &out) == True);
+  CHECK(Same(&in, &out) == True);
+
+  srand(19);
+  for (i = 0U; i < 2000U; i++)
+  {
+    in.id             = (u08_t)(1 + rand() % RS485_DIAG_NODE_MAX);
+    in.seq            = (u16_t)rand();
+    in.uptime_msec    = ((u32_t)rand() << 16) ^ (u32_t)rand();
+    for (ch = 0U; ch < RS485_DIAG_SENSOR_NUM; ch++)
+    {
+      in.sensor_mv[ch] = (u16_t)(rand() % 3301);
+    }
+    in.ossd1          = (u08_t)(rand() & 0x0F);
+    in.ossd2          = (u08_t)(rand() & 0x0F);
+    in.ossd_confirmed = (u08_t)(rand() & 0x0F);
+    in.relay_fb       = (u08_t)rand();
+    in.temper_raw     = (i16_t)((rand() % 20000) - 5000);
+    in.fault_latched  = ((u32_t)rand() << 16) ^ (u32_t)rand();
+    in.fault_count    = (u16_t)rand();
+    in.fault_level    = (u08_t)(rand() % 4);
+    if ((Round_Trip(&in, &out) == True) && (Same(&in, &out) == True))
+    {
+      ok++;
+    }
+  }
+  CHECK_EQ(ok, 2000U);
+}
+
+/** \brief 작은 버퍼, 다른 frame은 받지 않음 */
+static void Test_Reject(void)
+{
+  Rs485Diag_t in, out;
+  u08_t buf[RS485_DIAG_FRAME_SIZE];
+
+  memset(&in, 0, sizeof(in));
+  in.id = 2U;
+  CHECK_EQ(Rs485_Diag_Build_Frame(&in, buf, sizeof(buf) - 1U), 0U);
+  CHECK_EQ(Rs485_Diag_Build_Frame(&in, buf, sizeof(buf)), RS485_DIAG_FRAME_SIZE);
+  CHECK(Rs485_Diag_Parse_Frame(buf, RS485_DIAG_FRAME_SIZE, &out) == True);
+  CHECK(Rs485_Diag_Parse_Frame(buf, RS485_DIAG_FRAME_SIZE - 1U, &out) == False);
+  buf[4] = 0x01U;                                      /* 다른 msg_type */
+  CHECK(Rs485_Diag_Parse_Frame(buf, RS485_DIAG_FRAME_SIZE, &out) == False);
+  buf[4] = RS485_DIAG_MSG;
+  buf[5] = RS485_DIAG_FRAME_VER + 1U;                  /* 다른 버전 */
+  CHECK(Rs485_Diag_Parse_Frame(buf, RS485_DIAG_FRAME_SIZE, &out) == False);
+}
+
+/** \brief 보드 상태를 모아 보내면 마스터에서 같은 값 */
+static void Test_Collect(void)
+{
+  Rs485Diag_t d, out;
+  u08_t ch;
+
+  Rs485_Diag_Init();
+  for (ch = 0U; ch < kNbrOfSIs; ch++)
+  {
+    _sensor[ch].Sensor_Adc     = (u16_t)(1000U * ch + 123U);
+    _sensor[ch].Ossd_Confirmed = ((ch & 1U) != 0U) ? True : False;
+  }
+  _snap.ossd1 = 0x0FU;
+  _snap.ossd2 = 0x05U;
+  _snap.fb    = 0x13U;
+  g_device_temper_raw = (i16_t)(-10 * 128);
+  _info.latched = (1UL << kFLT_COM_TIMEOUT) | 1UL;
+  _info.level   = (FaultSev_t)2;
+  _faultCount[0] = 3U;
+  _faultCount[kFLT_COM_TIMEOUT] = 70000U;              /* 합이 16bit를 넘으면 포화 */
+  g_host_tick = 123456U;
+
+  Rs485_Diag_Collect(3U, &d);
+  CHECK_EQ(d.id, 3U);
+  CHECK_EQ(d.seq, 0U);
+  CHECK_EQ(d.uptime_msec, 123456U);
+  for (ch = 0U; ch < RS485_DIAG_SENSOR_NUM; ch++)
+  {
+    CHECK_EQ(d.sensor_mv[ch], Device_ADC_To_mV(ch, _sensor[ch].Sensor_Adc));
+  }
+  CHECK_EQ(d.ossd_confirmed, 0x0AU);
+  CHECK_EQ(d.ossd1, 0x0FU);
+  CHECK_EQ(d.ossd2, 0x05U);
+  CHECK_EQ(d.relay_fb, 0x13U);
+  CHECK_EQ(d.temper_raw, -1280);
+  CHECK_EQ(d.fault_latched, _info.latched);
+  CHECK_EQ(d.fault_count, 0xFFFFU);
+  CHECK_EQ(d.fault_level, 2U);
+  CHECK(Round_Trip(&d, &out) == True);
+  CHECK(Same(&d, &out) == True);
+
+  Rs485_Diag_Collect(3U, &d);
+  CHECK_EQ(d.seq, 1U);
+}
+
+/** \brief seq 건너뜀, 보드 재시작, 범위 밖 ID, 보드 순환 */
+static void Test_Store(void)
+{
+  Rs485Diag_t     d;
+  Rs485DiagNode_t n;
+  u08_t i;
+
+  Rs485_Diag_Init();
+  memset(&d, 0, sizeof(d));
+  d.id = 5U;
+  d.uptime_msec = 1000U;
+  Rs485_Diag_Store(&d, 10U);
+  d.seq = 1U;  d.uptime_msec = 1200U;
+  Rs485_Diag_Store(&d, 11U);
+  d.seq = 4U;  d.uptime_msec = 1800U;                  /* 2, 3을 잃음 */
+  Rs485_Diag_Store(&d, 12U);
+  d.seq = 0U;  d.uptime_msec = 50U;                    /* 보드 재시작 */
+  Rs485_Diag_Store(&d, 13U);
+  CHECK(Rs485_Diag_Get_Node(5U, &n) == True);
+  CHECK_EQ(n.seq_lost, 2U);                            /* 재시작은 세지 않음 */
+  d.seq = 0xFFFFU; d.uptime_msec = 100U;
+  Rs485_Diag_Store(&d, 14U);
+  d.seq = 0U;  d.uptime_msec = 300U;                   /* 0xFFFF -> 0 wrap은 잃은 것 없음 */
+  Rs485_Diag_Store(&d, 15U);
+
+  CHECK(Rs485_Diag_Get_Node(5U, &n) == True);
+  CHECK(n.valid == True);
+  CHECK_EQ(n.frames, 6U);
+  CHECK_EQ(n.rx_tick, 15U);
+  CHECK_EQ(n.seq_lost, 2U + 0xFFFEU);                  /* 0 -> 0xFFFF 는 건너뜀 */
+  CHECK(Rs485_Diag_Get_Node(0U, &n) == False);
+  CHECK(Rs485_Diag_Get_Node(RS485_DIAG_NODE_MAX + 1U, &n) == False);
+
+  d.id = RS485_DIAG_NODE_MAX + 1U;
+  Rs485_Diag_Store(&d, 16U);                           /* 범위 밖은 버림 */
+
+  Rs485_Diag_Sent(5U);
+  Rs485_Diag_Timeout(5U);
+  Rs485_Diag_Timeout(0U);
+  (void)Rs485_Diag_Get_Node(5U, &n);
+  CHECK_EQ(n.requests, 1U);
+  CHECK_EQ(n.timeouts, 1U);
+  Rs485_Diag_Clear();
+  (void)Rs485_Diag_Get_Node(5U, &n);
+  CHECK(n.valid == False);
+  CHECK_EQ(n.frames, 0U);
+
+  CHECK_EQ(Rs485_Diag_Next_Id(0U), 0U);
+  for (i = 0U; i < 7U; i++)
+  {
+    CHECK_EQ(Rs485_Diag_Next_Id(3U), (i % 3U) + 1U);
+  }
+  CHECK_EQ(Rs485_Diag_Next_Id(200U), 2U);              /* RS485_DIAG_NODE_MAX로 제한 */
+  for (i = 0U; i < 4U; i++)
+  {
+    (void)Rs485_Diag_Next_Id(200U);
+  }
+  CHECK_EQ(Rs485_Diag_Next_Id(200U), 1U);
+}
+
+int main(void)
+{
+  Test_Round_Trip();
+  Test_Reject();
+  Test_Collect();
+  Test_Store();
+  return HT_RESULT("test_rs485_diag");
+}
+
+/*************** (C) COPYRIGHT SHALOM ENGINEERING CO., LTD. ****END OF FILE****/
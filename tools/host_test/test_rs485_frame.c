@@ -0,0 +1,385 @@
+/** ****************************************************************************
+  * \file    test_rs485_frame.c
+  * \author  Jang Ho Jong
+  * \version V0.0.1
+  * \date    2026.10.17
+  * \brief   RS-485 frame parser host 시험
+  * ***************************************************************************/
+/*
+  - Rs485_Frame_Feed/Get의 resync, 한 수신 묶음의 여러 frame, 이유별 버린 수를 확인한다.
+  - 무작위 시험은 noise(STX 포함)와 틀린 frame 사이에 정상 frame을 섞어 보내고
+    정상 frame만 순서대로 모두 나오는지 본다.
+  - 같은 byte 열을 수신 묶음으로 잘라 Rs485_Frame_Scan에 넘겨 Feed/Get과 결과가 같은지 본다.
+  */
+
+#include <stdlib.h>
+#include <string.h>
+#include "host_test.h"
+#include "rs485_frame.h"
+#include "lib_crc16.h"
+
+/** \brief payload로 frame을 만든다.
+  * \retval frame 길이
+  */
+static u32_t Make_Frame(u08_t out[], const u08_t payload[], u08_t len)
+{
+  u16_t crc;
+
+  out[0] = RS485_FRAME_STX;
+  out[1] = len;
+  memcpy(&out[2], payload, len);
+  crc = Crc16_Krs(&out[1], (u32_t)len + 1U);
+  out[len + 2U] = (u08_t)(crc >> 8);
+  out[len + 3U] = (u08_t)(crc & 0xFFU);
+  out[len + 4U] = RS485_FRAME_ETX;
+  return (u32_t)len + RS485_FRAME_OVERHEAD;
+}
+
+/** \brief 번호가 들어간 시험 frame(payload 앞 2 byte가 번호) */
+static u32_t Make_Seq_Frame(u08_t out[], u32_t seq, u08_t len)
+{
+  u08_t payload[RS485_FRAME_PAYLOAD_MAX];
+  u32_t i;
+
+  for (i = 0U; i < len; i++)
+  {
+    payload[i] = (u08_t)(0x40U + i);
+  }
+  payload[0] = (u08_t)(seq >> 8);
+  payload[1] = (u08_t)seq;
+  return Make_Frame(out, payload, len);
+}
+
+/** \brief 꺼낸 frame이 기대한 frame과 같은지 */
+static Bool_t Same(const Rs485Frame_t * f, const u08_t exp[], u32_t len)
+{
+  return ((f->len == len) && (memcmp(f->data, exp, len) == 0)) ? True : False;
+}
+
+/** \brief 정상 frame 하나, 앞뒤 noise */
+static void Test_Single(void)
+{
+  static Rs485Parser_t p;
+  Rs485Frame_t f;
+  u08_t fr[RS485_FRAME_MAX];
+  u32_t n = Make_Seq_Frame(fr, 1U, 5U);
+
+  Rs485_Frame_Init(&p);
+  Rs485_Frame_Feed(&p, 0xAAU);
+  Rs485_Frame_Feed(&p, 0x55U);
+  Rs485_Frame_Feed_Buf(&p, fr, n);
+  Rs485_Frame_Feed(&p, 0x00U);
+  CHECK(Rs485_Frame_Get(&p, &f) == True);
+  CHECK(Same(&f, fr, n) == True);
+  CHECK(Rs485_Frame_Get(&p, &f) == False);
+  CHECK_EQ(p.frames, 1U);
+  CHECK_EQ(p.drop[kRS485_DROP_NOISE], 3U);
+}
+
+/** \brief 한 수신 묶음에 여러 frame(TDMA 응답 6개) */
+static void Test_Burst(void)
+{
+  static Rs485Parser_t p;
+  Rs485Frame_t f;
+  u08_t buf[6U * RS485_FRAME_MAX];
+  u08_t fr[6][RS485_FRAME_MAX];
+  u32_t len[6];
+  u32_t n = 0U;
+  u32_t i;
+
+  Rs485_Frame_Init(&p);
+  for (i = 0U; i < 6U; i++)
+  {
+    len[i] = Make_Seq_Frame(fr[i], i, (u08_t)(5U + i));
+    memcpy(&buf[n], fr[i], len[i]);
+    n += len[i];
+  }
+  Rs485_Frame_Feed_Buf(&p, buf, n);
+  for (i = 0U; i < 6U; i++)
+  {
+    CHECK(Rs485_Frame_Get(&p, &f) == True);
+    CHECK(Same(&f, fr[i], len[i]) == True);
+  }
+  CHECK(Rs485_Frame_Get(&p, &f) == False);
+  CHECK_EQ(p.frames, 6U);
+  for (i = 0U; i < kNbrOfRs485Drops; i++)
+  {
+    CHECK_EQ(p.drop[i], 0U);
+  }
+}
+
+/** \brief 잘린 frame, 중복 STX 뒤의 정상 frame을 다시 찾는다. */
+static void Test_Resync(void)
+{
+  static Rs485Parser_t p;
+  Rs485Frame_t f;
+  u08_t fr[RS485_FRAME_MAX];
+  u32_t n = Make_Seq_Frame(fr, 7U, 5U);
+
+  /* STX가 두번 : 첫 STX의 LEN은 0x02(정상 범위)라 frame 끝에서 틀리고, 두번째 STX부터 다시 해석 */
+  Rs485_Frame_Init(&p);
+  Rs485_Frame_Feed(&p, RS485_FRAME_STX);
+  Rs485_Frame_Feed_Buf(&p, fr, n);
+  CHECK(Rs485_Frame_Get(&p, &f) == True);
+  CHECK(Same(&f, fr, n) == True);
+  CHECK_EQ(p.frames, 1U);
+  CHECK_EQ(p.drop[kRS485_DROP_ETX] + p.drop[kRS485_DROP_CRC], 1U);
+
+  /* 앞 frame이 잘려 ETX 자리에 다음 frame의 byte가 온다. */
+  Rs485_Frame_Init(&p);
+  Rs485_Frame_Feed_Buf(&p, fr, n - 4U);
+  Rs485_Frame_Feed_Buf(&p, fr, n);
+  Rs485_Frame_Feed_Buf(&p, fr, n);
+  CHECK(Rs485_Frame_Get(&p, &f) == True);
+  CHECK(Same(&f, fr, n) == True);
+  CHECK(Rs485_Frame_Get(&p, &f) == True);
+  CHECK(Same(&f, fr, n) == True);
+  CHECK(Rs485_Frame_Get(&p, &f) == False);
+  CHECK_EQ(p.frames, 2U);
+}
+
+/** \brief 이유별 버린 수 */
+static void Test_Drop_Counter(void)
+{
+  static Rs485Parser_t p;
+  Rs485Frame_t f;
+  u08_t fr[RS485_FRAME_MAX];
+  u08_t bad[RS485_FRAME_MAX];
+  u32_t n = Make_Seq_Frame(fr, 3U, 6U);
+  u32_t i;
+
+  /* LEN 0, LEN 최대값 초과 */
+  Rs485_Frame_Init(&p);
+  bad[0] = RS485_FRAME_STX;
+  bad[1] = 0x00U;
+  Rs485_Frame_Feed_Buf(&p, bad, 2U);
+  bad[1] = RS485_FRAME_PAYLOAD_MAX + 1U;
+  Rs485_Frame_Feed_Buf(&p, bad, 2U);
+  CHECK_EQ(p.drop[kRS485_DROP_LEN], 2U);
+  CHECK_EQ(p.frames, 0U);
+
+  /* ETX 자리가 ETX 아님 */
+  Rs485_Frame_Init(&p);
+  memcpy(bad, fr, n);
+  bad[n - 1U] = 0x7EU;
+  Rs485_Frame_Feed_Buf(&p, bad, n);
+  CHECK_EQ(p.drop[kRS485_DROP_ETX], 1U);
+  CHECK_EQ(p.drop[kRS485_DROP_CRC], 0U);
+
+  /* payload 1 bit 오류 : CRC */
+  Rs485_Frame_Init(&p);
+  memcpy(bad, fr, n);
+  bad[4] ^= 0x10U;
+  Rs485_Frame_Feed_Buf(&p, bad, n);
+  Rs485_Frame_Feed_Buf(&p, fr, n);
+  CHECK_EQ(p.drop[kRS485_DROP_CRC], 1U);
+  CHECK_EQ(p.frames, 1U);
+
+  /* queue full : 꺼내지 않고 RS485_FRAME_QUEUE_SIZE + 1 개 */
+  Rs485_Frame_Init(&p);
+  for (i = 0U; i <= RS485_FRAME_QUEUE_SIZE; i++)
+  {
+    Rs485_Frame_Feed_Buf(&p, fr, n);
+  }
+  CHECK_EQ(p.frames, RS485_FRAME_QUEUE_SIZE);
+  CHECK_EQ(p.drop[kRS485_DROP_QUEUE], 1U);
+  for (i = 0U; i < RS485_FRAME_QUEUE_SIZE; i++)
+  {
+    CHECK(Rs485_Frame_Get(&p, &f) == True);
+  }
+  CHECK(Rs485_Frame_Get(&p, &f) == False);
+
+  /* 받는 중 Reset : PARTIAL, 받은 것이 없으면 세지 않음 */
+  Rs485_Frame_Init(&p);
+  Rs485_Frame_Feed_Buf(&p, fr, n / 2U);
+  Rs485_Frame_Reset(&p);
+  Rs485_Frame_Reset(&p);
+  CHECK_EQ(p.drop[kRS485_DROP_PARTIAL], 1U);
+  Rs485_Frame_Feed_Buf(&p, fr, n);
+  CHECK(Rs485_Frame_Get(&p, &f) == True);
+  CHECK(Same(&f, fr, n) == True);
+
+  Rs485_Frame_Clear_Stat(&p);
+  for (i = 0U; i < kNbrOfRs485Drops; i++)
+  {
+    CHECK_EQ(p.drop[i], 0U);
+  }
+  CHECK(strcmp(Rs485_Frame_Drop_Name(kRS485_DROP_CRC), "CRC") == 0);
+}
+
+static u08_t _stream[200000];                           /* 무작위 수신 byte 열 */
+static u32_t _streamLen;
+static u32_t _streamGood;                              /* 안에 든 정상 frame 수 */
+
+/** \brief noise(STX 포함), 1 bit 틀린 frame, 잘린 frame 사이에 번호 붙은 정상 frame을 섞는다.
+  * \note  틀린 frame, 잘린 frame은 번호가 0xFFFF이다.
+  */
+static void Make_Stream(u32_t seed)
+{
+  u08_t fr[RS485_FRAME_MAX];
+  u32_t n = 0U, good = 0U, len, i, k;
+
+  srand(seed);
+  while (((n + 200U) < sizeof(_stream)) && (good < 8000U))
+  {
+    switch (rand() % 4)
+    {
+    case 0 :                                           /* noise, STX(0x02)도 섞임 */
+      k = (u32_t)(rand() % 8);
+      for (i = 0U; i < k; i++)
+      {
+        _stream[n++] = (u08_t)(rand() % 5);
+      }
+      break;
+    case 1 :                                           /* 1 bit 틀린 frame */
+      len = Make_Seq_Frame(fr, 0xFFFFU, (u08_t)(1 + rand() % 20));
+      fr[1U + (u32_t)rand() % (len - 2U)] ^= (u08_t)(1U << (rand() % 8));
+      memcpy(&_stream[n], fr, len);
+      n += len;
+      break;
+    case 2 :                                           /* 잘린 frame */
+      len = Make_Seq_Frame(fr, 0xFFFFU, (u08_t)(1 + rand() % 20));
+      k   = 1U + (u32_t)rand() % (len - 1U);
+      memcpy(&_stream[n], fr, k);
+      n += k;
+      break;
+    default :                                          /* 정상 frame */
+      len = Make_Seq_Frame(fr, good, (u08_t)(2 + rand() % 20));
+      memcpy(&_stream[n], fr, len);
+      n += len;
+      good++;
+      break;
+    }
+  }
+  /* 마지막 frame 뒤에 STX 없는 byte로 미완성 frame을 밀어낸다(실제 bus는 다음 frame이 민다). */
+  for (i = 0U; i < RS485_FRAME_MAX; i++)
+  {
+    _stream[n++] = 0xA5U;
+  }
+  _streamLen  = n;
+  _streamGood = good;
+}
+
+/** \brief 무작위 noise, 틀린 frame 사이의 정상 frame이 순서대로 모두 나온다. */
+static void Test_Random(void)
+{
+  static Rs485Parser_t p;
+  Rs485Frame_t f;
+  u32_t  got = 0U, extra = 0U, i, k;
+  Bool_t order = True;
+
+  Make_Stream(1234U);
+  Rs485_Frame_Init(&p);
+  for (i = 0U; i < _streamLen; i++)
+  {
+    Rs485_Frame_Feed(&p, _stream[i]);
+    while (Rs485_Frame_Get(&p, &f) == True)
+    {
+      k = ((u32_t)f.data[2] << 8) | f.data[3];
+      if (k >= 0x8000U)
+      {
+        /* 틀린 frame(번호 0xFFFF)에서 나온 frame : 잘린 frame 뒤 noise가 마침 ETX이거나,
+           LEN이 틀려 짧아진 frame의 CRC가 우연히 맞으면 wire 상 정상 frame이 된다. */
+        extra++;
+        continue;
+      }
+      if (k != got)
+      {
+        order = False;
+      }
+      got++;
+    }
+  }
+  CHECK(order == True);
+  CHECK_EQ(got, _streamGood);
+  CHECK_EQ(p.frames, _streamGood + extra);
+  CHECK_EQ(p.drop[kRS485_DROP_QUEUE], 0U);
+  CHECK(p.drop[kRS485_DROP_CRC] + p.drop[kRS485_DROP_ETX] + p.drop[kRS485_DROP_LEN] > 0U);
+}
+
+/** \brief Rs485_Frame_Scan이 Feed/Get과 같은 frame, 같은 통계를 낸다.
+  * \note  같은 byte 열을 무작위 크기(1 ~ 2 frame)의 수신 묶음으로 잘라 Scan에 넘긴다.
+  *        묶음 경계에 걸친 frame은 Feed 경로로, 묶음 안의 frame은 복사 없는 경로로 나온다.
+  */
+static void Test_Scan_Equal(void)
+{
+  static Rs485Parser_t pf;
+  static Rs485Parser_t ps;
+  static u08_t  ref[10000][RS485_FRAME_MAX];
+  static u08_t  ref_len[10000];
+  static u08_t  chunk[2U * RS485_FRAME_MAX];
+  Rs485Frame_t  f;
+  Rs485View_t   v;
+  u32_t  nf = 0U, ns = 0U, zero_copy = 0U, i, k, c, pos;
+  u32_t  seed;
+  Bool_t same = True;
+
+  for (seed = 1U; seed <= 4U; seed++)
+  {
+    Make_Stream(seed);
+    nf = 0U;
+    ns = 0U;
+    zero_copy = 0U;
+    same = True;
+
+    Rs485_Frame_Init(&pf);
+    for (i = 0U; i < _streamLen; i++)
+    {
+      Rs485_Frame_Feed(&pf, _stream[i]);
+      while ((Rs485_Frame_Get(&pf, &f) == True) && (nf < 10000U))
+      {
+        memcpy(ref[nf], f.data, f.len);
+        ref_len[nf] = f.len;
+        nf++;
+      }
+    }
+
+    Rs485_Frame_Init(&ps);
+    for (i = 0U; i < _streamLen; i += c)
+    {
+      c = 1U + (u32_t)rand() % sizeof(chunk);
+      if ((i + c) > _streamLen)
+      {
+        c = _streamLen - i;
+      }
+      memcpy(chunk, &_stream[i], c);                   /* 드라이버 수신 버퍼 흉내 */
+      pos = 0U;
+      while (Rs485_Frame_Scan(&ps, chunk, c, &pos, &v) == True)
+      {
+        if ((v.data >= chunk) && (v.data < &chunk[c]))
+        {
+          zero_copy++;
+        }
+        if ((ns >= nf) || (v.len != ref_len[ns]) || (memcmp(v.data, ref[ns], v.len) != 0))
+        {
+          same = False;
+        }
+        ns++;
+      }
+      CHECK_EQ(pos, c);
+    }
+
+    CHECK(same == True);
+    CHECK_EQ(ns, nf);
+    CHECK_EQ(ps.frames, pf.frames);
+    for (k = 0U; k < kNbrOfRs485Drops; k++)
+    {
+      CHECK_EQ(ps.drop[k], pf.drop[k]);
+    }
+    CHECK(zero_copy > 0U);
+    CHECK(zero_copy < ns);
+  }
+}
+
+int main(void)
+{
+  Test_Single();
+  Test_Burst();
+  Test_Resync();
+  Test_Drop_Counter();
+  Test_Random();
+  Test_Scan_Equal();
+  return HT_RESULT("test_rs485_frame");
+}
+
+/*************** (C) COPYRIGHT SHALOM ENGINEERING CO., LTD. ****END OF FILE****/
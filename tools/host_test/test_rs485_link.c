@@ -0,0 +1,230 @@
+/** ****************************************************************************
+  * \file    test_rs485_link.c
+  * \author  Jang Ho Jong
+  * \version V0.0.1
+  * \date    2026.10.17
+  * \brief   RS-485 link RTT/RTO host 시험
+  * ***************************************************************************/
+/*
+  - Rs485_Link의 RTT 추정(srtt, rttvar)과 응답 대기 시간(RTO)이 실제 RTT로 수렴하는지 확인한다.
+  - 무응답 시 RTO 두배 증가, 재시도 한도, 통계 계수와 통계 frame도 확인한다.
+  */
+
+#include <stdlib.h>
+#include <string.h>
+#include "host_test.h"
+#include "rs485_link.h"
+#include "rs485_frame.h"
+
+/** \brief base ± jitter 사이의 무작위 RTT */
+static u32_t Rtt(u32_t base, u32_t jitter)
+{
+  return base - jitter + ((u32_t)rand() % ((2U * jitter) + 1U));
+}
+
+/** \brief 처음 RTO에서 흔들리는 RTT로 수렴 */
+static void Test_Converge(void)
+{
+  Rs485LinkStat_t s;
+  u32_t i, rtt, settle = 0U;
+
+  Rs485_Link_Init();
+  CHECK_EQ(Rs485_Link_Rto(1U), RS485_LINK_RTO_INIT_usec);
+  srand(14);
+  for (i = 1U; i <= 200U; i++)
+  {
+    rtt = Rtt(3000U, 200U);
+    Rs485_Link_Reply(1U, rtt);
+    if ((settle == 0U) && (Rs485_Link_Rto(1U) < 4500U))
+    {
+      settle = i;
+    }
+    if (i > 20U)
+    {
+      CHECK(Rs485_Link_Rto(1U) > rtt);                 /* 수렴 뒤에는 정상 응답을 무응답으로 보지 않음 */
+    }
+  }
+  (void)Rs485_Link_Get_Stat(1U, &s);
+  printf("  RTT 3000+-200 : RTO %u -> %u usec (srtt %u, rttvar %u), < 4500 after %u replies\n",
+         (unsigned)RS485_LINK_RTO_INIT_usec, (unsigned)s.rto, (unsigned)s.srtt, (unsigned)s.rttvar, (unsigned)settle);
+  CHECK(s.srtt > 2850U);
+  CHECK(s.srtt < 3150U);
+  CHECK(s.rto < 4500U);
+  CHECK(settle != 0U);
+  CHECK(settle <= 20U);
+  CHECK_EQ(s.replies, 200U);
+  CHECK_EQ(s.fails, 0U);
+}
+
+/** \brief 일정한 RTT : srtt는 정수 나눗셈 잔차 안으로, RTO는 하한에 고정 */
+static void Test_Steady(void)
+{
+  Rs485LinkStat_t s;
+  u32_t i;
+
+  Rs485_Link_Init();
+  for (i = 0U; i < 100U; i++)
+  {
+    Rs485_Link_Reply(2U, 5000U);
+  }
+  (void)Rs485_Link_Get_Stat(2U, &s);
+  CHECK(s.srtt > (5000U - 8U));
+  CHECK(s.srtt < (5000U + 8U));
+  CHECK(s.rto >= 5000U);
+  CHECK(s.rto < 5100U);
+
+  Rs485_Link_Init();
+  for (i = 0U; i < 100U; i++)
+  {
+    Rs485_Link_Reply(3U, 800U);
+  }
+  CHECK_EQ(Rs485_Link_Rto(3U), RS485_LINK_RTO_MIN_usec);
+
+  Rs485_Link_Init();
+  Rs485_Link_Reply(4U, 40000U);
+  Rs485_Link_Reply(4U, 45000U);
+  CHECK_EQ(Rs485_Link_Rto(4U), RS485_LINK_RTO_MAX_usec);
+}
+
+/** \brief RTT가 두배로 바뀌면(속도 저하, 중계 지연) 새 RTT로 다시 수렴 */
+static void Test_Step(void)
+{
+  Rs485LinkStat_t s;
+  u32_t i, settle = 0U;
+
+  Rs485_Link_Init();
+  for (i = 0U; i < 100U; i++)
+  {
+    Rs485_Link_Reply(5U, 3000U);
+  }
+  for (i = 1U; i <= 100U; i++)
+  {
+    Rs485_Link_Reply(5U, 6000U);
+    if ((settle == 0U) && (Rs485_Link_Rto(5U) > 6000U))
+    {
+      settle = i;
+    }
+  }
+  (void)Rs485_Link_Get_Stat(5U, &s);
+  printf("  RTT step 3000 -> 6000 : RTO > 6000 after %u replies, srtt %u\n", (unsigned)settle, (unsigned)s.srtt);
+  CHECK(settle != 0U);
+  CHECK(settle <= 3U);
+  CHECK(s.srtt > (6000U - 8U));
+  CHECK(s.rto >= 6000U);
+  CHECK(s.rto < 6200U);
+}
+
+/** \brief 무응답 : RTO 두배(상한), 재시도 한도를 넘으면 고장, 응답이 오면 연속 실패 지움 */
+static void Test_Timeout(void)
+{
+  Rs485LinkStat_t s;
+  u32_t i, rto;
+
+  Rs485_Link_Init();
+  for (i = 0U; i < 50U; i++)
+  {
+    Rs485_Link_Reply(1U, 3000U);
+  }
+  rto = Rs485_Link_Rto(1U);
+
+  CHECK_EQ(Rs485_Link_Get_Retry(), RS485_LINK_RETRY_DEF);
+  CHECK(Rs485_Link_Timeout(1U) == False);
+  CHECK_EQ(Rs485_Link_Rto(1U), 2U * rto);
+  CHECK(Rs485_Link_Timeout(1U) == False);
+  CHECK_EQ(Rs485_Link_Rto(1U), 4U * rto);
+  CHECK(Rs485_Link_Timeout(1U) == True);               /* RETRY_DEF(2)번 재시도 뒤 */
+  for (i = 0U; i < 10U; i++)
+  {
+    (void)Rs485_Link_Timeout(1U);
+  }
+  CHECK_EQ(Rs485_Link_Rto(1U), RS485_LINK_RTO_MAX_usec);
+
+  Rs485_Link_Reply(1U, 3000U);                         /* 복귀 : 연속 실패 지움, RTO는 다시 줄어듦 */
+  (void)Rs485_Link_Get_Stat(1U, &s);
+  CHECK_EQ(s.fails, 0U);
+  CHECK_EQ(s.timeouts, 13U);
+  CHECK(s.rto < RS485_LINK_RTO_MAX_usec);
+  CHECK(Rs485_Link_Timeout(1U) == False);
+
+  CHECK(Rs485_Link_Set_Retry(0U) == True);
+  CHECK(Rs485_Link_Timeout(2U) == True);
+  CHECK(Rs485_Link_Set_Retry(RS485_LINK_RETRY_MAX + 1U) == False);
+  CHECK_EQ(Rs485_Link_Get_Retry(), 0U);
+  CHECK(Rs485_Link_Set_Retry(RS485_LINK_RETRY_DEF) == True);
+
+  Rs485_Link_Reset_Rtt();                              /* 속도 변경 : 추정만 처음으로 */
+  (void)Rs485_Link_Get_Stat(1U, &s);
+  CHECK_EQ(s.rto, RS485_LINK_RTO_INIT_usec);
+  CHECK_EQ(s.srtt, 0U);
+  CHECK_EQ(s.timeouts, 14U);
+}
+
+/** \brief 통계 계수, min/avg/max, 통계 frame */
+static void Test_Stat_Frame(void)
+{
+  static Rs485Parser_t p;
+  Rs485LinkStat_t s;
+  Rs485Frame_t f;
+  u08_t buf[RS485_LINK_FRAME_SIZE + 4U];
+  u32_t n;
+
+  Rs485_Link_Init();
+  Rs485_Link_Sent(6U);
+  Rs485_Link_Sent(6U);
+  Rs485_Link_Sent(6U);
+  Rs485_Link_Reply(6U, 2000U);
+  Rs485_Link_Reply(6U, 4000U);
+  (void)Rs485_Link_Timeout(6U);
+  Rs485_Link_Crc_Error(6U);
+  Rs485_Link_Id_Error(6U);
+  Rs485_Link_Id_Error(0U);
+  Rs485_Link_Id_Error(200U);                           /* 범위 밖은 [0]으로 */
+  Rs485_Link_Len_Error(6U);
+  Rs485_Link_Len_Error(6U);
+
+  (void)Rs485_Link_Get_Stat(6U, &s);
+  CHECK_EQ(s.sent, 3U);
+  CHECK_EQ(s.replies, 2U);
+  CHECK_EQ(s.timeouts, 1U);
+  CHECK_EQ(s.crc_err, 1U);
+  CHECK_EQ(s.id_err, 1U);
+  CHECK_EQ(s.len_err, 2U);
+  CHECK_EQ(s.rtt_min, 2000U);
+  CHECK_EQ(s.rtt_max, 4000U);
+  CHECK_EQ(Rs485_Link_Rtt_Avg(6U), 3000U);
+  (void)Rs485_Link_Get_Stat(0U, &s);
+  CHECK_EQ(s.id_err, 2U);
+  CHECK(Rs485_Link_Get_Stat(RS485_LINK_NODE_MAX + 1U, &s) == False);
+
+  CHECK_EQ(Rs485_Link_Build_Frame(6U, buf, RS485_LINK_FRAME_SIZE - 1U), 0U);
+  n = Rs485_Link_Build_Frame(6U, buf, sizeof(buf));
+  CHECK_EQ(n, RS485_LINK_FRAME_SIZE);
+  Rs485_Frame_Init(&p);
+  Rs485_Frame_Feed_Buf(&p, buf, n);
+  CHECK(Rs485_Frame_Get(&p, &f) == True);              /* STX, LEN, CRC, ETX가 맞는 frame */
+  CHECK_EQ(f.data[2], RS485_LINK_MSG);
+  CHECK_EQ(f.data[3], RS485_LINK_FRAME_VER);
+  CHECK_EQ(f.data[4], 6U);
+  CHECK_EQ(((u32_t)f.data[5] << 24) | ((u32_t)f.data[6] << 16) | ((u32_t)f.data[7] << 8) | f.data[8], 3U);
+  CHECK_EQ(((u32_t)f.data[21] << 8) | f.data[22], 3000U);  /* rtt avg */
+  CHECK_EQ(((u32_t)f.data[27] << 8) | f.data[28], 2U);     /* len_err */
+
+  Rs485_Link_Clear_Stat();
+  (void)Rs485_Link_Get_Stat(6U, &s);
+  CHECK_EQ(s.sent, 0U);
+  CHECK_EQ(s.len_err, 0U);
+  CHECK_EQ(s.rtt_max, 0U);
+  CHECK(s.srtt != 0U);                                 /* 동작 상태는 유지 */
+}
+
+int main(void)
+{
+  Test_Converge();
+  Test_Steady();
+  Test_Step();
+  Test_Timeout();
+  Test_Stat_Frame();
+  return HT_RESULT("test_rs485_link");
+}
+
+/*************** (C) COPYRIGHT SHALOM ENGINEERING CO., LTD. ****END OF FILE****/
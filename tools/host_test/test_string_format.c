@@ -0,0 +1,248 @@
+/** ****************************************************************************
+  * \file    test_string_format.c
+  * \author  Jang Ho Jong
+  * \version V0.0.1
+  * \date    2026.10.17
+  * \brief   String_Format()/String_Printf() host 시험
+  * ***************************************************************************/
+/*
+  - 같은 format과 인자로 C library vsnprintf와 String_Format의 출력, 반환값이 같은지 확인한다.
+    정수(%d %i %u %x %X), 문자(%c), 문자열(%s)의 flag, width, precision, *, h/hh 조합과 무작위 값.
+  - vsnprintf에 없는 고정소수점(%q), 버퍼 잘림, put callback(줄 단위, 버퍼 가득)은 기대값과 비교한다.
+  - 끝에 host에서 한 호출당 시간을 snprintf와 비교해 출력한다(target cycle은 Console "CONTX"로 본다).
+  */
+
+#include <stdlib.h>
+#include <string.h>
+#include <stdarg.h>
+#include <time.h>
+#include "host_test.h"
+#include "lib_string.h"
+
+/** \brief libc와 String_Format 결과 비교 */
+static void Same_As_Libc(const char * fmt, ...)
+{
+  char     a[256], b[256];
+  va_list  ap, aq;
+  int      ra;
+  u32_t    rb;
+
+  va_start(ap, fmt);
+  va_copy(aq, ap);
+  ra = vsnprintf(a, sizeof(a), fmt, ap);
+  rb = String_Format(b, sizeof(b), NULL, NULL, fmt, aq);
+  va_end(aq);
+  va_end(ap);
+  ht_checks++;
+  if ((strcmp(a, b) != 0) || ((u32_t)ra != rb))
+  {
+    ht_fails++;
+    if (ht_fails < 30U)
+    {
+      printf("FAIL fmt [%s] libc [%s] %d, String_Format [%s] %u\n", fmt, a, ra, b, (unsigned)rb);
+    }
+  }
+}
+
+/** \brief 정수, 문자, 문자열 변환 */
+static void Test_Libc(void)
+{
+  static const char * const ifmt[] = { "%d", "%i", "%5d", "%-5d|", "%05d", "%+d", "% d", "%.3d", "%8.3d", "%-8.3d|",
+                                       "%08.3d", "%.0d", "%+05d", "%hd", "%hhd", "%*d", "%-*d|", "%.*d", "%ld" };
+  static const char * const ufmt[] = { "%u", "%x", "%X", "%08X", "%#x", "%#X", "%#010x", "%-6x|", "%.4x", "%hx",
+                                       "%hhu", "%2x", "%.0x", "%#.0x", "%lu" };
+  static const char * const sfmt[] = { "%s", "%10s", "%-10s|", "%.3s", "%10.2s", "%-3.1s|", "%.0s", "%.*s" };
+  static const int vals[] = { 0, 1, -1, 7, -7, 42, -42, 123, 99999, -99999, 2147483647, (int)0x80000000,
+                              65535, -32768, 255, -129, 1000000000 };
+  u32_t k, i;
+  int   v;
+
+  for (k = 0U; k < (sizeof(ifmt) / sizeof(ifmt[0])); k++)
+  {
+    for (i = 0U; i < (sizeof(vals) / sizeof(vals[0])); i++)
+    {
+      if (strchr(ifmt[k], '*') != NULL)
+      {
+        Same_As_Libc(ifmt[k], 7, vals[i]);
+      }
+      else if (strchr(ifmt[k], 'l') != NULL)
+      {
+        Same_As_Libc(ifmt[k], (long)vals[i]);
+      }
+      else
+      {
+        Same_As_Libc(ifmt[k], vals[i]);
+      }
+    }
+  }
+  for (k = 0U; k < (sizeof(ufmt) / sizeof(ufmt[0])); k++)
+  {
+    for (i = 0U; i < (sizeof(vals) / sizeof(vals[0])); i++)
+    {
+      if (strchr(ufmt[k], 'l') != NULL)
+      {
+        Same_As_Libc(ufmt[k], (unsigned long)(unsigned)vals[i]);
+      }
+      else
+      {
+        Same_As_Libc(ufmt[k], (unsigned)vals[i]);
+      }
+    }
+  }
+  for (k = 0U; k < (sizeof(sfmt) / sizeof(sfmt[0])); k++)
+  {
+    if (strchr(sfmt[k], '*') != NULL)
+    {
+      Same_As_Libc(sfmt[k], 2, "hello");
+    }
+    else
+    {
+      Same_As_Libc(sfmt[k], "hello");
+      Same_As_Libc(sfmt[k], "");
+    }
+  }
+
+  srand(24);
+  for (i = 0U; i < 20000U; i++)
+  {
+    v = rand() ^ (rand() << 16);
+    Same_As_Libc("[%d|%u|%x|%X|%08x|%-11d|%+.5d]", v, (unsigned)v, (unsigned)v, (unsigned)v, (unsigned)v, v, v);
+  }
+
+  Same_As_Libc("%c%c%5c%-3c|", 'a', 'B', 'x', 'y');
+  Same_As_Libc("100%% %s=%d\n", "x", 5);
+  Same_As_Libc("abc");
+  Same_As_Libc("");
+  Same_As_Libc("Console TX %s, Policy %s, Buf Peak %d/%d byte\n", "DMA", "BLOCK", 12, 2048);
+  Same_As_Libc("  ID %d : Sent %d, Reply %d, CRC %d, Timeout %d, ID %d, RTT %d/%d/%d, RTO %d\n",
+               3, 1000, 998, 1, 1, 0, 2900, 3010, 3400, 3458);
+}
+
+/** \brief 고정소수점 %q : 정수를 10^precision으로 나눈 값 */
+static void Test_Fixed_Point(void)
+{
+  static const struct
+  {
+    int          v;
+    const char * fmt;
+    const char * exp;
+  } q[] =
+  {
+    { -1234,           "%.2q",    "-12.34"       },
+    { 5,               "%.1q",    "0.5"          },
+    { -5,              "%.1q",    "-0.5"         },
+    { 25000,           "%.3q",    "25.000"       },
+    { 7,               "%q",      "7"            },
+    { -7,              "%+6.2q",  " -0.07"       },
+    { 7,               "%+.2q",   "+0.07"        },
+    { 123,             "%07.1q",  "00012.3"      },
+    { -123,            "%-8.1q|", "-12.3   |"    },
+    { 2147483647,      "%.9q",    "2.147483647"  },
+    { (int)0x80000000, "%.9q",    "-2.147483648" },
+    { 1,               "%.12q",   "0.000000001"  },
+  };
+  char  b[64];
+  u32_t k;
+
+  for (k = 0U; k < (sizeof(q) / sizeof(q[0])); k++)
+  {
+    (void)String_Printf(b, sizeof(b), q[k].fmt, q[k].v);
+    CHECK(strcmp(b, q[k].exp) == 0);
+  }
+}
+
+/** \brief 버퍼 잘림 : 항상 NUL로 끝나고 반환값은 잘리지 않은 길이(snprintf와 같음) */
+static void Test_Truncate(void)
+{
+  char  b[8];
+  u32_t r;
+
+  r = String_Printf(b, sizeof(b), "%s-%d", "abcdef", 12345);
+  CHECK(strcmp(b, "abcdef-") == 0);
+  CHECK_EQ(r, 12U);
+  r = String_Printf(b, 1U, "%d", 5);
+  CHECK(b[0] == '\0');
+  CHECK_EQ(r, 1U);
+  CHECK_EQ(String_Printf(NULL, 0U, "%d", 12345), 5U);
+}
+
+static char  _line[4096];                              /* put으로 받은 내용 */
+static u32_t _lineLen;
+static u32_t _puts;
+
+static void Put(void * ctx, const char_t s[], u32_t n)
+{
+  (void)ctx;
+  memcpy(&_line[_lineLen], s, n);
+  _lineLen += n;
+  _puts++;
+}
+
+static u32_t Format_Put(char * buf, u32_t size, const char * fmt, ...)
+{
+  va_list ap;
+  u32_t   r;
+
+  va_start(ap, fmt);
+  r = String_Format(buf, size, Put, NULL, fmt, ap);
+  va_end(ap);
+  return r;
+}
+
+/** \brief put callback : 줄이 끝날 때와 buf가 찰 때 내보내고 잘림이 없다. */
+static void Test_Put(void)
+{
+  char  b[16];
+  char  big[600];
+  u32_t r;
+
+  memset(big, 'x', sizeof(big) - 1U);
+  big[sizeof(big) - 1U] = '\0';
+  r = Format_Put(b, sizeof(b), "ab\ncd\n%s\ntail", big);
+  CHECK_EQ(r, 6U + 599U + 1U + 4U);
+  CHECK_EQ(_lineLen, r);
+  CHECK(memcmp(_line, "ab\ncd\n", 6U) == 0);
+  CHECK(memcmp(&_line[6U + 599U], "\ntail", 5U) == 0);
+  CHECK_EQ(_puts, 2U + 38U + 1U);                      /* 줄 2개, 15 byte씩 599+1 byte, 마지막 */
+}
+
+/** \brief host 한 호출당 시간(참고용) */
+static void Bench(void)
+{
+  static char b[512];
+  struct timespec a, c;
+  volatile u32_t sum = 0U;
+  double t_ours, t_libc;
+  int i;
+
+  clock_gettime(CLOCK_MONOTONIC, &a);
+  for (i = 0; i < 200000; i++)
+  {
+    sum += String_Printf(b, sizeof(b), "Msg %d, Drop New %d msg, Drop Old %d byte, %s %08X\n", i, i * 7, -i, "DMA", i);
+  }
+  clock_gettime(CLOCK_MONOTONIC, &c);
+  t_ours = ((double)(c.tv_sec - a.tv_sec) * 1e9) + (double)(c.tv_nsec - a.tv_nsec);
+
+  clock_gettime(CLOCK_MONOTONIC, &a);
+  for (i = 0; i < 200000; i++)
+  {
+    sum += (u32_t)snprintf(b, sizeof(b), "Msg %d, Drop New %d msg, Drop Old %d byte, %s %08X\n", i, i * 7, -i, "DMA", i);
+  }
+  clock_gettime(CLOCK_MONOTONIC, &c);
+  t_libc = ((double)(c.tv_sec - a.tv_sec) * 1e9) + (double)(c.tv_nsec - a.tv_nsec);
+
+  printf("  host : String_Printf %.0f nsec/call, snprintf %.0f nsec/call\n", t_ours / 200000.0, t_libc / 200000.0);
+  (void)sum;
+}
+
+int main(void)
+{
+  Test_Libc();
+  Test_Fixed_Point();
+  Test_Truncate();
+  Test_Put();
+  Bench();
+  return HT_RESULT("test_string_format");
+}
+
+/*************** (C) COPYRIGHT SHALOM ENGINEERING CO., LTD. ****END OF FILE****/